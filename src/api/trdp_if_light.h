@@ -17,6 +17,14 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: tlc_traceDump() added
+*      BL 2026-10-18: tlp_getBurstProfile() added
+*      BL 2026-10-18: tlm_notifyBatch() added
+*      BL 2026-10-18: tlm_openCompletionQueue(), tlm_postCompletion(), tlm_getCompletions() added
+*      BL 2026-10-18: tlm_allocBuffer(), tlm_freeBuffer(), tlm_notifyBuffer(), tlm_requestBuffer(), tlm_replyBuffer() added
+*      BL 2026-10-18: tlm_configTCPPool(), tlm_getTCPPoolStatistics() added
+*      BL 2026-10-18: tlp_setCallbackDispatch(), tlp_getDispatchStatistics() added
+*      BL 2026-10-18: tlc_startSessionThreads() added
 *
 *      BL 2020-09-08: Ticket #343 userStatus parameter size in tlm_reply and tlm_replyQuery
 *      BL 2020-08-05: tlc_freeBuffer() declaration removed, it was never defined!
@@ -100,6 +108,10 @@ EXT_DECL TRDP_ERR_T tlc_presetIndexSession (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_IDX_TABLE_T    *pIndexTableSizes);
 
+EXT_DECL TRDP_ERR_T tlc_startSessionThreads (
+    TRDP_APP_SESSION_T              appHandle,
+    const TRDP_PROCESS_CONFIG_T     *pProcessConfig);
+
 EXT_DECL TRDP_ERR_T tlc_closeSession (
     TRDP_APP_SESSION_T appHandle);
 
@@ -261,6 +273,20 @@ EXT_DECL TRDP_ERR_T tlp_get (
     UINT8               *pData,
     UINT32              *pDataSize);
 
+EXT_DECL TRDP_ERR_T tlp_setCallbackDispatch (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              noOfWorkers,
+    UINT32              queueDepth);
+
+EXT_DECL TRDP_ERR_T tlp_getDispatchStatistics (
+    TRDP_APP_SESSION_T              appHandle,
+    TRDP_SUB_T                      subHandle,
+    TRDP_PD_DISPATCH_STATISTICS_T   *pStatistics);
+
+EXT_DECL TRDP_ERR_T tlp_getBurstProfile (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_BURST_PROFILE_T    *pProfile);
+
 #if MD_SUPPORT
 
 EXT_DECL TRDP_ERR_T tlm_process (
@@ -290,6 +316,17 @@ EXT_DECL TRDP_ERR_T tlm_notify (
     const TRDP_URI_USER_T   srcURI,
     const TRDP_URI_USER_T   destURI);
 
+EXT_DECL TRDP_ERR_T tlm_notifyBatch (
+    TRDP_APP_SESSION_T          appHandle,
+    UINT32                      etbTopoCnt,
+    UINT32                      opTrnTopoCnt,
+    TRDP_IP_ADDR_T              srcIpAddr,
+    TRDP_FLAGS_T                pktFlags,
+    const TRDP_SEND_PARAM_T     *pSendParam,
+    const TRDP_MD_NOTIFY_ITEM_T *pItems,
+    UINT32                      noOfItems,
+    TRDP_ERR_T                  *pResults);
+
 
 EXT_DECL TRDP_ERR_T tlm_request (
     TRDP_APP_SESSION_T      appHandle,
@@ -322,6 +359,32 @@ EXT_DECL TRDP_ERR_T tlm_abortSession (
     TRDP_APP_SESSION_T  appHandle,
     const TRDP_UUID_T   *pSessionId);
 
+EXT_DECL TRDP_ERR_T tlm_configTCPPool (
+    TRDP_APP_SESSION_T              appHandle,
+    const TRDP_MD_TCP_POOL_CONFIG_T *pConfig);
+
+EXT_DECL TRDP_ERR_T tlm_getTCPPoolStatistics (
+    TRDP_APP_SESSION_T              appHandle,
+    TRDP_MD_TCP_POOL_STATISTICS_T   *pStatistics);
+
+EXT_DECL TRDP_ERR_T tlm_openCompletionQueue (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              depth);
+
+EXT_DECL void tlm_postCompletion (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize);
+
+EXT_DECL TRDP_ERR_T tlm_getCompletions (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_MD_COMPLETION_T    *pRecords,
+    UINT32                  maxRecords,
+    UINT32                  *pNoOfRecords,
+    UINT32                  usTimeout);
+
 
 EXT_DECL TRDP_ERR_T tlm_addListener (
     TRDP_APP_SESSION_T      appHandle,
@@ -374,6 +437,60 @@ EXT_DECL TRDP_ERR_T tlm_replyQuery (
     UINT32                  dataSize,
     const TRDP_URI_USER_T   srcURI);
 
+EXT_DECL TRDP_ERR_T tlm_allocBuffer (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              dataSize,
+    UINT8               **ppData);
+
+EXT_DECL TRDP_ERR_T tlm_freeBuffer (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT8               *pData);
+
+EXT_DECL TRDP_ERR_T tlm_notifyBuffer (
+    TRDP_APP_SESSION_T      appHandle,
+    const void              *pUserRef,
+    TRDP_MD_CALLBACK_T      pfCbFunction,
+    UINT32                  comId,
+    UINT32                  etbTopoCnt,
+    UINT32                  opTrnTopoCnt,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr,
+    TRDP_FLAGS_T            pktFlags,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    UINT8                   *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI,
+    const TRDP_URI_USER_T   destURI);
+
+EXT_DECL TRDP_ERR_T tlm_requestBuffer (
+    TRDP_APP_SESSION_T      appHandle,
+    const void              *pUserRef,
+    TRDP_MD_CALLBACK_T      pfCbFunction,
+    TRDP_UUID_T             *pSessionId,
+    UINT32                  comId,
+    UINT32                  etbTopoCnt,
+    UINT32                  opTrnTopoCnt,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr,
+    TRDP_FLAGS_T            pktFlags,
+    UINT32                  numReplies,
+    UINT32                  replyTimeout,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    UINT8                   *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI,
+    const TRDP_URI_USER_T   destURI);
+
+EXT_DECL TRDP_ERR_T tlm_replyBuffer (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_UUID_T       *pSessionId,
+    UINT32                  comId,
+    UINT32                  userStatus,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    UINT8                   *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI);
+
 #endif /* MD_SUPPORT    */
 
 EXT_DECL const CHAR8 *tlc_getVersionString (
@@ -422,6 +539,11 @@ EXT_DECL TRDP_ERR_T tlc_getJoinStatistics (
 EXT_DECL TRDP_ERR_T tlc_resetStatistics (
     TRDP_APP_SESSION_T appHandle);
 
+#ifdef TRDP_TRACE
+EXT_DECL TRDP_ERR_T tlc_traceDump (
+    const CHAR8 *pFileName);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,17 @@
  *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2015-2021. All rights reserved.
  */
 /*
+ *      BL 2026-10-18: Trace ring record and dump format (TRDP_TRACE_REC_T)
+ *      BL 2026-10-18: Timing histograms in subscriber and publisher statistics (TRDP_HISTOGRAM_T)
+ *      BL 2026-10-18: TRDP_OPTION_INDEXED selects the indexed scheduler per session, TRDP_OPTION_T 16 bit
+ *      BL 2026-10-18: Base transmit cycle of the index tables (TRDP_IDX_TABLE_T.baseCycle), HP granularity 250us
+ *      BL 2026-10-18: Burst profile of the indexed transmit tables (TRDP_BURST_PROFILE_T)
+ *      BL 2026-10-18: Generator of MD session IDs selectable (TRDP_MD_CONFIG_T.sessionIdGen)
+ *      BL 2026-10-18: Batched notification (TRDP_MD_NOTIFY_ITEM_T)
+ *      BL 2026-10-18: MD completion record (TRDP_MD_COMPLETION_T)
+ *      BL 2026-10-18: TCP MD connection pool configuration and statistics
+ *      BL 2026-10-18: PD callback dispatch statistics (TRDP_PD_DISPATCH_STATISTICS_T)
+ *      BL 2026-10-18: Thread layout (policy, priority, CPU affinity) for managed session threads
  *      SB 2021-08.09: Ticket #375 Replaced parameters of vos_memCount to prevent alignment issues
  *     AHW 2021-04-30: Ticket #349 support for parsing "dataset name" and "device type"
  *      BL 2020-07-10: Ticket #321 Move TRDP_TIMER_GRANULARITY to public API
@@ -220,8 +231,10 @@ typedef enum
 #define TRDP_INFINITE_TIMEOUT       0xffffffffu /**< Infinite reply timeout                               */
 #define TRDP_DEFAULT_PD_TIMEOUT     100000u /**< Default PD timeout 100ms from 61375-2-3 Table C.7        */
 
+#define TRDP_TIMER_GRANULARITY_INDEXED  250u            /**< granularity in us of the indexed scheduler    */
+
 #ifdef HIGH_PERF_INDEXED
-#   define TRDP_TIMER_GRANULARITY   500u                /**< granularity in us - we allow 0.5ms now!      */
+#   define TRDP_TIMER_GRANULARITY   TRDP_TIMER_GRANULARITY_INDEXED  /**< granularity in us - smallest base cycle */
 #else
 #   define TRDP_TIMER_GRANULARITY   5000u               /**< granularity in us - we allow 5ms now!        */
 #endif
@@ -308,6 +321,25 @@ typedef struct
     TRDP_ERR_T          resultCode;         /**< error code                                 */
 } TRDP_MD_INFO_T;
 
+/** Completion record of a MD session, returned by tlm_getCompletions() */
+typedef struct
+{
+    TRDP_MD_INFO_T      info;               /**< message info as passed to a callback       */
+    UINT8               *pData;             /**< received data in a lent buffer (see tlm_allocBuffer()), must be
+                                                 released by tlm_freeBuffer() or sent by a tlm_*Buffer() call,
+                                                 NULL if no data                            */
+    UINT32              dataSize;           /**< size of the received data                  */
+} TRDP_MD_COMPLETION_T;
+
+/** Notification of a batch sent by tlm_notifyBatch() */
+typedef struct
+{
+    UINT32              comId;              /**< ComID                                      */
+    TRDP_IP_ADDR_T      destIpAddr;         /**< unicast or multicast destination           */
+    const UINT8         *pData;             /**< data / dataset, NULL if none               */
+    UINT32              dataSize;           /**< size of the data                           */
+} TRDP_MD_NOTIFY_ITEM_T;
+
 
 /**    Quality/type of service, time to live , no. of retries, TSN flag and VLAN ID   */
 typedef struct
@@ -476,6 +508,21 @@ typedef struct
     TRDP_MD_STATISTICS_T    tcpMd;        /**< TCP md statistics */
 } GNU_PACKED TRDP_STATISTICS_T;
 
+/** Number of buckets of a timing histogram */
+#define TRDP_HISTOGRAM_BUCKETS      20u
+
+/** Logarithmic histogram of PD timing samples in us.
+ *  Bucket 0 counts samples of 0us, bucket n samples from 2^(n-1) to 2^n - 1us,
+ *  the last bucket all samples from 2^(TRDP_HISTOGRAM_BUCKETS - 2)us (262ms) on. */
+typedef struct
+{
+    UINT32  count;                              /**< Number of samples */
+    UINT32  min;                                /**< Smallest sample in us */
+    UINT32  max;                                /**< Largest sample in us */
+    UINT32  p99;                                /**< 99th percentile in us (upper bound of its bucket, at most max) */
+    UINT32  bucket[TRDP_HISTOGRAM_BUCKETS];     /**< Number of samples per bucket */
+} GNU_PACKED TRDP_HISTOGRAM_T;
+
 /** Table containing particular PD subscription information. */
 typedef struct
 {
@@ -490,6 +537,7 @@ typedef struct
     UINT32                  toBehav; /**< Behavior at time-out. Set data to zero / keep last value */
     UINT32                  numRecv; /**< Number of packets received for this subscription */
     UINT32                  numMissed; /**< number of packets skipped for this subscription */
+    TRDP_HISTOGRAM_T        jitter; /**< Inter-arrival jitter: change of the time between two packets in us */
 } GNU_PACKED TRDP_SUBS_STATISTICS_T;
 
 /** Table containing particular PD publishing information. */
@@ -502,8 +550,46 @@ typedef struct
     UINT32          redState;   /**< Redundant state.Leader or Follower */
     UINT32          numPut;     /**< Number of packet updates */
     UINT32          numSend;    /**< Number of packets sent out */
+    TRDP_HISTOGRAM_T deviation; /**< Deviation of the send times from the ideal schedule in us */
 } GNU_PACKED TRDP_PUB_STATISTICS_T;
 
+/** Callback dispatch information of a PD subscription, see tlp_setCallbackDispatch() */
+typedef struct
+{
+    UINT32  queued;             /**< Number of callbacks currently waiting for a dispatch worker */
+    UINT32  maxQueued;          /**< Highest number of callbacks waiting at the same time */
+    UINT32  numCalls;           /**< Number of callbacks executed by the dispatch workers */
+    UINT32  numDropped;         /**< Number of callbacks dropped because the dispatch queue was full */
+    UINT32  lastDuration;       /**< Execution time of the last callback in us */
+    UINT32  maxDuration;        /**< Longest execution time of a callback in us */
+    UINT32  maxLatency;         /**< Longest time between reception and start of the callback in us */
+} TRDP_PD_DISPATCH_STATISTICS_T;
+
+/** Number of time slots reported per category of the indexed transmit tables (100ms in 250us slots) */
+#define TRDP_BURST_PROFILE_SLOTS    400u
+
+/** Load of the time slots of one category of the indexed transmit tables */
+typedef struct
+{
+    UINT32  slotCycle;                          /**< Time between two slots in us */
+    UINT32  noOfSlots;                          /**< Number of slots reported */
+    UINT32  peakBytes;                          /**< Highest number of bytes on the wire in one slot */
+    UINT32  peakPackets;                        /**< Highest number of packets in one slot */
+    UINT32  bytes[TRDP_BURST_PROFILE_SLOTS];    /**< Bytes on the wire per slot (including Ethernet, IP, UDP header) */
+    UINT32  packets[TRDP_BURST_PROFILE_SLOTS];  /**< Packets per slot */
+} TRDP_BURST_CATEGORY_T;
+
+/** Burst profile of the indexed transmit tables (TRDP_OPTION_INDEXED), see tlp_getBurstProfile() */
+typedef struct
+{
+    TRDP_BURST_CATEGORY_T   lowCat;             /**< Publishers with intervals <= 100ms */
+    TRDP_BURST_CATEGORY_T   midCat;             /**< Publishers with intervals <= 1000ms */
+    TRDP_BURST_CATEGORY_T   highCat;            /**< Publishers with intervals <= 10000ms */
+    UINT32                  peakCycleBytes;     /**< Highest number of bytes sent in one transmit cycle, all categories */
+    UINT32                  peakCyclePackets;   /**< Highest number of packets sent in one transmit cycle */
+    UINT32                  noOfExtPublishers;  /**< Publishers with intervals > 10000ms, sent outside the slots */
+} TRDP_BURST_PROFILE_T;
+
 
 /** Information about a particular MD listener */
 typedef struct
@@ -517,6 +603,17 @@ typedef struct
     UINT32          numRecv;    /**< Number of received packets  */
 } GNU_PACKED TRDP_LIST_STATISTICS_T;
 
+/** TCP MD connection pool information, see tlm_getTCPPoolStatistics() */
+typedef struct
+{
+    UINT32  numConnections;     /**< Number of currently open caller connections */
+    UINT32  numConnect;         /**< Number of connections opened for caller sessions */
+    UINT32  numReuse;           /**< Number of caller sessions which got an already open connection */
+    UINT32  numMultiplexed;     /**< Number of caller sessions sharing their connection with outstanding sessions */
+    UINT32  numIdleClose;       /**< Number of connections closed after the keep-alive time */
+    UINT32  numWarmUp;          /**< Number of connections opened in advance to configured peers */
+} TRDP_MD_TCP_POOL_STATISTICS_T;
+
 
 /** A table containing PD redundant group information */
 typedef struct
@@ -670,6 +767,13 @@ typedef void (*TRDP_MD_CALLBACK_T)(
     UINT8                   *pData,
     UINT32                  dataSize);
 
+/** Generator of MD session IDs  */
+typedef enum
+{
+    TRDP_MD_SESSION_ID_UUID = 0,    /**< vos_getUuid() for each session (default)                           */
+    TRDP_MD_SESSION_ID_FAST = 1     /**< random prefix drawn once per application session and a counter,
+                                         no system call per session                                         */
+} TRDP_MD_SESSION_ID_T;
 
 /**********************************************************************************************************************/
 /** Default MD configuration
@@ -687,8 +791,28 @@ typedef struct
     UINT16              udpPort;                /**< Port to be used for UDP MD communication (default: 17225)  */
     UINT16              tcpPort;                /**< Port to be used for TCP MD communication (default: 17225)  */
     UINT32              maxNumSessions;         /**< Maximal number of replier sessions         */
+    TRDP_MD_SESSION_ID_T sessionIdGen;          /**< Generator of session IDs                   */
 } TRDP_MD_CONFIG_T;
 
+#ifndef TRDP_MD_TCP_POOL_MAX_PEERS
+#define TRDP_MD_TCP_POOL_MAX_PEERS          8u      /**< Max. number of peers connected in advance              */
+#endif
+#ifndef TRDP_MD_TCP_MAX_SESSIONS_PER_CONN
+#define TRDP_MD_TCP_MAX_SESSIONS_PER_CONN   16u     /**< Default max. number of caller sessions per connection  */
+#endif
+
+/**********************************************************************************************************************/
+/** TCP MD connection pool configuration, see tlm_configTCPPool()
+ */
+typedef struct
+{
+    UINT32          maxSessionsPerConn;     /**< Max. outstanding caller sessions sharing a connection
+                                                 (0: TRDP_MD_TCP_MAX_SESSIONS_PER_CONN, 1: one session per connection) */
+    UINT32          keepAlive;              /**< Time in us an unused connection is kept open (0: connectTimeout) */
+    UINT32          noOfPeers;              /**< Number of entries in peers[]                                     */
+    TRDP_IP_ADDR_T  peers[TRDP_MD_TCP_POOL_MAX_PEERS]; /**< Peers to connect in advance, kept open while unused   */
+} TRDP_MD_TCP_POOL_CONFIG_T;
+
 
 
 /**********************************************************************************************************************/
@@ -725,8 +849,20 @@ typedef struct
 #define TRDP_OPTION_NO_PD_STATS         0x40u   /**< Suppress PD statistics \
                                                   Default: Don't suppress                                   */
 #define TRDP_OPTION_DEFAULT_CONFIG      0x80u   /**< no XML process config, defaults were used              */
+#define TRDP_OPTION_INDEXED             0x100u  /**< Send and receive PD by index tables (see tlc_presetIndexSession)
+                                                  Default: OFF, always ON in HIGH_PERF_INDEXED builds       */
+
+typedef UINT16 TRDP_OPTION_T;                   /**< 16 bit since 2.3, was UINT8 (layout of TRDP_PROCESS_CONFIG_T) */
 
-typedef UINT8 TRDP_OPTION_T;
+/**********************************************************************************************************************/
+/** Scheduling parameters of one of the threads started by tlc_startSessionThreads()
+ */
+typedef struct
+{
+    UINT8               policy;         /**< scheduling policy (VOS_THREAD_POLICY_T), 0 = system default     */
+    UINT8               priority;       /**< thread priority (1-255), 0 = use process priority               */
+    UINT32              cpuMask;        /**< CPU affinity (bit 0 = CPU 0), 0 = no restriction                */
+} TRDP_THREAD_CONFIG_T;
 
 /**********************************************************************************************************************/
 /** Various flags/general TRDP options for library initialization
@@ -739,8 +875,12 @@ typedef struct
     UINT32              cycleTime;      /**< TRDP main process cycle time in us  */
     UINT32              priority;       /**< TRDP main process priority (0-255, 0=default, 255=highest)   */
     TRDP_OPTION_T       options;        /**< TRDP options */
+    TRDP_THREAD_CONFIG_T txThread;      /**< cyclic PD transmit thread (tlc_startSessionThreads)   */
+    TRDP_THREAD_CONFIG_T rxThread;      /**< PD receive thread (tlc_startSessionThreads)           */
+    TRDP_THREAD_CONFIG_T mdThread;      /**< MD thread (tlc_startSessionThreads)                   */
 } TRDP_PROCESS_CONFIG_T;
 
+
 /**********************************************************************************************************************/
 /** Settings for pre-allocation of index tables for application session initialization
  */
@@ -756,8 +896,61 @@ typedef struct
     UINT32  maxNoOfHighCatPublishers;           /**< Max. number of expected publishers with intervals <= 10000ms   */
     UINT32  maxDepthOfHighCatPublishers;        /**< depth / overlapped publishers with intervals <= 10000ms        */
     UINT32  maxNoOfExtPublishers;               /**< Max. number of expected publishers with intervals > 10000ms    */
+    UINT32  baseCycle;                          /**< Base transmit cycle in us: 250, 500 or 1000 (default, if 0)    */
 } TRDP_IDX_TABLE_T;
 
+/**********************************************************************************************************************/
+/** Events of the trace ring (stack built with TRDP_TRACE, see tlc_traceDump())
+ */
+typedef enum
+{
+    TRDP_TRACE_PD_RECEIVE   = 1,    /**< PD packet received, info: result of the packet check               */
+    TRDP_TRACE_PD_SEND      = 2,    /**< PD packet sent                                                     */
+    TRDP_TRACE_PD_TIMEOUT   = 3,    /**< PD subscription timed out                                          */
+    TRDP_TRACE_PD_CB_ENTRY  = 4,    /**< PD callback called, info: result code passed                       */
+    TRDP_TRACE_PD_CB_EXIT   = 5,    /**< PD callback returned                                               */
+    TRDP_TRACE_MD_RECEIVE   = 6,    /**< MD packet received, info: message type                             */
+    TRDP_TRACE_MD_SEND      = 7,    /**< MD packet sent, info: message type                                 */
+    TRDP_TRACE_MD_STATE     = 8,    /**< MD session changed its state, info: new state                      */
+    TRDP_TRACE_MD_TIMEOUT   = 9,    /**< MD session timed out, info: result code                            */
+    TRDP_TRACE_MD_CB_ENTRY  = 10,   /**< MD callback called, info: result code passed                       */
+    TRDP_TRACE_MD_CB_EXIT   = 11    /**< MD callback returned                                               */
+} TRDP_TRACE_EVENT_T;
+
+/** Binary trace record (32 bytes) */
+typedef struct
+{
+    UINT64  timeStamp;              /**< real time in ns (vos_getNanoTime)                                  */
+    UINT16  event;                  /**< TRDP_TRACE_EVENT_T                                                 */
+    INT16   info;                   /**< event specific, see TRDP_TRACE_EVENT_T                             */
+    UINT32  comId;                  /**< comId                                                              */
+    UINT32  seqCnt;                 /**< sequence counter                                                   */
+    UINT32  srcIpAddr;              /**< source IP address                                                  */
+    UINT32  size;                   /**< dataset size                                                       */
+    UINT32  reserved;               /**< zero                                                               */
+} TRDP_TRACE_REC_T;
+
+#define TRDP_TRACE_MAGIC    0x54524352u     /**< 'TRCR', first word of a trace dump in the byte order of the writer */
+#define TRDP_TRACE_VERSION  1u              /**< version of the trace dump format                               */
+
+/** Header of a trace dump, followed by noOfRings rings: TRDP_TRACE_RING_HEAD_T and its records, oldest first */
+typedef struct
+{
+    UINT32  magic;                  /**< TRDP_TRACE_MAGIC                                                   */
+    UINT16  version;                /**< TRDP_TRACE_VERSION                                                 */
+    UINT16  recSize;                /**< size of a record                                                   */
+    UINT32  noOfRings;              /**< number of rings (tracing threads)                                  */
+    UINT32  noOfLost;               /**< events of threads which did not get a ring                         */
+} TRDP_TRACE_FILE_HEAD_T;
+
+/** Header of a ring in a trace dump */
+typedef struct
+{
+    UINT32  ringId;                 /**< number of the ring, i.e. of the tracing thread                     */
+    UINT32  noOfRecs;               /**< number of records following                                        */
+    UINT32  noOfOverwritten;        /**< older records overwritten by the ring                              */
+} TRDP_TRACE_RING_HEAD_T;
+
 
 #ifdef __cplusplus
 }
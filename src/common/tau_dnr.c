@@ -41,6 +41,8 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_TAU
+
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
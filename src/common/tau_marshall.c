@@ -42,6 +42,8 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_TAU
+
 #include <string.h>
 
 #include "trdp_types.h"
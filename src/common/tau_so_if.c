@@ -20,6 +20,7 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: tau_getServicesList() waits once for the reply instead of polling in 100ms steps
 *      SB 2019-10-15: Added option for filtering requested services.
 *      SB 2019-10-02: Fixed bug with reply callback triggered after timeout with now invalid context.
 *      SB 2019-09-17: Fixed bug, with semaphores not valid during callback (including MR retries triggering cb).
@@ -33,6 +34,8 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_TAU
+
 #include <string.h>
 #include <stdio.h>
 
@@ -494,22 +497,8 @@ EXT_DECL TRDP_ERR_T tau_getServicesList (
 
     if (err == TRDP_NO_ERR)
     {
-        const UINT32    cWaitChunk  = 100000u;  /* 100ms steps */
-        UINT32          count       = SRM_SERVICE_READ_REQ_TO / cWaitChunk;
-        do
-        {
-            /* Make sure the request is sent now and the reply can be received : */
-            /* (void) tlm_process(appHandle, NULL, NULL); */
-
-            /* wait on semaphore or timeout */
-            vos_err = vos_semaTake(context.waitForResponse, cWaitChunk);
-            if (vos_err == VOS_NO_ERR)
-            {
-                /* We got access fast, leave the loop. */
-                break;
-            }
-        }
-        while (count-- || (vos_err != VOS_NO_ERR));
+        /* wait on semaphore or timeout, the callback gives it on reply or timeout of the session */
+        vos_err = vos_semaTake(context.waitForResponse, SRM_SERVICE_READ_REQ_TO);
 
         if (vos_err == VOS_SEMA_ERR)
         {
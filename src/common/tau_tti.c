@@ -76,6 +76,8 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_TAU
+
 #include <string.h>
 #include <stdio.h>
 
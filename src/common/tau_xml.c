@@ -17,6 +17,9 @@
  /*
  * $Id$
  *
+ *      BL 2026-10-18: trdp-process attribute indexed ("yes" selects the indexed PD scheduler)
+ *      BL 2026-10-18: md-com-parameter attribute session-id ("uuid" / "fast")
+ *      BL 2026-10-18: Thread layout attributes of trdp-process (tx/rx/md-policy, -priority, -cpu-mask)
  *     AHW 2021-04-30: Ticket #349 support for parsing "dataset name" and "device type"
  *      SB 2021-02-04: Ticket #359: fixed parsing of 'service-device' elements
  *      SB 2020-06-29: Ticket #338: Attribute Callback always does not work
@@ -56,6 +59,9 @@
 /*******************************************************************************
  * INCLUDES
  */
+
+#define VOS_LOG_CAT     VOS_LOG_CAT_TAU
+
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -185,6 +191,9 @@ static void setDefaultInterfaceValues (
         pProcessConfig->cycleTime   = TRDP_PROCESS_DEFAULT_CYCLE_TIME;
         pProcessConfig->options     = TRDP_PROCESS_DEFAULT_OPTIONS | TRDP_OPTION_DEFAULT_CONFIG;
         pProcessConfig->priority    = TRDP_PROCESS_DEFAULT_PRIORITY;
+        memset(&pProcessConfig->txThread, 0, sizeof(TRDP_THREAD_CONFIG_T));
+        memset(&pProcessConfig->rxThread, 0, sizeof(TRDP_THREAD_CONFIG_T));
+        memset(&pProcessConfig->mdThread, 0, sizeof(TRDP_THREAD_CONFIG_T));
     }
 
     /*  Default Pd configuration    */
@@ -220,7 +229,68 @@ static void setDefaultInterfaceValues (
         pMdConfig->tcpPort              = TRDP_MD_TCP_PORT;
         pMdConfig->udpPort              = TRDP_MD_UDP_PORT;
         pMdConfig->maxNumSessions       = TRDP_MD_MAX_NUM_SESSIONS;
+        pMdConfig->sessionIdGen         = TRDP_MD_SESSION_ID_UUID;
+
+    }
+}
+
+/*
+ * Evaluate a thread layout attribute of the trdp-process element ("tx-", "rx-" or "md-" followed by
+ * "policy", "priority" or "cpu-mask"). Returns TRUE if the attribute was consumed.
+ */
+static BOOL8 readThreadAttribute (
+    const CHAR8             *pAttribute,
+    const CHAR8             *pValue,
+    UINT32                  valueInt,
+    TRDP_PROCESS_CONFIG_T   *pProcessConfig)
+{
+    TRDP_THREAD_CONFIG_T *pThreadConfig;
+
+    if (vos_strnicmp(pAttribute, "tx-", 3u) == 0)
+    {
+        pThreadConfig = &pProcessConfig->txThread;
+    }
+    else if (vos_strnicmp(pAttribute, "rx-", 3u) == 0)
+    {
+        pThreadConfig = &pProcessConfig->rxThread;
+    }
+    else if (vos_strnicmp(pAttribute, "md-", 3u) == 0)
+    {
+        pThreadConfig = &pProcessConfig->mdThread;
+    }
+    else
+    {
+        return FALSE;
+    }
+
+    if (vos_strnicmp(&pAttribute[3], "policy", MAX_TOK_LEN) == 0)
+    {
+        if (vos_strnicmp(pValue, "fifo", TRDP_MAX_LABEL_LEN) == 0)
+        {
+            pThreadConfig->policy = (UINT8) VOS_THREAD_POLICY_FIFO;
+        }
+        else if (vos_strnicmp(pValue, "rr", TRDP_MAX_LABEL_LEN) == 0)
+        {
+            pThreadConfig->policy = (UINT8) VOS_THREAD_POLICY_RR;
+        }
+        else
+        {
+            pThreadConfig->policy = (UINT8) VOS_THREAD_POLICY_OTHER;
+        }
+    }
+    else if (vos_strnicmp(&pAttribute[3], "priority", MAX_TOK_LEN) == 0)
+    {
+        pThreadConfig->priority = (UINT8) valueInt;
     }
+    else if (vos_strnicmp(&pAttribute[3], "cpu-mask", MAX_TOK_LEN) == 0)
+    {
+        pThreadConfig->cpuMask = valueInt;
+    }
+    else
+    {
+        return FALSE;
+    }
+    return TRUE;
 }
 
 #ifdef LIST_EXCH_PARAMS
@@ -1569,6 +1639,13 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                                 {
                                     pMdConfig->replyTimeout = valueInt;
                                 }
+                                else if (vos_strnicmp(attribute, "session-id", MAX_TOK_LEN) == 0)
+                                {
+                                    if (vos_strnicmp("fast", value, TRDP_MAX_LABEL_LEN) == 0)
+                                    {
+                                        pMdConfig->sessionIdGen = TRDP_MD_SESSION_ID_FAST;
+                                    }
+                                }
                             }
                         }
 
@@ -1591,6 +1668,13 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                                         pProcessConfig->options &= (TRDP_OPTION_T) ~TRDP_OPTION_TRAFFIC_SHAPING;
                                     }
                                 }
+                                else if (vos_strnicmp(attribute, "indexed", MAX_TOK_LEN) == 0)
+                                {
+                                    if (vos_strnicmp("yes", value, TRDP_MAX_LABEL_LEN) == 0)
+                                    {
+                                        pProcessConfig->options |= TRDP_OPTION_INDEXED;
+                                    }
+                                }
                                 else if (vos_strnicmp(attribute, "priority", MAX_TOK_LEN) == 0)
                                 {
                                     pProcessConfig->priority = valueInt;
@@ -1600,6 +1684,11 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                                     pProcessConfig->cycleTime = valueInt;
                                     pProcessConfig->options &= ~TRDP_OPTION_DEFAULT_CONFIG;
                                 }
+                                else
+                                {
+                                    (void) readThreadAttribute(attribute, value, valueInt, pProcessConfig);
+                                }
+
                             }
                         }
                         /* read the n-th telegram / exchange parameters */
@@ -17,6 +17,21 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: Session threads signal a semaphore when they stop, trdp_stopSessionThreads() waits on it
+*      BL 2026-10-18: Session threads release their trace ring when they stop
+*      BL 2026-10-18: tlc_closeSession() releases MD packet buffers still lent to the application
+*      BL 2026-10-18: tlc_openSession() sets the default MD sending timeout, it was left 0
+*      BL 2026-10-18: Indexed scheduler selectable per session (TRDP_OPTION_INDEXED), tlc_process() dispatches
+*      BL 2026-10-18: tlc_presetIndexSession() takes the base transmit cycle, session transmit thread follows it
+*      BL 2026-10-18: tlc_configSession() takes the generator of MD session IDs
+*      BL 2026-10-18: tlc_closeSession() frees the arena of batched notifications
+*      BL 2026-10-18: tlc_closeSession() deletes the MD completion queue
+*      BL 2026-10-18: tlc_closeSession() frees the MD receive buffer pool
+*      BL 2026-10-18: tlc_closeSession() frees the TCP receive buffers
+*      BL 2026-10-18: tlc_closeSession() frees the MD timer heap
+*      BL 2026-10-18: tlc_closeSession() stops the PD callback dispatch workers
+*      BL 2026-10-18: tlc_startSessionThreads(): managed PD transmit, PD receive and MD threads per session
+*      BL 2026-10-18: Lock-free session handle validation by generation-tagged handle table
 *      SB 2021-08-09: Lint warnings
 *      BL 2020-07-29: tlc_init() marks version info with 'trunk' (if vers.evo != 0)
 *      BL 2020-01-10: Undoing svn revision output, would reflect file revision, only.
@@ -95,32 +110,67 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_PD
+
 #include <string.h>
 
 #include "trdp_if_light.h"
 #include "trdp_utils.h"
 #include "trdp_pdcom.h"
 #include "trdp_stats.h"
+#include "trdp_pddispatch.h"
+#include "trdp_trace.h"
 #include "vos_sock.h"
+
 #include "vos_mem.h"
 #include "vos_utils.h"
 
 #if MD_SUPPORT
 #include "trdp_mdcom.h"
+#include "trdp_mdcompletion.h"
 #endif
 
-#ifdef HIGH_PERF_INDEXED
 #include "trdp_pdindex.h"
-#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TRDP_THREAD_MAX_WAIT    100000u     /**< max. select() time of receive threads, bounds the shutdown time [us] */
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
+/** Threads started by tlc_startSessionThreads().
+ *  Termination is cooperative: tlc_closeSession() sets 'stop' and takes 'left' once per started thread before the
+ *  session is torn down, no thread is cancelled while it holds a session mutex.
+ */
+typedef struct TRDP_SESSION_THREADS
+{
+    TRDP_APP_SESSION_T  appHandle;          /**< session served by the threads                      */
+    VOS_THREAD_T        txThread;           /**< cyclic PD transmit thread                          */
+    VOS_THREAD_T        rxThread;           /**< PD receive thread                                  */
+    VOS_THREAD_T        mdThread;           /**< MD thread                                          */
+    UINT32              stop;               /**< != 0: threads shall terminate                      */
+    VOS_SEMA_T          left;               /**< given by each thread when it left the session      */
+    UINT32              cycleTime;          /**< cycle time of the transmit thread [us]             */
+} TRDP_SESSION_THREADS_T;
+
+/** Entry of the session handle table.
+ *  Entries are written under sSessionMutex only. The generation is odd while an entry is being changed, readers
+ *  accept a match only if the generation was even and unchanged before and after reading the session pointer.
+ */
+typedef struct
+{
+    TRDP_SESSION_PT pSession;               /**< registered session or NULL                 */
+    UINT32          generation;             /**< incremented on every change of the entry   */
+} TRDP_SESSION_SLOT_T;
+
 /***********************************************************************************************************************
  * LOCALS
  */
@@ -129,6 +179,8 @@ const TRDP_VERSION_T        trdpVersion = {TRDP_VERSION, TRDP_RELEASE, TRDP_UPDA
 static TRDP_APP_SESSION_T   sSession        = NULL;
 static VOS_MUTEX_T          sSessionMutex   = NULL;
 static BOOL8 sInited = FALSE;
+static TRDP_SESSION_SLOT_T  sSessionTable[TRDP_MAX_SESSIONS];
+static UINT32 sSessionMaxProbe = 0u;        /**< longest probe sequence ever used for an entry   */
 
 /******************************************************************************
  * LOCAL FUNCTIONS
@@ -139,6 +191,283 @@ TRDP_APP_SESSION_T  *trdp_sessionQueue (void);
 TRDP_ERR_T          trdp_getAccess (TRDP_APP_SESSION_T  pSessionHandle, int force);
 void                trdp_releaseAccess (TRDP_APP_SESSION_T pSessionHandle);
 
+/**********************************************************************************************************************/
+/** Compute the home slot of a session handle in the session table
+ *
+ *  @param[in]    pSessionHandle        session handle
+ *
+ *  @retval       index into sSessionTable
+ */
+static UINT32 trdp_sessionSlot (
+    const void *pSessionHandle)
+{
+    /* Fibonacci hashing of the pointer value, the lower bits are zero due to alignment */
+    UINT32 hash = (UINT32) (((uintptr_t) pSessionHandle) >> 4u) * 2654435761u;
+    return (hash >> 16u) & (TRDP_MAX_SESSIONS - 1u);
+}
+
+/**********************************************************************************************************************/
+/** Enter a session into the session table
+ *  Must be called with sSessionMutex held.
+ *
+ *  @param[in]    pSession              session to register
+ *
+ *  @retval       TRDP_NO_ERR           no error
+ *  @retval       TRDP_MEM_ERR          session table full
+ */
+static TRDP_ERR_T trdp_sessionTableAdd (
+    TRDP_SESSION_PT pSession)
+{
+    UINT32 probe;
+    UINT32 idx = trdp_sessionSlot(pSession);
+
+    for (probe = 0u; probe < TRDP_MAX_SESSIONS; probe++)
+    {
+        TRDP_SESSION_SLOT_T *pSlot = &sSessionTable[(idx + probe) & (TRDP_MAX_SESSIONS - 1u)];
+
+        if (pSlot->pSession == NULL)
+        {
+            (void) VOS_ATOMIC_ADD(&pSlot->generation, 1u);         /* odd: entry is changing   */
+            VOS_ATOMIC_STORE_PTR(&pSlot->pSession, pSession);
+            (void) VOS_ATOMIC_ADD(&pSlot->generation, 1u);         /* even: entry is stable    */
+            if (probe >= sSessionMaxProbe)
+            {
+                VOS_ATOMIC_STORE(&sSessionMaxProbe, probe + 1u);
+            }
+            return TRDP_NO_ERR;
+        }
+    }
+    return TRDP_MEM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Remove a session from the session table
+ *  Must be called with sSessionMutex held. After return, trdp_isValidSession() will not accept the handle anymore.
+ *
+ *  @param[in]    pSession              session to remove
+ */
+static void trdp_sessionTableRemove (
+    TRDP_SESSION_PT pSession)
+{
+    UINT32 probe;
+    UINT32 idx = trdp_sessionSlot(pSession);
+
+    for (probe = 0u; probe < sSessionMaxProbe; probe++)
+    {
+        TRDP_SESSION_SLOT_T *pSlot = &sSessionTable[(idx + probe) & (TRDP_MAX_SESSIONS - 1u)];
+
+        if (pSlot->pSession == pSession)
+        {
+            (void) VOS_ATOMIC_ADD(&pSlot->generation, 1u);
+            VOS_ATOMIC_STORE_PTR(&pSlot->pSession, (TRDP_SESSION_PT) NULL);
+            (void) VOS_ATOMIC_ADD(&pSlot->generation, 1u);
+            return;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Cyclic PD transmit thread function
+ *
+ *  @param[in]    pArg                  pointer to the session's thread control block
+ */
+static void trdp_txThread (
+    void *pArg)
+{
+    TRDP_SESSION_THREADS_T *pThreads = (TRDP_SESSION_THREADS_T *) pArg;
+
+    if (VOS_ATOMIC_LOAD(&pThreads->stop) == 0u)
+    {
+        TRDP_ERR_T err = tlp_processSend(pThreads->appHandle);
+
+        if ((err != TRDP_NO_ERR) && (err != TRDP_BLOCK_ERR))
+        {
+            vos_printLog(VOS_LOG_WARNING, "tlp_processSend() failed (Err: %d)\n", err);
+        }
+    }
+    else
+    {
+        /* The cyclic thread has no loop to leave: it cancels itself, which takes effect when this call returns
+           and before it could run again. No session mutex is held here. */
+        VOS_THREAD_T self = NULL;
+
+        (void) vos_threadSelf(&self);
+        TRDP_TRACE_RELEASE();
+        vos_semaGive(pThreads->left);       /* pThreads may be freed from now on */
+        (void) vos_threadTerminate(self);
+    }
+}
+
+/**********************************************************************************************************************/
+/** PD receive thread function
+ *  Waits for PD sockets becoming readable or the next receive time-out, whatever comes first.
+ *
+ *  @param[in]    pArg                  pointer to the session's thread control block
+ */
+static void trdp_rxThread (
+    void *pArg)
+{
+    TRDP_SESSION_THREADS_T *pThreads = (TRDP_SESSION_THREADS_T *) pArg;
+
+    while (VOS_ATOMIC_LOAD(&pThreads->stop) == 0u)
+    {
+        TRDP_FDS_T  fileDesc;
+        TRDP_TIME_T interval    = {0, 0};
+        INT32       noDesc      = 0;
+        TRDP_ERR_T  err;
+
+        FD_ZERO(&fileDesc);
+        (void) tlp_getInterval(pThreads->appHandle, &interval, &fileDesc, &noDesc);
+        if ((interval.tv_sec > 0) || (interval.tv_usec > (INT32) TRDP_THREAD_MAX_WAIT))
+        {
+            interval.tv_sec     = 0;
+            interval.tv_usec    = TRDP_THREAD_MAX_WAIT;
+        }
+        noDesc  = vos_select(noDesc + 1, &fileDesc, NULL, NULL, &interval);
+        err     = tlp_processReceive(pThreads->appHandle, &fileDesc, &noDesc);
+        if ((err != TRDP_NO_ERR) && (err != TRDP_BLOCK_ERR))
+        {
+            vos_printLog(VOS_LOG_INFO, "tlp_processReceive() failed (Err: %d)\n", err);
+        }
+    }
+    TRDP_TRACE_RELEASE();
+    vos_semaGive(pThreads->left);           /* pThreads may be freed from now on */
+}
+
+#if MD_SUPPORT
+/**********************************************************************************************************************/
+/** MD thread function
+ *
+ *  @param[in]    pArg                  pointer to the session's thread control block
+ */
+static void trdp_mdThread (
+    void *pArg)
+{
+    TRDP_SESSION_THREADS_T *pThreads = (TRDP_SESSION_THREADS_T *) pArg;
+
+    while (VOS_ATOMIC_LOAD(&pThreads->stop) == 0u)
+    {
+        TRDP_FDS_T  fileDesc;
+        TRDP_TIME_T interval    = {0, 0};
+        INT32       noDesc      = 0;
+        TRDP_ERR_T  err;
+
+        FD_ZERO(&fileDesc);
+        (void) tlm_getInterval(pThreads->appHandle, &interval, &fileDesc, &noDesc);
+        if ((interval.tv_sec > 0) || (interval.tv_usec > (INT32) TRDP_THREAD_MAX_WAIT))
+        {
+            interval.tv_sec     = 0;
+            interval.tv_usec    = TRDP_THREAD_MAX_WAIT;
+        }
+        noDesc  = vos_select(noDesc + 1, &fileDesc, NULL, NULL, &interval);
+        err     = tlm_process(pThreads->appHandle, &fileDesc, &noDesc);
+        if ((err != TRDP_NO_ERR) && (err != TRDP_BLOCK_ERR))
+        {
+            vos_printLog(VOS_LOG_INFO, "tlm_process() failed (Err: %d)\n", err);
+        }
+    }
+    TRDP_TRACE_RELEASE();
+    vos_semaGive(pThreads->left);           /* pThreads may be freed from now on */
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Create one of the session threads and apply its CPU affinity
+ *
+ *  @param[out]   pThread               returned thread handle
+ *  @param[in]    pName                 thread name
+ *  @param[in]    pConfig               thread layout
+ *  @param[in]    defaultPriority       priority to use if none is configured
+ *  @param[in]    interval              cycle time for cyclic threads [us], 0 otherwise
+ *  @param[in]    pFunction             thread function
+ *  @param[in]    pThreads              thread control block
+ *
+ *  @retval       TRDP_NO_ERR           no error
+ *  @retval       TRDP_THREAD_ERR       thread could not be created
+ */
+static TRDP_ERR_T trdp_createSessionThread (
+    VOS_THREAD_T                *pThread,
+    const CHAR8                 *pName,
+    const TRDP_THREAD_CONFIG_T  *pConfig,
+    UINT32                      defaultPriority,
+    UINT32                      interval,
+    VOS_THREAD_FUNC_T           pFunction,
+    TRDP_SESSION_THREADS_T      *pThreads)
+{
+    VOS_THREAD_PRIORITY_T   priority = (VOS_THREAD_PRIORITY_T) defaultPriority;
+    VOS_ERR_T               err;
+
+    if (pConfig->priority != 0u)
+    {
+        priority = (VOS_THREAD_PRIORITY_T) pConfig->priority;
+    }
+
+    err = vos_threadCreateSync(pThread, pName, (VOS_THREAD_POLICY_T) pConfig->policy, priority, interval,
+                               NULL, 0u, pFunction, pThreads);
+    if (err != VOS_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Creating thread %s failed (Err: %d)\n", pName, err);
+        return TRDP_THREAD_ERR;
+    }
+
+    if ((pConfig->cpuMask != 0u) &&
+        (vos_threadSetAffinity(*pThread, pConfig->cpuMask) != VOS_NO_ERR))
+    {
+        /* Not fatal, the thread just runs on any CPU */
+        vos_printLog(VOS_LOG_WARNING, "CPU affinity 0x%x of thread %s not set\n",
+                     (unsigned int) pConfig->cpuMask, pName);
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Stop the threads started by tlc_startSessionThreads() and release their control block.
+ *  The threads are detached and cannot be joined. They are asked to stop, each of them gives the 'left' semaphore
+ *  when it will not touch the session anymore; the function returns after it was taken once per started thread.
+ *  None of them is cancelled while it may hold a session mutex. A thread blocked in an application callback
+ *  delays the return, a warning is logged every second while waiting for it.
+ *  Must not be called from within one of these threads (e.g. from a callback).
+ *
+ *  @param[in]    appHandle             session
+ */
+static void trdp_stopSessionThreads (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_SESSION_THREADS_T  *pThreads   = appHandle->pThreads;
+    UINT32                  running     = 0u;
+    UINT32                  waited      = 0u;
+
+    if (pThreads == NULL)
+    {
+        return;
+    }
+
+    running += (pThreads->txThread != NULL) ? 1u : 0u;
+    running += (pThreads->rxThread != NULL) ? 1u : 0u;
+    running += (pThreads->mdThread != NULL) ? 1u : 0u;
+
+    VOS_ATOMIC_STORE(&pThreads->stop, 1u);
+    VOS_ATOMIC_FENCE();
+
+    /* The threads notice 'stop' within one transmit cycle or one select() time-out */
+    while (running > 0u)
+    {
+        if (vos_semaTake(pThreads->left, 1000000u) == VOS_NO_ERR)
+        {
+            running--;
+        }
+        else
+        {
+            vos_printLog(VOS_LOG_WARNING, "Still waiting for %u session thread(s) to terminate (%u s)\n",
+                         (unsigned int) running, (unsigned int) ++waited);
+        }
+    }
+
+    appHandle->pThreads = NULL;
+    vos_semaDelete(pThreads->left);
+    vos_memFree(pThreads);
+}
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -146,6 +475,8 @@ void                trdp_releaseAccess (TRDP_APP_SESSION_T pSessionHandle);
 /**********************************************************************************************************************/
 /** Check if the session handle is valid
  *
+ *  The check does not take the global session mutex: The handle is looked up in the session table, starting at
+ *  its home slot. An entry matches only if its generation is stable (even and unchanged) while reading it.
  *
  *  @param[in]    pSessionHandle        pointer to packet data (dataset)
  *
@@ -155,37 +486,31 @@ void                trdp_releaseAccess (TRDP_APP_SESSION_T pSessionHandle);
 BOOL8    trdp_isValidSession (
     TRDP_APP_SESSION_T pSessionHandle)
 {
-    TRDP_SESSION_PT pSession = NULL;
-    BOOL8 found = FALSE;
+    UINT32  probe;
+    UINT32  idx;
+    UINT32  maxProbe;
 
     if (pSessionHandle == NULL)
     {
         return FALSE;
     }
 
-    if (vos_mutexLock(sSessionMutex) != VOS_NO_ERR)
-    {
-        return FALSE;
-    }
+    idx         = trdp_sessionSlot(pSessionHandle);
+    maxProbe    = VOS_ATOMIC_LOAD(&sSessionMaxProbe);
 
-    pSession = sSession;
-
-    while (pSession)
+    for (probe = 0u; probe < maxProbe; probe++)
     {
-        if (pSession == (TRDP_SESSION_PT) pSessionHandle)
+        const TRDP_SESSION_SLOT_T *pSlot = &sSessionTable[(idx + probe) & (TRDP_MAX_SESSIONS - 1u)];
+        UINT32 generation = VOS_ATOMIC_LOAD(&pSlot->generation);
+
+        if (((generation & 1u) == 0u) &&
+            (VOS_ATOMIC_LOAD_PTR(&pSlot->pSession) == (TRDP_SESSION_PT) pSessionHandle) &&
+            (VOS_ATOMIC_LOAD(&pSlot->generation) == generation))
         {
-            found = TRUE;
-            break;
+            return TRUE;
         }
-        pSession = pSession->pNext;
     }
-
-    if (vos_mutexUnlock(sSessionMutex) != VOS_NO_ERR)
-    {
-        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
-    }
-
-    return found;
+    return FALSE;
 }
 
 /**********************************************************************************************************************/
@@ -368,6 +693,10 @@ EXT_DECL TRDP_ERR_T tlc_init (
 /** Open a session with the TRDP stack.
  *
  *  tlc_openSession returns in pAppHandle a unique handle to be used in further calls to the stack.
+ *  With TRDP_OPTION_INDEXED set in the process options (default in HIGH_PERF_INDEXED builds) PD of the session is
+ *  scheduled by index tables (see tlc_presetIndexSession()), otherwise by the send queue.
+ *  A process can open up to TRDP_MAX_SESSIONS (32, a power of 2 which can be changed at compile time) sessions at
+ *  the same time.
  *
  *  @param[out]     pAppHandle          A handle for further calls to the trdp stack
  *  @param[in]      ownIpAddr           Own IP address, can be different for each process in multihoming systems,
@@ -384,6 +713,7 @@ EXT_DECL TRDP_ERR_T tlc_init (
  *  @retval         TRDP_INIT_ERR       not yet inited
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_SOCK_ERR       socket error
+ *  @retval         TRDP_MEM_ERR        out of memory or TRDP_MAX_SESSIONS sessions already open
  */
 EXT_DECL TRDP_ERR_T tlc_openSession (
     TRDP_APP_SESSION_T              *pAppHandle,
@@ -421,15 +751,6 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
 
     /* memset(pSession, 0, sizeof(TRDP_SESSION_T)); not necessary, vos_memAlloc always returns cleared block! */
 
-#ifdef HIGH_PERF_INDEXED
-    ret = trdp_indexInit(pSession);
-    if (ret != TRDP_NO_ERR)
-    {
-        vos_printLogStr(VOS_LOG_ERROR, "trdp_indexInit() failed\n");
-        return ret;
-    }
-#endif
-
     pSession->realIP    = ownIpAddr;
     pSession->virtualIP = leaderIpAddr;
 
@@ -447,6 +768,7 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
     pSession->mdDefault.pRefCon         = NULL;
     pSession->mdDefault.confirmTimeout  = TRDP_MD_DEFAULT_CONFIRM_TIMEOUT;
     pSession->mdDefault.connectTimeout  = TRDP_MD_DEFAULT_CONNECTION_TIMEOUT;
+    pSession->mdDefault.sendingTimeout  = TRDP_MD_DEFAULT_SENDING_TIMEOUT;
     pSession->mdDefault.replyTimeout    = TRDP_MD_DEFAULT_REPLY_TIMEOUT;
     pSession->mdDefault.flags               = TRDP_FLAGS_NONE;
     pSession->mdDefault.udpPort             = TRDP_MD_UDP_PORT;
@@ -466,6 +788,25 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
         return ret;
     }
 
+    /*  Choose the PD scheduler: indexed tables or the send queue (see tlc_presetIndexSession)  */
+#ifdef HIGH_PERF_INDEXED
+    pSession->option |= TRDP_OPTION_INDEXED;
+#endif
+    if ((pProcessConfig != NULL) && ((pProcessConfig->options & TRDP_OPTION_INDEXED) != 0u))
+    {
+        pSession->option |= TRDP_OPTION_INDEXED;
+    }
+    if ((pSession->option & TRDP_OPTION_INDEXED) != 0u)
+    {
+        ret = trdp_indexInit(pSession);
+        if (ret != TRDP_NO_ERR)
+        {
+            vos_memFree(pSession);
+            vos_printLogStr(VOS_LOG_ERROR, "trdp_indexInit() failed\n");
+            return ret;
+        }
+    }
+
     ret = (TRDP_ERR_T) vos_mutexCreate(&pSession->mutex);
     ret += (TRDP_ERR_T) vos_mutexCreate(&pSession->mutexTxPD); /*lint !e656 Only checking for error code TRDP_NO_ERR, which is 0 */
     ret += (TRDP_ERR_T) vos_mutexCreate(&pSession->mutexRxPD); /*lint !e656 Only checking for error code TRDP_NO_ERR, which is 0 */
@@ -488,8 +829,6 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
 
 #if MD_SUPPORT
     trdp_initSockets(pSession->ifaceMD, TRDP_MAX_MD_SOCKET_CNT);
-    /* Initialize pointers to Null in the incomplete message structure */
-    trdp_initUncompletedTCP(pSession);
 #endif
 
     /*    Clear the statistics for this session */
@@ -516,6 +855,21 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
         vos_memFree(pSession);
         vos_printLog(VOS_LOG_ERROR, "vos_mutexLock() failed (Err: %d)\n", ret);
     }
+    else if (trdp_sessionTableAdd(pSession) != TRDP_NO_ERR)
+    {
+        (void) vos_mutexUnlock(sSessionMutex);
+        vos_mutexDelete(pSession->mutex);
+        vos_mutexDelete(pSession->mutexTxPD);
+        vos_mutexDelete(pSession->mutexRxPD);
+#if MD_SUPPORT
+        vos_mutexDelete(pSession->mutexMD);
+#endif
+        trdp_indexDeInit(pSession);
+        vos_memFree(pSession->pNewFrame);
+        vos_memFree(pSession);
+        vos_printLog(VOS_LOG_ERROR, "Too many sessions (max. %u)\n", TRDP_MAX_SESSIONS);
+        ret = TRDP_MEM_ERR;
+    }
     else
     {
         unsigned int        retries;
@@ -627,7 +981,9 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
 
     if (pProcessConfig != NULL)
     {
-        pSession->option = pProcessConfig->options;
+        /* The scheduler is chosen by tlc_openSession() or tlc_presetIndexSession() and kept */
+        pSession->option = (TRDP_OPTION_T) ((pProcessConfig->options & (TRDP_OPTION_T) ~TRDP_OPTION_INDEXED) |
+                                            (pSession->option & TRDP_OPTION_INDEXED));
         pSession->stats.processCycle    = pProcessConfig->cycleTime;
         pSession->stats.processPrio     = pProcessConfig->priority;
         vos_strncpy(pSession->stats.hostName, pProcessConfig->hostName, TRDP_MAX_LABEL_LEN - 1);
@@ -792,6 +1148,12 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
             pSession->mdDefault.maxNumSessions = pMdDefault->maxNumSessions;
         }
 
+        if ((pSession->mdDefault.sessionIdGen == TRDP_MD_SESSION_ID_UUID) &&
+            (pMdDefault->sessionIdGen != TRDP_MD_SESSION_ID_UUID))
+        {
+            pSession->mdDefault.sessionIdGen = pMdDefault->sessionIdGen;
+        }
+
     }
 
     /* Set some statistic defaults here */
@@ -815,8 +1177,8 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
 /** Update a session.
  *
  *  tlc_updateSession signals the end of the set-up phase to the stack. It shall be called after the last publisher
- *  and subscriber was added and will create and compute the index tables to be used by the high-performance targets.
- *  This function is currently a no-op on standard targets.
+ *  and subscriber was added and will create and compute the index tables of a session using the indexed scheduler.
+ *  For sessions using the send queue this function is a no-op.
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
  *
@@ -829,37 +1191,36 @@ EXT_DECL TRDP_ERR_T tlc_updateSession (
 {
     TRDP_ERR_T ret = TRDP_NO_ERR;
 
-#ifdef HIGH_PERF_INDEXED
-
     /*  Stop any ongoing communication by getting the mutexes */
 
     ret = trdp_getAccess(appHandle, FALSE);
 
     if (ret == TRDP_NO_ERR)
     {
-        ret = trdp_indexCreatePubTables(appHandle);
-        if (ret == TRDP_NO_ERR)
+        if (appHandle->pSlot != NULL)
         {
-            ret = trdp_indexCreateSubTables(appHandle);
+            ret = trdp_indexCreatePubTables(appHandle);
+            if (ret == TRDP_NO_ERR)
+            {
+                ret = trdp_indexCreateSubTables(appHandle);
+            }
         }
         trdp_releaseAccess(appHandle);
     }
 
-#else
-
-    (void)appHandle;  /* lint !e550 return value not used */
-
-#endif
-
     return ret;
 } /* lint !w438 return value not used */
 
 /**********************************************************************************************************************/
 /** Preset the index table sizes of a session.
  *
- *  tlc_presetIndexSession allows to preallocate the table sizes in HIGH_PERF_INDEXED mode.
- *  If no table sizes are provided, the default sizes are used. In normal mode, this is a no-op.
- *  This function should be called during initialisation stage, e.g. right after a session has been opened.
+ *  tlc_presetIndexSession switches the session to the indexed scheduler, if it was not opened with
+ *  TRDP_OPTION_INDEXED, and preallocates the index tables. If no table sizes are provided, the default sizes are used.
+ *  The base cycle sets the transmit tick: publishers with intervals down to the base cycle (250, 500 or 1000us)
+ *  can be sent. tlp_processSend() must then be called every process cycle (TRDP_PROCESS_CONFIG_T.cycleTime,
+ *  default: base cycle), which has to be a multiple of the base cycle.
+ *  This function should be called during initialisation stage, e.g. right after a session has been opened and
+ *  before the first publisher is added.
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
  *  @param[in]      pIndexTableSizes    Pointer to a table of sizes to reserve the memory
@@ -867,16 +1228,14 @@ EXT_DECL TRDP_ERR_T tlc_updateSession (
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_INIT_ERR       not yet inited
  *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        out of memory
  */
 EXT_DECL TRDP_ERR_T tlc_presetIndexSession (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_IDX_TABLE_T    *pIndexTableSizes)
 {
-    TRDP_ERR_T ret = TRDP_NO_ERR;
-
-#ifdef HIGH_PERF_INDEXED
-
-    TRDP_IDX_TABLE_T    localSizes = TRDP_DEFAULT_INDEX_SIZES;
+    TRDP_ERR_T          ret         = TRDP_NO_ERR;
+    TRDP_IDX_TABLE_T    localSizes  = TRDP_DEFAULT_INDEX_SIZES;
 
     /*  Stop any ongoing communication by getting the mutexes */
 
@@ -886,6 +1245,14 @@ EXT_DECL TRDP_ERR_T tlc_presetIndexSession (
     {
         UINT32  maxNoOfSubscriptions;
 
+        ret = trdp_indexInit(appHandle);
+        if (ret != TRDP_NO_ERR)
+        {
+            trdp_releaseAccess(appHandle);
+            return ret;
+        }
+        appHandle->option |= TRDP_OPTION_INDEXED;
+
         if (pIndexTableSizes != NULL)
         {
             localSizes = *pIndexTableSizes;
@@ -902,28 +1269,140 @@ EXT_DECL TRDP_ERR_T tlc_presetIndexSession (
                                         localSizes.maxDepthOfMidCatPublishers,
                                         localSizes.maxNoOfHighCatPublishers,
                                         localSizes.maxDepthOfHighCatPublishers,
-                                        localSizes.maxNoOfExtPublishers);
+                                        localSizes.maxNoOfExtPublishers,
+                                        localSizes.baseCycle);
         trdp_releaseAccess(appHandle);
     }
-#else
 
-    (void)appHandle;  /* lint !e550 parameter not used */
-    (void)pIndexTableSizes;  /* lint !e550 parameter not used */
+    return ret;
+} /* lint !w438 return value not used */
 
-#endif
+/**********************************************************************************************************************/
+/** Start the communication threads of a session.
+ *  Instead of driving the session by tlc_process() or by own threads, the application may let the stack run
+ *  - a cyclic PD transmit thread calling tlp_processSend() every cycleTime,
+ *  - an event driven PD receive thread (tlp_getInterval(), select(), tlp_processReceive()) and
+ *  - an MD thread (tlm_getInterval(), select(), tlm_process()), if MD is supported.
+ *  Scheduling policy, priority and CPU affinity of each thread are taken from the process configuration
+ *  (trdp-process element of the XML configuration, see tau_readXmlInterfaceConfig()).
+ *  The threads are stopped by tlc_closeSession(). Callbacks are executed in the context of these threads.
+ *  With the indexed scheduler the transmit thread runs with the process cycle of the index tables (by default the
+ *  base cycle set by tlc_presetIndexSession()), its absolute deadlines keep the slots free of drift.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      pProcessConfig      Cycle time, priority and thread layout, NULL for defaults
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_STATE_ERR      threads already started
+ *  @retval         TRDP_PARAM_ERR      cycle time does not match the index tables
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_SEMA_ERR       no semaphore available
+ *  @retval         TRDP_THREAD_ERR     thread could not be created
+ */
+
+EXT_DECL TRDP_ERR_T tlc_startSessionThreads (
+    TRDP_APP_SESSION_T              appHandle,
+    const TRDP_PROCESS_CONFIG_T     *pProcessConfig)
+{
+    static const TRDP_THREAD_CONFIG_T   cDefaultLayout = {0u, 0u, 0u};
+    TRDP_SESSION_THREADS_T              *pThreads;
+    TRDP_ERR_T  ret;
+    UINT32      cycleTime   = TRDP_PROCESS_DEFAULT_CYCLE_TIME;
+    UINT32      priority    = TRDP_PROCESS_DEFAULT_PRIORITY;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (appHandle->pThreads != NULL)
+    {
+        return TRDP_STATE_ERR;
+    }
+    if (pProcessConfig != NULL)
+    {
+        if (pProcessConfig->cycleTime != 0u)
+        {
+            cycleTime = pProcessConfig->cycleTime;
+        }
+        if (pProcessConfig->priority != 0u)
+        {
+            priority = pProcessConfig->priority;
+        }
+    }
+
+    if (appHandle->pSlot != NULL)
+    {
+        /* The index tables are sent in steps of the process cycle, the transmit thread must run with it */
+        if ((pProcessConfig == NULL) || (pProcessConfig->cycleTime == 0u))
+        {
+            cycleTime = (appHandle->stats.processCycle != 0u) ? appHandle->stats.processCycle
+                                                               : appHandle->pSlot->baseCycle;
+        }
+        if ((appHandle->pSlot->processCycle != 0u) &&
+            (appHandle->pSlot->processCycle != cycleTime))
+        {
+            vos_printLog(VOS_LOG_ERROR, "Cycle time %uus differs from the process cycle of the index tables (%uus)\n",
+                         (unsigned int) cycleTime, (unsigned int) appHandle->pSlot->processCycle);
+            return TRDP_PARAM_ERR;
+        }
+        appHandle->stats.processCycle = cycleTime;      /* for tlc_updateSession() */
+    }
+
+    pThreads = (TRDP_SESSION_THREADS_T *) vos_memAlloc(sizeof(TRDP_SESSION_THREADS_T));
+
+    if (pThreads == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    if (vos_semaCreate(&pThreads->left, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+    {
+        vos_memFree(pThreads);
+        return TRDP_SEMA_ERR;
+    }
+    pThreads->appHandle = appHandle;
+    pThreads->cycleTime = cycleTime;
+    appHandle->pThreads = pThreads;
 
+    ret = trdp_createSessionThread(&pThreads->rxThread, "TRDP PD Rx",
+                                   (pProcessConfig != NULL) ? &pProcessConfig->rxThread : &cDefaultLayout,
+                                   priority, 0u, (VOS_THREAD_FUNC_T) trdp_rxThread, pThreads);
+#if MD_SUPPORT
+    if (ret == TRDP_NO_ERR)
+    {
+        ret = trdp_createSessionThread(&pThreads->mdThread, "TRDP MD",
+                                       (pProcessConfig != NULL) ? &pProcessConfig->mdThread : &cDefaultLayout,
+                                       priority, 0u, (VOS_THREAD_FUNC_T) trdp_mdThread, pThreads);
+    }
+#endif
+    if (ret == TRDP_NO_ERR)
+    {
+        ret = trdp_createSessionThread(&pThreads->txThread, "TRDP PD Tx",
+                                       (pProcessConfig != NULL) ? &pProcessConfig->txThread : &cDefaultLayout,
+                                       priority, cycleTime, (VOS_THREAD_FUNC_T) trdp_txThread, pThreads);
+    }
+    if (ret != TRDP_NO_ERR)
+    {
+        trdp_stopSessionThreads(appHandle);
+    }
+    else
+    {
+        vos_printLog(VOS_LOG_INFO, "Session threads started (cycle time %u us)\n", (unsigned int) cycleTime);
+    }
     return ret;
-} /* lint !w438 return value not used */
+}
 
 /**********************************************************************************************************************/
 /** Close a session.
- *  Clean up and release all resources of that session
+ *  Clean up and release all resources of that session. Threads started by tlc_startSessionThreads() are stopped
+ *  before, therefore this function must not be called from within a callback of these threads.
  *
  *  @param[in]      appHandle             The handle returned by tlc_openSession
  *
  *  @retval         TRDP_NO_ERR           no error
  *  @retval         TRDP_NOINIT_ERR       handle invalid
  *  @retval         TRDP_PARAM_ERR        handle NULL
+ *  @retval         TRDP_MUTEX_ERR        PD dispatch workers could not be stopped, session kept
  */
 
 EXT_DECL TRDP_ERR_T tlc_closeSession (
@@ -939,6 +1418,18 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
         return TRDP_PARAM_ERR;
     }
 
+    /*    Stop the session threads and the PD dispatch workers while the session is still fully operational    */
+    if (trdp_isValidSession(appHandle))
+    {
+        trdp_stopSessionThreads(appHandle);
+        if (trdp_pdDispatchStop(appHandle) != TRDP_NO_ERR)
+        {
+            /* The workers still refer to the session, it must not be freed */
+            vos_printLogStr(VOS_LOG_ERROR, "PD dispatch workers could not be stopped\n");
+            return TRDP_MUTEX_ERR;
+        }
+    }
+
     ret = (TRDP_ERR_T) vos_mutexLock(sSessionMutex);
 
     if (ret != TRDP_NO_ERR)
@@ -968,7 +1459,14 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
             }
         }
 
+        if (found)
+        {
+            /* From now on the handle is rejected by trdp_isValidSession() */
+            trdp_sessionTableRemove((TRDP_SESSION_PT) appHandle);
+        }
+
         /* We can release the global session mutex after removing the session from the list */
+
         if (vos_mutexUnlock(sSessionMutex) != VOS_NO_ERR)
         {
             vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -990,9 +1488,8 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
             }
             else
             {
-#ifdef HIGH_PERF_INDEXED
                 trdp_indexDeInit(pSession);
-#endif
+
                 /*    Release all allocated sockets and memory    */
                 vos_memFree(pSession->pNewFrame);
 
@@ -1038,11 +1535,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
 #if MD_SUPPORT
                 if (pSession->pMDRcvEle != NULL)
                 {
-                    if (pSession->pMDRcvEle->pPacket != NULL)
-                    {
-                        vos_memFree(pSession->pMDRcvEle->pPacket);
-                    }
-                    vos_memFree(pSession->pMDRcvEle);
+                    trdp_mdFreeSession(pSession, pSession->pMDRcvEle);
                     pSession->pMDRcvEle = NULL;
                 }
 
@@ -1057,7 +1550,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                                        pSession->mdDefault.connectTimeout,
                                        FALSE,
                                        VOS_INADDR_ANY);
-                    trdp_mdFreeSession(pSession->pMDSndQueue);
+                    trdp_mdFreeSession(pSession, pSession->pMDSndQueue);
                     pSession->pMDSndQueue = pNext;
                 }
                 /*    Release all allocated sockets and memory    */
@@ -1071,9 +1564,25 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                                        pSession->mdDefault.connectTimeout,
                                        FALSE,
                                        VOS_INADDR_ANY);
-                    trdp_mdFreeSession(pSession->pMDRcvQueue);
+                    trdp_mdFreeSession(pSession, pSession->pMDRcvQueue);
                     pSession->pMDRcvQueue = pNext;
                 }
+                trdp_mdRcvPoolFree(pSession);
+                trdp_mdCompletionClose(pSession);
+                trdp_mdBufferFreeAll(pSession);
+                if (pSession->ppMDTimers != NULL)
+                {
+                    vos_memFree(pSession->ppMDTimers);
+                    pSession->ppMDTimers    = NULL;
+                    pSession->numMDTimers   = 0u;
+                }
+                if (pSession->pMDNotifyArena != NULL)
+                {
+                    vos_memFree(pSession->pMDNotifyArena);
+                    pSession->pMDNotifyArena    = NULL;
+                    pSession->mdNotifyArenaSize = 0u;
+                }
+
                 /*    Release all allocated sockets and memory    */
                 while (pSession->pMDListenQueue != NULL)
                 {
@@ -1097,6 +1606,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     (void)vos_sockClose(pSession->tcpFd.listen_sd);
                     pSession->tcpFd.listen_sd = VOS_INVALID_SOCKET;
                 }
+                trdp_freeTCPRx(pSession->ifaceMD, TRDP_MAX_MD_SOCKET_CNT);
 #endif
                 trdp_releaseAccess(pSession);
 
@@ -1151,6 +1661,7 @@ EXT_DECL TRDP_ERR_T tlc_terminate (void)
         /* Delete SessionMutex and clear static variable */
         vos_mutexDelete(sSessionMutex);
         sSessionMutex = NULL;
+        sSessionMaxProbe = 0u;
 
         /* Close stop timers, release memory  */
         vos_terminate();
@@ -1233,6 +1744,7 @@ EXT_DECL TRDP_ERR_T tlc_reinitSession (
  *  Return the maximum time interval suitable for 'select()' so that we
  *    can send due PD packets in time.
  *    If the PD send queue is empty, return zero time
+ *    For sessions using the indexed scheduler the interval ends with the next process cycle.
  *
  *  @param[in]      appHandle          The handle returned by tlc_openSession
  *  @param[out]     pInterval          pointer to needed interval
@@ -1248,11 +1760,6 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
     TRDP_FDS_T          *pFileDesc,
     INT32               *pNoDesc)
 {
-#ifdef HIGH_PERF_INDEXED
-    vos_printLogStr(VOS_LOG_ERROR, "####   tlc_getInterval() is not supported when using HIGH_PERF_INDEXED!  ####\n");
-    vos_printLogStr(VOS_LOG_ERROR, "####           Use tlp_getInterval()/tlm_getInterval() instead!          ####\n");
-    return TRDP_NOINIT_ERR; 
-#else
     TRDP_TIME_T now;
     TRDP_ERR_T  ret = TRDP_NOINIT_ERR;
 
@@ -1278,10 +1785,29 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
                 vos_getTime(&now);
                 vos_clearTime(&appHandle->nextJob);
 
-                trdp_pdCheckPending(appHandle, pFileDesc, pNoDesc, TRUE);
+                if ((appHandle->pSlot != NULL) && (appHandle->pSlot->processCycle != 0u))
+                {
+                    /* Indexed scheduler: PD is sent with the next process cycle */
+                    trdp_pdCheckPending(appHandle, pFileDesc, pNoDesc, FALSE);
+                    trdp_indexNextCycle(appHandle, &appHandle->nextJob);
+                }
+                else
+                {
+                    trdp_pdCheckPending(appHandle, pFileDesc, pNoDesc, TRUE);
+                }
 
 #if MD_SUPPORT
-                trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
+                {
+                    TRDP_TIME_T mdJob;
+
+                    /* the earliest MD session time-out may come before the next PD job */
+                    trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc, &mdJob);
+                    if (timerisset(&mdJob) &&
+                        (!timerisset(&appHandle->nextJob) || timercmp(&mdJob, &appHandle->nextJob, <)))
+                    {
+                        appHandle->nextJob = mdJob;
+                    }
+                }
 #endif
 
                 /*    if next job time is known, return the time-out value to the caller   */
@@ -1310,13 +1836,14 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
         }
     }
     return ret;
-#endif
 }
 
 /**********************************************************************************************************************/
 /** Work loop of the TRDP handler.
  *    Search the queue for pending PDs and MDs to be sent
  *    Search the receive queue for pending PDs and MDs (time out)
+ *    Sessions using the indexed scheduler send their index tables once per process cycle; cycles missed by a late
+ *    call are skipped.
  *
  *  Note:
  *      If using tlc_process(), do not use tlp_process*() and tlm_process() calls at the same time!
@@ -1339,11 +1866,6 @@ EXT_DECL TRDP_ERR_T tlc_process (
     TRDP_FDS_T          *pRfds,
     INT32               *pCount)
 {
-#ifdef HIGH_PERF_INDEXED
-    vos_printLogStr(VOS_LOG_ERROR, "####   tlc_process() is not supported when using HIGH_PERF_INDEXED!  ####\n");
-    vos_printLogStr(VOS_LOG_ERROR, "#### Use tlp_processSend/tlp_processReceive()/tlm_process() instead! ####\n");
-    return TRDP_NOINIT_ERR;
-#else
     TRDP_ERR_T  result = TRDP_NO_ERR;
     TRDP_ERR_T  err;
 
@@ -1366,7 +1888,14 @@ EXT_DECL TRDP_ERR_T tlc_process (
 
         if (vos_mutexTryLock(appHandle->mutexTxPD) == VOS_NO_ERR)
         {
-            err = trdp_pdSendQueued(appHandle);
+            if ((appHandle->pSlot != NULL) && (appHandle->pSlot->processCycle != 0u))
+            {
+                err = trdp_pdSendIndexedDue(appHandle);
+            }
+            else
+            {
+                err = trdp_pdSendQueued(appHandle);
+            }
 
             if (err != TRDP_NO_ERR)
             {
@@ -1386,10 +1915,18 @@ EXT_DECL TRDP_ERR_T tlc_process (
             /******************************************************
              Find packets which are pending/overdue
              ******************************************************/
-            trdp_pdHandleTimeOuts(appHandle);
+            if ((appHandle->pSlot != NULL) && (appHandle->pSlot->pRcvTableTimeOut != NULL))
+            {
+                trdp_pdHandleTimeOutsIndexed(appHandle);
+            }
+            else
+            {
+                trdp_pdHandleTimeOuts(appHandle);
+            }
 
             /******************************************************
              Find packets which are to be received
+
              ******************************************************/
             err = trdp_pdCheckListenSocks(appHandle, pRfds, pCount);
             if (err != TRDP_NO_ERR)
@@ -1441,7 +1978,6 @@ EXT_DECL TRDP_ERR_T tlc_process (
     }
 
     return result;
-#endif
 }
 
 /**********************************************************************************************************************/
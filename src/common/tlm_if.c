@@ -17,6 +17,12 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: tlm_notifyBatch() sends a batch of notifications at once
+*      BL 2026-10-18: tlm_openCompletionQueue(), tlm_postCompletion(), tlm_getCompletions(): MD completion queue
+*      BL 2026-10-18: tlm_allocBuffer(), tlm_freeBuffer() and tlm_*Buffer() send functions without payload copy
+*      BL 2026-10-18: tlm_configTCPPool(), tlm_getTCPPoolStatistics() added
+*      BL 2026-10-18: Listeners are added to / removed from the MD listener dispatch table
+*      BL 2026-10-18: tlm_abortSession looks up the session index of both MD queues
 *     AHW 2021-05-26: Ticket #370 Number of Listeners in MD statistics not counted correctly
 *      BL 2020-09-08: Ticket #343 userStatus parameter size in tlm_reply and tlm_replyQuery
 *      BL 2020-08-10: Ticket #309 revisited: tlm_abortSession shall return noError if morituri is not set
@@ -39,11 +45,14 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_MD
+
 #include <string.h>
 
 #include "tlc_if.h"
 #include "trdp_utils.h"
 #include "trdp_mdcom.h"
+#include "trdp_mdcompletion.h"
 #include "trdp_stats.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
@@ -73,6 +82,8 @@ extern "C" {
 /** Get the lowest time interval for MDs.
  *  Return the maximum time interval suitable for 'select()' so that we
  *    can report time outs to the higher layer.
+ *  The interval ends with the earliest session time-out, but lasts TRDP_MD_MAN_CYCLE_TIME at most: messages
+ *  queued by tlm_notify(), tlm_request() etc. are sent by the next tlm_process() call.
  *
  *  @param[in]      appHandle          The handle returned by tlc_openSession
  *  @param[out]     pInterval          pointer to needed interval
@@ -108,12 +119,32 @@ EXT_DECL TRDP_ERR_T tlm_getInterval (
             }
             else
             {
-                trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
+                TRDP_TIME_T nextJob;
+                TRDP_TIME_T now;
+
+                trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc, &nextJob);
 
                 /*  Return a time-out value to the caller   */
                 pInterval->tv_sec   = 0u;                       /* if no timeout is set             */
                 pInterval->tv_usec  = TRDP_MD_MAN_CYCLE_TIME;   /* Application should limit this    */
 
+                if (timerisset(&nextJob))
+                {
+                    vos_getTime(&now);
+                    if (timercmp(&now, &nextJob, <))
+                    {
+                        vos_subTime(&nextJob, &now);
+                        if (timercmp(&nextJob, pInterval, <))
+                        {
+                            *pInterval = nextJob;
+                        }
+                    }
+                    else
+                    {
+                        pInterval->tv_usec = 0;                 /* time-out is due                  */
+                    }
+                }
+
                 if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
                 {
                     vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -269,10 +300,71 @@ EXT_DECL TRDP_ERR_T tlm_notify (
                pData,
                dataSize,
                srcURI,
-               destURI
+               destURI,
+               NULL
                );
 }
 
+/**********************************************************************************************************************/
+/** Send a batch of MD notifications.
+ *  The notifications are built under one lock and sent at once, on Linux with one system call per
+ *  VOS_MAX_DGRAM_CNT notifications. Unlike tlm_notify() they are not queued for the next tlc_process(), no callback
+ *  is invoked and no URIs are sent. Only UDP is supported.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
+ *  @param[in]      pktFlags            OPTION:
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL
+ *  @param[in]      pSendParam          optional pointer to send parameter, NULL - default parameters are used
+ *  @param[in]      pItems              notifications (comId, destination, data) to send
+ *  @param[in]      noOfItems           number of notifications
+ *  @param[out]     pResults            result per notification, NULL if not needed
+ *
+ *  @retval         TRDP_NO_ERR         all notifications sent
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_TOPO_ERR       topocount mismatch
+ *  @retval         != TRDP_NO_ERR      result of the first notification not sent
+ */
+EXT_DECL TRDP_ERR_T tlm_notifyBatch (
+    TRDP_APP_SESSION_T          appHandle,
+    UINT32                      etbTopoCnt,
+    UINT32                      opTrnTopoCnt,
+    TRDP_IP_ADDR_T              srcIpAddr,
+    TRDP_FLAGS_T                pktFlags,
+    const TRDP_SEND_PARAM_T     *pSendParam,
+    const TRDP_MD_NOTIFY_ITEM_T *pItems,
+    UINT32                      noOfItems,
+    TRDP_ERR_T                  *pResults)
+{
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if ((pItems == NULL) || (noOfItems == 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_validTopoCounters(appHandle->etbTopoCnt,
+                                appHandle->opTrnTopoCnt,
+                                etbTopoCnt,
+                                opTrnTopoCnt))
+    {
+        return TRDP_TOPO_ERR;
+    }
+    return trdp_mdNotifyBatch(appHandle,
+                              etbTopoCnt,
+                              opTrnTopoCnt,
+                              srcIpAddr,
+                              pktFlags,
+                              pSendParam,
+                              pItems,
+                              noOfItems,
+                              pResults);
+}
+
 /**********************************************************************************************************************/
 /** Initiate sending MD request message.
  *  Send a MD request message
@@ -373,7 +465,8 @@ EXT_DECL TRDP_ERR_T tlm_request (
                    pData,
                    dataSize,
                    srcURI,
-                   destURI
+                   destURI,
+                   NULL
                    );
     }
 }
@@ -526,6 +619,7 @@ EXT_DECL TRDP_ERR_T  tlm_addListener (
                     /* Insert into list */
                     pNewElement->pNext          = appHandle->pMDListenQueue;
                     appHandle->pMDListenQueue   = pNewElement;
+                    trdp_mdListenerInsert(appHandle, pNewElement);
 
                     /* Statistics */
                     if ((pNewElement->pktFlags & TRDP_FLAGS_TCP) != 0)
@@ -621,6 +715,8 @@ EXT_DECL TRDP_ERR_T tlm_delListener (
 
         if (TRUE == dequeued)
         {
+            trdp_mdListenerRemove(appHandle, pDelete);
+
             /* cleanup instance */
             if (pDelete->socketIdx != -1)
             {
@@ -756,6 +852,7 @@ EXT_DECL TRDP_ERR_T tlm_readdListener (
         }
         if (ret == TRDP_NO_ERR)
         {
+            /* comId and URIs are not changed, the listener keeps its dispatch table entry */
             pListener->addr.etbTopoCnt      = etbTopoCnt;
             pListener->addr.opTrnTopoCnt    = opTrnTopoCnt;
             pListener->addr.mcGroup         = mcDestIpAddr;
@@ -825,7 +922,8 @@ EXT_DECL TRDP_ERR_T tlm_reply (
                         pSendParam,
                         pData,
                         dataSize,
-                        pSrcURI);
+                        pSrcURI,
+                        NULL);
 }
 
 
@@ -896,7 +994,320 @@ EXT_DECL TRDP_ERR_T tlm_replyQuery (
                         pSendParam,
                         pData,
                         dataSize,
-                        pSrcURI);
+                        pSrcURI,
+                        NULL);
+}
+
+/**********************************************************************************************************************/
+/** Borrow a packet buffer for sending MD without copying.
+ *  The payload is filled in place and handed to tlm_notifyBuffer(), tlm_requestBuffer() or tlm_replyBuffer(),
+ *  which take over the buffer. A buffer not sent must be returned by tlm_freeBuffer().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      dataSize            max. size of the payload
+ *  @param[out]     ppData              Pointer to return the payload buffer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlm_allocBuffer (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              dataSize,
+    UINT8               **ppData)
+{
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if ((ppData == NULL) || (dataSize > TRDP_MAX_MD_DATA_SIZE))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    *ppData = trdp_mdBufferAlloc(appHandle, dataSize);
+
+    return (*ppData == NULL) ? TRDP_MEM_ERR : TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return a borrowed packet buffer which was not sent.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pData               payload buffer returned by tlm_allocBuffer()
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      not a borrowed buffer
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlm_freeBuffer (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT8               *pData)
+{
+    MD_PACKET_T *pBuffer;
+
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pBuffer = trdp_mdBufferGet(appHandle, pData, 0u);
+    if (pBuffer == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    trdp_mdBufferFree(pBuffer);
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Send a MD notification message from a borrowed buffer.
+ *  Like tlm_notify(), but the payload is not copied. The buffer is taken over, also if an error is returned.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pUserRef            user supplied value returned with reply
+ *  @param[in]      pfCbFunction        Pointer to listener specific callback function, NULL to use default function
+ *  @param[in]      comId               comId of packet to be sent
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
+ *  @param[in]      destIpAddr          where to send the packet to
+ *  @param[in]      pktFlags            OPTION:
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
+ *  @param[in]      pSendParam          optional pointer to send parameter, NULL - default parameters are used
+ *  @param[in]      pData               payload buffer returned by tlm_allocBuffer()
+ *  @param[in]      dataSize            size of packet data
+ *  @param[in]      srcURI              only functional group of source URI
+ *  @param[in]      destURI             only functional group of destination URI
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, pData is not taken over if it is no borrowed buffer
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid, pData is not taken over
+ */
+EXT_DECL TRDP_ERR_T tlm_notifyBuffer (
+    TRDP_APP_SESSION_T      appHandle,
+    const void              *pUserRef,
+    TRDP_MD_CALLBACK_T      pfCbFunction,
+    UINT32                  comId,
+    UINT32                  etbTopoCnt,
+    UINT32                  opTrnTopoCnt,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr,
+    TRDP_FLAGS_T            pktFlags,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    UINT8                   *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI,
+    const TRDP_URI_USER_T   destURI)
+{
+    MD_PACKET_T *pBuffer;
+
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    pBuffer = trdp_mdBufferGet(appHandle, pData, dataSize);
+    if (pBuffer == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_validTopoCounters(appHandle->etbTopoCnt,
+        appHandle->opTrnTopoCnt,
+        etbTopoCnt,
+        opTrnTopoCnt))
+    {
+        trdp_mdBufferFree(pBuffer);
+        return TRDP_TOPO_ERR;
+    }
+    return trdp_mdCall(
+               TRDP_MSG_MN,                                    /* notify without reply */
+               appHandle,
+               pUserRef,
+               pfCbFunction,
+               NULL,
+               comId,
+               etbTopoCnt,
+               opTrnTopoCnt,
+               srcIpAddr,
+               destIpAddr,
+               pktFlags,
+               0u,                                              /* numbber of repliers for notify */
+               0u,                                              /* reply timeout for notify */
+               TRDP_REPLY_OK,                                  /* reply state */
+               pSendParam,
+               pData,
+               dataSize,
+               srcURI,
+               destURI,
+               pBuffer
+               );
+}
+
+/**********************************************************************************************************************/
+/** Send a MD request message from a borrowed buffer.
+ *  Like tlm_request(), but the payload is not copied. The buffer is taken over, also if an error is returned.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pUserRef            user supplied value returned with reply
+ *  @param[in]      pfCbFunction        Pointer to listener specific callback function, NULL to use default function
+ *  @param[out]     pSessionId          return session ID
+ *  @param[in]      comId               comId of packet to be sent
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
+ *  @param[in]      destIpAddr          where to send the packet to
+ *  @param[in]      pktFlags            OPTION:
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL
+ *  @param[in]      numReplies          number of expected replies, 0 if unknown
+ *  @param[in]      replyTimeout        timeout for reply
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *  @param[in]      pData               payload buffer returned by tlm_allocBuffer()
+ *  @param[in]      dataSize            size of packet data
+ *  @param[in]      srcURI              only functional group of source URI
+ *  @param[in]      destURI             only functional group of destination URI
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, pData is not taken over if it is no borrowed buffer
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid, pData is not taken over
+ */
+EXT_DECL TRDP_ERR_T tlm_requestBuffer (
+    TRDP_APP_SESSION_T      appHandle,
+    const void              *pUserRef,
+    TRDP_MD_CALLBACK_T      pfCbFunction,
+    TRDP_UUID_T             *pSessionId,
+    UINT32                  comId,
+    UINT32                  etbTopoCnt,
+    UINT32                  opTrnTopoCnt,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr,
+    TRDP_FLAGS_T            pktFlags,
+    UINT32                  numReplies,
+    UINT32                  replyTimeout,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    UINT8                   *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI,
+    const TRDP_URI_USER_T   destURI)
+{
+    MD_PACKET_T *pBuffer;
+    UINT32      mdTimeOut;
+
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    pBuffer = trdp_mdBufferGet(appHandle, pData, dataSize);
+    if (pBuffer == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if ( replyTimeout == 0U )
+    {
+        mdTimeOut = appHandle->mdDefault.replyTimeout;
+    }
+    else if ( replyTimeout == TRDP_INFINITE_TIMEOUT)
+    {
+        mdTimeOut = 0;
+    }
+    else
+    {
+        mdTimeOut = replyTimeout;
+    }
+
+    if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
+                                  appHandle->opTrnTopoCnt,
+                                  etbTopoCnt,
+                                  opTrnTopoCnt))
+    {
+        trdp_mdBufferFree(pBuffer);
+        return TRDP_TOPO_ERR;
+    }
+    return trdp_mdCall(
+               TRDP_MSG_MR,                                           /* request with reply */
+               appHandle,
+               pUserRef,
+               pfCbFunction,
+               pSessionId,
+               comId,
+               etbTopoCnt,
+               opTrnTopoCnt,
+               srcIpAddr,
+               destIpAddr,
+               pktFlags,
+               numReplies,
+               mdTimeOut,
+               TRDP_REPLY_OK,                                         /* reply state */
+               pSendParam,
+               pData,
+               dataSize,
+               srcURI,
+               destURI,
+               pBuffer
+               );
+}
+
+/**********************************************************************************************************************/
+/** Send a MD reply message from a borrowed buffer.
+ *  Like tlm_reply(), but the payload is not copied. The buffer is taken over, also if an error is returned.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pSessionId          Session ID returned by indication
+ *  @param[in]      comId               comId of packet to be sent
+ *  @param[in]      userStatus          Info for requester about application errors
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *  @param[in]      pData               payload buffer returned by tlm_allocBuffer()
+ *  @param[in]      dataSize            size of packet data
+ *  @param[in]      srcURI              only functional group of source URI, set to NULL if not used
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, pData is not taken over if it is no borrowed buffer
+ *  @retval         TRDP_MEM_ERR        Out of memory
+ *  @retval         TRDP_NO_SESSION_ERR no such session
+ *  @retval         TRDP_NOINIT_ERR     handle invalid, pData is not taken over
+ */
+EXT_DECL TRDP_ERR_T tlm_replyBuffer (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_UUID_T       *pSessionId,
+    UINT32                  comId,
+    UINT32                  userStatus,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    UINT8                   *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI)
+{
+    const TRDP_URI_USER_T   *pSrcURI = (const TRDP_URI_USER_T *) srcURI;    /* Array as parameter is a pointer */
+    MD_PACKET_T             *pBuffer;
+
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    pBuffer = trdp_mdBufferGet(appHandle, pData, dataSize);
+    if (pBuffer == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (userStatus > 0x7FFFFFFF)
+    {
+        trdp_mdBufferFree(pBuffer);
+        return TRDP_PARAM_ERR;
+    }
+    return trdp_mdReply(TRDP_MSG_MP,
+                        appHandle,
+                        (UINT8 *)pSessionId,
+                        comId,
+                        0u,
+                        (INT32)userStatus,
+                        pSendParam,
+                        pData,
+                        dataSize,
+                        pSrcURI,
+                        pBuffer);
 }
 
 
@@ -945,7 +1356,8 @@ EXT_DECL TRDP_ERR_T tlm_abortSession (
     const TRDP_UUID_T   *pSessionId)
 {
     MD_ELE_T    *iterMD     = NULL;
-    BOOL8       firstLoop   = TRUE;
+    MD_ELE_T    * *ppTable[2];
+    UINT32      i;
     TRDP_ERR_T  err         = TRDP_NOSESSION_ERR;
 
     if (!trdp_isValidSession(appHandle))
@@ -965,20 +1377,16 @@ EXT_DECL TRDP_ERR_T tlm_abortSession (
         return TRDP_NOINIT_ERR;
     }
 
-    iterMD = appHandle->pMDSndQueue;
-
     /*  Find the session which needs to be killed. Actual release will be done in tlc_process().
      Note: We must also check the receive queue for pending replies! */
-    do
+    ppTable[0]  = appHandle->pMDSndSessions;
+    ppTable[1]  = appHandle->pMDRcvSessions;
+    for (i = 0u; i < 2u; i++)
     {
-        /*  Switch to receive queue */
-        if ((NULL == iterMD) && (TRUE == firstLoop))
-        {
-            iterMD      = appHandle->pMDRcvQueue;
-            firstLoop   = FALSE;
-        }
+        for (iterMD = trdp_mdSessionBucket(ppTable[i], (const UINT8 *) pSessionId);
 
-        if (NULL != iterMD)
+             iterMD != NULL;
+             iterMD = iterMD->pNextSession)
         {
             if ((memcmp(iterMD->sessionID, pSessionId, TRDP_SESS_ID_SIZE) == 0) &&
                 (iterMD->morituri == FALSE))
@@ -987,10 +1395,8 @@ EXT_DECL TRDP_ERR_T tlm_abortSession (
                 iterMD->morituri = TRUE;
                 err = TRDP_NO_ERR;
             }
-            iterMD = iterMD->pNext;
         }
     }
-    while (iterMD != NULL);
 
     /* Release mutex */
     if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
@@ -1001,6 +1407,189 @@ EXT_DECL TRDP_ERR_T tlm_abortSession (
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Configure the pool of TCP connections used by callers.
+ *  Caller sessions to the same peer share a connection, up to maxSessionsPerConn outstanding sessions each.
+ *  Unused connections are closed after the keep-alive time, unless they lead to one of the configured peers.
+ *  Connections to these peers are opened immediately.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pConfig             Pointer to the pool configuration
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_SOCK_ERR       a peer could not be connected
+ */
+EXT_DECL TRDP_ERR_T tlm_configTCPPool (
+    TRDP_APP_SESSION_T              appHandle,
+    const TRDP_MD_TCP_POOL_CONFIG_T *pConfig)
+{
+    TRDP_ERR_T err;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pConfig == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    err = trdp_mdTCPPoolConfig(appHandle, pConfig);
+
+    if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Return the counters of the TCP connection pool.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the pool counters
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlm_getTCPPoolStatistics (
+    TRDP_APP_SESSION_T              appHandle,
+    TRDP_MD_TCP_POOL_STATISTICS_T   *pStatistics)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_mdTCPPoolStatistics(appHandle, pStatistics);
+
+    if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Open the completion queue of a session.
+ *  Sessions and listeners which get tlm_postCompletion() as callback function post their results (notifications,
+ *  requests, replies, confirmations and timeouts) to this queue. The session ID returned by tlm_request() is the
+ *  ticket to match the results of a request. The queue is deleted by tlc_closeSession().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      depth               max. number of records not yet taken (1 ... TRDP_MD_COMPLETION_MAX_DEPTH)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_STATE_ERR      completion queue already open
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+EXT_DECL TRDP_ERR_T tlm_openCompletionQueue (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              depth)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if ((depth == 0u) || (depth > TRDP_MD_COMPLETION_MAX_DEPTH))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (appHandle->pMDCompletion != NULL)
+    {
+        return TRDP_STATE_ERR;
+    }
+
+    return trdp_mdCompletionOpen(appHandle, depth);
+}
+
+/**********************************************************************************************************************/
+/** MD callback function posting to the completion queue.
+ *  Pass this function as callback to tlm_request(), tlm_notify(), tlm_addListener() or as default MD callback
+ *  to get the results through tlm_getCompletions().
+ *
+ *  @param[in]      pRefCon             user context (unused)
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pMsg                message info
+ *  @param[in]      pData               received data
+ *  @param[in]      dataSize            size of received data
+ */
+EXT_DECL void tlm_postCompletion (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+
+    trdp_mdCompletionPost(appHandle, pMsg, pData, dataSize);
+}
+
+/**********************************************************************************************************************/
+/** Take completion records from the completion queue.
+ *  Waits up to usTimeout for the first record and takes further records as far as available, without waiting.
+ *  The calling thread need not be the one processing MD, but only one thread at a time may take records.
+ *  The received data of a record is held in a lent buffer, which must be returned by tlm_freeBuffer() or can be
+ *  sent by tlm_notifyBuffer(), tlm_requestBuffer() or tlm_replyBuffer().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pRecords            array to copy the records to
+ *  @param[in]      maxRecords          number of records the array can hold
+ *  @param[out]     pNoOfRecords        number of records copied
+ *  @param[in]      usTimeout           max. time to wait for a record [us], 0 - return at once
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NODATA_ERR     no completion until timeout
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_STATE_ERR      no completion queue open
+ */
+EXT_DECL TRDP_ERR_T tlm_getCompletions (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_MD_COMPLETION_T    *pRecords,
+    UINT32                  maxRecords,
+    UINT32                  *pNoOfRecords,
+    UINT32                  usTimeout)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if ((pRecords == NULL) || (maxRecords == 0u) || (pNoOfRecords == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    return trdp_mdCompletionGet(appHandle, pRecords, maxRecords, pNoOfRecords, usTimeout);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,9 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: Indexed scheduler selected per session at run time (appHandle->pSlot)
+*      BL 2026-10-18: tlp_publish() enters the publisher into existing index tables, tlp_getBurstProfile() added
+*      BL 2026-10-18: tlp_setCallbackDispatch(), tlp_getDispatchStatistics(): deferred PD callback dispatch
 *     AHW 2022-03-24: Ticket #391 Allow PD request without reply
 *     IBO 2021-08-12: Ticket #355 Redundant PD default state should be follower
 *     AHW 2021-05-04: Ticket #354 Sequence counter synchronization error working in redundancy mode
@@ -45,19 +48,20 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_PD
+
 #include <string.h>
 
 #include "tlc_if.h"
 #include "trdp_utils.h"
 #include "trdp_pdcom.h"
 #include "trdp_stats.h"
+#include "trdp_pddispatch.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
 #include "vos_utils.h"
 
-#ifdef HIGH_PERF_INDEXED
 #include "trdp_pdindex.h"
-#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -118,12 +122,10 @@ EXT_DECL TRDP_ERR_T tlp_getInterval (
                 vos_printLogStr(VOS_LOG_INFO, "vos_mutexLock() failed\n");
                 return ret;
             }
-#ifdef HIGH_PERF_INDEXED
             else if (appHandle->pSlot != NULL)
             {
                 trdp_indexCheckPending(appHandle, pInterval, pFileDesc, pNoDesc);
             }
-#endif
             else
             {
                 TRDP_TIME_T now;
@@ -210,7 +212,6 @@ EXT_DECL TRDP_ERR_T tlp_processReceive (
          Find packets which are pending/overdue
          ******************************************************/
 
-#ifdef HIGH_PERF_INDEXED
         if ((appHandle->pSlot != NULL) &&
             (appHandle->pSlot->pRcvTableTimeOut != NULL))
         {
@@ -221,9 +222,6 @@ EXT_DECL TRDP_ERR_T tlp_processReceive (
         {
             trdp_pdHandleTimeOuts(appHandle);
         }
-#else
-        trdp_pdHandleTimeOuts(appHandle);
-#endif
         if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
         {
             vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -266,9 +264,11 @@ EXT_DECL TRDP_ERR_T tlp_processSend (
          Find and send the packets which have to be sent next:
          ******************************************************/
 
-#ifdef HIGH_PERF_INDEXED
-        if ((appHandle->pSlot == NULL) ||
-            (appHandle->pSlot->processCycle == 0u))
+        if (appHandle->pSlot == NULL)
+        {
+            err = trdp_pdSendQueued(appHandle);
+        }
+        else if (appHandle->pSlot->processCycle == 0u)
         {
             static int count = 5000;
             err = trdp_pdSendQueued(appHandle);
@@ -283,9 +283,7 @@ EXT_DECL TRDP_ERR_T tlp_processSend (
         {
             err = trdp_pdSendIndexed(appHandle);
         }
-#else
-        err = trdp_pdSendQueued(appHandle);
-#endif
+
         if (err != TRDP_NO_ERR)
         {
             /*  We do not break here, only report error */
@@ -437,7 +435,8 @@ EXT_DECL TRDP_ERR_T tlp_getRedundant (
  *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
  *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
  *  @param[in]      destIpAddr          where to send the packet to
- *  @param[in]      interval            frequency of PD packet (>= 10ms) in usec
+ *  @param[in]      interval            frequency of PD packet in usec (>= TRDP_TIMER_GRANULARITY, with the indexed
+ *                                      scheduler >= TRDP_TIMER_GRANULARITY_INDEXED)
  *  @param[in]      redId               0 - Non-redundant, > 0 valid redundancy group
  *  @param[in]      pktFlags            OPTION:
  *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
@@ -476,8 +475,7 @@ EXT_DECL TRDP_ERR_T tlp_publish (
     TRDP_SOCK_TYPE_T    sockType    = TRDP_SOCK_PD;
 
     /*    Check params    */
-    if ((interval != 0u && interval < TRDP_TIMER_GRANULARITY)
-        || (pPubHandle == NULL))
+    if (pPubHandle == NULL)
     {
         return TRDP_PARAM_ERR;
     }
@@ -487,6 +485,13 @@ EXT_DECL TRDP_ERR_T tlp_publish (
         return TRDP_NOINIT_ERR;
     }
 
+    /*    The indexed scheduler allows shorter intervals    */
+    if ((interval != 0u) &&
+        (interval < ((appHandle->pSlot != NULL) ? TRDP_TIMER_GRANULARITY_INDEXED : TRDP_TIMER_GRANULARITY)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
     /*    Reserve mutual access    */
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexTxPD);
     if (ret == TRDP_NO_ERR)
@@ -676,13 +681,16 @@ EXT_DECL TRDP_ERR_T tlp_publish (
             /*    Compute the header fields */
             trdp_pdInit(pNewElement, msgType, etbTopoCnt, opTrnTopoCnt, 0u, 0u, serviceId);
 
-#ifdef HIGH_PERF_INDEXED
-            /*    Keep queue sorted    */
-            trdp_queueInsThroughputAccending(&appHandle->pSndQueue, pNewElement);
-#else
-            /*    Insert at front    */
-            trdp_queueInsFirst(&appHandle->pSndQueue, pNewElement);
-#endif
+            if (appHandle->pSlot != NULL)
+            {
+                /*    Keep queue sorted    */
+                trdp_queueInsThroughputAccending(&appHandle->pSndQueue, pNewElement);
+            }
+            else
+            {
+                /*    Insert at front    */
+                trdp_queueInsFirst(&appHandle->pSndQueue, pNewElement);
+            }
 
             *pPubHandle = (TRDP_PUB_T) pNewElement;
 
@@ -699,12 +707,15 @@ EXT_DECL TRDP_ERR_T tlp_publish (
                 {
                     ret = tlp_put(appHandle, *pPubHandle, pData, dataSize);
                 }
-#ifndef HIGH_PERF_INDEXED
-                if ((ret == TRDP_NO_ERR) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING))
+                if ((ret == TRDP_NO_ERR) && (appHandle->pSlot != NULL))
+                {
+                    /* No need for tlc_updateSession(), if the index tables exist already */
+                    ret = trdp_indexAddPub(appHandle, pNewElement);
+                }
+                else if ((ret == TRDP_NO_ERR) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING))
                 {
                     ret = trdp_pdDistribute(appHandle->pSndQueue);
                 }
-#endif
             }
         }
 
@@ -835,16 +846,16 @@ EXT_DECL TRDP_ERR_T  tlp_unpublish (
         vos_memFree(pElement->pFrame);
         vos_memFree(pElement);
 
-#ifndef HIGH_PERF_INDEXED
-        /* Re-compute distribution times */
-        if (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING)
+        if (appHandle->pSlot != NULL)
+        {
+            /* We must check if this publisher is listed in our indexed arrays */
+            trdp_indexRemovePub(appHandle, pElement);
+        }
+        else if (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING)
         {
+            /* Re-compute distribution times */
             ret = trdp_pdDistribute(appHandle->pSndQueue);
         }
-#else
-        /* We must check if this publisher is listed in our indexed arrays */
-        trdp_indexRemovePub(appHandle, pElement);
-#endif
 
         if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
         {
@@ -1296,9 +1307,9 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
     {
         timeout = appHandle->pdDefault.timeout;
     }
-    else if (timeout < TRDP_TIMER_GRANULARITY)
+    else if (timeout < ((appHandle->pSlot != NULL) ? TRDP_TIMER_GRANULARITY_INDEXED : TRDP_TIMER_GRANULARITY))
     {
-        timeout = TRDP_TIMER_GRANULARITY;
+        timeout = (appHandle->pSlot != NULL) ? TRDP_TIMER_GRANULARITY_INDEXED : TRDP_TIMER_GRANULARITY;
     }
 
     /*    Reserve mutual access    */
@@ -1493,20 +1504,11 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
         }
         trdp_releaseSocket(appHandle->ifacePD, pElement->socketIdx, 0u, FALSE, mcGroup);
         pElement->magic = 0u;
-        if (pElement->pFrame != NULL)
-        {
-            vos_memFree(pElement->pFrame);
-        }
-        if (pElement->pSeqCntList != NULL)
-        {
-            vos_memFree(pElement->pSeqCntList);
-        }
-        vos_memFree(pElement);
 
-#ifdef HIGH_PERF_INDEXED
-        /* We must check if this publisher is listed in our indexed arrays */
+        /* We must check if this subscriber is listed in our indexed arrays */
         trdp_indexRemoveSub(appHandle, pElement);
-#endif
+        /*    Freed now or after its last queued callback was dispatched    */
+        trdp_pdReleaseElement(pElement);
 
         ret = TRDP_NO_ERR;
         if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
@@ -1753,6 +1755,143 @@ EXT_DECL TRDP_ERR_T tlp_get (
     return ret;
 }
 
+/**********************************************************************************************************************/
+/** Select how PD callbacks are executed.
+ *  By default the callbacks of subscriptions are called from within tlp_processReceive() (or tlp_get()), while the
+ *  receive queue is locked. With dispatch workers, received telegrams are queued together with their
+ *  TRDP_PD_INFO_T and the callbacks are executed by a pool of worker threads. Callbacks of the same comId are
+ *  executed in the order of reception, never concurrently. If a queue is full, the callback is dropped and counted.
+ *  Callbacks still queued when the dispatch is stopped are discarded, callbacks queued for a subscription are not
+ *  executed anymore after it has been unsubscribed.
+ *  Must not be called from within a PD callback.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      noOfWorkers         number of worker threads, 0 = call back from the receiving thread (default)
+ *  @param[in]      queueDepth          max. number of queued callbacks per comId shard (up to 64), 0 = default (16)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_STATE_ERR      called from within a dispatched callback
+ *  @retval         TRDP_MUTEX_ERR      running dispatch could not be stopped
+ *  @retval         TRDP_MEM_ERR        not enough memory for the queues
+ *  @retval         TRDP_THREAD_ERR     worker threads could not be created
+ */
+EXT_DECL TRDP_ERR_T tlp_setCallbackDispatch (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              noOfWorkers,
+    UINT32              queueDepth)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if ((noOfWorkers > TRDP_DISPATCH_MAX_WORKERS) || (queueDepth > TRDP_DISPATCH_MAX_DEPTH))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (trdp_pdDispatchIsWorker(appHandle))
+    {
+        return TRDP_STATE_ERR;
+    }
+
+    if (trdp_pdDispatchStop(appHandle) != TRDP_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+
+    if (noOfWorkers == 0u)
+    {
+        return TRDP_NO_ERR;
+    }
+    return trdp_pdDispatchStart(appHandle, noOfWorkers, queueDepth);
+}
+
+/**********************************************************************************************************************/
+/** Return the callback dispatch statistics of a subscription.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[out]     pStatistics         Pointer to the dispatch statistics of the subscription
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ */
+EXT_DECL TRDP_ERR_T tlp_getDispatchStatistics (
+    TRDP_APP_SESSION_T              appHandle,
+    TRDP_SUB_T                      subHandle,
+    TRDP_PD_DISPATCH_STATISTICS_T   *pStatistics)
+{
+    PD_ELE_T *pElement = (PD_ELE_T *) subHandle;
+
+    if ((pElement == NULL) || (pStatistics == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    *pStatistics        = pElement->dispatchStats;
+    pStatistics->queued = VOS_ATOMIC_LOAD(&pElement->dispatchRef) & TRDP_DISPATCH_REF_MASK;
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return the burst profile of the transmitter index tables (indexed scheduler).
+ *  Bytes on the wire and packets per time slot of each category and the peaks per transmit cycle show how evenly
+ *  the publishers are distributed.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pProfile            Pointer to the burst profile
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_STATE_ERR      no index tables (not yet created by tlc_updateSession or send queue session)
+ */
+EXT_DECL TRDP_ERR_T tlp_getBurstProfile (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_BURST_PROFILE_T    *pProfile)
+{
+    TRDP_ERR_T ret;
+
+    if (pProfile == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    ret = trdp_indexBurstProfile(appHandle, pProfile);
+    if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return ret;
+
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,17 @@
  /*
  * $Id$
  *
+ *      BL 2026-10-18: TCP messages are sent as separate header and payload buffers by one gather call, also alone
+ *      BL 2026-10-18: Lent MD packet buffers are looked up in a list per session instead of marks in their header
+ *      BL 2026-10-18: One message in flight per TCP connection, a connection is closed if its message is abandoned
+ *      BL 2026-10-18: Trace points for receive, send, state changes, timeouts and callbacks
+ *      BL 2026-10-18: Fast session ID generator (random prefix and counter) selectable by mdDefault.sessionIdGen
+ *      BL 2026-10-18: trdp_mdNotifyBatch() builds a batch of notifications in an arena and sends them at once
+ *      BL 2026-10-18: Size-classed MD receive buffer pool, datagram size probed by vos_sockPeekUDP()
+ *      BL 2026-10-18: MD packet buffers lent to the application are sent without copying the payload
+ *      BL 2026-10-18: TCP connection pool: caller sessions share a connection per peer, peers connected in advance
+ *      BL 2026-10-18: TCP receive buffer per connection parsing pipelined messages, gather send of queued TCP messages
+ *      BL 2026-10-18: MD session timeouts kept on a timer heap, trdp_mdCheckTimeouts() only visits elapsed sessions
  *      SB 2021-08.09: Compiler warning
  *      SB 2021-08-05: Ticket #281 TRDP_NOSESSION_ERR should be returned from tlm_reply() and tlm_replyQuery() in case of incorrect session (id)
  *     AHW 2021-05-06: Ticket #322 Subscriber multicast message routing in multi-home device
@@ -74,12 +85,16 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_MD
+
+#include <stddef.h>
 #include <string.h>
 
 #include "trdp_if_light.h"
 #include "tlc_if.h"
 #include "trdp_utils.h"
 #include "trdp_mdcom.h"
+#include "trdp_trace.h"
 
 
 /***********************************************************************************************************************
@@ -97,7 +112,10 @@
  *   Locals
  */
 
-static const UINT32 cMinimumMDSize = 1480u;                            /**< Initial size for message data received */
+static const UINT32 cMdRcvPoolSize[TRDP_MD_RCV_POOL_CLASSES] =         /**< Packet sizes of the receive pool classes */
+{
+    1480u, 8192u, 32768u, (UINT32) TRDP_MAX_MD_PACKET_SIZE
+};
 static const UINT8  cEmptySession[TRDP_SESS_ID_SIZE];                  /**< Empty sessionID to compare             */
 static const TRDP_MD_INFO_T cTrdp_md_info_default;
 
@@ -107,10 +125,14 @@ static const TRDP_MD_INFO_T cTrdp_md_info_default;
 static void         trdp_mdUpdatePacket (MD_ELE_T *pElement);
 static void         trdp_mdFillStateElement (const TRDP_MSG_T   msgType,
                                              MD_ELE_T           *pMdElement);
-static void         trdp_mdManageSessionId (TRDP_UUID_T pSessionId,
-                                            MD_ELE_T    *pMdElement);
-
-static TRDP_ERR_T   trdp_mdLookupElement (MD_ELE_T                  *pinitialMdElement,
+static UINT64       trdp_mdMix64 (UINT64 value);
+static void         trdp_mdNewSessionId (TRDP_SESSION_PT    appHandle,
+                                         VOS_UUID_T         uuid);
+static void         trdp_mdManageSessionId (TRDP_SESSION_PT appHandle,
+                                            TRDP_UUID_T     pSessionId,
+                                            MD_ELE_T        *pMdElement);
+
+static TRDP_ERR_T   trdp_mdLookupElement (MD_ELE_T                  * const *ppSessionTable,
                                           const TRDP_MD_ELE_ST_T    elementState,
                                           const TRDP_UUID_T         pSessionId,
                                           MD_ELE_T                  * *pretrievedMdElement);
@@ -124,6 +146,14 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T          *pElement,
 static MD_ELE_T     *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T  appHandle,
                                                 MD_HEADER_T         *pMdItemHeader);
 
+static UINT32       trdp_mdListenerURIHash (const CHAR8 *pURI);
+static BOOL8        trdp_mdListenerMatches (TRDP_SESSION_PT     appHandle,
+                                            const MD_LIS_ELE_T  *pListener,
+                                            BOOL8               isTCP,
+                                            const MD_HEADER_T   *pH);
+static MD_LIS_ELE_T *trdp_mdFindListener (TRDP_SESSION_PT   appHandle,
+                                          BOOL8             isTCP,
+                                          const MD_HEADER_T *pH);
 static TRDP_ERR_T   trdp_mdHandleRequest (TRDP_SESSION_PT   appHandle,
                                           BOOL8             isTCP,
                                           UINT32            sockIndex,
@@ -131,11 +161,22 @@ static TRDP_ERR_T   trdp_mdHandleRequest (TRDP_SESSION_PT   appHandle,
                                           TRDP_MD_ELE_ST_T  state,
                                           MD_ELE_T          * *pIterMD);
 
+static void trdp_mdAbandonSend (TRDP_SESSION_PT appHandle,
+                                MD_ELE_T        *pElement);
 static void trdp_mdCloseSessions (TRDP_SESSION_PT   appHandle,
                                   INT32             socketIndex,
                                   SOCKET            newSocket,
                                   BOOL8             checkAllSockets);
 static void trdp_mdSetSessionTimeout (MD_ELE_T *pMDSession);
+static void trdp_mdTimerSwap (TRDP_SESSION_PT   appHandle,
+                              UINT32            idxA,
+                              UINT32            idxB);
+static void trdp_mdTimerSift (TRDP_SESSION_PT   appHandle,
+                              UINT32            idx);
+static void trdp_mdTimerArm (TRDP_SESSION_PT    appHandle,
+                             MD_ELE_T           *pElement);
+static void trdp_mdTimerDisarm (TRDP_SESSION_PT appHandle,
+                                MD_ELE_T        *pElement);
 static TRDP_ERR_T   trdp_mdCheck (TRDP_SESSION_PT   appHandle,
                                   MD_HEADER_T       *pPacket,
                                   UINT32            packetSize,
@@ -143,6 +184,21 @@ static TRDP_ERR_T   trdp_mdCheck (TRDP_SESSION_PT   appHandle,
 static TRDP_ERR_T   trdp_mdSendPacket (SOCKET   mdSock,
                                        UINT16   port,
                                        MD_ELE_T *pElement);
+static UINT32       trdp_mdTCPIov (const MD_ELE_T   *pElement,
+                                   VOS_IOVEC_T      *pIov);
+static void         trdp_mdSendTCPBatch (TRDP_SESSION_PT    appHandle,
+                                         INT32              sockIndex);
+static TRDP_ERR_T   trdp_mdTCPRxNext (TRDP_SESSION_PT       appHandle,
+                                      const TRDP_TCP_RX_T   *pRx,
+                                      UINT32                *pMsgSize);
+static BOOL8        trdp_mdTCPRxPending (TRDP_SESSION_PT    appHandle,
+                                         UINT32             sockIndex);
+static TRDP_ERR_T   trdp_mdRcvBufGet (TRDP_SESSION_PT   appHandle,
+                                      MD_ELE_T          *pElement,
+                                      UINT32            packetSize);
+static void         trdp_mdReleasePacket (TRDP_SESSION_PT   appHandle,
+                                          MD_ELE_T          *pElement);
+
 static TRDP_ERR_T   trdp_mdRecvTCPPacket (TRDP_SESSION_PT   appHandle,
                                           SOCKET            mdSock,
                                           MD_ELE_T          *pElement);
@@ -171,12 +227,23 @@ static TRDP_ERR_T   trdp_mdSendME (TRDP_SESSION_PT  appHandle,
                                    MD_HEADER_T      *pH,
                                    INT32            replyStatus);
 
+static BOOL8        trdp_mdTCPPoolKeepOpen (TRDP_SESSION_PT appHandle,
+                                            INT32           sockIndex);
+static UINT32       trdp_mdTCPPoolKeepAlive (TRDP_SESSION_PT appHandle);
+static INT32        trdp_mdTCPPoolGet (TRDP_SESSION_PT          appHandle,
+                                       const TRDP_SEND_PARAM_T  *pSendParam,
+                                       TRDP_IP_ADDR_T           srcIpAddr,
+                                       TRDP_IP_ADDR_T           destIpAddr);
 static TRDP_ERR_T   trdp_mdConnectSocket (TRDP_APP_SESSION_T        appHandle,
                                           const TRDP_SEND_PARAM_T   *pSendParam,
                                           TRDP_IP_ADDR_T            srcIpAddr,
                                           TRDP_IP_ADDR_T            destIpAddr,
                                           BOOL8                     newSession,
                                           MD_ELE_T                  *pSenderElement);
+static void         trdp_mdNotifyResult (TRDP_ERR_T *pResults,
+                                         UINT32     itemIdx,
+                                         TRDP_ERR_T result,
+                                         TRDP_ERR_T *pFirstErr);
 
 /**********************************************************************************************************************/
 /** Set the statEle property to next state
@@ -215,20 +282,85 @@ static void trdp_mdFillStateElement (const TRDP_MSG_T msgType, MD_ELE_T *pMdElem
            pMdElement->stateEle = TRDP_ST_TX_NOTIFY_ARM;
            break;
     }
+    TRDP_TRACE_ELEMENT(MD_STATE, pMdElement, pMdElement->stateEle);
+}
+
+
+/**********************************************************************************************************************/
+/** Scramble a 64 bit value (finalizer of splitmix64)
+ *
+ *  @param[in]      value               value to scramble
+ *
+ *  @retval         scrambled value
+ */
+static UINT64 trdp_mdMix64 (UINT64 value)
+{
+    value   = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9ull;
+    value   = (value ^ (value >> 27u)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31u);
 }
 
+/**********************************************************************************************************************/
+/** Create a new session ID
+ *  The fast generator draws a random 64 bit prefix once per application session, seeded by a UUID and the time, and
+ *  appends a counter. The result is formatted as RFC 4122 version 4 UUID and needs no system call.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[out]     uuid                new session ID
+ */
+static void trdp_mdNewSessionId (TRDP_SESSION_PT appHandle, VOS_UUID_T uuid)
+{
+    UINT64  count;
+    UINT32  i;
+
+    if (appHandle->mdDefault.sessionIdGen != TRDP_MD_SESSION_ID_FAST)
+    {
+        vos_getUuid(uuid);
+        return;
+    }
+
+    if (appHandle->mdSessionIdPrefix == 0u)
+    {
+        VOS_TIMEVAL_T   now;
+        UINT64          seed = 0u;
+
+        vos_getUuid(uuid);
+        vos_getTime(&now);
+        for (i = 0u; i < TRDP_SESS_ID_SIZE; i++)
+        {
+            seed = (seed << 8u) ^ (seed >> 56u) ^ uuid[i];
+        }
+        seed ^= ((UINT64) now.tv_sec << 20u) ^ (UINT64) now.tv_usec;
+        appHandle->mdSessionIdPrefix    = trdp_mdMix64(seed);
+        appHandle->mdSessionIdCount     = trdp_mdMix64(appHandle->mdSessionIdPrefix);
+        if (appHandle->mdSessionIdPrefix == 0u)
+        {
+            appHandle->mdSessionIdPrefix = 1u;
+        }
+    }
+
+    count = appHandle->mdSessionIdCount++;
+    for (i = 0u; i < 8u; i++)
+    {
+        uuid[i]         = (UINT8) (appHandle->mdSessionIdPrefix >> (56u - 8u * i));
+        uuid[8u + i]    = (UINT8) (count >> (56u - 8u * i));
+    }
+    uuid[6] = (uuid[6] & 0x0Fu) | 0x40u;    /* version 4 (random) */
+    uuid[8] = (uuid[8] & 0x3Fu) | 0x80u;    /* RFC 4122 variant */
+}
 
 /**********************************************************************************************************************/
 /** Create session ID for a given MD_ELE_T
  *  This function will create a new UUID if the given MD_ELE_T contains
  *  an empty session ID.
  *
+ *  @param[in]      appHandle           session pointer
  *  @param[in]      pSessionId          Type of MD message
  *  @param[out]     pMdElement          MD element taken from queue or newly allocated
  *
  *  @retval         none
  */
-static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement)
+static void trdp_mdManageSessionId (TRDP_SESSION_PT appHandle, TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement)
 {
     if (memcmp(pMdElement->sessionID, cEmptySession, TRDP_SESS_ID_SIZE) != 0)
     {
@@ -243,7 +375,7 @@ static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement
     {
         /* create session ID */
         VOS_UUID_T uuid;
-        vos_getUuid(uuid);
+        trdp_mdNewSessionId(appHandle, uuid);
 
         /* return session id to caller if required */
         if (NULL != pSessionId)
@@ -263,9 +395,9 @@ static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement
 
 /**********************************************************************************************************************/
 /** Look up an element identified by its elementState and pSessionId
- *  within a list starting with pinitialMdElement.*
+ *  within the session index of the send or receive queue.
  *
- *  @param[in]      pinitialMdElement   start element within a list of element
+ *  @param[in]      ppSessionTable      session index (pMDSndSessions or pMDRcvSessions)
  *  @param[in]      elementState        element state to look for
  *  @param[in]      pSessionId          element session to look for
  *  @param[out]     pretrievedMdElement pointer to looked up element
@@ -273,19 +405,17 @@ static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement
  *  @retval         TRDP_NO_ERR           no error
  *  @retval         TRDP_NOSESSION_ERR    no match found error
  */
-static TRDP_ERR_T trdp_mdLookupElement (MD_ELE_T                *pinitialMdElement,
+static TRDP_ERR_T trdp_mdLookupElement (MD_ELE_T                * const *ppSessionTable,
                                         const TRDP_MD_ELE_ST_T  elementState,
                                         const TRDP_UUID_T       pSessionId,
                                         MD_ELE_T                * *pretrievedMdElement)
 {
     TRDP_ERR_T errv = TRDP_NOSESSION_ERR; /* init error code indicating no matching MD_ELE_T in list */ /* Ticket #281 */
-    if ((pinitialMdElement != NULL)
-        &&
-        (pSessionId != NULL))
+    if (pSessionId != NULL)
     {
         MD_ELE_T *iterMD;
-        /* start iteration through receive or send list */
-        for (iterMD = pinitialMdElement; iterMD != NULL; iterMD = iterMD->pNext)
+        /* iterate through the elements sharing the bucket of this session ID */
+        for (iterMD = trdp_mdSessionBucket(ppSessionTable, pSessionId); iterMD != NULL; iterMD = iterMD->pNextSession)
         {
             if ((elementState == iterMD->stateEle)
                 &&
@@ -379,12 +509,14 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
         theMessage.etbTopoCnt   = vos_ntohl(pMdItem->pPacket->frameHead.etbTopoCnt);
         theMessage.opTrnTopoCnt = vos_ntohl(pMdItem->pPacket->frameHead.opTrnTopoCnt);
         theMessage.srcIpAddr    = pMdItem->addr.srcIpAddr;
+        TRDP_TRACE_ELEMENT(MD_CB_ENTRY, pMdItem, resultCode);
         pMdItem->pfCbFunction(
             appHandle->mdDefault.pRefCon,
             appHandle,
             &theMessage,
             (UINT8 *)(pMdItem->pPacket->data),
             vos_ntohl(pMdItem->pPacket->frameHead.datasetLength));
+        TRDP_TRACE_ELEMENT(MD_CB_EXIT, pMdItem, 0);
     }
     else
     {
@@ -393,12 +525,14 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
         theMessage.opTrnTopoCnt = pMdItem->addr.opTrnTopoCnt;
         theMessage.srcIpAddr    = 0u;
         /*in case of any detected turbulence return a zero buffer*/
+        TRDP_TRACE_ELEMENT(MD_CB_ENTRY, pMdItem, resultCode);
         pMdItem->pfCbFunction(
             appHandle->mdDefault.pRefCon,
             appHandle,
             &theMessage,
             (UINT8 *)NULL,
             0u);
+        TRDP_TRACE_ELEMENT(MD_CB_EXIT, pMdItem, 0);
     }
 }
 
@@ -471,6 +605,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                        /* this MD_ELE_T item to TRDP_ST_TX_REQUEST_ARM, for ref- */
                        /* erence check the trdp_mdSend function                  */
                        pElement->stateEle = TRDP_ST_TX_REQUEST_ARM;
+                       TRDP_TRACE_ELEMENT(MD_STATE, pElement, pElement->stateEle);
                        /* Increment the retry counter */
                        pElement->numRetries++;
                        /* Increment sequence counter in network order of course */
@@ -479,6 +614,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                        /* Store new sequence counter within the management info */
                        /* Set new time out value */
                        vos_addTime(&pElement->timeToGo, &pElement->interval);
+                       trdp_mdTimerArm(appHandle, pElement);
                        /* update the frame header CRC also */
                        trdp_mdUpdatePacket(pElement);
                        /* ready to proceed - will be handled by trdp_mdSend run- */
@@ -584,7 +720,7 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
     if ((vos_ntohs(pMdItemHeader->msgType) == TRDP_MSG_MC)
         )
     {
-        startElement = appHandle->pMDRcvQueue;
+        startElement = trdp_mdSessionBucket(appHandle->pMDRcvSessions, pMdItemHeader->sessionID);
     }
     else
     {
@@ -594,15 +730,15 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
             ||
             (vos_ntohs(pMdItemHeader->msgType) == TRDP_MSG_ME))
         {
-            startElement = appHandle->pMDSndQueue;
+            startElement = trdp_mdSessionBucket(appHandle->pMDSndSessions, pMdItemHeader->sessionID);
         }
         /* having no else here will render the startElement to be NULL  */
         /* this will sufficiently skip the for loop below, getting NULL */
         /* as function return value - which also will get correctly     */
         /* handled by trdp_mdRecv                                       */
     }
-    /* iterate through the receive queue */
-    for (iterMD = startElement; iterMD != NULL; iterMD = iterMD->pNext)
+    /* iterate through the elements of the queue sharing the bucket of this session ID */
+    for (iterMD = startElement; iterMD != NULL; iterMD = iterMD->pNextSession)
     {
         /* accept only local communication or matching topo counters */
         if (((pMdItemHeader->etbTopoCnt != 0u) || (pMdItemHeader->opTrnTopoCnt != 0u))
@@ -615,19 +751,18 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
             continue;
         }
         /* try to get a session match - topo counts must have matched at this point, if applicable */
-        if (0 == memcmp(iterMD->pPacket->frameHead.sessionID, pMdItemHeader->sessionID, TRDP_SESS_ID_SIZE))
+        if (0 == memcmp(iterMD->sessionID, pMdItemHeader->sessionID, TRDP_SESS_ID_SIZE))
         {
             /* throw away old packet data  */
-            if (NULL != iterMD->pPacket)
-            {
-                vos_memFree(iterMD->pPacket);
-            }
+            trdp_mdReleasePacket(appHandle, iterMD);
             /* and get the newly received data  */
             iterMD->pPacket     = appHandle->pMDRcvEle->pPacket;
+            iterMD->poolClass   = appHandle->pMDRcvEle->poolClass;
             iterMD->dataSize    = vos_ntohl(pMdItemHeader->datasetLength);
             iterMD->grossSize   = appHandle->pMDRcvEle->grossSize;
 
-            appHandle->pMDRcvEle->pPacket = NULL;
+            appHandle->pMDRcvEle->pPacket   = NULL;
+            appHandle->pMDRcvEle->poolClass = 0u;
 
             /* Table A.26 states that the comID for an Me message is zero. This     */
             /* induces the need to lookup the caller comID by using the received    */
@@ -647,6 +782,7 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
                 /* set element state and indicate that the item has to be removed */
                 iterMD->stateEle    = TRDP_ST_RX_CONF_RECEIVED;
                 iterMD->morituri    = TRUE;
+                TRDP_TRACE_ELEMENT(MD_STATE, iterMD, iterMD->stateEle);
                 vos_printLogStr(VOS_LOG_INFO, "Received Confirmation, session will be closed!\n");
                 break; /* exit for loop */
             }
@@ -664,6 +800,7 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
                     iterMD->numRepliesQuery++;
 
                     iterMD->stateEle = TRDP_ST_TX_REQ_W4AP_CONFIRM;
+                    TRDP_TRACE_ELEMENT(MD_STATE, iterMD, iterMD->stateEle);
 
                     /* receive time */
                     vos_getTime(&iterMD->timeToGo);
@@ -672,6 +809,7 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
                     iterMD->interval.tv_sec     = vos_ntohl(pMdItemHeader->replyTimeout) / 1000000u;
                     iterMD->interval.tv_usec    = vos_ntohl(pMdItemHeader->replyTimeout) % 1000000;
                     vos_addTime(&iterMD->timeToGo, &iterMD->interval);
+                    trdp_mdTimerArm(appHandle, iterMD);
                     break; /* exit for loop */
 
                 }
@@ -681,6 +819,7 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
                 {
                     /* dedicated MP handling */
                     iterMD->stateEle = TRDP_ST_TX_REPLY_RECEIVED;
+                    TRDP_TRACE_ELEMENT(MD_STATE, iterMD, iterMD->stateEle);
                     iterMD->numReplies++;
                     /* Handle multiple replies
                      Close session now if number of expected replies reached and confirmed as far as requested
@@ -709,6 +848,26 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
 }
 
 
+/**********************************************************************************************************************/
+/** Close the TCP connection of a session freed while its message is written in part
+ *  The rest of the message is never sent, the peer would take the next message on the connection for its tail.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        session to be freed
+ */
+static void trdp_mdAbandonSend (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    if ((pElement->tcpParameters.msgUncomplete == TRUE)
+        && (pElement->socketIdx != TRDP_INVALID_SOCKET_INDEX))
+    {
+        vos_printLog(VOS_LOG_WARNING, "Closing TCP connection, message sent in part (Socket: %d)\n",
+                     (int) appHandle->ifaceMD[pElement->socketIdx].sock);
+        appHandle->ifaceMD[pElement->socketIdx].tcpParams.morituri = TRUE;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Close and free any session marked as dead.
  *
@@ -738,15 +897,18 @@ static void trdp_mdCloseSessions (
     {
         if (TRUE == iterMD->morituri)
         {
-            trdp_releaseSocket(appHandle->ifaceMD, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
+            trdp_mdAbandonSend(appHandle, iterMD);
+            trdp_releaseSocket(appHandle->ifaceMD, iterMD->socketIdx, trdp_mdTCPPoolKeepAlive(appHandle),
                                FALSE, VOS_INADDR_ANY);
             trdp_MDqueueDelElement(&appHandle->pMDSndQueue, iterMD);
+            trdp_mdSessionRemove(appHandle->pMDSndSessions, iterMD);
+            trdp_mdTimerDisarm(appHandle, iterMD);
             vos_printLog(VOS_LOG_INFO, "Freeing %s MD caller session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
                          iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
                          iterMD->sessionID[0], iterMD->sessionID[1], iterMD->sessionID[2], iterMD->sessionID[3],
                          iterMD->sessionID[4], iterMD->sessionID[5], iterMD->sessionID[6], iterMD->sessionID[7])
 
-            trdp_mdFreeSession(iterMD);
+            trdp_mdFreeSession(appHandle, iterMD);
             iterMD = appHandle->pMDSndQueue;
         }
         else
@@ -763,15 +925,20 @@ static void trdp_mdCloseSessions (
         {
             if (0 != (iterMD->pktFlags & TRDP_FLAGS_TCP))
             {
-                trdp_releaseSocket(appHandle->ifaceMD, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
+                trdp_mdAbandonSend(appHandle, iterMD);
+                trdp_releaseSocket(appHandle->ifaceMD, iterMD->socketIdx, trdp_mdTCPPoolKeepAlive(appHandle),
                                    FALSE, VOS_INADDR_ANY);
             }
             trdp_MDqueueDelElement(&appHandle->pMDRcvQueue, iterMD);
+            trdp_mdSessionRemove(appHandle->pMDRcvSessions, iterMD);
+            trdp_mdTimerDisarm(appHandle, iterMD);
+            appHandle->numMDRcvSessions--;
+
             vos_printLog(VOS_LOG_INFO, "Freeing MD %s replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
                          iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
                          iterMD->sessionID[0], iterMD->sessionID[1], iterMD->sessionID[2], iterMD->sessionID[3],
                          iterMD->sessionID[4], iterMD->sessionID[5], iterMD->sessionID[6], iterMD->sessionID[7])
-            trdp_mdFreeSession(iterMD);
+            trdp_mdFreeSession(appHandle, iterMD);
             iterMD = appHandle->pMDRcvQueue;
         }
         else
@@ -795,9 +962,17 @@ static void trdp_mdCloseSessions (
         appHandle->ifaceMD[socketIndex].usage                 = 0;
         appHandle->ifaceMD[socketIndex].tcpParams.sendNotOk   = FALSE;
         appHandle->ifaceMD[socketIndex].tcpParams.addFileDesc = TRUE;
+        appHandle->ifaceMD[socketIndex].tcpParams.connected   = TRUE;
         appHandle->ifaceMD[socketIndex].tcpParams.connectionTimeout.tv_sec    = 0u;
         appHandle->ifaceMD[socketIndex].tcpParams.connectionTimeout.tv_usec   = 0;
+        if (appHandle->ifaceMD[socketIndex].tcpParams.pRx != NULL)
+        {
+            /* Data left from the old connection is void */
+            appHandle->ifaceMD[socketIndex].tcpParams.pRx->head = 0u;
+            appHandle->ifaceMD[socketIndex].tcpParams.pRx->tail = 0u;
+        }
     }
+
 }
 
 
@@ -830,6 +1005,147 @@ static void trdp_mdSetSessionTimeout (
     }
 }
 
+/**********************************************************************************************************************/
+/** Exchange two entries of the MD timer heap
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      idxA                heap index
+ *  @param[in]      idxB                heap index
+ */
+static void trdp_mdTimerSwap (
+    TRDP_SESSION_PT appHandle,
+    UINT32          idxA,
+    UINT32          idxB)
+{
+    MD_ELE_T *pTemp = appHandle->ppMDTimers[idxA];
+
+    appHandle->ppMDTimers[idxA] = appHandle->ppMDTimers[idxB];
+    appHandle->ppMDTimers[idxB] = pTemp;
+    appHandle->ppMDTimers[idxA]->timerIdx   = idxA + 1u;
+    appHandle->ppMDTimers[idxB]->timerIdx   = idxB + 1u;
+}
+
+/**********************************************************************************************************************/
+/** Restore the heap order for an entry whose timeToGo has changed
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      idx                 heap index of the changed entry
+ */
+static void trdp_mdTimerSift (
+    TRDP_SESSION_PT appHandle,
+    UINT32          idx)
+{
+    MD_ELE_T * *ppHeap = appHandle->ppMDTimers;
+
+    /* move up while earlier than the parent */
+    while ((idx > 0u) &&
+           (0 > vos_cmpTime(&ppHeap[idx]->timeToGo, &ppHeap[(idx - 1u) / 2u]->timeToGo)))
+    {
+        trdp_mdTimerSwap(appHandle, idx, (idx - 1u) / 2u);
+        idx = (idx - 1u) / 2u;
+    }
+
+    /* move down while later than one of the children */
+    for (;; )
+    {
+        UINT32  child       = 2u * idx + 1u;
+        UINT32  earliest    = idx;
+
+        if ((child < appHandle->numMDTimers) &&
+            (0 > vos_cmpTime(&ppHeap[child]->timeToGo, &ppHeap[earliest]->timeToGo)))
+        {
+            earliest = child;
+        }
+        child++;
+        if ((child < appHandle->numMDTimers) &&
+            (0 > vos_cmpTime(&ppHeap[child]->timeToGo, &ppHeap[earliest]->timeToGo)))
+        {
+            earliest = child;
+        }
+        if (earliest == idx)
+        {
+            break;
+        }
+        trdp_mdTimerSwap(appHandle, idx, earliest);
+        idx = earliest;
+    }
+}
+
+/**********************************************************************************************************************/
+/** (Re-)arm the timeout of a session
+ *  Must be called whenever timeToGo or interval of a queued session has been changed.
+ *  Sessions with infinite timeout are not kept on the timer heap.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            session to arm
+ */
+static void trdp_mdTimerArm (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    if ((pElement->interval.tv_sec == TRDP_MD_INFINITE_TIME) &&
+        (pElement->interval.tv_usec == TRDP_MD_INFINITE_USEC_TIME))
+    {
+        trdp_mdTimerDisarm(appHandle, pElement);
+        return;
+    }
+
+    if (pElement->timerIdx == 0u)
+    {
+        if (appHandle->numMDTimers >= appHandle->maxMDTimers)
+        {
+            UINT32      newSize = (appHandle->maxMDTimers == 0u) ? 64u : 2u * appHandle->maxMDTimers;
+            MD_ELE_T    * *ppNew = (MD_ELE_T * *) vos_memAlloc(newSize * sizeof(MD_ELE_T *));
+
+            if (ppNew == NULL)
+            {
+                vos_printLog(VOS_LOG_ERROR, "MD timer heap: out of memory (%u sessions)\n",
+                             (unsigned int) appHandle->numMDTimers);
+                return;
+            }
+            if (appHandle->ppMDTimers != NULL)
+            {
+                memcpy(ppNew, appHandle->ppMDTimers, appHandle->numMDTimers * sizeof(MD_ELE_T *));
+                vos_memFree(appHandle->ppMDTimers);
+            }
+            appHandle->ppMDTimers   = ppNew;
+            appHandle->maxMDTimers  = newSize;
+        }
+        appHandle->ppMDTimers[appHandle->numMDTimers] = pElement;
+        pElement->timerIdx = ++appHandle->numMDTimers;
+    }
+    trdp_mdTimerSift(appHandle, pElement->timerIdx - 1u);
+}
+
+/**********************************************************************************************************************/
+/** Remove a session from the timer heap
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            session to disarm
+ */
+static void trdp_mdTimerDisarm (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    UINT32 idx = pElement->timerIdx;
+
+    if (idx == 0u)
+    {
+        return;
+    }
+    pElement->timerIdx = 0u;
+    appHandle->numMDTimers--;
+    idx--;
+    if (idx < appHandle->numMDTimers)
+    {
+        /* fill the gap with the last entry */
+        appHandle->ppMDTimers[idx] = appHandle->ppMDTimers[appHandle->numMDTimers];
+        appHandle->ppMDTimers[idx]->timerIdx = idx + 1u;
+        trdp_mdTimerSift(appHandle, idx);
+    }
+}
+
+
 /**********************************************************************************************************************/
 /** Check for incoming md packet
  *
@@ -995,12 +1311,21 @@ static TRDP_ERR_T  trdp_mdSendPacket (SOCKET    mdSock,
 
     if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)
     {
-        tmpSndSize = pElement->sendSize;
+        /* Resume behind the bytes already sent (partial send or trdp_mdSendTCPBatch()) */
+        if (pElement->sendSize < pElement->grossSize)
+        {
+            VOS_IOVEC_T iov[2u];
+            UINT32      iovCnt = trdp_mdTCPIov(pElement, iov);
 
-        pElement->sendSize = pElement->grossSize - tmpSndSize;
+            err = vos_sockSendTCPv(mdSock, iov, iovCnt, &tmpSndSize);
+            pElement->sendSize += tmpSndSize;
 
-        err = vos_sockSendTCP(mdSock, ((UINT8 *)&pElement->pPacket->frameHead) + tmpSndSize, &pElement->sendSize);
-        pElement->sendSize = tmpSndSize + pElement->sendSize;
+            if (err == VOS_BLOCK_ERR)
+            {
+                /* Socket buffer full, the rest is sent later on */
+                err = VOS_NO_ERR;
+            }
+        }
     }
     else
     {
@@ -1044,307 +1369,381 @@ static TRDP_ERR_T  trdp_mdSendPacket (SOCKET    mdSock,
 
 
 /**********************************************************************************************************************/
-/** Receive MD packet transmitted via TCP
+/** Describe the unsent part of a TCP message for a gather send
+ *  Header and payload are passed as buffers of their own, the payload straight from where the message holds it
+ *  (a lent buffer or the copy taken by the send call). Bytes already sent (sendSize) are skipped.
  *
- *  @param[in]      appHandle       session pointer
- *  @param[in]      mdSock          socket descriptor
- *  @param[out]     pElement        pointer to received packet
- *  @retval         != TRDP_NO_ERR  error
+ *  @param[in]      pElement        element to be sent
+ *  @param[out]     pIov            two buffers at least
+ *
+ *  @retval         number of buffers filled in (0...2)
  */
-static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock, MD_ELE_T *pElement)
+static UINT32 trdp_mdTCPIov (const MD_ELE_T *pElement,
+                             VOS_IOVEC_T    *pIov)
 {
-    /* TCP receiver */
-    TRDP_ERR_T  err = TRDP_NO_ERR;
-    UINT32      size = 0u;                       /* Size of the all data read until now */
-    UINT32      dataSize        = 0u;            /* The pending data to read */
-    UINT32      socketIndex     = 0u;
-    UINT32      readSize        = 0u;            /* All the data read in this cycle (Header + Data) */
-    UINT32      readDataSize    = 0u;            /* All the data part read in this cycle (Data) */
-    BOOL8       noDataToRead    = FALSE;
-    UINT32      storedDataSize  = 0u;
-
-    /* Initialize to 0 the stored header size*/
-    UINT32      storedHeader = 0;
-
-    /* Initialize to 0 the pElement->dataSize
-     * Once it is known, the message complete data size will be saved*/
-    pElement->dataSize = 0u;
-
-    /* Fill destination address */
-    pElement->addr.destIpAddr = appHandle->realIP;
+    UINT32  iovCnt  = 0u;
+    UINT32  offset  = pElement->sendSize;
 
-    /* Find the socket index */
-    for ( socketIndex = 0u; socketIndex < (UINT32)trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); socketIndex++ )
+    if (offset < sizeof(MD_HEADER_T))
     {
-        if ( appHandle->ifaceMD[socketIndex].sock == mdSock )
-        {
-            break;
-        }
+        pIov[iovCnt].pBuffer    = ((const UINT8 *)&pElement->pPacket->frameHead) + offset;
+        pIov[iovCnt].size       = sizeof(MD_HEADER_T) - offset;
+        iovCnt++;
+        offset = sizeof(MD_HEADER_T);
     }
-
-    if ( socketIndex >= (UINT32)trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP) )
+    if (offset < pElement->grossSize)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecvPacket - Socket index out of range\n");
-        return TRDP_UNKNOWN_ERR;
+        pIov[iovCnt].pBuffer    = pElement->pPacket->data + (offset - sizeof(MD_HEADER_T));
+        pIov[iovCnt].size       = pElement->grossSize - offset;
+        iovCnt++;
     }
+    return iovCnt;
+}
+
+/**********************************************************************************************************************/
+/** Send the pending messages of a TCP connection with one gather call
+ *  Messages armed for sending on the connection are collected in queue order and written by vos_sockSendTCPv(),
+ *  header and payload of each one from where they are held (see trdp_mdTCPIov()). This also applies to a single
+ *  message. The bytes written are accounted in each element's sendSize, the state handling is left to
+ *  trdp_mdSend(), which also resumes a partially sent message.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      sockIndex       index of the TCP connection in ifaceMD[]
+ */
+static void trdp_mdSendTCPBatch (TRDP_SESSION_PT    appHandle,
+                                 INT32              sockIndex)
+{
+    MD_ELE_T    *pBatch[VOS_MAX_IOV_CNT / 2u];
+    VOS_IOVEC_T iov[VOS_MAX_IOV_CNT];
+    MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
+    BOOL8       firstLoop   = TRUE;
+    UINT32      noOfMsg     = 0u;
+    UINT32      iovCnt      = 0u;
+    UINT32      sent        = 0u;
+    UINT32      i;
 
-    /* Read Header */
-    if ((appHandle->uncompletedTCP[socketIndex] == NULL)
-        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
-            && (appHandle->uncompletedTCP[socketIndex]->grossSize < sizeof(MD_HEADER_T))))
+    /* Collect the messages to send, stop at the first one which cannot be sent right now to keep the order */
+    while (noOfMsg < VOS_MAX_IOV_CNT / 2u)
     {
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
+        if (NULL == iterMD && TRUE == firstLoop)
         {
-            readSize = sizeof(MD_HEADER_T);
+            iterMD      = appHandle->pMDRcvQueue;
+            firstLoop   = FALSE;
         }
-        else
+        if (NULL == iterMD)
         {
-            /* If we have read some data before, read the rest */
-            readSize        = sizeof(MD_HEADER_T) - appHandle->uncompletedTCP[socketIndex]->grossSize;
-            storedHeader    = appHandle->uncompletedTCP[socketIndex]->grossSize;
+            break;
         }
-
-        if ( readSize > 0u )
+        if ((iterMD->socketIdx == sockIndex)
+            && ((iterMD->stateEle == TRDP_ST_TX_NOTIFY_ARM)
+                || (iterMD->stateEle == TRDP_ST_TX_REQUEST_ARM)
+                || (iterMD->stateEle == TRDP_ST_TX_REPLY_ARM)
+                || (iterMD->stateEle == TRDP_ST_TX_REPLYQUERY_ARM)
+                || (iterMD->stateEle == TRDP_ST_TX_CONFIRM_ARM))
+            && !(iterMD->privFlags & TRDP_REDUNDANT))
         {
-            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
-                                                  ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
-                                                  &readSize);
-
-            /* Add the read data size to the size read before */
-            size = storedHeader + readSize;
-
-            if ( err == TRDP_NO_ERR
-                 && (appHandle->uncompletedTCP[socketIndex] != NULL)
-                 && (size >= sizeof(MD_HEADER_T))
-                 && appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )     /* BL: Prevent NULL pointer access */
+            if ((iterMD->tcpParameters.doConnect == TRUE)
+                || (iterMD->sendSize != 0u))
             {
-                if ( trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, size, CHECK_HEADER_ONLY) == TRDP_NO_ERR )
-                {
-                    /* Uncompleted Header, completed. Save some parameters in the uncompletedTCP structure */
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength =
-                        pElement->pPacket->frameHead.datasetLength;
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.frameCheckSum =
-                        pElement->pPacket->frameHead.frameCheckSum;
-                }
-                else
-                {
-                    vos_printLogStr(VOS_LOG_INFO, "TCP MD header check failed\n");
-                    return TRDP_NODATA_ERR;
-                }
+                break;
             }
+            trdp_mdUpdatePacket(iterMD);
+            pBatch[noOfMsg] = iterMD;
+            iovCnt += trdp_mdTCPIov(iterMD, &iov[iovCnt]);
+            noOfMsg++;
         }
+        iterMD = iterMD->pNext;
     }
 
-    /* Read Data */
-    if ((size >= sizeof(MD_HEADER_T))
-        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
-            && (appHandle->uncompletedTCP[socketIndex]->grossSize >= sizeof(MD_HEADER_T))))
+    if (noOfMsg == 0u)
     {
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL || appHandle->uncompletedTCP[socketIndex]->pPacket == NULL )
-        {
-            /* Get the rest of the message length */
-            dataSize = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
+        return;
+    }
 
-            readDataSize        = trdp_packetSizeMD(dataSize - sizeof(MD_HEADER_T));
-            pElement->grossSize = trdp_packetSizeMD(dataSize);
-            pElement->dataSize  = dataSize;
-            dataSize = pElement->grossSize - sizeof(MD_HEADER_T);
-        }
-        else
-        {
-            /* Calculate the data size that is pending to read */
-            dataSize = vos_ntohl(appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength);
+    /* Errors are reported when trdp_mdSend() tries to send the rest */
+    (void) vos_sockSendTCPv(appHandle->ifaceMD[sockIndex].sock, iov, iovCnt, &sent);
 
-            pElement->dataSize  = dataSize;
-            pElement->grossSize = trdp_packetSizeMD(dataSize);
+    /* Messages written completely only need their state handled by trdp_mdSend(), even while the connection is
+       blocked. A message written in part owns the connection until trdp_mdSend() has written the rest. */
+    for (i = 0u; (i < noOfMsg) && (sent > 0u); i++)
+    {
+        pBatch[i]->sendSize = (sent < pBatch[i]->grossSize) ? sent : pBatch[i]->grossSize;
+        sent -= pBatch[i]->sendSize;
+    }
+    if ((i > 0u) && (pBatch[i - 1u]->sendSize < pBatch[i - 1u]->grossSize))
+    {
+        pBatch[i - 1u]->tcpParameters.msgUncomplete = TRUE;
+        appHandle->ifaceMD[sockIndex].tcpParams.notSend = TRUE;
+    }
+}
 
-            size = appHandle->uncompletedTCP[socketIndex]->grossSize + readSize;
-            dataSize        = dataSize - (size - sizeof(MD_HEADER_T));
-            readDataSize    = dataSize; /* trdp_packetSizeMD(dataSize); */
-        }
+/**********************************************************************************************************************/
+/** Check for a complete MD message at the head of a TCP receive buffer
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pRx             receive buffer of the connection
+ *  @param[out]     pMsgSize        size of the message at the head (header size, if the header is incomplete)
+ *
+ *  @retval         TRDP_NO_ERR     a complete message of *pMsgSize bytes is buffered
+ *  @retval         TRDP_PACKET_ERR message not yet complete, at least *pMsgSize bytes are needed
+ *  @retval         != TRDP_NO_ERR  header check failed, connection is out of sync
+ */
+static TRDP_ERR_T trdp_mdTCPRxNext (TRDP_SESSION_PT     appHandle,
+                                    const TRDP_TCP_RX_T *pRx,
+                                    UINT32              *pMsgSize)
+{
+    TRDP_ERR_T  err;
+    UINT32      rxSize = pRx->tail - pRx->head;
 
-        /* If all the Header is read, check if more memory is needed */
-        if ( size >= sizeof(MD_HEADER_T))
-        {
-            if ( trdp_packetSizeMD(pElement->dataSize) > cMinimumMDSize )
-            {
-                /* we have to allocate a bigger buffer */
-                MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-                if ( pBigData == NULL )
-                {
-                    return TRDP_MEM_ERR;
-                }
-                /*  Swap the pointers ...  */
-                memcpy(((UINT8 *)&pBigData->frameHead) + storedHeader,
-                       ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
-                       readSize);
+    *pMsgSize = sizeof(MD_HEADER_T);
 
-                vos_memFree(pElement->pPacket);
-                pElement->pPacket = pBigData;
-            }
-        }
+    if (rxSize < sizeof(MD_HEADER_T))
+    {
+        return TRDP_PACKET_ERR;
+    }
 
-        if ( readDataSize > 0u )
-        {
-            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
-                                                  ((UINT8 *)&pElement->pPacket->frameHead) + size,
-                                                  &readDataSize);
+    err = trdp_mdCheck(appHandle, (MD_HEADER_T *)(pRx->data + pRx->head), sizeof(MD_HEADER_T), CHECK_HEADER_ONLY);
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "TCP MD header check failed\n");
+        return err;
+    }
 
-            /* Add the read data size */
-            size = size + readDataSize;
+    *pMsgSize = trdp_packetSizeMD(vos_ntohl(((MD_HEADER_T *)(pRx->data + pRx->head))->datasetLength));
 
-            /* Add the read Data size to the size read during this cycle */
-            readSize = readSize + readDataSize;
-        }
-    }
-    pElement->grossSize = size;
+    return (rxSize >= *pMsgSize) ? TRDP_NO_ERR : TRDP_PACKET_ERR;
+}
 
-    /* If the Header is incomplete, the data size will be "0". Otherwise it will be calculated. */
-    switch ( err )
+/**********************************************************************************************************************/
+/** Check if a TCP connection holds buffered data to be processed without reading the socket
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      sockIndex       index of the connection in ifaceMD[]
+ *
+ *  @retval         TRUE            a complete message (or an invalid header) is buffered
+ *  @retval         FALSE           nothing to process until more data is received
+ */
+static BOOL8 trdp_mdTCPRxPending (TRDP_SESSION_PT   appHandle,
+                                  UINT32            sockIndex)
+{
+    const TRDP_TCP_RX_T *pRx = appHandle->ifaceMD[sockIndex].tcpParams.pRx;
+    UINT32 msgSize;
+
+    if ((appHandle->ifaceMD[sockIndex].sock == VOS_INVALID_SOCKET) || (pRx == NULL))
     {
-       case TRDP_NODATA_ERR:
-           vos_printLog(VOS_LOG_INFO, "vos_sockReceiveTCP - No data at socket %d\n", (int) mdSock);
-           return TRDP_NODATA_ERR;
-       case TRDP_BLOCK_ERR:
-           if (((pElement->pktFlags & TRDP_FLAGS_TCP) != 0) && (readSize == 0u))
-           {
-               return TRDP_BLOCK_ERR;
-           }
-           break;
-       case TRDP_NO_ERR:
-           break;
-       default:
-           vos_printLog(VOS_LOG_ERROR, "vos_sockReceiveTCP failed (Err: %d, Socket: %d)\n", err, (int) mdSock);
-           return err;
+        return FALSE;
     }
-    /* All the data (Header + Data) stored in the uncompletedTCP[] array */
-    /* Check if it's necessary to read some data */
-    if ( pElement->grossSize == sizeof(MD_HEADER_T))
+    return (trdp_mdTCPRxNext(appHandle, pRx, &msgSize) != TRDP_PACKET_ERR) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Provide a receive buffer for a packet
+ *  The element keeps its buffer if it is large enough, else it gets one of the smallest fitting size class from
+ *  the session's receive pool. Only an empty pool class leads to an allocation.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in,out]  pElement        element to receive into
+ *  @param[in]      packetSize      size of the packet to be received
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T trdp_mdRcvBufGet (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement,
+    UINT32          packetSize)
+{
+    UINT32 sizeClass = 0u;
+
+    if ((pElement->pPacket != NULL)
+        && (pElement->poolClass != 0u)
+        && (packetSize <= cMdRcvPoolSize[pElement->poolClass - 1u]))
     {
-        if ( dataSize == 0u )
-        {
-            noDataToRead = TRUE;
-        }
+        return TRDP_NO_ERR;
     }
+    trdp_mdReleasePacket(appHandle, pElement);
 
-    /* Compare if all the data has been read */
-    if (((pElement->grossSize < sizeof(MD_HEADER_T)) && (readDataSize == 0u))
-        ||
-        ((noDataToRead == FALSE) && (readDataSize != dataSize)))
+    while ((sizeClass < (TRDP_MD_RCV_POOL_CLASSES - 1u)) && (packetSize > cMdRcvPoolSize[sizeClass]))
     {
-        /* Uncompleted message received */
+        sizeClass++;
+    }
 
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
+    pElement->pPacket = appHandle->mdRcvPool.pFree[sizeClass];
+    if (pElement->pPacket != NULL)
+    {
+        appHandle->mdRcvPool.pFree[sizeClass] = *(MD_PACKET_T * *) pElement->pPacket;
+        appHandle->mdRcvPool.noOfFree[sizeClass]--;
+    }
+    else
+    {
+        pElement->pPacket = (MD_PACKET_T *) vos_memAlloc(cMdRcvPoolSize[sizeClass]);
+        if (pElement->pPacket == NULL)
         {
-            /* It is the first loop, no data stored yet. Allocate memory for the message */
-            appHandle->uncompletedTCP[socketIndex] = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
-
-            if ( appHandle->uncompletedTCP[socketIndex] == NULL )
-            {
-                /* vos_memDelete(NULL); */
-                vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
-                return TRDP_MEM_ERR;
-            }
-
-            /* Check the memory that is needed */
-            if ( trdp_packetSizeMD(pElement->dataSize) < cMinimumMDSize )
-            {
-                /* Allocate the cMinimumMDSize memory at least for now*/
-                appHandle->uncompletedTCP[socketIndex]->pPacket = (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize);
-            }
-            else
-            {
-                /* Allocate the dataSize memory */
-                /* we have to allocate a bigger buffer */
-                appHandle->uncompletedTCP[socketIndex]->pPacket =
-                    (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-            }
+            vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecv - Out of receive buffers!\n");
+            return TRDP_MEM_ERR;
+        }
+    }
+    pElement->poolClass = (UINT8) (sizeClass + 1u);
+    return TRDP_NO_ERR;
+}
 
-            if ( appHandle->uncompletedTCP[socketIndex]->pPacket == NULL )
-            {
-                return TRDP_MEM_ERR;
-            }
+/**********************************************************************************************************************/
+/** Release the packet buffer of an element
+ *  Buffers of the receive pool are kept for reuse up to TRDP_MD_RCV_POOL_DEPTH per size class, others are freed.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in,out]  pElement        element to release the packet of
+ */
+static void trdp_mdReleasePacket (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    UINT32 sizeClass = pElement->poolClass;
 
-            storedDataSize = 0;
+    if (pElement->pPacket != NULL)
+    {
+        if ((sizeClass != 0u) && (appHandle->mdRcvPool.noOfFree[sizeClass - 1u] < TRDP_MD_RCV_POOL_DEPTH))
+        {
+            *(MD_PACKET_T * *) pElement->pPacket        = appHandle->mdRcvPool.pFree[sizeClass - 1u];
+            appHandle->mdRcvPool.pFree[sizeClass - 1u]  = pElement->pPacket;
+            appHandle->mdRcvPool.noOfFree[sizeClass - 1u]++;
         }
         else
         {
-            /* Get the size that have been already stored in the uncompletedTCP[] */
-            storedDataSize = appHandle->uncompletedTCP[socketIndex]->grossSize;
+            vos_memFree(pElement->pPacket);
+        }
+        pElement->pPacket = NULL;
+    }
+    pElement->poolClass = 0u;
+}
 
-            if ((storedDataSize < sizeof(MD_HEADER_T))
-                && (pElement->grossSize > sizeof(MD_HEADER_T)))
-            {
-                if ( trdp_packetSizeMD(pElement->dataSize) > cMinimumMDSize )
-                {
-                    /* we have to allocate a bigger buffer */
-                    MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-                    if ( pBigData == NULL )
-                    {
-                        return TRDP_MEM_ERR;
-                    }
 
-                    /* Copy the data to the pBigData->frameHead */
-                    memcpy(((UINT8 *)&pBigData->frameHead),
-                           ((UINT8 *)&pElement->pPacket->frameHead),
-                           storedDataSize);
+/**********************************************************************************************************************/
+/** Receive MD packet transmitted via TCP
+ *  The connection's receive buffer is filled with as much data as the socket delivers, messages are taken from its
+ *  head one at a time. Further pipelined messages stay buffered and are returned by the next calls without
+ *  reading the socket again (see trdp_mdTCPRxPending()).
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      mdSock          socket descriptor
+ *  @param[out]     pElement        pointer to received packet
+ *  @retval         TRDP_NO_ERR     complete message received
+ *  @retval         TRDP_PACKET_ERR message not yet complete
+ *  @retval         != TRDP_NO_ERR  error
+ */
+static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock, MD_ELE_T *pElement)
+{
+    TRDP_ERR_T      err         = TRDP_NO_ERR;
+    UINT32          socketIndex = 0u;
+    UINT32          msgSize     = 0u;
+    UINT32          readSize    = 0u;
+    TRDP_TCP_RX_T   *pRx;
+
+    pElement->dataSize  = 0u;
+    pElement->grossSize = 0u;
 
-                    /*  Swap the pointers ...  */
-                    vos_memFree(appHandle->uncompletedTCP[socketIndex]->pPacket);
-                    appHandle->uncompletedTCP[socketIndex]->pPacket = pBigData;
-                }
-            }
-        }
+    /* Fill destination address */
+    pElement->addr.destIpAddr = appHandle->realIP;
 
-        if ( (readSize > 0u)  && (appHandle->uncompletedTCP[socketIndex]->pPacket !=NULL))
-        {
-            /* Copy the read data in the uncompletedTCP[] */
-            memcpy(((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead) + storedDataSize,
-                   ((UINT8 *)&pElement->pPacket->frameHead) + storedDataSize, readSize);
-            appHandle->uncompletedTCP[socketIndex]->grossSize   = pElement->grossSize;
-            appHandle->uncompletedTCP[socketIndex]->dataSize    = readDataSize;
-        }
-        else
+    /* Find the socket index */
+    for ( socketIndex = 0u; socketIndex < (UINT32)trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); socketIndex++ )
+    {
+        if ( appHandle->ifaceMD[socketIndex].sock == mdSock )
         {
-            vos_printLog(VOS_LOG_DBG, "Received TCP - readSize = 0 (Socket: %d)\n", (int) mdSock);
-            return TRDP_PARAM_ERR;
+            break;
         }
+    }
 
-        return TRDP_PACKET_ERR;
+    if ( socketIndex >= (UINT32)trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP) )
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecvPacket - Socket index out of range\n");
+        return TRDP_UNKNOWN_ERR;
     }
-    else
+
+    pRx = appHandle->ifaceMD[socketIndex].tcpParams.pRx;
+    if ( pRx == NULL )
     {
-        /* Complete message */
-        /* All data is read. Save all the data and copy to the pElement to continue */
-        if ( appHandle->uncompletedTCP[socketIndex] != NULL )
+        pRx = (TRDP_TCP_RX_T *) vos_memAlloc(TRDP_MD_TCP_RX_SIZE);
+        if ( pRx == NULL )
         {
-            /* Add the received information and copy all the data to the pElement */
-            storedDataSize = appHandle->uncompletedTCP[socketIndex]->grossSize;
+            vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
+            return TRDP_MEM_ERR;
+        }
+        pRx->size = TRDP_MD_TCP_RX_SIZE - (UINT32) offsetof(TRDP_TCP_RX_T, data);
+        appHandle->ifaceMD[socketIndex].tcpParams.pRx = pRx;
+    }
 
-            if ((readSize > 0u) &&
-                appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )
-            {
-                /* Copy the read data in the uncompletedTCP[] */
-                memcpy(((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead) + storedDataSize,
-                       ((UINT8 *)&pElement->pPacket->frameHead) + storedDataSize, readSize);
-
-                /* Copy all the uncompletedTCP data to the pElement */
-                memcpy(((UINT8 *)&pElement->pPacket->frameHead),
-                       ((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead), pElement->grossSize);
-
-                /* Disallocate the memory */
-                /* 1st free data buffer - independant pointer */
-                vos_memFree(appHandle->uncompletedTCP[socketIndex]->pPacket);
-                /* 2nd free socket element */
-                vos_memFree(appHandle->uncompletedTCP[socketIndex]);
-                appHandle->uncompletedTCP[socketIndex] = NULL;
-            }
-            else
+    err = trdp_mdTCPRxNext(appHandle, pRx, &msgSize);
+
+    if ( err == TRDP_PACKET_ERR )
+    {
+        /* Move the incomplete message to the front and make room for all of it */
+        if ( pRx->head > 0u )
+        {
+            memmove(pRx->data, pRx->data + pRx->head, pRx->tail - pRx->head);
+            pRx->tail  -= pRx->head;
+            pRx->head   = 0u;
+        }
+        if ( msgSize > pRx->size )
+        {
+            TRDP_TCP_RX_T *pBigRx = (TRDP_TCP_RX_T *) vos_memAlloc((UINT32) offsetof(TRDP_TCP_RX_T, data) + msgSize);
+            if ( pBigRx == NULL )
             {
-                vos_printLog(VOS_LOG_DBG, "vos_sockReceiveTCP - readSize = 0 (Socket: %d)\n", (int) mdSock);
-                return TRDP_PARAM_ERR;
+                vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
+                return TRDP_MEM_ERR;
             }
+            memcpy(pBigRx->data, pRx->data, pRx->tail);
+            pBigRx->tail    = pRx->tail;
+            pBigRx->size    = msgSize;
+            vos_memFree(pRx);
+            pRx = pBigRx;
+            appHandle->ifaceMD[socketIndex].tcpParams.pRx = pRx;
+        }
+
+        /* Read as much as is available and fits */
+        readSize = pRx->size - pRx->tail;
+        err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock, pRx->data + pRx->tail, &readSize);
+        pRx->tail += readSize;
+
+        switch ( err )
+        {
+           case TRDP_NO_ERR:
+               break;
+           case TRDP_NODATA_ERR:
+               vos_printLog(VOS_LOG_INFO, "vos_sockReceiveTCP - No data at socket %d\n", (int) mdSock);
+               return TRDP_NODATA_ERR;
+           case TRDP_BLOCK_ERR:
+               return TRDP_BLOCK_ERR;
+           default:
+               vos_printLog(VOS_LOG_ERROR, "vos_sockReceiveTCP failed (Err: %d, Socket: %d)\n", err, (int) mdSock);
+               return err;
         }
+
+        err = trdp_mdTCPRxNext(appHandle, pRx, &msgSize);
+    }
+
+    if ( err != TRDP_NO_ERR )
+    {
+        /* Uncompleted message or invalid header */
+        return err;
+    }
+
+    /* Complete message at the head of the buffer */
+    err = trdp_mdRcvBufGet(appHandle, pElement, msgSize);
+    if ( err != TRDP_NO_ERR )
+    {
+        return err;
+    }
+
+    memcpy(&pElement->pPacket->frameHead, pRx->data + pRx->head, msgSize);
+    pElement->grossSize = msgSize;
+    pElement->dataSize  = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
+
+    pRx->head += msgSize;
+    if ( pRx->head == pRx->tail )
+    {
+        pRx->head   = 0u;
+        pRx->tail   = 0u;
     }
     return TRDP_NO_ERR;
 }
@@ -1364,51 +1763,42 @@ static TRDP_ERR_T trdp_mdRecvUDPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock
     /* UDP receiver */
     TRDP_ERR_T  err = TRDP_NO_ERR;
     UINT32      size; /* Size of the all data read until now */
+    UINT32      dgramSize = 0u;
+    MD_HEADER_T header;
 
-    /* We read the header first */
+    /* We peek at the header first, this also tells the size of the datagram */
     size = sizeof(MD_HEADER_T);
     pElement->addr.srcIpAddr    = 0u;
     pElement->addr.destIpAddr   = appHandle->realIP;    /* Preset destination IP  */
 
-    err = (TRDP_ERR_T) vos_sockReceiveUDP(mdSock,
-                                          (UINT8 *)pElement->pPacket,
-                                          &size,
-                                          &pElement->addr.srcIpAddr,
-                                          &pElement->replyPort,
-                                          &pElement->addr.destIpAddr,
-                                          NULL,   /* #322 */
-                                          TRUE);
+    err = (TRDP_ERR_T) vos_sockPeekUDP(mdSock, (UINT8 *) &header, &size, &dgramSize);
 
-    /* does the announced data fit into our (small) allocated buffer?   */
+    /* get a receive buffer of the matching size class */
     if ( err == TRDP_NO_ERR )
     {
         if ((size == sizeof(MD_HEADER_T))
-            && (trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, size, CHECK_HEADER_ONLY) == TRDP_NO_ERR))
+            && (trdp_mdCheck(appHandle, &header, size, CHECK_HEADER_ONLY) == TRDP_NO_ERR))
         {
-            pElement->dataSize  = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
+            pElement->dataSize  = vos_ntohl(header.datasetLength);
             pElement->grossSize = trdp_packetSizeMD(pElement->dataSize);
 
-            if ( trdp_packetSizeMD(pElement->dataSize) > cMinimumMDSize )
+            /* The datagram size is not known on every platform, the header tells what it should be */
+            err = trdp_mdRcvBufGet(appHandle,
+                                   pElement,
+                                   (dgramSize > pElement->grossSize) ? dgramSize : pElement->grossSize);
+            if ( err != TRDP_NO_ERR )
             {
-                /* we have to allocate a bigger buffer */
-                MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-                if ( pBigData == NULL )
-                {
-                    /* Ticket #346: We have to flush the receive buffers, in case the message is too big for us. */
-                    (void) vos_sockReceiveUDP(mdSock,
-                                              (UINT8 *)pElement->pPacket,
-                                              &size,
-                                              NULL,
-                                              NULL,
-                                              NULL,
-                                              NULL,   /* #322 */
-                                              FALSE);
-                    return TRDP_MEM_ERR;
-                }
-                /*  Swap the pointers ...  */
-                vos_memFree(pElement->pPacket);
-                pElement->pPacket   = pBigData;
-                pElement->grossSize = trdp_packetSizeMD(pElement->dataSize);
+                /* Ticket #346: We have to flush the receive buffers, in case the message is too big for us. */
+                size = sizeof(MD_HEADER_T);
+                (void) vos_sockReceiveUDP(mdSock,
+                                          (UINT8 *) &header,
+                                          &size,
+                                          NULL,
+                                          NULL,
+                                          NULL,
+                                          NULL,   /* #322 */
+                                          FALSE);
+                return TRDP_MEM_ERR;
             }
 
             /*  get the complete packet */
@@ -1436,7 +1826,7 @@ static TRDP_ERR_T trdp_mdRecvUDPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock
             /* header information can't be read - throw the packet away reading some bytes */
             size = sizeof(MD_HEADER_T);
             (void) vos_sockReceiveUDP(mdSock,
-                                      (UINT8 *)pElement->pPacket,
+                                      (UINT8 *) &header,
                                       &size,
                                       &pElement->addr.srcIpAddr,
                                       &pElement->replyPort, &pElement->addr.destIpAddr,
@@ -1534,7 +1924,8 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
            ;
     }
 
-    if (err != TRDP_NO_ERR)
+    /* An incomplete TCP message is no error, the rest follows with the next read */
+    if ((err != TRDP_NO_ERR) && (err != TRDP_PACKET_ERR))
     {
         vos_printLog(VOS_LOG_ERROR, "trdp_mdCheck %s failed (Err: %d)\n",
                      (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", err);
@@ -1543,6 +1934,171 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Compute the dispatch bucket of a destination URI
+ *  The URI is hashed in lower case, as listeners match URIs case insensitive.
+ *
+ *  @param[in]      pURI            destination URI (user part)
+ *
+ *  @retval         bucket index (0 ... TRDP_MD_LISTENER_HASH_SIZE - 1)
+ */
+static UINT32 trdp_mdListenerURIHash (
+    const CHAR8 *pURI)
+{
+    UINT32  hash = 2166136261u;     /* FNV-1a */
+    UINT32  i;
+
+    for (i = 0u; (i < TRDP_USR_URI_SIZE) && (pURI[i] != 0); i++)
+    {
+        CHAR8 c = pURI[i];
+        if ((c >= 'A') && (c <= 'Z'))
+        {
+            c = (CHAR8) (c - 'A' + 'a');
+        }
+        hash = (hash ^ (UINT8) c) * 16777619u;
+    }
+    return hash & (TRDP_MD_LISTENER_HASH_SIZE - 1u);
+}
+
+/**********************************************************************************************************************/
+/** Check all filter rules of a listener against an incoming request
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_init
+ *  @param[in]      pListener       listener to check
+ *  @param[in]      isTCP           TCP ?
+ *  @param[in]      pH              Header of the incoming message
+ *
+ *  @retval         TRUE            listener is addressed
+ *  @retval         FALSE           listener does not match
+ */
+static BOOL8 trdp_mdListenerMatches (
+    TRDP_SESSION_PT     appHandle,
+    const MD_LIS_ELE_T  *pListener,
+    BOOL8               isTCP,
+    const MD_HEADER_T   *pH)
+{
+    if ((pListener->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
+        (isTCP == TRUE))
+    {
+        return FALSE;
+    }
+
+    /* Ticket #206: TCP requests should use TCP listeners only */
+    if ((pListener->pktFlags & TRDP_FLAGS_TCP) && (isTCP == FALSE))
+    {
+        return FALSE;
+    }
+
+    /* Ticket #180: Do the filtering as the standard demands */
+
+    /* If comID does not match but should, continue */
+    if (((pListener->privFlags & TRDP_CHECK_COMID) != 0) &&
+        (vos_ntohl(pH->comId) != pListener->addr.comId))
+    {
+        return FALSE;
+    }
+
+    /* check the source URI if set  */
+    if ((pListener->srcURI[0] != 0) &&
+        (!trdp_isAddressed(pListener->srcURI, (CHAR8 *) pH->sourceURI)))
+    {
+        return FALSE;
+    }
+
+    /* check the destination URI if set  */
+    if ((pListener->destURI[0] != 0) &&
+        (!trdp_isAddressed(pListener->destURI, (CHAR8 *) pH->destinationURI)))
+    {
+        return FALSE;
+    }
+
+    /* check topocounts before comparing source or destination IP addresses! */
+    /* Step 1: here we need to check the topccounts */
+    /* in case of train communication (topo counters != zero) check topo validity of recvd message and */
+    /* recv queue item by matching the etbTopoCnt and opTrnTopoCnt                                     */
+    if (((pH->etbTopoCnt != 0u) || (pH->opTrnTopoCnt != 0u))
+        && (!trdp_validTopoCounters( vos_ntohl(pH->etbTopoCnt),
+                                     vos_ntohl(pH->opTrnTopoCnt),
+                                     pListener->addr.etbTopoCnt,
+                                     pListener->addr.opTrnTopoCnt)))
+    {
+        return FALSE;
+    }
+
+    /* If multicast address is set, but does not match, we go to the next listener (if any) */
+    if ((pListener->addr.mcGroup != 0u || vos_isMulticast(appHandle->pMDRcvEle->addr.destIpAddr)) &&
+        (pListener->addr.mcGroup != appHandle->pMDRcvEle->addr.destIpAddr))
+    {
+        /* no IP match for unicast addressing */
+        return FALSE;
+    }
+
+    /* if source IP given (and no range) */
+    if ((pListener->addr.srcIpAddr2 == 0) &&
+        (pListener->addr.srcIpAddr != 0) &&
+        (pListener->addr.srcIpAddr != appHandle->pMDRcvEle->addr.srcIpAddr))
+    {
+        return FALSE;
+    }
+
+    /* if source IP given and is within given IP range */
+    if ((pListener->addr.srcIpAddr != 0) &&
+        (pListener->addr.srcIpAddr2 != 0) &&
+        (!trdp_isInIPrange(appHandle->pMDRcvEle->addr.srcIpAddr,
+                           pListener->addr.srcIpAddr,
+                           pListener->addr.srcIpAddr2)))
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Find the listener for an incoming request
+ *  Only the listeners of the comId bucket, of the destination URI bucket and the wildcard listeners are checked.
+ *  If several listeners match, the most recently added one is taken, as with a scan of pMDListenQueue.
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_init
+ *  @param[in]      isTCP           TCP ?
+ *  @param[in]      pH              Header of the incoming message
+ *
+ *  @retval         pointer to the listener or NULL
+ */
+static MD_LIS_ELE_T *trdp_mdFindListener (
+    TRDP_SESSION_PT     appHandle,
+    BOOL8               isTCP,
+    const MD_HEADER_T   *pH)
+{
+    MD_LIS_ELE_T    *pCandidate[3];
+    MD_LIS_ELE_T    *pFound = NULL;
+    MD_LIS_ELE_T    *iterListener;
+    UINT32          comId   = vos_ntohl(pH->comId);
+    UINT32          i;
+
+    pCandidate[0]   = appHandle->pMDListenComId[comId & (TRDP_MD_LISTENER_HASH_SIZE - 1u)];
+    pCandidate[1]   = appHandle->pMDListenURI[trdp_mdListenerURIHash((const CHAR8 *) pH->destinationURI)];
+    pCandidate[2]   = appHandle->pMDListenAny;
+
+    /* the buckets are sorted newest first, take the first match of each and keep the newest one */
+    for (i = 0u; i < 3u; i++)
+    {
+        for (iterListener = pCandidate[i]; iterListener != NULL; iterListener = iterListener->pNextDispatch)
+        {
+            if ((pFound != NULL) && ((INT32)(iterListener->order - pFound->order) < 0))
+            {
+                break;      /* all remaining listeners of this bucket are older */
+            }
+            if (trdp_mdListenerMatches(appHandle, iterListener, isTCP, pH))
+            {
+                pFound = iterListener;
+                break;
+            }
+        }
+    }
+    return pFound;
+}
+
 /**********************************************************************************************************************/
 /** Handle incoming request message - private SW level
  *
@@ -1563,7 +2119,6 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
                                         TRDP_MD_ELE_ST_T    state,
                                         MD_ELE_T            * *pIterMD)
 {
-    UINT32 numOfReceivers = 0u;
     MD_LIS_ELE_T    *iterListener   = NULL;
     TRDP_ERR_T      result          = TRDP_NO_ERR;
     MD_ELE_T        *iterMD         = NULL;
@@ -1577,10 +2132,11 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
         /* Search for existing session (in case it is a repeated request)  */
         /* This is kind of error detection/comm issue remedy functionality */
         /* running ahead of further logic */
-        for ( iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext )
+        for ( iterMD = trdp_mdSessionBucket(appHandle->pMDRcvSessions, pH->sessionID);
+              iterMD != NULL;
+              iterMD = iterMD->pNextSession )
         {
-            numOfReceivers++; /* count the list items here */
-            if ( 0 == memcmp(iterMD->pPacket->frameHead.sessionID, pH->sessionID, TRDP_SESS_ID_SIZE))
+            if ( 0 == memcmp(iterMD->sessionID, pH->sessionID, TRDP_SESS_ID_SIZE))
             {
                 /* According IEC61375-2-3 A.7.7.1 (BL: non existant chapter?)*/
                 /* encountered a matching session */
@@ -1621,6 +2177,7 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
                     /* this MD_ELE_T item to TRDP_ST_TX_REPLYQUERY_ARM, for  */
                     /* reference check the trdp_mdSend function              */
                     iterMD->stateEle = TRDP_ST_TX_REPLYQUERY_ARM;
+                    TRDP_TRACE_ELEMENT(MD_STATE, iterMD, iterMD->stateEle);
                     /* Increment the retry counter */
                     iterMD->numRetries++;
                     /* Align sequence counter with the received counter. Both*/
@@ -1630,6 +2187,7 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
                     /* Store new sequence counter within the management info */
                     /* Set new time out value */
                     vos_addTime(&iterMD->timeToGo, &iterMD->interval);
+                    trdp_mdTimerArm(appHandle, iterMD);
                     /* update the frame header CRC also */
                     trdp_mdUpdatePacket(iterMD);
                     /* ready to proceed - will be handled by trdp_mdSend run- */
@@ -1639,10 +2197,11 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
             }
         }
         /* Inhibit MQ/MN Flooding */
-        if ( appHandle->mdDefault.maxNumSessions <= numOfReceivers )
+        if ( appHandle->mdDefault.maxNumSessions <= appHandle->numMDRcvSessions )
         {
             /* Discard MD request, we shall not be flooded by incoming requests */
-            vos_printLog(VOS_LOG_INFO, "trdp_mdRecv: Max. number of requests reached (%d)!\n", numOfReceivers);
+            vos_printLog(VOS_LOG_INFO, "trdp_mdRecv: Max. number of requests reached (%u)!\n",
+                         (unsigned int) appHandle->numMDRcvSessions);
             /* Indicate that this call can not get replied due to receiver count limitation  */
             (void)trdp_mdSendME(appHandle, pH, TRDP_REPLY_NO_MEM_REPL);
             /* return to calling routine without performing any receiver action */
@@ -1653,121 +2212,49 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
     iterMD = NULL; /* reset item for the actual lookup task */
 
     /* search for existing listener */
-    for ( iterListener = appHandle->pMDListenQueue; iterListener != NULL;
-          iterListener = iterListener->pNext )
+    iterListener = trdp_mdFindListener(appHandle, isTCP, pH);
+    if (NULL != iterListener)
     {
-        if ((iterListener->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
-            (isTCP == TRUE))
-        {
-            continue;
-        }
-
-        /* Ticket #206: TCP requests should use TCP listeners only */
-        if ((iterListener->pktFlags & TRDP_FLAGS_TCP) && (isTCP == FALSE))
-        {
-            continue;
-        }
-
-        /* Ticket #180: Do the filtering as the standard demands */
-
-        /* If comID does not match but should, continue */
-        if (((iterListener->privFlags & TRDP_CHECK_COMID) != 0) &&
-            (vos_ntohl(pH->comId) != iterListener->addr.comId))
-        {
-            continue;
-        }
-
-        /* check the source URI if set  */
-        if ((iterListener->srcURI[0] != 0) &&
-            (!trdp_isAddressed(iterListener->srcURI, (CHAR8 *) pH->sourceURI)))
-        {
-            continue;
-        }
-
-        /* check the destination URI if set  */
-        if ((iterListener->destURI[0] != 0) &&
-            (!trdp_isAddressed(iterListener->destURI, (CHAR8 *) pH->destinationURI)))
-        {
-            continue;
-        }
-
-        /* check topocounts before comparing source or destination IP addresses! */
-        /* Step 1: here we need to check the topccounts */
-        /* in case of train communication (topo counters != zero) check topo validity of recvd message and */
-        /* recv queue item by matching the etbTopoCnt and opTrnTopoCnt                                     */
-        if (((pH->etbTopoCnt != 0u) || (pH->opTrnTopoCnt != 0u))
-            && (!trdp_validTopoCounters( vos_ntohl(pH->etbTopoCnt),
-                                         vos_ntohl(pH->opTrnTopoCnt),
-                                         iterListener->addr.etbTopoCnt,
-                                         iterListener->addr.opTrnTopoCnt)))
-        {
-            continue;
-        }
-
-        /* If multicast address is set, but does not match, we go to the next listener (if any) */
-        if ((iterListener->addr.mcGroup != 0u || vos_isMulticast(appHandle->pMDRcvEle->addr.destIpAddr)) &&
-            (iterListener->addr.mcGroup != appHandle->pMDRcvEle->addr.destIpAddr))
-        {
-            /* no IP match for unicast addressing */
-            continue;
-        }
-
-        /* if source IP given (and no range) */
-        if ((iterListener->addr.srcIpAddr2 == 0) &&
-            (iterListener->addr.srcIpAddr != 0) &&
-            (iterListener->addr.srcIpAddr != appHandle->pMDRcvEle->addr.srcIpAddr))
+        /* We found a listener, set some values for this new session  */
+        iterMD = appHandle->pMDRcvEle;
+        iterMD->pUserRef = iterListener->pUserRef;
+        iterMD->pfCbFunction        = iterListener->pfCbFunction;
+        iterMD->stateEle            = state;
+        iterMD->addr.etbTopoCnt     = iterListener->addr.etbTopoCnt;
+        iterMD->addr.opTrnTopoCnt   = iterListener->addr.opTrnTopoCnt;
+        iterMD->pktFlags            = iterListener->pktFlags;           /* BL: This was missing! */
+        iterMD->pListener           = iterListener;
+        TRDP_TRACE_EVENT(MD_STATE, vos_ntohl(pH->comId), vos_ntohl(pH->sequenceCounter), iterMD->addr.srcIpAddr,
+                         vos_ntohl(pH->datasetLength), state);
+
+
+        /* Count this Request/Notification as new session */
+        iterListener->numSessions++;
+
+        if ( iterListener->socketIdx == TRDP_INVALID_SOCKET_INDEX ) /* On TCP, listeners have no socket
+           assigned  */
         {
-            continue;
+            iterMD->socketIdx = (INT32) sockIndex;
         }
-
-        /* if source IP given and is within given IP range */
-        if ((iterListener->addr.srcIpAddr != 0) &&
-            (iterListener->addr.srcIpAddr2 != 0) &&
-            (!trdp_isInIPrange(appHandle->pMDRcvEle->addr.srcIpAddr,
-                               iterListener->addr.srcIpAddr,
-                               iterListener->addr.srcIpAddr2)))
+        else
         {
-            continue;
+            iterMD->socketIdx = iterListener->socketIdx;
         }
 
-        /* If we come here, it is the right listener! */
-        {
-            /* We found a listener, set some values for this new session  */
-            iterMD = appHandle->pMDRcvEle;
-            iterMD->pUserRef = iterListener->pUserRef;
-            iterMD->pfCbFunction        = iterListener->pfCbFunction;
-            iterMD->stateEle            = state;
-            iterMD->addr.etbTopoCnt     = iterListener->addr.etbTopoCnt;
-            iterMD->addr.opTrnTopoCnt   = iterListener->addr.opTrnTopoCnt;
-            iterMD->pktFlags            = iterListener->pktFlags;           /* BL: This was missing! */
-            iterMD->pListener           = iterListener;
-
-
-            /* Count this Request/Notification as new session */
-            iterListener->numSessions++;
-
-            if ( iterListener->socketIdx == TRDP_INVALID_SOCKET_INDEX ) /* On TCP, listeners have no socket
-               assigned  */
-            {
-                iterMD->socketIdx = (INT32) sockIndex;
-            }
-            else
-            {
-                iterMD->socketIdx = iterListener->socketIdx;
-            }
-
-            trdp_MDqueueInsFirst(&appHandle->pMDRcvQueue, iterMD);
+        /* the session ID is needed to index the new element */
+        memcpy(iterMD->sessionID, pH->sessionID, TRDP_SESS_ID_SIZE);
+        trdp_MDqueueInsFirst(&appHandle->pMDRcvQueue, iterMD);
+        trdp_mdSessionInsert(appHandle->pMDRcvSessions, iterMD);
+        appHandle->numMDRcvSessions++;
 
-            appHandle->pMDRcvEle = NULL;
+        appHandle->pMDRcvEle = NULL;
 
-            vos_printLog(VOS_LOG_INFO,
-                         "Creating %s MD replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
-                         iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
-                         pH->sessionID[0], pH->sessionID[1], pH->sessionID[2],
-                         pH->sessionID[3], pH->sessionID[4], pH->sessionID[5],
-                         pH->sessionID[6], pH->sessionID[7]);
-            break;
-        }
+        vos_printLog(VOS_LOG_INFO,
+                     "Creating %s MD replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
+                     iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
+                     pH->sessionID[0], pH->sessionID[1], pH->sessionID[2],
+                     pH->sessionID[3], pH->sessionID[4], pH->sessionID[5],
+                     pH->sessionID[6], pH->sessionID[7]);
     }
     if ( NULL != iterMD )
     {
@@ -1796,6 +2283,8 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
         memcpy(iterMD->sessionID, pH->sessionID, TRDP_SESS_ID_SIZE);
         /* save source URI for reply */
         vos_strncpy(iterMD->srcURI, (CHAR8 *) pH->sourceURI, TRDP_MAX_URI_USER_LEN);
+
+        trdp_mdTimerArm(appHandle, iterMD);
     }
     else
     {
@@ -1900,8 +2389,7 @@ static TRDP_ERR_T trdp_mdSendME (TRDP_SESSION_PT appHandle, MD_HEADER_T *pH, INT
                  */
                 if ( NULL != pSenderElement->pPacket )
                 {
-                    vos_memFree(pSenderElement->pPacket);
-                    pSenderElement->pPacket = NULL;
+                    trdp_mdReleasePacket(appHandle, pSenderElement);
                 }
                 /* allocate a buffer for the data   */
                 pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
@@ -1937,7 +2425,7 @@ static TRDP_ERR_T trdp_mdSendME (TRDP_SESSION_PT appHandle, MD_HEADER_T *pH, INT
         if ( TRDP_NO_ERR != errv &&
              NULL != pSenderElement )
         {
-            trdp_mdFreeSession(pSenderElement);
+            trdp_mdFreeSession(appHandle, pSenderElement);
             pSenderElement = NULL;
         }
     }
@@ -1982,13 +2470,23 @@ static TRDP_ERR_T  trdp_mdRecv (
         return TRDP_PARAM_ERR;
     }
 
-    /* get buffer if none available */
+    /* get element if none available, the packet buffer is provided by the receive functions */
     if (appHandle->pMDRcvEle == NULL)
     {
-        appHandle->pMDRcvEle = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+        if (appHandle->mdRcvPool.pFreeEle != NULL)
+        {
+            appHandle->pMDRcvEle            = appHandle->mdRcvPool.pFreeEle;
+            appHandle->mdRcvPool.pFreeEle   = appHandle->pMDRcvEle->pNext;
+            appHandle->mdRcvPool.noOfFreeEle--;
+            memset(appHandle->pMDRcvEle, 0, sizeof(MD_ELE_T));
+        }
+        else
+        {
+            appHandle->pMDRcvEle = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+        }
         if (NULL != appHandle->pMDRcvEle)
         {
-            appHandle->pMDRcvEle->pPacket   = NULL; /* (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize); */
+            appHandle->pMDRcvEle->pPacket   = NULL;
             appHandle->pMDRcvEle->pktFlags  = appHandle->mdDefault.flags;
         }
         else
@@ -2009,20 +2507,6 @@ static TRDP_ERR_T  trdp_mdRecv (
         isTCP = FALSE;
     }
 
-    if (appHandle->pMDRcvEle->pPacket == NULL)
-    {
-        /* Malloc the minimum size for now */
-        appHandle->pMDRcvEle->pPacket = (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize);
-
-        if (appHandle->pMDRcvEle->pPacket == NULL)
-        {
-            vos_memFree(appHandle->pMDRcvEle);
-            appHandle->pMDRcvEle = NULL;
-            vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecv - Out of receive buffers!\n");
-            return TRDP_MEM_ERR;
-        }
-    }
-
     /* get packet: */
     result = trdp_mdRecvPacket(appHandle, appHandle->ifaceMD[sockIndex].sock, appHandle->pMDRcvEle);
 
@@ -2033,6 +2517,8 @@ static TRDP_ERR_T  trdp_mdRecv (
 
     /* process message */
     pH = &appHandle->pMDRcvEle->pPacket->frameHead;
+    TRDP_TRACE_EVENT(MD_RECEIVE, vos_ntohl(pH->comId), vos_ntohl(pH->sequenceCounter),
+                     appHandle->pMDRcvEle->addr.srcIpAddr, vos_ntohl(pH->datasetLength), vos_ntohs(pH->msgType));
 
     vos_printLog(VOS_LOG_INFO,
                  "Received %s MD packet (type: '%c%c' UUID: %02x%02x%02x%02x%02x%02x%02x%02x Data len: %u)\n",
@@ -2186,44 +2672,246 @@ TRDP_ERR_T trdp_mdGetTCPSocket (
 
 /**********************************************************************************************************************/
 /** Free memory of session
+ *  The element and a receive pool buffer are kept in the session's receive pool for reuse.
  *
- *  @param[in]      pMDSession        session pointer
+ *  @param[in]      appHandle         session pointer
+ *  @param[in]      pMDSession        MD session element
  */
+
 void trdp_mdFreeSession (
-    MD_ELE_T *pMDSession)
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pMDSession)
 {
     if (NULL != pMDSession)
     {
-        if (NULL != pMDSession->pPacket)
+        trdp_mdReleasePacket(appHandle, pMDSession);
+        if (appHandle->mdRcvPool.noOfFreeEle < TRDP_MD_RCV_POOL_DEPTH)
+        {
+            pMDSession->pNext               = appHandle->mdRcvPool.pFreeEle;
+            appHandle->mdRcvPool.pFreeEle   = pMDSession;
+            appHandle->mdRcvPool.noOfFreeEle++;
+        }
+        else
         {
-            vos_memFree(pMDSession->pPacket);
+            vos_memFree(pMDSession);
         }
-        vos_memFree(pMDSession);
     }
 }
 
 /**********************************************************************************************************************/
-/** Sending MD messages
- *  Send the messages stored in the sendQueue
- *  Call user's callback if needed
+/** Free the idle buffers and elements of the MD receive pool
  *
- *  @param[in]      appHandle           session pointer
+ *  @param[in]      appHandle         session pointer
  */
-TRDP_ERR_T  trdp_mdSend (
+void trdp_mdRcvPoolFree (
     TRDP_SESSION_PT appHandle)
 {
-    TRDP_ERR_T  result      = TRDP_NO_ERR;
-    MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
-    BOOL8       firstLoop   = TRUE;
+    UINT32 sizeClass;
 
-    /*  Find the packet which has to be sent next:
-     Note: We must also check the receive queue for pending replies! */
-    do
+    for (sizeClass = 0u; sizeClass < TRDP_MD_RCV_POOL_CLASSES; sizeClass++)
     {
-        int dotx = 0;
-        TRDP_MD_ELE_ST_T nextstate = TRDP_ST_NONE;
+        while (appHandle->mdRcvPool.pFree[sizeClass] != NULL)
+        {
+            MD_PACKET_T *pNext = *(MD_PACKET_T * *) appHandle->mdRcvPool.pFree[sizeClass];
 
-        /*  Switch to receive queue */
+            vos_memFree(appHandle->mdRcvPool.pFree[sizeClass]);
+            appHandle->mdRcvPool.pFree[sizeClass] = pNext;
+        }
+        appHandle->mdRcvPool.noOfFree[sizeClass] = 0u;
+    }
+    while (appHandle->mdRcvPool.pFreeEle != NULL)
+    {
+        MD_ELE_T *pNext = appHandle->mdRcvPool.pFreeEle->pNext;
+
+        vos_memFree(appHandle->mdRcvPool.pFreeEle);
+        appHandle->mdRcvPool.pFreeEle = pNext;
+    }
+    appHandle->mdRcvPool.noOfFreeEle = 0u;
+}
+
+
+/**********************************************************************************************************************/
+/** Return the dispatch bucket a listener belongs to
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pListener           listener
+ *
+ *  @retval         pointer to the head of the bucket
+ */
+static MD_LIS_ELE_T * *trdp_mdListenerBucket (
+    TRDP_SESSION_PT     appHandle,
+    const MD_LIS_ELE_T  *pListener)
+{
+    if ((pListener->privFlags & TRDP_CHECK_COMID) != 0)
+    {
+        return &appHandle->pMDListenComId[pListener->addr.comId & (TRDP_MD_LISTENER_HASH_SIZE - 1u)];
+    }
+    if (pListener->destURI[0] != 0)
+    {
+        return &appHandle->pMDListenURI[trdp_mdListenerURIHash(pListener->destURI)];
+    }
+    return &appHandle->pMDListenAny;
+}
+
+/**********************************************************************************************************************/
+/** Add a listener to the dispatch table
+ *  Listeners filtering the comId are hashed by comId, listeners filtering only the destination URI by URI,
+ *  all others are kept in the wildcard list. The comId and URIs of a listener must not change while it is added.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pListener           listener to add
+ */
+void trdp_mdListenerInsert (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pListener)
+{
+    MD_LIS_ELE_T * *ppBucket = trdp_mdListenerBucket(appHandle, pListener);
+
+    /* newest first, like pMDListenQueue */
+    pListener->order            = ++appHandle->mdListenOrder;
+    pListener->pNextDispatch    = *ppBucket;
+    *ppBucket = pListener;
+}
+
+/**********************************************************************************************************************/
+/** Remove a listener from the dispatch table
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pListener           listener to remove
+ */
+void trdp_mdListenerRemove (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pListener)
+{
+    MD_LIS_ELE_T * *ppIter = trdp_mdListenerBucket(appHandle, pListener);
+
+    while (*ppIter != NULL)
+    {
+        if (*ppIter == pListener)
+        {
+            *ppIter = pListener->pNextDispatch;
+            pListener->pNextDispatch = NULL;
+            return;
+        }
+        ppIter = &(*ppIter)->pNextDispatch;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Compute the session index bucket of a session ID
+ *  The four 32 bit words of the UUID are folded together.
+ *
+ *  @param[in]      pSessionId          session ID
+ *
+ *  @retval         bucket index (0 ... TRDP_MD_SESSION_HASH_SIZE - 1)
+ */
+static UINT32 trdp_mdSessionHash (
+    const UINT8 *pSessionId)
+{
+    UINT32  hash = 0u;
+    UINT32  i;
+
+    for (i = 0u; i < TRDP_SESS_ID_SIZE; i += 4u)
+    {
+        hash ^= ((UINT32) pSessionId[i] << 24u) | ((UINT32) pSessionId[i + 1u] << 16u) |
+            ((UINT32) pSessionId[i + 2u] << 8u) | (UINT32) pSessionId[i + 3u];
+    }
+    hash ^= hash >> 16u;
+    return hash & (TRDP_MD_SESSION_HASH_SIZE - 1u);
+}
+
+/**********************************************************************************************************************/
+/** Return the first element of the session index bucket a session ID belongs to
+ *  Elements of the bucket are chained by pNextSession, the caller has to compare the sessionID.
+ *
+ *  @param[in]      ppTable             session index (pMDSndSessions or pMDRcvSessions)
+ *  @param[in]      pSessionId          session ID
+ *
+ *  @retval         first element of the bucket or NULL
+ */
+MD_ELE_T *trdp_mdSessionBucket (
+    MD_ELE_T    * const *ppTable,
+    const UINT8 *pSessionId)
+{
+    return ppTable[trdp_mdSessionHash(pSessionId)];
+}
+
+/**********************************************************************************************************************/
+/** Add an element to a session index
+ *  Must be called after the sessionID of the element has been set.
+ *
+ *  @param[in]      ppTable             session index (pMDSndSessions or pMDRcvSessions)
+ *  @param[in]      pElement            element to add
+ */
+void trdp_mdSessionInsert (
+    MD_ELE_T    * *ppTable,
+    MD_ELE_T    *pElement)
+{
+    UINT32 bucket = trdp_mdSessionHash(pElement->sessionID);
+
+    pElement->pNextSession  = ppTable[bucket];
+    ppTable[bucket]         = pElement;
+}
+
+/**********************************************************************************************************************/
+/** Remove an element from a session index
+ *
+ *  @param[in]      ppTable             session index (pMDSndSessions or pMDRcvSessions)
+ *  @param[in]      pElement            element to remove
+ */
+void trdp_mdSessionRemove (
+    MD_ELE_T    * *ppTable,
+    MD_ELE_T    *pElement)
+{
+    MD_ELE_T * *ppIter = &ppTable[trdp_mdSessionHash(pElement->sessionID)];
+
+    while (*ppIter != NULL)
+    {
+        if (*ppIter == pElement)
+        {
+            *ppIter = pElement->pNextSession;
+            pElement->pNextSession = NULL;
+            return;
+        }
+        ppIter = &(*ppIter)->pNextSession;
+    }
+}
+
+
+/**********************************************************************************************************************/
+/** Sending MD messages
+ *  Send the messages stored in the sendQueue
+ *  Call user's callback if needed
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+TRDP_ERR_T  trdp_mdSend (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_ERR_T  result      = TRDP_NO_ERR;
+    MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
+    BOOL8       firstLoop   = TRUE;
+    INT32       lIndex;
+
+    /*  Write the messages queued for each TCP connection at once, the loop below completes them */
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); lIndex++)
+    {
+        if ((appHandle->ifaceMD[lIndex].sock != VOS_INVALID_SOCKET)
+            && (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
+            && (appHandle->ifaceMD[lIndex].tcpParams.notSend == FALSE))
+        {
+            trdp_mdSendTCPBatch(appHandle, lIndex);
+        }
+    }
+
+    /*  Find the packet which has to be sent next:
+     Note: We must also check the receive queue for pending replies! */
+    do
+    {
+        int dotx = 0;
+        TRDP_MD_ELE_ST_T nextstate = TRDP_ST_NONE;
+
+        /*  Switch to receive queue */
         if (NULL == iterMD && TRUE == firstLoop)
         {
             iterMD      = appHandle->pMDRcvQueue;
@@ -2282,6 +2970,7 @@ TRDP_ERR_T  trdp_mdSend (
                         if (err == VOS_NO_ERR)
                         {
                             iterMD->tcpParameters.doConnect = FALSE;
+                            appHandle->ifaceMD[iterMD->socketIdx].tcpParams.connected = TRUE;
                             vos_printLog(VOS_LOG_INFO,
                                          "Opened TCP connection to %s (Socket: %d, Port: %u)\n",
                                          vos_ipDotted(iterMD->addr.destIpAddr),
@@ -2331,10 +3020,12 @@ TRDP_ERR_T  trdp_mdSend (
                     }
                 }
 
+                /*  Only one message may be in flight on a TCP connection: while one is written in part, the others
+                    wait, except those trdp_mdSendTCPBatch() already wrote completely. */
                 if (((iterMD->pktFlags & TRDP_FLAGS_TCP) == 0)
-                    || (((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
-                        && ((appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend == FALSE)
-                            || (iterMD->tcpParameters.msgUncomplete == TRUE))))
+                    || (appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend == FALSE)
+                    || (iterMD->tcpParameters.msgUncomplete == TRUE)
+                    || (iterMD->sendSize == iterMD->grossSize))
                 {
 
                     if (0u != iterMD->replyPort &&
@@ -2356,9 +3047,14 @@ TRDP_ERR_T  trdp_mdSend (
                     {
                         if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
                         {
-                            appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend = FALSE;
-                            iterMD->tcpParameters.msgUncomplete = FALSE;
+                            if (iterMD->tcpParameters.msgUncomplete == TRUE)
+                            {
+                                /* The message in flight is complete, the connection is free for the others */
+                                appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend = FALSE;
+                                iterMD->tcpParameters.msgUncomplete = FALSE;
+                            }
                             appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk = FALSE;
+                            appHandle->ifaceMD[iterMD->socketIdx].tcpParams.connected = TRUE;
 
                             /* Add the socket in the file descriptor*/
                             appHandle->ifaceMD[iterMD->socketIdx].tcpParams.addFileDesc = TRUE;
@@ -2370,6 +3066,7 @@ TRDP_ERR_T  trdp_mdSend (
                             /* increment transmission counter for UDP */
                             appHandle->stats.udpMd.numSend++;
                         }
+                        TRDP_TRACE_ELEMENT(MD_SEND, iterMD, vos_ntohs(iterMD->pPacket->frameHead.msgType));
 
                         if (nextstate == TRDP_ST_RX_REPLYQUERY_W4C)
                         {
@@ -2379,6 +3076,7 @@ TRDP_ERR_T  trdp_mdSend (
                             {
                                 vos_getTime(&iterMD->timeToGo);
                                 vos_addTime(&iterMD->timeToGo, &iterMD->interval);
+                                trdp_mdTimerArm(appHandle, iterMD);
                                 vos_printLogStr(VOS_LOG_INFO, "Setting timeout for confirmation!\n");
                             }
                         }
@@ -2419,6 +3117,7 @@ TRDP_ERR_T  trdp_mdSend (
                                ;
                         }
                         iterMD->stateEle = nextstate;
+                        TRDP_TRACE_ELEMENT(MD_STATE, iterMD, iterMD->stateEle);
                     }
                     else
                     {
@@ -2427,8 +3126,12 @@ TRDP_ERR_T  trdp_mdSend (
                             /* Send uncompleted */
                             if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
                             {
-                                appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend = TRUE;
-                                iterMD->tcpParameters.msgUncomplete = TRUE;
+                                /* Other sessions on the connection must wait until a started message is complete */
+                                if (iterMD->sendSize > 0u)
+                                {
+                                    appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend = TRUE;
+                                    iterMD->tcpParameters.msgUncomplete = TRUE;
+                                }
 
                                 if (appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk == FALSE)
                                 {
@@ -2488,20 +3191,22 @@ TRDP_ERR_T  trdp_mdSend (
 
 /******************************************************************************/
 /** Check for pending packets, set FD if non blocking
+ *  The sockets are taken from the MD socket table and the earliest time-out from the top of the session timer heap,
+ *  the cost does not depend on the number of sessions.
  *
  *  @param[in]      appHandle           session pointer
  *  @param[in,out]  pFileDesc           pointer to set of ready descriptors
  *  @param[in,out]  pNoDesc             pointer to number of ready descriptors
+ *  @param[out]     pNextJob            earliest time-out of an MD session, cleared if there is none
  */
 
 void trdp_mdCheckPending (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_FDS_T          *pFileDesc,
-    INT32               *pNoDesc)
+    INT32               *pNoDesc,
+    TRDP_TIME_T         *pNextJob)
 {
     int lIndex;
-    MD_ELE_T *iterMD;
-    MD_LIS_ELE_T *iterListener;
 
     /*    Add the socket to the pFileDesc    */
     if (appHandle->tcpFd.listen_sd != VOS_INVALID_SOCKET)
@@ -2515,11 +3220,14 @@ void trdp_mdCheckPending (
         }
     }
 
-    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); lIndex++)
+    /*  UDP sockets are closed when their last listener or session releases them, TCP connections are added
+        once they are ready  */
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_UDP); lIndex++)
     {
         if ((appHandle->ifaceMD[lIndex].sock != VOS_INVALID_SOCKET)
-            && (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
-            && (appHandle->ifaceMD[lIndex].tcpParams.addFileDesc == TRUE))
+            && ((appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_UDP)
+                || ((appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
+                    && (appHandle->ifaceMD[lIndex].tcpParams.addFileDesc == TRUE))))
         {
             FD_SET(appHandle->ifaceMD[lIndex].sock, (fd_set *)pFileDesc); /*lint !e573 !e505
                                                                         signed/unsigned division in macro /
@@ -2531,80 +3239,13 @@ void trdp_mdCheckPending (
         }
     }
 
-    /*  Include MD UDP listener sockets sockets  */
-    for (iterListener = appHandle->pMDListenQueue;
-         iterListener != NULL;
-         iterListener = iterListener->pNext)
+    if (appHandle->numMDTimers > 0u)
     {
-        /*    There can be several sockets depending on TRDP_PD_CONFIG_T    */
-        if ((iterListener->socketIdx != TRDP_INVALID_SOCKET_INDEX)
-            && (appHandle->ifaceMD[iterListener->socketIdx].sock != VOS_INVALID_SOCKET)
-            && ((appHandle->ifaceMD[iterListener->socketIdx].type != TRDP_SOCK_MD_TCP)
-                || ((appHandle->ifaceMD[iterListener->socketIdx].type == TRDP_SOCK_MD_TCP)
-                    && (appHandle->ifaceMD[iterListener->socketIdx].tcpParams.addFileDesc == TRUE))))
-        {
-            if (!FD_ISSET(appHandle->ifaceMD[iterListener->socketIdx].sock, (fd_set *)pFileDesc)) /*lint !e573 !e505
-                                                                                                signed/unsigned division in macro /
-                                                                                                Redundant left argument to comma */
-            {
-                FD_SET(appHandle->ifaceMD[iterListener->socketIdx].sock, (fd_set *)pFileDesc); /*lint !e573 !e505
-                                                                                             signed/unsigned division in macro /
-                                                                                             Redundant left argument to comma */
-                if (appHandle->ifaceMD[iterListener->socketIdx].sock > *pNoDesc)
-                {
-                    *pNoDesc = (INT32) appHandle->ifaceMD[iterListener->socketIdx].sock;
-                }
-            }
-        }
-    }
-
-    /*  Include MD UDP receive sockets */
-    for (iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext)
-    {
-        /*    There can be several sockets depending on TRDP_PD_CONFIG_T    */
-        if ((iterMD->socketIdx != TRDP_INVALID_SOCKET_INDEX)
-            && (appHandle->ifaceMD[iterMD->socketIdx].sock != VOS_INVALID_SOCKET)
-            && ((appHandle->ifaceMD[iterMD->socketIdx].type != TRDP_SOCK_MD_TCP)
-                || ((appHandle->ifaceMD[iterMD->socketIdx].type == TRDP_SOCK_MD_TCP)
-                    && (appHandle->ifaceMD[iterMD->socketIdx].tcpParams.addFileDesc == TRUE))))
-        {
-            if (!FD_ISSET(appHandle->ifaceMD[iterMD->socketIdx].sock, (fd_set *)pFileDesc)) /*lint !e573 !e505
-                                                                                          signed/unsigned division in macro /
-                                                                                          Redundant left argument to comma */
-            {
-                FD_SET(appHandle->ifaceMD[iterMD->socketIdx].sock, (fd_set *)pFileDesc); /*lint !e573 !e505
-                                                                                       signed/unsigned division in macro /
-                                                                                       Redundant left argument to comma */
-                if (appHandle->ifaceMD[iterMD->socketIdx].sock > *pNoDesc)
-                {
-                    *pNoDesc = (INT32) appHandle->ifaceMD[iterMD->socketIdx].sock;
-                }
-            }
-        }
+        *pNextJob = appHandle->ppMDTimers[0]->timeToGo;
     }
-
-    for (iterMD = appHandle->pMDSndQueue; iterMD != NULL; iterMD = iterMD->pNext)
+    else
     {
-        /*    There can be several sockets depending on TRDP_PD_CONFIG_T    */
-        if ((iterMD->socketIdx != TRDP_INVALID_SOCKET_INDEX)
-            && (appHandle->ifaceMD[iterMD->socketIdx].sock != VOS_INVALID_SOCKET)
-            && ((appHandle->ifaceMD[iterMD->socketIdx].type != TRDP_SOCK_MD_TCP)
-                || ((appHandle->ifaceMD[iterMD->socketIdx].type == TRDP_SOCK_MD_TCP)
-                    && (appHandle->ifaceMD[iterMD->socketIdx].tcpParams.addFileDesc == TRUE))))
-        {
-            if (!FD_ISSET(appHandle->ifaceMD[iterMD->socketIdx].sock, (fd_set *)pFileDesc)) /*lint !e573 !e505
-                                                                                          signed/unsigned division in macro /
-                                                                                          Redundant left argument to comma */
-            {
-                FD_SET(appHandle->ifaceMD[iterMD->socketIdx].sock, (fd_set *)pFileDesc); /*lint !e573 !e505
-                                                                                       signed/unsigned division in macro /
-                                                                                       Redundant left argument to comma */
-                if (appHandle->ifaceMD[iterMD->socketIdx].sock >= *pNoDesc)
-                {
-                    *pNoDesc = (INT32) appHandle->ifaceMD[iterMD->socketIdx].sock;
-                }
-            }
-        }
+        vos_clearTime(pNextJob);
     }
 }
 
@@ -2797,12 +3438,12 @@ void  trdp_mdCheckListenSocks (
 
                             if (appHandle->ifaceMD[socketIndex].usage > 0)
                             {
+                                /* The peer opened another connection (its pool is busy), keep both */
                                 vos_printLog(
                                     VOS_LOG_INFO,
-                                    "The new socket accepted from the same device (Ip = %u), won't be removed, because it is still in use\n",
+                                    "The old socket accepted from the same device (Ip = %u) is still in use, both are served\n",
                                     newIp);
-                                socketFound = TRUE;
-                                break;
+                                continue;
                             }
 
                             if (FD_ISSET(appHandle->ifaceMD[socketIndex].sock, (fd_set *) pRfds)) /*lint !e573 !e505
@@ -2888,6 +3529,18 @@ void  trdp_mdCheckListenSocks (
 
             if (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
             {
+                /* Process further messages received with the same read, until the connection fails */
+                while ((err != TRDP_PACKET_ERR)
+                       && (err != TRDP_NODATA_ERR)
+                       && (err != TRDP_CRC_ERR)
+                       && (err != TRDP_WIRE_ERR)
+                       && (err != TRDP_TOPO_ERR)
+                       && (err != TRDP_MEM_ERR)
+                       && (trdp_mdTCPRxPending(appHandle, (UINT32) lIndex) == TRUE))
+                {
+                    err = trdp_mdRecv(appHandle, (UINT32) lIndex);
+                }
+
                 /* The receive message is incomplete */
                 if (err == TRDP_PACKET_ERR)
                 {
@@ -2939,9 +3592,9 @@ void  trdp_mdCheckListenSocks (
 void  trdp_mdCheckTimeouts (
     TRDP_SESSION_PT appHandle)
 {
-    MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
-    BOOL8       firstLoop   = TRUE;
-    BOOL8       timeOut     = FALSE;
+    MD_ELE_T    *iterMD     = NULL;
+    MD_ELE_T    *pExpired   = NULL;
+    MD_ELE_T    * *ppLast   = &pExpired;
     TRDP_TIME_T now;
 
     if (appHandle == NULL)
@@ -2949,38 +3602,27 @@ void  trdp_mdCheckTimeouts (
         return;
     }
 
-    /*  Find the sessions which needs action
-     Note: We must also check the receive queue for pending replies! */
-    do
-    {
-        TRDP_ERR_T resultCode = TRDP_UNKNOWN_ERR;
+    vos_getTime(&now);
 
-        /* Update the current time always inside loop in case of application delays  */
-        vos_getTime(&now);
-
-        /*  Switch to receive queue */
-        if (NULL == iterMD && TRUE == firstLoop)
-        {
-            iterMD      = appHandle->pMDRcvQueue;
-            firstLoop   = FALSE;
-        }
-
-        /*  Are we finished?   */
-        if (NULL == iterMD)
-        {
-            break;
-        }
+    /*  Take the sessions with elapsed timeout off the timer heap, soonest first.
+        Only these need action, the timeToGo of all other sessions of both queues lies in the future. */
+    while ((appHandle->numMDTimers > 0u) &&
+           (0 > vos_cmpTime(&appHandle->ppMDTimers[0]->timeToGo, &now)))     /* timeout overflow */
+    {
+        iterMD = appHandle->ppMDTimers[0];
+        trdp_mdTimerDisarm(appHandle, iterMD);
+        iterMD->pNextExpired    = NULL;
+        *ppLast = iterMD;
+        ppLast  = &iterMD->pNextExpired;
+    }
 
-        /* timeToGo is timeout value! */
-        if (((iterMD->interval.tv_sec != TRDP_MD_INFINITE_TIME) ||
-             (iterMD->interval.tv_usec != TRDP_MD_INFINITE_USEC_TIME)) &&
-            (0 > vos_cmpTime(&iterMD->timeToGo, &now)))     /* timeout overflow */
-        {
-            timeOut = trdp_mdTimeOutStateHandler( iterMD, appHandle, &resultCode);
-        }
+    for (iterMD = pExpired; iterMD != NULL; iterMD = iterMD->pNextExpired)
+    {
+        TRDP_ERR_T resultCode = TRDP_UNKNOWN_ERR;
 
-        if (TRUE == timeOut)    /* Notify user  */
+        if (TRUE == trdp_mdTimeOutStateHandler(iterMD, appHandle, &resultCode))    /* Notify user  */
         {
+            TRDP_TRACE_ELEMENT(MD_TIMEOUT, iterMD, resultCode);
             /* Execute callback */
             if (iterMD->pfCbFunction != NULL)
             {
@@ -2988,9 +3630,17 @@ void  trdp_mdCheckTimeouts (
             }
         }
 
-        iterMD = iterMD->pNext;
+        /*  If the state machine did not set a new timeout, the session is checked again after one management
+            cycle. Re-arming it with the elapsed time would keep tlm_getInterval() at 0. */
+        if ((iterMD->timerIdx == 0u) && (iterMD->morituri == FALSE))
+        {
+            TRDP_TIME_T cycle = {0, TRDP_MD_MAN_CYCLE_TIME};
+
+            iterMD->timeToGo = now;
+            vos_addTime(&iterMD->timeToGo, &cycle);
+            trdp_mdTimerArm(appHandle, iterMD);
+        }
     }
-    while (TRUE); /*lint !e506 */
 
     /* Check for sockets Connection Timeouts */
     /* if ((appHandle->mdDefault.flags & TRDP_FLAGS_TCP) != 0) */
@@ -3004,13 +3654,16 @@ void  trdp_mdCheckTimeouts (
                 && (appHandle->ifaceMD[lIndex].usage == 0)
                 && (appHandle->ifaceMD[lIndex].rcvMostly == FALSE)
                 && ((appHandle->ifaceMD[lIndex].tcpParams.connectionTimeout.tv_sec > 0)
-                    || (appHandle->ifaceMD[lIndex].tcpParams.connectionTimeout.tv_usec > 0)))
+                    || (appHandle->ifaceMD[lIndex].tcpParams.connectionTimeout.tv_usec > 0))
+                && (trdp_mdTCPPoolKeepOpen(appHandle, lIndex) == FALSE))
             {
                 if (0 > vos_cmpTime(&appHandle->ifaceMD[lIndex].tcpParams.connectionTimeout, &now))
                 {
                     vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) TIMEOUT\n", (int) appHandle->ifaceMD[lIndex].sock);
                     appHandle->ifaceMD[lIndex].tcpParams.morituri = TRUE;
+                    appHandle->tcpPoolStats.numIdleClose++;
                 }
+
             }
         }
     }
@@ -3061,6 +3714,207 @@ void  trdp_mdCheckTimeouts (
 
 
 
+/**********************************************************************************************************************/
+/** Check if an unused caller connection is kept open beyond the keep-alive time
+ *  One connection to each configured peer stays open, additional ones opened under load are closed when idle.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      sockIndex           index of the connection in ifaceMD[]
+ *
+ *  @retval         TRUE                first connection to a configured peer
+ *  @retval         FALSE               connection may be closed
+ */
+static BOOL8 trdp_mdTCPPoolKeepOpen (TRDP_SESSION_PT    appHandle,
+                                     INT32              sockIndex)
+{
+    TRDP_IP_ADDR_T  peer = appHandle->ifaceMD[sockIndex].tcpParams.cornerIp;
+    UINT32          i;
+    INT32           lIndex;
+
+    for (i = 0u; i < appHandle->tcpPool.noOfPeers; i++)
+    {
+        if (appHandle->tcpPool.peers[i] == peer)
+        {
+            break;
+        }
+    }
+    if (i == appHandle->tcpPool.noOfPeers)
+    {
+        return FALSE;
+    }
+
+    for (lIndex = 0; lIndex < sockIndex; lIndex++)
+    {
+        if ((appHandle->ifaceMD[lIndex].sock != VOS_INVALID_SOCKET)
+            && (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
+            && (appHandle->ifaceMD[lIndex].rcvMostly == FALSE)
+            && (appHandle->ifaceMD[lIndex].tcpParams.morituri == FALSE)
+            && (appHandle->ifaceMD[lIndex].tcpParams.cornerIp == peer))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Time an unused caller connection is kept open
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         keep-alive time of the TCP pool in us, the default connection timeout if none is configured
+ */
+static UINT32 trdp_mdTCPPoolKeepAlive (TRDP_SESSION_PT appHandle)
+{
+    return (appHandle->tcpPool.keepAlive != 0u) ? appHandle->tcpPool.keepAlive : appHandle->mdDefault.connectTimeout;
+}
+
+/**********************************************************************************************************************/
+/** Find an open TCP connection to a peer which can take another caller session
+ *  Connections about to be closed or failing to send are not shared. Of the suitable connections the one
+ *  with the fewest outstanding sessions is chosen.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSendParam          send parameters of the session
+ *  @param[in]      srcIpAddr           own IP address to send from
+ *  @param[in]      destIpAddr          IP address of the peer
+ *
+ *  @retval         index of the connection in ifaceMD[] or TRDP_INVALID_SOCKET_INDEX
+ */
+static INT32 trdp_mdTCPPoolGet (TRDP_SESSION_PT         appHandle,
+                                const TRDP_SEND_PARAM_T *pSendParam,
+                                TRDP_IP_ADDR_T          srcIpAddr,
+                                TRDP_IP_ADDR_T          destIpAddr)
+{
+    TRDP_IP_ADDR_T  bindAddr    = vos_determineBindAddr(srcIpAddr, 0u, FALSE);
+    INT32           maxUsage    = (appHandle->tcpPool.maxSessionsPerConn == 0u) ?
+                                  (INT32) TRDP_MD_TCP_MAX_SESSIONS_PER_CONN : (INT32) appHandle->tcpPool.maxSessionsPerConn;
+    INT32           found       = TRDP_INVALID_SOCKET_INDEX;
+    INT32           lIndex;
+
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); lIndex++)
+    {
+        const TRDP_SOCKETS_T *pIface = &appHandle->ifaceMD[lIndex];
+
+        if ((pIface->sock != VOS_INVALID_SOCKET)
+            && (pIface->type == TRDP_SOCK_MD_TCP)
+            && (pIface->rcvMostly == FALSE)
+            && (pIface->tcpParams.cornerIp == destIpAddr)
+            && (pIface->tcpParams.morituri == FALSE)
+            && (pIface->tcpParams.sendNotOk == FALSE)
+            && (pIface->usage < maxUsage)
+            && ((bindAddr == 0u) || (pIface->bindAddr == bindAddr))
+            && (pIface->sendParam.qos == pSendParam->qos)
+            && (pIface->sendParam.ttl == pSendParam->ttl)
+            && (pIface->sendParam.tsn == pSendParam->tsn)
+            && (pIface->sendParam.vlan == pSendParam->vlan)
+            && ((found == TRDP_INVALID_SOCKET_INDEX) || (pIface->usage < appHandle->ifaceMD[found].usage)))
+        {
+            found = lIndex;
+        }
+    }
+    return found;
+}
+
+/**********************************************************************************************************************/
+/** Configure the TCP connection pool and connect to the configured peers
+ *  Connections to the peers are opened without waiting for the handshake to finish and kept open while unused.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pConfig             pool configuration
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      too many peers
+ *  @retval         TRDP_SOCK_ERR       no socket available
+ */
+TRDP_ERR_T trdp_mdTCPPoolConfig (TRDP_SESSION_PT                    appHandle,
+                                 const TRDP_MD_TCP_POOL_CONFIG_T    *pConfig)
+{
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      i;
+
+    if (pConfig->noOfPeers > TRDP_MD_TCP_POOL_MAX_PEERS)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    appHandle->tcpPool = *pConfig;
+
+    for (i = 0u; i < pConfig->noOfPeers; i++)
+    {
+        INT32 sockIndex = trdp_mdTCPPoolGet(appHandle, &appHandle->mdDefault.sendParam, appHandle->realIP,
+                                            pConfig->peers[i]);
+        if (sockIndex != TRDP_INVALID_SOCKET_INDEX)
+        {
+            /* Already connected */
+            continue;
+        }
+
+        err = trdp_requestSocket(appHandle->ifaceMD,
+                                 appHandle->mdDefault.tcpPort,
+                                 &appHandle->mdDefault.sendParam,
+                                 appHandle->realIP, 0u,
+                                 TRDP_SOCK_MD_TCP,
+                                 TRDP_OPTION_NONE,
+                                 FALSE,
+                                 VOS_INVALID_SOCKET,
+                                 &sockIndex,
+                                 pConfig->peers[i]);
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "No socket to connect to %s (Err: %d)\n",
+                         vos_ipDotted(pConfig->peers[i]), err);
+            break;
+        }
+
+        /* The handshake is finished by the connect() of the first session */
+        switch (vos_sockConnect(appHandle->ifaceMD[sockIndex].sock, pConfig->peers[i], appHandle->mdDefault.tcpPort))
+        {
+           case VOS_NO_ERR:
+               appHandle->ifaceMD[sockIndex].tcpParams.connected = TRUE;
+               break;
+           case VOS_BLOCK_ERR:
+               break;
+           default:
+               vos_printLog(VOS_LOG_WARNING, "Connecting to %s failed, retried on first use\n",
+                            vos_ipDotted(pConfig->peers[i]));
+               break;
+        }
+        vos_printLog(VOS_LOG_INFO, "Opened TCP connection to %s in advance (Socket: %d)\n",
+                     vos_ipDotted(pConfig->peers[i]), (int) appHandle->ifaceMD[sockIndex].sock);
+
+        /* No user yet, kept open by trdp_mdCheckTimeouts() */
+        trdp_releaseSocket(appHandle->ifaceMD, sockIndex, trdp_mdTCPPoolKeepAlive(appHandle), FALSE, VOS_INADDR_ANY);
+        appHandle->tcpPoolStats.numWarmUp++;
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Return the TCP connection pool counters
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[out]     pStatistics         pool counters
+ */
+void trdp_mdTCPPoolStatistics (TRDP_SESSION_PT                  appHandle,
+                               TRDP_MD_TCP_POOL_STATISTICS_T    *pStatistics)
+{
+    INT32 lIndex;
+
+    *pStatistics = appHandle->tcpPoolStats;
+    pStatistics->numConnections = 0u;
+
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); lIndex++)
+    {
+        if ((appHandle->ifaceMD[lIndex].sock != VOS_INVALID_SOCKET)
+            && (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
+            && (appHandle->ifaceMD[lIndex].rcvMostly == FALSE))
+        {
+            pStatistics->numConnections++;
+        }
+    }
+}
+
 /**********************************************************************************************************************/
 /*reply side functions*/
 static TRDP_ERR_T trdp_mdConnectSocket (TRDP_APP_SESSION_T      appHandle,
@@ -3076,37 +3930,59 @@ static TRDP_ERR_T trdp_mdConnectSocket (TRDP_APP_SESSION_T      appHandle,
     {
         if ( pSenderElement->socketIdx == TRDP_INVALID_SOCKET_INDEX )
         {
-            /* socket to send TCP MD for request or notify only */
-            err = trdp_requestSocket(appHandle->ifaceMD,
-                                     appHandle->mdDefault.tcpPort,
-                                     (pSendParam != NULL) ?
-                                     pSendParam : (&appHandle->mdDefault.sendParam),
-                                     srcIpAddr, 0, /* no TCP multicast possible */
-                                     TRDP_SOCK_MD_TCP,
-                                     TRDP_OPTION_NONE,
-                                     FALSE,
-                                     VOS_INVALID_SOCKET,
-                                     &pSenderElement->socketIdx,
-                                     destIpAddr);
-
-            if ( TRDP_NO_ERR != err )
+            /* Share an open connection to the peer, the replies are told apart by their session ID */
+            pSenderElement->socketIdx = trdp_mdTCPPoolGet(appHandle,
+                                                          (pSendParam != NULL) ?
+                                                          pSendParam : (&appHandle->mdDefault.sendParam),
+                                                          srcIpAddr,
+                                                          destIpAddr);
+            if ( pSenderElement->socketIdx != TRDP_INVALID_SOCKET_INDEX )
             {
-                /* Error getting socket, exit function */
-                return err;
+                TRDP_SOCKETS_T *pIface = &appHandle->ifaceMD[pSenderElement->socketIdx];
+
+                if ( pIface->usage > 0 )
+                {
+                    appHandle->tcpPoolStats.numMultiplexed++;
+                }
+                appHandle->tcpPoolStats.numReuse++;
+                pIface->usage++;
+                pIface->tcpParams.connectionTimeout.tv_sec  = 0;
+                pIface->tcpParams.connectionTimeout.tv_usec = 0;
+            }
+            else
+            {
+                /* socket to send TCP MD for request or notify only */
+                err = trdp_requestSocket(appHandle->ifaceMD,
+                                         appHandle->mdDefault.tcpPort,
+                                         (pSendParam != NULL) ?
+                                         pSendParam : (&appHandle->mdDefault.sendParam),
+                                         srcIpAddr, 0, /* no TCP multicast possible */
+                                         TRDP_SOCK_MD_TCP,
+                                         TRDP_OPTION_NONE,
+                                         FALSE,
+                                         VOS_INVALID_SOCKET,
+                                         &pSenderElement->socketIdx,
+                                         destIpAddr);
+
+                if ( TRDP_NO_ERR != err )
+                {
+                    /* Error getting socket, exit function */
+                    return err;
+                }
+                appHandle->tcpPoolStats.numConnect++;
             }
         }
 
-        /* In the case that it is the first connection, do connect() */
-        if ( appHandle->ifaceMD[pSenderElement->socketIdx].usage > 1 )
+        /* connect() until the connection is established, later sessions on the connection just send */
+        if ( appHandle->ifaceMD[pSenderElement->socketIdx].tcpParams.connected == TRUE )
         {
             pSenderElement->tcpParameters.doConnect = FALSE;
         }
         else
         {
             pSenderElement->tcpParameters.doConnect = TRUE;
-            /*  Ticket #Usage should be handled inside trdp_requestSocket() only, if it returns without error, usage is incremented
-                appHandle->ifaceMD[pSenderElement->socketIdx].usage++; */
         }
+
     }
     else if ( TRUE == newSession
               && TRDP_INVALID_SOCKET_INDEX == pSenderElement->socketIdx )
@@ -3212,7 +4088,7 @@ static void trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
             pSenderElement->grossSize = trdp_packetSizeMD(destSize);
             pSenderElement->dataSize = destSize;
         }
-        else
+        else if (pSenderElement->pPacket->data != pData)    /* a lent buffer holds the data already */
         {
             memcpy(pSenderElement->pPacket->data, pData, dataSize);
         }
@@ -3222,8 +4098,12 @@ static void trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
     if ( TRUE == newSession )
     {
             trdp_MDqueueAppLast(&appHandle->pMDSndQueue, pSenderElement);
+            trdp_mdSessionInsert(appHandle->pMDSndSessions, pSenderElement);
     }
 
+    /* the timeout may have been (re-)set by the caller */
+    trdp_mdTimerArm(appHandle, pSenderElement);
+
     vos_printLog(VOS_LOG_INFO,
                  "MD sender element state = %d, msgType=%c%c\n",
                  pSenderElement->stateEle,
@@ -3232,6 +4112,125 @@ static void trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
                  );
 }
 
+/**********************************************************************************************************************/
+/** Allocate a packet buffer to be lent to the application
+ *  The application fills the payload in place and passes it to one of the tlm_*Buffer() send functions, which send
+ *  the buffer without copying. Until then, the buffer is kept in the list of lent buffers of the session.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      dataSize            payload size the buffer is able to hold
+ *
+ *  @retval         pointer to the payload of the buffer, NULL if out of memory
+ */
+UINT8 *trdp_mdBufferAlloc (
+    TRDP_SESSION_PT appHandle,
+    UINT32          dataSize)
+{
+    TRDP_MD_LENT_BUF_T *pLent = (TRDP_MD_LENT_BUF_T *) vos_memAlloc(sizeof(TRDP_MD_LENT_BUF_T));
+
+    if (pLent == NULL)
+    {
+        return NULL;
+    }
+    pLent->pPacket = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(dataSize));
+    if (pLent->pPacket == NULL)
+    {
+        vos_memFree(pLent);
+        return NULL;
+    }
+    pLent->capacity = dataSize;
+
+    if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        vos_memFree(pLent->pPacket);
+        vos_memFree(pLent);
+        return NULL;
+    }
+    pLent->pNext            = appHandle->pMDLentBufs;
+    appHandle->pMDLentBufs  = pLent;
+    (void) vos_mutexUnlock(appHandle->mutexMD);
+
+    return pLent->pPacket->data;
+}
+
+/**********************************************************************************************************************/
+/** Take back the packet buffer of a payload pointer returned by trdp_mdBufferAlloc()
+ *  Only pointers found in the list of lent buffers of the session are accepted, the buffer is removed from the list.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pData               payload pointer
+ *  @param[in]      dataSize            payload size to be sent
+ *
+ *  @retval         packet buffer, NULL if pData is not a lent buffer or dataSize exceeds its capacity
+ */
+MD_PACKET_T *trdp_mdBufferGet (
+    TRDP_SESSION_PT appHandle,
+    UINT8           *pData,
+    UINT32          dataSize)
+{
+    TRDP_MD_LENT_BUF_T  * *ppLent;
+    TRDP_MD_LENT_BUF_T  *pLent  = NULL;
+    MD_PACKET_T         *pBuffer = NULL;
+
+    if ((pData == NULL)
+        || (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR))
+    {
+        return NULL;
+    }
+    for (ppLent = &appHandle->pMDLentBufs; *ppLent != NULL; ppLent = &(*ppLent)->pNext)
+    {
+        if ((*ppLent)->pPacket->data == pData)
+        {
+            if (dataSize <= (*ppLent)->capacity)
+            {
+                pLent   = *ppLent;
+                *ppLent = pLent->pNext;
+            }
+            break;
+        }
+    }
+    (void) vos_mutexUnlock(appHandle->mutexMD);
+
+    if (pLent != NULL)
+    {
+        pBuffer = pLent->pPacket;
+        vos_memFree(pLent);
+    }
+    return pBuffer;
+}
+
+/**********************************************************************************************************************/
+/** Release a packet buffer taken back by trdp_mdBufferGet()
+ *
+ *  @param[in]      pBuffer             packet buffer, may be NULL
+ */
+void trdp_mdBufferFree (
+    MD_PACKET_T *pBuffer)
+{
+    if (pBuffer != NULL)
+    {
+        vos_memFree(pBuffer);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Release the packet buffers still lent to the application when the session is closed
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_mdBufferFreeAll (
+    TRDP_SESSION_PT appHandle)
+{
+    while (appHandle->pMDLentBufs != NULL)
+    {
+        TRDP_MD_LENT_BUF_T *pNext = appHandle->pMDLentBufs->pNext;
+
+        vos_memFree(appHandle->pMDLentBufs->pPacket);
+        vos_memFree(appHandle->pMDLentBufs);
+        appHandle->pMDLentBufs = pNext;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Send a MD reply/reply query message.
  *  Send either a MD reply message or a MD reply query message after receiving a request and ask for confirmation.
@@ -3247,6 +4246,8 @@ static void trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
  *  @param[in]      pData               pointer to packet data / dataset
  *  @param[in]      dataSize            size of packet data
  *  @param[in]      pSrcURI          pointer to source URI, can be set by user
+ *  @param[in]      pBuffer             packet buffer lent by trdp_mdBufferAlloc() holding pData, NULL to copy pData.
+ *                                      The buffer is taken over, also on error.
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
@@ -3262,8 +4263,10 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                          const TRDP_SEND_PARAM_T    *pSendParam,
                          const UINT8                *pData,
                          UINT32                     dataSize,
-                         const TRDP_URI_USER_T      *pSrcURI)
+                         const TRDP_URI_USER_T      *pSrcURI,
+                         MD_PACKET_T                *pBuffer)
 {
+
     TRDP_IP_ADDR_T  srcIpAddr;
     TRDP_IP_ADDR_T  destIpAddr;
     TRDP_URI_USER_T *destURI    = NULL;
@@ -3277,23 +4280,26 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
         &&
         (msgType != TRDP_MSG_MQ))
     {
+        trdp_mdBufferFree(pBuffer);
         return TRDP_PARAM_ERR;
     }
 
     /* lock mutex */
     if ( vos_mutexLock(appHandle->mutex) != VOS_NO_ERR )
     {
+        trdp_mdBufferFree(pBuffer);
         return TRDP_MUTEX_ERR;
     }
     if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
     {
         (void) vos_mutexUnlock(appHandle->mutex);
+        trdp_mdBufferFree(pBuffer);
         return TRDP_MUTEX_ERR;
     }
 
     if ( pSessionId )
     {
-        errv = trdp_mdLookupElement((MD_ELE_T *)appHandle->pMDRcvQueue,
+        errv = trdp_mdLookupElement(appHandle->pMDRcvSessions,
                                     TRDP_ST_RX_REQ_W4AP_REPLY,
                                     pSessionId,
                                     &pSenderElement);
@@ -3324,7 +4330,7 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                 pSenderElement->pCachedDS       = NULL;
                 pSenderElement->morituri        = FALSE;
                 trdp_mdFillStateElement(msgType, pSenderElement);
-                trdp_mdManageSessionId(pSessionId, pSenderElement);
+                trdp_mdManageSessionId(appHandle, pSessionId, pSenderElement);
 
                 if ( msgType == TRDP_MSG_MQ )
                 {
@@ -3344,11 +4350,20 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                 {
                     if ( NULL != pSenderElement->pPacket )
                     {
-                        vos_memFree(pSenderElement->pPacket);
-                        pSenderElement->pPacket = NULL;
+                        trdp_mdReleasePacket(appHandle, pSenderElement);
+                    }
+                    if ((NULL != pBuffer) &&
+                        !((pSenderElement->pktFlags & TRDP_FLAGS_MARSHALL) && (appHandle->marshall.pfCbMarshall != NULL)))
+                    {
+                        /* send the lent buffer, it holds the data already */
+                        pSenderElement->pPacket = pBuffer;
+                        pBuffer = NULL;
+                    }
+                    else
+                    {
+                        /* allocate a buffer for the data   */
+                        pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
                     }
-                    /* allocate a buffer for the data   */
-                    pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
                     if ( NULL == pSenderElement->pPacket )
                     {
                         vos_memFree(pSenderElement);
@@ -3392,9 +4407,13 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
         vos_printLogStr(VOS_LOG_ERROR, "vos_mutexUnlock() failed\n");
     }
 
+    /* The lent buffer was not sent or its data was marshalled */
+    trdp_mdBufferFree(pBuffer);
+
     return errv;    /*lint !e438 unused pSenderElement */
 }
 
+
 /**********************************************************************************************************************/
 /** Initiate sending MD request message - private SW level
  *  Send a MD request message
@@ -3419,6 +4438,8 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
  *  @param[in]      dataSize            size of packet data
  *  @param[in]      srcURI              only functional group of source URI
  *  @param[in]      destURI             only functional group of destination URI
+ *  @param[in]      pBuffer             packet buffer lent by trdp_mdBufferAlloc() holding pData, NULL to copy pData.
+ *                                      The buffer is taken over, also on error.
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
@@ -3443,7 +4464,8 @@ TRDP_ERR_T trdp_mdCall (
     const UINT8             *pData,
     UINT32                  dataSize,
     const TRDP_URI_USER_T   srcURI,
-    const TRDP_URI_USER_T   destURI)
+    const TRDP_URI_USER_T   destURI,
+    MD_PACKET_T             *pBuffer)
 {
     TRDP_ERR_T  errv = TRDP_NO_ERR;
     MD_ELE_T    *pSenderElement = NULL;
@@ -3454,12 +4476,14 @@ TRDP_ERR_T trdp_mdCall (
     if (((msgType != TRDP_MSG_MR) && (msgType != TRDP_MSG_MN))
         || ((pSendParam != NULL) && (pSendParam->retries > TRDP_MAX_MD_RETRIES)))
     {
+        trdp_mdBufferFree(pBuffer);
         return TRDP_PARAM_ERR;
     }
 
     /* lock mutex */
     if ( vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR )
     {
+        trdp_mdBufferFree(pBuffer);
         return TRDP_MUTEX_ERR;
     }
 
@@ -3557,7 +4581,7 @@ TRDP_ERR_T trdp_mdCall (
         {
             trdp_mdFillStateElement(msgType, pSenderElement);
 
-            trdp_mdManageSessionId((UINT8 *)pSessionId, pSenderElement);
+            trdp_mdManageSessionId(appHandle, (UINT8 *)pSessionId, pSenderElement);
 
             /*
              (Re-)allocate the data buffer if current size is different from requested size.
@@ -3565,11 +4589,20 @@ TRDP_ERR_T trdp_mdCall (
              */
             if ( NULL != pSenderElement->pPacket )
             {
-                vos_memFree(pSenderElement->pPacket);
-                pSenderElement->pPacket = NULL;
+                trdp_mdReleasePacket(appHandle, pSenderElement);
+            }
+            if ((NULL != pBuffer) &&
+                !((pSenderElement->pktFlags & TRDP_FLAGS_MARSHALL) && (appHandle->marshall.pfCbMarshall != NULL)))
+            {
+                /* send the lent buffer, it holds the data already */
+                pSenderElement->pPacket = pBuffer;
+                pBuffer = NULL;
+            }
+            else
+            {
+                /* allocate a buffer for the data   */
+                pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
             }
-            /* allocate a buffer for the data   */
-            pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
             if ( NULL == pSenderElement->pPacket )
             {
                 vos_memFree(pSenderElement);
@@ -3577,6 +4610,7 @@ TRDP_ERR_T trdp_mdCall (
                 errv = TRDP_MEM_ERR;
 
             }
+
             else
             {
                 trdp_mdDetailSenderPacket(msgType,
@@ -3602,7 +4636,7 @@ TRDP_ERR_T trdp_mdCall (
     if ( TRDP_NO_ERR != errv &&
          NULL != pSenderElement )
     {
-        trdp_mdFreeSession(pSenderElement);
+        trdp_mdFreeSession(appHandle, pSenderElement);
         pSenderElement = NULL;
     }
 
@@ -3612,10 +4646,268 @@ TRDP_ERR_T trdp_mdCall (
         vos_printLogStr(VOS_LOG_ERROR, "vos_mutexUnlock() failed\n");
     }
 
+    /* The lent buffer was not sent or its data was marshalled */
+    trdp_mdBufferFree(pBuffer);
+
     return errv;    /*lint !e438 unused pSenderElement */
 }
 
 
+/**********************************************************************************************************************/
+/** Report the result of a batched notification
+ *
+ *  @param[in,out]  pResults            results per notification or NULL
+ *  @param[in]      itemIdx             index of the notification
+ *  @param[in]      result              its result
+ *  @param[in,out]  pFirstErr           error of the first notification not sent
+ */
+static void trdp_mdNotifyResult (TRDP_ERR_T *pResults,
+                                 UINT32     itemIdx,
+                                 TRDP_ERR_T result,
+                                 TRDP_ERR_T *pFirstErr)
+{
+    if (pResults != NULL)
+    {
+        pResults[itemIdx] = result;
+    }
+    if ((*pFirstErr == TRDP_NO_ERR) && (result != TRDP_NO_ERR))
+    {
+        *pFirstErr = result;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Send a batch of MD notifications - private SW level
+ *  The packets are built under one lock in the session's notification arena and sent at once, without queueing an
+ *  element per notification. Notifications carry no session ID, so none is generated.
+ *  Sending goes on behind a notification which could not be sent, its error is reported in pResults.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_init
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
+ *  @param[in]      pktFlags            OPTION:
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *  @param[in]      pItems              notifications to send
+ *  @param[in]      noOfItems           number of notifications
+ *  @param[out]     pResults            result per notification, NULL if not needed
+ *
+ *  @retval         TRDP_NO_ERR         all notifications sent
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MUTEX_ERR      mutex error
+ *  @retval         != TRDP_NO_ERR      result of the first notification not sent
+ */
+TRDP_ERR_T trdp_mdNotifyBatch (
+    TRDP_SESSION_PT             appHandle,
+    UINT32                      etbTopoCnt,
+    UINT32                      opTrnTopoCnt,
+    TRDP_IP_ADDR_T              srcIpAddr,
+    TRDP_FLAGS_T                pktFlags,
+    const TRDP_SEND_PARAM_T     *pSendParam,
+    const TRDP_MD_NOTIFY_ITEM_T *pItems,
+    UINT32                      noOfItems,
+    TRDP_ERR_T                  *pResults)
+{
+    VOS_DGRAM_T     dgram[VOS_MAX_DGRAM_CNT];
+    UINT32          itemIdx[VOS_MAX_DGRAM_CNT];
+    TRDP_ERR_T      result;
+    TRDP_ERR_T      errv    = TRDP_NO_ERR;
+    INT32           sockIdx = TRDP_INVALID_SOCKET_INDEX;
+    UINT32          first;
+    UINT32          next;
+    UINT32          i;
+    UINT32          j;
+    UINT32          cnt;
+    UINT32          built;
+    UINT32          noSent;
+    UINT32          arenaSize;
+    VOS_ERR_T       err;
+
+    if (pktFlags == TRDP_FLAGS_DEFAULT)
+    {
+        pktFlags = appHandle->mdDefault.flags;
+    }
+    if ((pktFlags & TRDP_FLAGS_TCP) != 0)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (pSendParam == NULL)
+    {
+        pSendParam = &appHandle->mdDefault.sendParam;
+    }
+
+    if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+
+    /* set correct source IP address */
+    if (srcIpAddr == 0u)
+    {
+        srcIpAddr = appHandle->realIP;
+    }
+
+    /* One socket for the whole batch */
+    result = trdp_requestSocket(appHandle->ifaceMD,
+                                appHandle->mdDefault.udpPort,
+                                pSendParam,
+                                srcIpAddr,
+                                0u,
+                                TRDP_SOCK_MD_UDP,
+                                appHandle->option,
+                                FALSE,
+                                VOS_INVALID_SOCKET,
+                                &sockIdx,
+                                0u);
+    if (result != TRDP_NO_ERR)
+    {
+        for (i = 0u; i < noOfItems; i++)
+        {
+            trdp_mdNotifyResult(pResults, i, result, &errv);
+        }
+        noOfItems = 0u;
+    }
+
+    for (first = 0u; first < noOfItems; first = next)
+    {
+        /* Collect the next notifications to send with one call */
+        arenaSize   = 0u;
+        cnt         = 0u;
+        for (next = first; (next < noOfItems) && (cnt < VOS_MAX_DGRAM_CNT); next++)
+        {
+            if (((pItems[next].pData == NULL) && (pItems[next].dataSize != 0u))
+                || (pItems[next].dataSize > TRDP_MAX_MD_DATA_SIZE))
+            {
+                trdp_mdNotifyResult(pResults, next, TRDP_PARAM_ERR, &errv);
+            }
+            else
+            {
+                itemIdx[cnt++]  = next;
+                arenaSize      += trdp_packetSizeMD(pItems[next].dataSize);
+            }
+        }
+        if (cnt == 0u)
+        {
+            continue;
+        }
+
+        /* The arena grows to the largest chunk sent and is kept for the next batch */
+        if (arenaSize > appHandle->mdNotifyArenaSize)
+        {
+            if (appHandle->pMDNotifyArena != NULL)
+            {
+                vos_memFree(appHandle->pMDNotifyArena);
+            }
+            appHandle->pMDNotifyArena = (UINT8 *) vos_memAlloc(arenaSize);
+            appHandle->mdNotifyArenaSize = (appHandle->pMDNotifyArena != NULL) ? arenaSize : 0u;
+        }
+
+        if (appHandle->pMDNotifyArena == NULL)
+        {
+            for (i = 0u; i < cnt; i++)
+            {
+                trdp_mdNotifyResult(pResults, itemIdx[i], TRDP_MEM_ERR, &errv);
+            }
+            continue;
+        }
+
+        /* Build the packets, a notification which cannot be marshalled is left out */
+        arenaSize   = 0u;
+        built       = 0u;
+        for (i = 0u; i < cnt; i++)
+        {
+            const TRDP_MD_NOTIFY_ITEM_T *pItem  = &pItems[itemIdx[i]];
+            UINT32                      dataSize = pItem->dataSize;
+            MD_PACKET_T                 *pPacket;
+
+            pPacket = (MD_PACKET_T *) (appHandle->pMDNotifyArena + arenaSize);
+
+            memset(&pPacket->frameHead, 0, sizeof(MD_HEADER_T));
+            pPacket->frameHead.protocolVersion  = vos_htons(TRDP_PROTO_VER);
+            pPacket->frameHead.msgType          = vos_htons((UINT16) TRDP_MSG_MN);
+            pPacket->frameHead.comId            = vos_htonl(pItem->comId);
+            pPacket->frameHead.etbTopoCnt       = vos_htonl(etbTopoCnt);
+            pPacket->frameHead.opTrnTopoCnt     = vos_htonl(opTrnTopoCnt);
+
+            if (pItem->pData != NULL)
+            {
+                if ((pktFlags & TRDP_FLAGS_MARSHALL) && (appHandle->marshall.pfCbMarshall != NULL))
+                {
+                    TRDP_DATASET_T *pCachedDS = NULL;
+
+                    result = appHandle->marshall.pfCbMarshall(appHandle->marshall.pRefCon,
+                                                              pItem->comId,
+                                                              (UINT8 *) pItem->pData,
+                                                              pItem->dataSize,
+                                                              pPacket->data,
+                                                              &dataSize,
+                                                              &pCachedDS);
+                    if (result != TRDP_NO_ERR)
+                    {
+                        vos_printLog(VOS_LOG_WARNING, "Batched notification of comId %u not marshalled (Err: %d)\n",
+                                     pItem->comId, result);
+                        trdp_mdNotifyResult(pResults, itemIdx[i], result, &errv);
+                        continue;
+                    }
+                }
+                else
+                {
+                    memcpy(pPacket->data, pItem->pData, dataSize);
+                }
+            }
+            pPacket->frameHead.datasetLength = vos_htonl(dataSize);
+
+            dgram[built].pBuffer    = (const UINT8 *) pPacket;
+            dgram[built].size       = trdp_packetSizeMD(dataSize);
+            dgram[built].ipAddress  = pItem->destIpAddr;
+            dgram[built].port       = appHandle->mdDefault.udpPort;
+
+            /* zero the padding */
+            memset(pPacket->data + dataSize, 0, dgram[built].size - sizeof(MD_HEADER_T) - dataSize);
+
+            pPacket->frameHead.frameCheckSum = MAKE_LE(vos_crc32(INITFCS,
+                                                                 (UINT8 *) &pPacket->frameHead,
+                                                                 sizeof(MD_HEADER_T) - SIZE_OF_FCS));
+            arenaSize          += dgram[built].size;
+            itemIdx[built++]    = itemIdx[i];
+        }
+        cnt = built;
+
+        /* Send them, a notification which could not be sent is skipped */
+        for (i = 0u; i < cnt; i += noSent + 1u)
+        {
+            err = vos_sockSendUDPv(appHandle->ifaceMD[sockIdx].sock, &dgram[i], cnt - i, &noSent);
+            appHandle->stats.udpMd.numSend += noSent;
+            for (j = i; j < i + noSent; j++)
+            {
+                TRDP_TRACE_EVENT(MD_SEND, pItems[itemIdx[j]].comId, 0u, appHandle->realIP, dgram[j].size, TRDP_MSG_MN);
+                trdp_mdNotifyResult(pResults, itemIdx[j], TRDP_NO_ERR, &errv);
+            }
+            if (err == VOS_NO_ERR)
+            {
+                break;
+            }
+            vos_printLog(VOS_LOG_WARNING, "Batched notification of comId %u not sent (Err: %d)\n",
+                         pItems[itemIdx[i + noSent]].comId, err);
+            trdp_mdNotifyResult(pResults, itemIdx[i + noSent],
+                                (err == VOS_BLOCK_ERR) ? TRDP_BLOCK_ERR : TRDP_IO_ERR, &errv);
+        }
+    }
+
+    if (sockIdx != TRDP_INVALID_SOCKET_INDEX)
+    {
+        trdp_releaseSocket(appHandle->ifaceMD, sockIdx, 0u, FALSE, VOS_INADDR_ANY);
+    }
+
+    if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_mutexUnlock() failed\n");
+    }
+
+    return errv;
+}
+
 /**********************************************************************************************************************/
 /** Initiate sending MD confirm message - private SW level
  *  Send a MD confirmation message
@@ -3661,7 +4953,7 @@ TRDP_ERR_T trdp_mdConfirm (
 
     if ( pSessionId )
     {
-        errv = trdp_mdLookupElement((MD_ELE_T *)appHandle->pMDSndQueue,
+        errv = trdp_mdLookupElement(appHandle->pMDSndSessions,
                                     TRDP_ST_TX_REQ_W4AP_CONFIRM,
                                     (const UINT8 *)pSessionId,
                                     &pSenderElement);
@@ -3708,8 +5000,7 @@ TRDP_ERR_T trdp_mdConfirm (
 
                 if ( NULL != pSenderElement->pPacket )
                 {
-                    vos_memFree(pSenderElement->pPacket);
-                    pSenderElement->pPacket = NULL;
+                    trdp_mdReleasePacket(appHandle, pSenderElement);
                 }
                 /* allocate a buffer for the data   */
                 pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
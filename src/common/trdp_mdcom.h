@@ -17,6 +17,12 @@
  /*
  * $Id$
  *
+ *      BL 2026-10-18: trdp_mdNotifyBatch() sends a batch of notifications at once
+ *      BL 2026-10-18: MD receive buffer pool, trdp_mdFreeSession() takes the session pointer
+ *      BL 2026-10-18: Lent MD packet buffers (trdp_mdBufferAlloc/Get/Free), pBuffer parameter of trdp_mdCall/Reply
+ *      BL 2026-10-18: TCP MD connection pool
+ *      BL 2026-10-18: MD listener dispatch table
+ *      BL 2026-10-18: MD session index by session ID
  *      BL 2020-07-29: Ticket #286 tlm_reply() is missing a sourceURI parameter as defined in the standard
  *     AHW 2017-11-08: Ticket #179 Max. number of retries (part of sendParam) of a MD request needs to be checked
  *      BL 2014-07-14: Ticket #46: Protocol change: operational topocount needed
@@ -50,7 +56,39 @@ TRDP_ERR_T  trdp_mdGetTCPSocket (
     TRDP_SESSION_PT pSession);
 
 void        trdp_mdFreeSession (
-    MD_ELE_T *pMDSession);
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pMDSession);
+
+void        trdp_mdRcvPoolFree (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_mdListenerInsert (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pListener);
+
+void        trdp_mdListenerRemove (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pListener);
+
+MD_ELE_T    *trdp_mdSessionBucket (
+    MD_ELE_T    * const *ppTable,
+    const UINT8 *pSessionId);
+
+void        trdp_mdSessionInsert (
+    MD_ELE_T    * *ppTable,
+    MD_ELE_T    *pElement);
+
+void        trdp_mdSessionRemove (
+    MD_ELE_T    * *ppTable,
+    MD_ELE_T    *pElement);
+
+TRDP_ERR_T  trdp_mdTCPPoolConfig (
+    TRDP_SESSION_PT                 appHandle,
+    const TRDP_MD_TCP_POOL_CONFIG_T *pConfig);
+
+void        trdp_mdTCPPoolStatistics (
+    TRDP_SESSION_PT                 appHandle,
+    TRDP_MD_TCP_POOL_STATISTICS_T   *pStatistics);
 
 TRDP_ERR_T  trdp_mdSend (
     TRDP_SESSION_PT appHandle);
@@ -58,7 +96,8 @@ TRDP_ERR_T  trdp_mdSend (
 void        trdp_mdCheckPending (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_FDS_T          *pFileDesc,
-    INT32               *pNoDesc);
+    INT32               *pNoDesc,
+    TRDP_TIME_T         *pNextJob);
 
 void trdp_mdCheckListenSocks (
     const TRDP_SESSION_PT appHandle,
@@ -105,7 +144,8 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T        msgType,
                          const TRDP_SEND_PARAM_T *pSendParam,
                          const UINT8             *pData,
                          UINT32                  dataSize,
-                         const TRDP_URI_USER_T   *pSourceURI);
+                         const TRDP_URI_USER_T   *pSourceURI,
+                         MD_PACKET_T             *pBuffer);
 
 TRDP_ERR_T trdp_mdCall (const TRDP_MSG_T        msgType,
                         TRDP_APP_SESSION_T      appHandle,
@@ -125,5 +165,31 @@ TRDP_ERR_T trdp_mdCall (const TRDP_MSG_T        msgType,
                         const UINT8             *pData,
                         UINT32                  dataSize,
                         const TRDP_URI_USER_T   srcURI,
-                        const TRDP_URI_USER_T   destURI);
+                        const TRDP_URI_USER_T   destURI,
+                        MD_PACKET_T             *pBuffer);
+
+TRDP_ERR_T trdp_mdNotifyBatch (TRDP_SESSION_PT              appHandle,
+                               UINT32                       etbTopoCnt,
+                               UINT32                       opTrnTopoCnt,
+                               TRDP_IP_ADDR_T               srcIpAddr,
+                               TRDP_FLAGS_T                 pktFlags,
+                               const TRDP_SEND_PARAM_T      *pSendParam,
+                               const TRDP_MD_NOTIFY_ITEM_T  *pItems,
+                               UINT32                       noOfItems,
+                               TRDP_ERR_T                   *pResults);
+
+UINT8       *trdp_mdBufferAlloc (
+    TRDP_SESSION_PT appHandle,
+    UINT32          dataSize);
+
+MD_PACKET_T *trdp_mdBufferGet (
+    TRDP_SESSION_PT appHandle,
+    UINT8           *pData,
+    UINT32          dataSize);
+
+void        trdp_mdBufferFree (
+    MD_PACKET_T *pBuffer);
+
+void        trdp_mdBufferFreeAll (
+    TRDP_SESSION_PT appHandle);
 #endif
@@ -0,0 +1,258 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_mdcompletion.c
+ *
+ * @brief           MD completion queue
+ *
+ * @details         Results of MD sessions (notifications, requests, replies, confirmations and timeouts) are posted
+ *                  as fixed-size records to a queue. Any application thread can wait on it or take the records in
+ *                  batches, it is not bound to the thread processing MD.
+ *
+ *                  The records are allocated once. Unused records are kept in a lock-free ring the posting side
+ *                  takes them from, posted records are passed on through a second one. Records are posted while
+ *                  mutexMD is held, so both rings have a single consumer each: the posting MD processing for the
+ *                  unused records, the application for the posted ones. Only a waiting application thread is woken
+ *                  by a semaphore, posting and polling need no system call otherwise.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ *      BL 2026-10-18: MD completion queue
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#define VOS_LOG_CAT     VOS_LOG_CAT_MD
+
+#include <string.h>
+
+#include "trdp_mdcompletion.h"
+#include "trdp_mdcom.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Completion queue of a session */
+typedef struct TRDP_MD_COMPLETION_QUEUE
+{
+    VOS_QUEUE_T             posted;             /**< records posted, not yet taken by the application   */
+    VOS_QUEUE_T             idle;               /**< unused records                                     */
+    TRDP_MD_COMPLETION_T    *pRecords;          /**< storage of all records                             */
+    UINT32                  numLost;            /**< completions dropped for lack of records            */
+} TRDP_MD_COMPLETION_QUEUE_T;
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Release a completion queue and the lent buffers of records not taken
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pQueue          completion queue
+ */
+static void trdp_mdCompletionFree (
+    TRDP_SESSION_PT             appHandle,
+    TRDP_MD_COMPLETION_QUEUE_T  *pQueue)
+{
+    TRDP_MD_COMPLETION_T    *pRecord;
+    UINT32                  size;
+
+    if (pQueue->posted != NULL)
+    {
+        while (vos_queueReceive(pQueue->posted, (UINT8 * *) &pRecord, &size, 0u) == VOS_NO_ERR)
+        {
+            trdp_mdBufferFree(trdp_mdBufferGet(appHandle, pRecord->pData, 0u));
+        }
+        (void) vos_queueDestroy(pQueue->posted);
+    }
+    if (pQueue->idle != NULL)
+    {
+        (void) vos_queueDestroy(pQueue->idle);
+    }
+    if (pQueue->pRecords != NULL)
+    {
+        vos_memFree(pQueue->pRecords);
+    }
+    vos_memFree(pQueue);
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Create the completion queue of a session
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      depth           number of completion records
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *  @retval         TRDP_QUEUE_ERR  queue could not be created
+ *  @retval         TRDP_MUTEX_ERR  mutex error
+ */
+TRDP_ERR_T trdp_mdCompletionOpen (
+    TRDP_SESSION_PT appHandle,
+    UINT32          depth)
+{
+    TRDP_MD_COMPLETION_QUEUE_T  *pQueue;
+    UINT32                      i;
+
+    pQueue = (TRDP_MD_COMPLETION_QUEUE_T *) vos_memAlloc(sizeof(TRDP_MD_COMPLETION_QUEUE_T));
+    if (pQueue == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pQueue->pRecords = (TRDP_MD_COMPLETION_T *) vos_memAlloc(depth * sizeof(TRDP_MD_COMPLETION_T));
+    if (pQueue->pRecords == NULL)
+    {
+        trdp_mdCompletionFree(appHandle, pQueue);
+        return TRDP_MEM_ERR;
+    }
+    if ((vos_queueCreate(VOS_QUEUE_POLICY_MPSC, depth, &pQueue->posted) != VOS_NO_ERR) ||
+        (vos_queueCreate(VOS_QUEUE_POLICY_MPSC, depth, &pQueue->idle) != VOS_NO_ERR))
+    {
+        trdp_mdCompletionFree(appHandle, pQueue);
+        return TRDP_QUEUE_ERR;
+    }
+    for (i = 0u; i < depth; i++)
+    {
+        (void) vos_queueSend(pQueue->idle, (UINT8 *) &pQueue->pRecords[i], sizeof(TRDP_MD_COMPLETION_T));
+    }
+
+    if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        trdp_mdCompletionFree(appHandle, pQueue);
+        return TRDP_MUTEX_ERR;
+    }
+    appHandle->pMDCompletion = pQueue;
+    (void) vos_mutexUnlock(appHandle->mutexMD);
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Delete the completion queue of a session
+ *  No application thread may wait on the queue any longer.
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_mdCompletionClose (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pMDCompletion != NULL)
+    {
+        trdp_mdCompletionFree(appHandle, appHandle->pMDCompletion);
+        appHandle->pMDCompletion = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Post the result of a MD session
+ *  Called with mutexMD held, from the MD callback tlm_postCompletion(). The data is copied into a lent buffer the
+ *  application takes over with the record.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pMsg            message info
+ *  @param[in]      pData           received data or NULL
+ *  @param[in]      dataSize        size of the received data
+ */
+void trdp_mdCompletionPost (
+    TRDP_SESSION_PT         appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    const UINT8             *pData,
+    UINT32                  dataSize)
+{
+    TRDP_MD_COMPLETION_QUEUE_T  *pQueue = appHandle->pMDCompletion;
+    TRDP_MD_COMPLETION_T        *pRecord;
+    UINT32                      size;
+
+    if (pQueue == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "MD completion posted without completion queue\n");
+        return;
+    }
+    if (vos_queueReceive(pQueue->idle, (UINT8 * *) &pRecord, &size, 0u) != VOS_NO_ERR)
+    {
+        pQueue->numLost++;
+        vos_printLog(VOS_LOG_WARNING, "MD completion queue full, completion of comId %u lost (%u lost)\n",
+                     pMsg->comId, pQueue->numLost);
+        return;
+    }
+
+    pRecord->info       = *pMsg;
+    pRecord->pData      = NULL;
+    pRecord->dataSize   = 0u;
+    if ((pData != NULL) && (dataSize > 0u))
+    {
+        pRecord->pData = trdp_mdBufferAlloc(appHandle, dataSize);
+        if (pRecord->pData != NULL)
+        {
+            memcpy(pRecord->pData, pData, dataSize);
+            pRecord->dataSize = dataSize;
+        }
+        else
+        {
+            pRecord->info.resultCode = TRDP_MEM_ERR;
+        }
+    }
+    (void) vos_queueSend(pQueue->posted, (UINT8 *) pRecord, sizeof(TRDP_MD_COMPLETION_T));
+}
+
+/**********************************************************************************************************************/
+/** Take posted completion records
+ *  Waits up to usTimeout for the first record, further records are taken as far as they are available.
+ *  Only one application thread at a time may take records.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[out]     pRecords        array to copy the records to
+ *  @param[in]      maxRecords      size of the array
+ *  @param[out]     pNoOfRecords    number of records copied
+ *  @param[in]      usTimeout       max. time to wait for the first record [us], 0 to poll
+ *
+ *  @retval         TRDP_NO_ERR     records taken
+ *  @retval         TRDP_NODATA_ERR no record available
+ *  @retval         TRDP_STATE_ERR  no completion queue
+ */
+TRDP_ERR_T trdp_mdCompletionGet (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_MD_COMPLETION_T    *pRecords,
+    UINT32                  maxRecords,
+    UINT32                  *pNoOfRecords,
+    UINT32                  usTimeout)
+{
+    TRDP_MD_COMPLETION_QUEUE_T  *pQueue = appHandle->pMDCompletion;
+    TRDP_MD_COMPLETION_T        *pRecord;
+    UINT32                      size;
+    UINT32                      timeout = usTimeout;
+
+    *pNoOfRecords = 0u;
+    if (pQueue == NULL)
+    {
+        return TRDP_STATE_ERR;
+    }
+    while ((*pNoOfRecords < maxRecords) &&
+           (vos_queueReceive(pQueue->posted, (UINT8 * *) &pRecord, &size, timeout) == VOS_NO_ERR))
+    {
+        pRecords[*pNoOfRecords] = *pRecord;
+        (*pNoOfRecords)++;
+        (void) vos_queueSend(pQueue->idle, (UINT8 *) pRecord, sizeof(TRDP_MD_COMPLETION_T));
+        timeout = 0u;
+    }
+    return (*pNoOfRecords > 0u) ? TRDP_NO_ERR : TRDP_NODATA_ERR;
+}
@@ -0,0 +1,57 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_mdcompletion.h
+ *
+ * @brief           MD completion queue
+ *
+ * @details         Results of MD sessions are posted as fixed-size records to a queue the application waits on or
+ *                  polls, instead of being handed to a callback
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ *      BL 2026-10-18: MD completion queue
+ */
+
+#ifndef TRDP_MDCOMPLETION_H
+#define TRDP_MDCOMPLETION_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_private.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifndef TRDP_MD_COMPLETION_MAX_DEPTH
+#define TRDP_MD_COMPLETION_MAX_DEPTH    4096u       /**< max. number of completion records per session          */
+#endif
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+TRDP_ERR_T  trdp_mdCompletionOpen (TRDP_SESSION_PT appHandle, UINT32 depth);
+void        trdp_mdCompletionClose (TRDP_SESSION_PT appHandle);
+void        trdp_mdCompletionPost (TRDP_SESSION_PT      appHandle,
+                                   const TRDP_MD_INFO_T *pMsg,
+                                   const UINT8          *pData,
+                                   UINT32               dataSize);
+TRDP_ERR_T  trdp_mdCompletionGet (TRDP_SESSION_PT       appHandle,
+                                  TRDP_MD_COMPLETION_T  *pRecords,
+                                  UINT32                maxRecords,
+                                  UINT32                *pNoOfRecords,
+                                  UINT32                usTimeout);
+
+#endif
@@ -17,6 +17,10 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: Trace points for receive, send, timeout and callbacks
+*      BL 2026-10-18: Timing histograms updated on send and receive
+*      BL 2026-10-18: Send queue or index tables chosen per session at run time
+*      BL 2026-10-18: Callbacks are passed to trdp_pdDispatchCallback() for optional deferred dispatch
 *     AHW 2022-03-24: Ticket #391 Allow PD request without reply
 *     AHW 2021-05-06: Ticket #322 Subscriber multicast message routing in multi-home device
 *     AHW 2021-04-30: Ticket #369 Variable sized arrays are not supported if marshall is active
@@ -82,6 +86,8 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_PD
+
 #include <string.h>
 
 #include "trdp_types.h"
@@ -89,12 +95,12 @@
 #include "trdp_pdcom.h"
 #include "tlc_if.h"
 #include "trdp_stats.h"
+#include "trdp_pddispatch.h"
+#include "trdp_trace.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
 
-#ifdef HIGH_PERF_INDEXED
 #include "trdp_pdindex.h"
-#endif
 
 /*******************************************************************************
  * DEFINES
@@ -303,8 +309,9 @@ TRDP_ERR_T  trdp_pdSendImmediateTSN (
 
     if (err == VOS_NO_ERR)
     {
-        appHandle->stats.pd.numSend++;
-        pSendPD->numRxTx++;
+        TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_TX].numSend);
+        TRDP_STATS_INC(pSendPD->numRxTx);
+        TRDP_TRACE_ELEMENT(PD_SEND, pSendPD, 0);
     }
     return (TRDP_ERR_T) err;
 }
@@ -353,8 +360,9 @@ TRDP_ERR_T  trdp_pdSendImmediate (
 
         if (err == TRDP_NO_ERR)
         {
-            appHandle->stats.pd.numSend++;
-            pSendPD->numRxTx++;
+            TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_TX].numSend);
+            TRDP_STATS_INC(pSendPD->numRxTx);
+            TRDP_TRACE_ELEMENT(PD_SEND, pSendPD, 0);
         }
     }
 
@@ -481,18 +489,25 @@ TRDP_ERR_T  trdp_pdSendElement (
                 theMessage.pUserRef     = iterPD->pUserRef; /* User reference given with the local subscribe? */
                 theMessage.resultCode   = err;
 
+                TRDP_TRACE_ELEMENT(PD_CB_ENTRY, iterPD, err);
                 iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
                                      appHandle,
                                      &theMessage,
                                      iterPD->pFrame->data,
                                      vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
+                TRDP_TRACE_ELEMENT(PD_CB_EXIT, iterPD, 0);
             }
             /* We pass the error to the application, but we keep on going    */
             result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
             if (result == TRDP_NO_ERR)
             {
-                appHandle->stats.pd.numSend++;
-                iterPD->numRxTx++;
+                TRDP_TIME_T now;
+
+                TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_TX].numSend);
+                TRDP_STATS_INC(iterPD->numRxTx);
+                TRDP_TRACE_ELEMENT(PD_SEND, iterPD, 0);
+                vos_getTime(&now);
+                trdp_statsTxTiming(iterPD, &now);
             }
             else
             {
@@ -507,9 +522,10 @@ TRDP_ERR_T  trdp_pdSendElement (
         /* Do not reset timer, but restore msgType */
         iterPD->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PD);
     }
-#ifndef HIGH_PERF_INDEXED
-    else if (timerisset(&iterPD->interval))
+    else if (((appHandle->pSlot == NULL) || (appHandle->pSlot->processCycle == 0u)) &&
+             timerisset(&iterPD->interval))
     {
+        /*  The send queue is scheduled by time, the index tables by their slots    */
         TRDP_TIME_T now;
 
         /*    Get the current time    */
@@ -527,7 +543,6 @@ TRDP_ERR_T  trdp_pdSendElement (
             vos_addTime(&iterPD->timeToGo, &iterPD->interval);
         }
     }
-#endif
     /* Reset "immediate" flag for request or requested packet */
     if (iterPD->privFlags & TRDP_REQ_2B_SENT)
     {
@@ -645,18 +660,22 @@ TRDP_ERR_T  trdp_pdSendQueued (
                         theMessage.pUserRef     = iterPD->pUserRef; /* User reference given with the local subscribe? */
                         theMessage.resultCode   = err;
 
+                        TRDP_TRACE_ELEMENT(PD_CB_ENTRY, iterPD, err);
                         iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
                                              appHandle,
                                              &theMessage,
                                              iterPD->pFrame->data,
                                              vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
+                        TRDP_TRACE_ELEMENT(PD_CB_EXIT, iterPD, 0);
                     }
                     /* We pass the error to the application, but we keep on going    */
                     result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
                     if (result == TRDP_NO_ERR)
                     {
-                        appHandle->stats.pd.numSend++;
-                        iterPD->numRxTx++;
+                        TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_TX].numSend);
+                        TRDP_STATS_INC(iterPD->numRxTx);
+                        TRDP_TRACE_ELEMENT(PD_SEND, iterPD, 0);
+                        trdp_statsTxTiming(iterPD, &now);
                     }
                     else
                     {
@@ -776,18 +795,20 @@ TRDP_ERR_T  trdp_pdReceive (
 
     /*  Is packet sane?    */
     err = trdp_pdCheck(pNewFrameHead, recSize, &isTSN);
+    TRDP_TRACE_EVENT(PD_RECEIVE, vos_ntohl(pNewFrameHead->comId), vos_ntohl(pNewFrameHead->sequenceCounter),
+                     subAddresses.srcIpAddr, recSize, err);
 
     /*  Update statistics   */
     switch (err)
     {
         case TRDP_NO_ERR:
-            appHandle->stats.pd.numRcv++;
+            TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_RX].numRcv);
             break;
         case TRDP_CRC_ERR:
-            appHandle->stats.pd.numCrcErr++;
+            TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_RX].numCrcErr);
             return err;
         case TRDP_WIRE_ERR:
-            appHandle->stats.pd.numProtErr++;
+            TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_RX].numProtErr);
             return err;
         default:
             return err;
@@ -814,7 +835,7 @@ TRDP_ERR_T  trdp_pdReceive (
                                       vos_ntohl(pNewFrameHead->etbTopoCnt),
                                       vos_ntohl(pNewFrameHead->opTrnTopoCnt)))
         {
-            appHandle->stats.pd.numTopoErr++;
+            TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_RX].numTopoErr);
             return TRDP_TOPO_ERR;
         }
 
@@ -829,9 +850,11 @@ TRDP_ERR_T  trdp_pdReceive (
     }
 
     /*  Examine subscription queue, are we interested in this PD?   */
-#ifdef HIGH_PERF_INDEXED
-    if ((appHandle->pSlot == NULL) ||
-        (appHandle->pSlot->noOfRxEntries == 0))
+    if (appHandle->pSlot == NULL)
+    {
+        pExistingElement = trdp_queueFindSubAddr(appHandle->pRcvQueue, &subAddresses);
+    }
+    else if (appHandle->pSlot->noOfRxEntries == 0)
     {
         /*  If not set up until now, we issue a warning, but handle the data...   */
         vos_printLogStr(VOS_LOG_WARNING, "Receiving PD while tlc_updateSession() not yet called or rcvIdx empty.\n");
@@ -842,9 +865,6 @@ TRDP_ERR_T  trdp_pdReceive (
         /*  This is the fast, indexed access to our subscriptions!   */
         pExistingElement = trdp_indexedFindSubAddr(appHandle, &subAddresses);
     }
-#else
-    pExistingElement = trdp_queueFindSubAddr(appHandle->pRcvQueue, &subAddresses);
-#endif
 
     if (pExistingElement == NULL)
     {
@@ -853,7 +873,7 @@ TRDP_ERR_T  trdp_pdReceive (
          vos_ntohl(pNewFrame->frameHead.comId));
          */
         err = TRDP_NOSUB_ERR;
-        appHandle->stats.pd.numNoSubs++;
+        TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_RX].numNoSubs);
     }
     else
     {
@@ -896,11 +916,11 @@ TRDP_ERR_T  trdp_pdReceive (
 
             if ((newSeqCnt > 0u) && (newSeqCnt > (pExistingElement->curSeqCnt + 1u)))
             {
-                pExistingElement->numMissed += newSeqCnt - pExistingElement->curSeqCnt - 1u;
+                TRDP_STATS_ADD(pExistingElement->numMissed, newSeqCnt - pExistingElement->curSeqCnt - 1u);
             }
             else if (pExistingElement->curSeqCnt > newSeqCnt)
             {
-                pExistingElement->numMissed += UINT32_MAX - pExistingElement->curSeqCnt + newSeqCnt;
+                TRDP_STATS_ADD(pExistingElement->numMissed, UINT32_MAX - pExistingElement->curSeqCnt + newSeqCnt);
             }
 
             /* Store last received sequence counter here, too (pd_get et. al. may access it).   */
@@ -939,10 +959,11 @@ TRDP_ERR_T  trdp_pdReceive (
 
             /*  Get the current time and compute the next time this packet should be received.  */
             vos_getTime(&pExistingElement->timeToGo);
+            trdp_statsRxTiming(pExistingElement, &pExistingElement->timeToGo);
             vos_addTime(&pExistingElement->timeToGo, &pExistingElement->interval);
 
             /*  Update some statistics  */
-            pExistingElement->numRxTx++;
+            TRDP_STATS_INC(pExistingElement->numRxTx);
             pExistingElement->lastErr   = TRDP_NO_ERR;
             pExistingElement->privFlags =
                 (TRDP_PRIV_FLAGS_T) (pExistingElement->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_TIMED_OUT);
@@ -1039,7 +1060,7 @@ TRDP_ERR_T  trdp_pdReceive (
         }
         else
         {
-            appHandle->stats.pd.numTopoErr++;
+            TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_RX].numTopoErr);
             pExistingElement->lastErr = TRDP_TOPO_ERR;
             err         = TRDP_TOPO_ERR;
             informUser  = TRUE;
@@ -1073,12 +1094,12 @@ TRDP_ERR_T  trdp_pdReceive (
                 theMessage.replyIpAddr  = VOS_INADDR_ANY;
                 theMessage.protVersion  = pTSNFrameHead->protocolVersion;
                 theMessage.serviceId    = pTSNFrameHead->reserved;
-                pExistingElement->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                               appHandle,
-                                               &theMessage,
-                                               ((PD2_PACKET_T *)pExistingElement->pFrame)->data,
-                                               (UINT32) vos_ntohs(((PD2_PACKET_T *)pExistingElement->pFrame)->frameHead
-                                                                  .datasetLength));
+                trdp_pdDispatchCallback(appHandle,
+                                        pExistingElement,
+                                        &theMessage,
+                                        ((PD2_PACKET_T *)pExistingElement->pFrame)->data,
+                                        (UINT32) vos_ntohs(((PD2_PACKET_T *)pExistingElement->pFrame)->frameHead
+                                                           .datasetLength));
             }
             else
 #endif
@@ -1089,11 +1110,11 @@ TRDP_ERR_T  trdp_pdReceive (
                 theMessage.replyComId   = vos_ntohl(pExistingElement->pFrame->frameHead.replyComId);
                 theMessage.replyIpAddr  = vos_ntohl(pExistingElement->pFrame->frameHead.replyIpAddress);
                 theMessage.serviceId    = vos_ntohl(pExistingElement->pFrame->frameHead.reserved);
-                pExistingElement->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                               appHandle,
-                                               &theMessage,
-                                               pExistingElement->pFrame->data,
-                                               vos_ntohl(pExistingElement->pFrame->frameHead.datasetLength));
+                trdp_pdDispatchCallback(appHandle,
+                                        pExistingElement,
+                                        &theMessage,
+                                        pExistingElement->pFrame->data,
+                                        vos_ntohl(pExistingElement->pFrame->frameHead.datasetLength));
             }
         }
     }
@@ -1203,7 +1224,8 @@ void trdp_handleTimeout (
         !(pPacket->addr.comId == TRDP_STATISTICS_PULL_COMID)) /*  Do not bother user with statistics timeout */
     {
         /*  Update some statistics  */
-        appHandle->stats.pd.numTimeout++;
+        TRDP_STATS_INC(appHandle->pdCounters[TRDP_STATS_CTX_RX].numTimeout);
+        TRDP_TRACE_ELEMENT(PD_TIMEOUT, pPacket, TRDP_TIMEOUT_ERR);
         pPacket->lastErr = TRDP_TIMEOUT_ERR;
 
         /* Packet is late! We inform the user about this:    */
@@ -1237,19 +1259,20 @@ void trdp_handleTimeout (
                     theMessage.replyComId   = vos_ntohl(pPacket->pFrame->frameHead.replyComId);
                     theMessage.replyIpAddr  = vos_ntohl(pPacket->pFrame->frameHead.replyIpAddress);
                 }
-                pPacket->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                      appHandle,
-                                      &theMessage,
-                                      pPacket->pFrame->data,
-                                      pPacket->dataSize);
+                trdp_pdDispatchCallback(appHandle,
+                                        pPacket,
+                                        &theMessage,
+                                        pPacket->pFrame->data,
+                                        pPacket->dataSize);
             }
             else
             {
-                pPacket->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                      appHandle,
-                                      &theMessage,
-                                      NULL,
-                                      pPacket->dataSize);
+                trdp_pdDispatchCallback(appHandle,
+                                        pPacket,
+                                        &theMessage,
+                                        NULL,
+                                        pPacket->dataSize);
+
             }
         }
 
@@ -1535,9 +1558,7 @@ TRDP_ERR_T  trdp_pdSend (
     return TRDP_NO_ERR;
 }
 
-#ifndef HIGH_PERF_INDEXED
-
-/* Note: This function is not necessary for the high performance version; see trdp_pdindex.c */
+/* Note: This function is used by the send queue only, the index tables are distributed by trdp_pdindex.c */
 
 /******************************************************************************/
 /** Distribute send time of PD packets over time
@@ -1655,4 +1676,3 @@ TRDP_ERR_T  trdp_pdDistribute (
 
     return TRDP_NO_ERR;
 }
-#endif
@@ -17,6 +17,7 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: trdp_pdDistribute() always available (send queue sessions)
 *      BL 2019-06-17: Ticket #264 Provide service oriented interface
 *      BL 2019-06-17: Ticket #162 Independent handling of PD and MD to reduce jitter
 *      BL 2019-06-17: Ticket #161 Increase performance
@@ -127,9 +128,7 @@ TRDP_ERR_T  trdp_pdCheckListenSocks (
     TRDP_SESSION_PT appHandle,
     TRDP_FDS_T      *pRfds,
     INT32           *pCount);
-#ifndef HIGH_PERF_INDEXED
 TRDP_ERR_T trdp_pdDistribute (
     PD_ELE_T *pSndQueue);
-#endif
 
 #endif
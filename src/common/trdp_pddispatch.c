@@ -0,0 +1,701 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_pddispatch.c
+ *
+ * @brief           Deferred PD callback dispatch
+ *
+ * @details         Callbacks of received or timed out PD telegrams are queued and executed by a pool of worker
+ *                  threads instead of the receiving thread. A slow application callback does no longer delay the
+ *                  reception of other telegrams.
+ *
+ *                  The callbacks are distributed by comId onto shards. Every shard is a single producer / single
+ *                  consumer ring: Producers are serialized by mutexRxPD, a consumer must own the shard (CAS on
+ *                  'owner') while it executes the callbacks. Hence callbacks of the same comId (and source) are
+ *                  executed in the order of reception. Each worker serves its home shards first and steals work
+ *                  from the other shards if its own are empty.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ *      BL 2026-10-18: trdp_pdDispatchStop() keeps the dispatcher if the receive queue cannot be locked
+ *      BL 2026-10-18: Dispatch workers release their trace ring when they stop
+ *      BL 2026-10-18: Trace points around the callbacks
+ *      BL 2026-10-18: Deferred PD callback dispatch through a worker pool
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#define VOS_LOG_CAT     VOS_LOG_CAT_PD
+
+#include <string.h>
+
+#include "trdp_pddispatch.h"
+#include "trdp_trace.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifdef TSN_SUPPORT
+#define TRDP_DISPATCH_MAX_DATA      TRDP_MAX_PD2_DATA_SIZE
+#else
+#define TRDP_DISPATCH_MAX_DATA      TRDP_MAX_PD_DATA_SIZE
+#endif
+
+#define TRDP_DISPATCH_BATCH         8u          /**< max. callbacks executed before a shard is handed back     */
+#define TRDP_DISPATCH_IDLE_WAIT     10000u      /**< max. sleep time of an idle worker [us]                     */
+#define TRDP_DISPATCH_STOP_WAIT     1000000u    /**< max. time to wait for the workers on stop [us]             */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** A queued callback: copy of the telegram data and its info */
+typedef struct
+{
+    PD_ELE_T            *pElement;              /**< subscription, kept alive by its dispatchRef         */
+    TRDP_PD_CALLBACK_T  pfCbFunction;           /**< callback to execute                                */
+    void                *pRefCon;               /**< user context of the session                        */
+    TRDP_TIME_T         queued;                 /**< time the callback was queued                       */
+    TRDP_PD_INFO_T      info;                   /**< message info                                       */
+    UINT32              dataSize;               /**< size of the data                                   */
+    BOOL8               hasData;                /**< FALSE: callback is called with pData == NULL       */
+    UINT8               data[TRDP_DISPATCH_MAX_DATA];   /**< copy of the received data                  */
+} TRDP_PD_DISPATCH_REC_T;
+
+/** Ring of queued callbacks of one comId shard. Head and tail are kept on separate cache lines. */
+typedef struct
+{
+    UINT32                  head;               /**< next record to write, changed by the producer only */
+    UINT8                   pad1[VOS_CACHELINE_SIZE - sizeof(UINT32)];
+    UINT32                  tail;               /**< next record to read, changed by the owner only     */
+    UINT32                  owner;              /**< 0 or index + 1 of the worker serving the shard     */
+    UINT8                   pad2[VOS_CACHELINE_SIZE - 2u * sizeof(UINT32)];
+    TRDP_PD_DISPATCH_REC_T  *pRec;              /**< records, queueDepth entries                        */
+} TRDP_PD_DISPATCH_SHARD_T;
+
+struct TRDP_PD_DISPATCH;
+
+/** Worker thread */
+typedef struct
+{
+    struct TRDP_PD_DISPATCH *pDispatch;         /**< dispatcher the worker belongs to                   */
+    VOS_THREAD_T            thread;             /**< thread handle                                      */
+    UINT32                  index;              /**< worker index, selects the home shards              */
+    UINT32                  done;               /**< worker left its loop                               */
+} TRDP_PD_DISPATCH_WORKER_T;
+
+/** Dispatcher of a session */
+typedef struct TRDP_PD_DISPATCH
+{
+    TRDP_SESSION_PT             appHandle;      /**< session served                                     */
+    UINT32                      noOfWorkers;    /**< number of worker threads                           */
+    UINT32                      noOfShards;     /**< number of comId shards                             */
+    UINT32                      mask;           /**< queue depth - 1                                    */
+    UINT32                      stop;           /**< != 0: workers shall terminate                      */
+    UINT32                      idle;           /**< number of workers waiting for the semaphore        */
+    VOS_SEMA_T                  wakeup;         /**< given by the producer if a worker is idle          */
+    TRDP_PD_DISPATCH_SHARD_T    *pShard;        /**< noOfShards rings                                   */
+    TRDP_PD_DISPATCH_WORKER_T   worker[TRDP_DISPATCH_MAX_WORKERS];
+} TRDP_PD_DISPATCH_T;
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Free a subscription element
+ *
+ *  @param[in]      pElement            subscription to free
+ */
+static void trdp_pdFreeElement (
+    PD_ELE_T *pElement)
+{
+    if (pElement->pFrame != NULL)
+    {
+        vos_memFree(pElement->pFrame);
+    }
+    if (pElement->pSeqCntList != NULL)
+    {
+        vos_memFree(pElement->pSeqCntList);
+    }
+    vos_memFree(pElement);
+}
+
+/**********************************************************************************************************************/
+/** Drop the reference of a queued callback to its subscription
+ *
+ *  @param[in]      pElement            subscription
+ */
+static void trdp_pdDispatchUnref (
+    PD_ELE_T *pElement)
+{
+    if (VOS_ATOMIC_SUB(&pElement->dispatchRef, 1u) == TRDP_DISPATCH_REF_RELEASED)
+    {
+        /* The subscription was released while this callback was queued: we are the last one using it */
+        trdp_pdFreeElement(pElement);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Time difference in us
+ *
+ *  @param[in]      pStart              start time
+ *  @param[in]      pEnd                end time
+ *
+ *  @retval         pEnd - pStart in us, 0 if negative
+ */
+static UINT32 trdp_pdDispatchDiff (
+    const TRDP_TIME_T   *pStart,
+    const TRDP_TIME_T   *pEnd)
+{
+    TRDP_TIME_T diff = *pEnd;
+
+    if (vos_cmpTime(pEnd, pStart) <= 0)
+    {
+        return 0u;
+    }
+    vos_subTime(&diff, pStart);
+    return (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+}
+
+/**********************************************************************************************************************/
+/** Shard of a comId
+ *
+ *  @param[in]      pDispatch           dispatcher
+ *  @param[in]      comId               comId of the telegram
+ *
+ *  @retval         shard index
+ */
+static UINT32 trdp_pdDispatchShard (
+    const TRDP_PD_DISPATCH_T    *pDispatch,
+    UINT32                      comId)
+{
+    return ((comId * 2654435761u) >> 16u) % pDispatch->noOfShards;
+}
+
+/**********************************************************************************************************************/
+/** Execute the queued callbacks of a shard
+ *  Must be called with the shard owned by the worker.
+ *
+ *  @param[in]      pDispatch           dispatcher
+ *  @param[in]      pShard              shard to serve
+ *
+ *  @retval         number of records processed
+ */
+static UINT32 trdp_pdDispatchServe (
+    TRDP_PD_DISPATCH_T          *pDispatch,
+    TRDP_PD_DISPATCH_SHARD_T    *pShard)
+{
+    UINT32 count;
+    UINT32 tail = pShard->tail;
+
+    for (count = 0u; count < TRDP_DISPATCH_BATCH; count++)
+    {
+        TRDP_PD_DISPATCH_REC_T  *pRec;
+        PD_ELE_T                *pElement;
+
+        if (tail == VOS_ATOMIC_LOAD(&pShard->head))
+        {
+            break;
+        }
+        pRec        = &pShard->pRec[tail & pDispatch->mask];
+        pElement    = pRec->pElement;
+
+        /* Callbacks of an unsubscribed element are not executed anymore */
+        if (VOS_ATOMIC_LOAD(&pElement->magic) == TRDP_MAGIC_SUB_HNDL_VALUE)
+        {
+            TRDP_TIME_T start;
+            TRDP_TIME_T end;
+            UINT32      duration;
+            UINT32      latency;
+
+            vos_getTime(&start);
+            TRDP_TRACE_EVENT(PD_CB_ENTRY, pRec->info.comId, pRec->info.seqCount, pRec->info.srcIpAddr,
+                             pRec->dataSize, pRec->info.resultCode);
+            pRec->pfCbFunction(pRec->pRefCon,
+                               pDispatch->appHandle,
+                               &pRec->info,
+                               (pRec->hasData == TRUE) ? pRec->data : NULL,
+                               pRec->dataSize);
+            TRDP_TRACE_EVENT(PD_CB_EXIT, pRec->info.comId, pRec->info.seqCount, pRec->info.srcIpAddr,
+                             pRec->dataSize, 0);
+            vos_getTime(&end);
+
+            /* Callbacks of one subscription are served by one worker at a time, no need to lock */
+            latency     = trdp_pdDispatchDiff(&pRec->queued, &start);
+            duration    = trdp_pdDispatchDiff(&start, &end);
+            pElement->dispatchStats.numCalls++;
+            pElement->dispatchStats.lastDuration = duration;
+            if (duration > pElement->dispatchStats.maxDuration)
+            {
+                pElement->dispatchStats.maxDuration = duration;
+            }
+            if (latency > pElement->dispatchStats.maxLatency)
+            {
+                pElement->dispatchStats.maxLatency = latency;
+            }
+        }
+        tail++;
+        VOS_ATOMIC_STORE(&pShard->tail, tail);      /* record may be reused from now on */
+        trdp_pdDispatchUnref(pElement);
+    }
+    return count;
+}
+
+/**********************************************************************************************************************/
+/** Try to take a shard and serve it
+ *
+ *  @param[in]      pWorker             worker
+ *  @param[in]      pShard              shard to serve
+ *
+ *  @retval         number of records processed
+ */
+static UINT32 trdp_pdDispatchTryShard (
+    TRDP_PD_DISPATCH_WORKER_T   *pWorker,
+    TRDP_PD_DISPATCH_SHARD_T    *pShard)
+{
+    UINT32  count;
+    UINT32  free = 0u;
+
+    if ((VOS_ATOMIC_LOAD(&pShard->head) == VOS_ATOMIC_LOAD(&pShard->tail)) ||
+        !VOS_ATOMIC_CAS(&pShard->owner, &free, pWorker->index + 1u))
+    {
+        /* empty or served by another worker */
+        return 0u;
+    }
+    count = trdp_pdDispatchServe(pWorker->pDispatch, pShard);
+    VOS_ATOMIC_STORE(&pShard->owner, 0u);
+    return count;
+}
+
+/**********************************************************************************************************************/
+/** Serve the home shards of a worker, then steal from the others
+ *
+ *  @param[in]      pWorker             worker
+ *
+ *  @retval         number of records processed
+ */
+static UINT32 trdp_pdDispatchRound (
+    TRDP_PD_DISPATCH_WORKER_T *pWorker)
+{
+    TRDP_PD_DISPATCH_T  *pDispatch  = pWorker->pDispatch;
+    UINT32              count       = 0u;
+    UINT32              idx;
+
+    for (idx = pWorker->index; idx < pDispatch->noOfShards; idx += pDispatch->noOfWorkers)
+    {
+        count += trdp_pdDispatchTryShard(pWorker, &pDispatch->pShard[idx]);
+    }
+    if (count == 0u)
+    {
+        for (idx = 0u; idx < pDispatch->noOfShards; idx++)
+        {
+            if ((idx % pDispatch->noOfWorkers) != pWorker->index)
+            {
+                count += trdp_pdDispatchTryShard(pWorker, &pDispatch->pShard[idx]);
+            }
+        }
+    }
+    return count;
+}
+
+/**********************************************************************************************************************/
+/** Dispatch worker thread function
+ *
+ *  @param[in]      pArg                pointer to the worker
+ */
+static void trdp_pdDispatchWorker (
+    void *pArg)
+{
+    TRDP_PD_DISPATCH_WORKER_T   *pWorker    = (TRDP_PD_DISPATCH_WORKER_T *) pArg;
+    TRDP_PD_DISPATCH_T          *pDispatch  = pWorker->pDispatch;
+
+    while (VOS_ATOMIC_LOAD(&pDispatch->stop) == 0u)
+    {
+        if (trdp_pdDispatchRound(pWorker) == 0u)
+        {
+            /* Announce that we are idle before checking a last time, the producer gives the semaphore
+               after queueing if it sees an idle worker. */
+            (void) VOS_ATOMIC_ADD(&pDispatch->idle, 1u);
+            VOS_ATOMIC_FENCE();
+            if ((trdp_pdDispatchRound(pWorker) == 0u) &&
+                (VOS_ATOMIC_LOAD(&pDispatch->stop) == 0u))
+            {
+                (void) vos_semaTake(pDispatch->wakeup, TRDP_DISPATCH_IDLE_WAIT);
+            }
+            (void) VOS_ATOMIC_SUB(&pDispatch->idle, 1u);
+        }
+    }
+    TRDP_TRACE_RELEASE();
+    VOS_ATOMIC_STORE(&pWorker->done, 1u);
+}
+
+/**********************************************************************************************************************/
+/** Release all resources of a dispatcher, queued callbacks are discarded
+ *  The workers must have terminated.
+ *
+ *  @param[in]      pDispatch           dispatcher
+ */
+static void trdp_pdDispatchFree (
+    TRDP_PD_DISPATCH_T *pDispatch)
+{
+    UINT32 idx;
+
+    if (pDispatch->pShard != NULL)
+    {
+        for (idx = 0u; idx < pDispatch->noOfShards; idx++)
+        {
+            TRDP_PD_DISPATCH_SHARD_T *pShard = &pDispatch->pShard[idx];
+
+            if (pShard->pRec != NULL)
+            {
+                for (; pShard->tail != pShard->head; pShard->tail++)
+                {
+                    trdp_pdDispatchUnref(pShard->pRec[pShard->tail & pDispatch->mask].pElement);
+                }
+                vos_memFree(pShard->pRec);
+            }
+        }
+        vos_memFree(pDispatch->pShard);
+    }
+    if (pDispatch->wakeup != NULL)
+    {
+        vos_semaDelete(pDispatch->wakeup);
+    }
+    vos_memFree(pDispatch);
+}
+
+/**********************************************************************************************************************/
+/** Stop the workers and release the dispatcher
+ *
+ *  @param[in]      pDispatch           dispatcher, already detached from its session
+ */
+static void trdp_pdDispatchDestroy (
+    TRDP_PD_DISPATCH_T *pDispatch)
+{
+    UINT32  idx;
+    UINT32  waitTime;
+    BOOL8   finished = FALSE;
+
+    VOS_ATOMIC_STORE(&pDispatch->stop, 1u);
+    VOS_ATOMIC_FENCE();
+    for (idx = 0u; idx < pDispatch->noOfWorkers; idx++)
+    {
+        vos_semaGive(pDispatch->wakeup);
+    }
+
+    for (waitTime = TRDP_DISPATCH_STOP_WAIT; waitTime > 0u; waitTime = (waitTime > 1000u) ? (waitTime - 1000u) : 0u)
+    {
+        finished = TRUE;
+        for (idx = 0u; idx < pDispatch->noOfWorkers; idx++)
+        {
+            if ((pDispatch->worker[idx].thread != NULL) &&
+                (VOS_ATOMIC_LOAD(&pDispatch->worker[idx].done) == 0u))
+            {
+                finished = FALSE;
+            }
+        }
+        if (finished == TRUE)
+        {
+            break;
+        }
+        (void) vos_threadDelay(1000u);
+    }
+
+    if (finished == TRUE)
+    {
+        trdp_pdDispatchFree(pDispatch);
+    }
+    else
+    {
+        /* A worker is stuck in an application callback. Cancel it and keep the dispatcher,
+           because the worker may still refer to it. */
+        vos_printLogStr(VOS_LOG_ERROR, "PD dispatch workers did not terminate in time, cancelling them\n");
+        for (idx = 0u; idx < pDispatch->noOfWorkers; idx++)
+        {
+            if ((pDispatch->worker[idx].thread != NULL) &&
+                (VOS_ATOMIC_LOAD(&pDispatch->worker[idx].done) == 0u))
+            {
+                (void) vos_threadTerminate(pDispatch->worker[idx].thread);
+            }
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Create the dispatch workers of a session
+ *  Must be called without holding mutexRxPD.
+ *
+ *  @param[in]      appHandle           session
+ *  @param[in]      noOfWorkers         number of worker threads (1...TRDP_DISPATCH_MAX_WORKERS)
+ *  @param[in]      queueDepth          max. number of queued callbacks per shard, 0 = default
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_STATE_ERR      dispatch already active
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_THREAD_ERR     worker could not be created
+ */
+TRDP_ERR_T trdp_pdDispatchStart (
+    TRDP_SESSION_PT appHandle,
+    UINT32          noOfWorkers,
+    UINT32          queueDepth)
+{
+    TRDP_PD_DISPATCH_T  *pDispatch;
+    TRDP_ERR_T          ret = TRDP_NO_ERR;
+    UINT32              depth;
+    UINT32              idx;
+
+    if ((noOfWorkers == 0u) || (noOfWorkers > TRDP_DISPATCH_MAX_WORKERS) || (queueDepth > TRDP_DISPATCH_MAX_DEPTH))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (appHandle->pDispatch != NULL)
+    {
+        return TRDP_STATE_ERR;
+    }
+
+    /* Round the queue depth up to a power of 2 */
+    for (depth = 1u; depth < ((queueDepth == 0u) ? TRDP_DISPATCH_DEFAULT_DEPTH : queueDepth); depth <<= 1u)
+    {
+        ;
+    }
+
+    pDispatch = (TRDP_PD_DISPATCH_T *) vos_memAlloc(sizeof(TRDP_PD_DISPATCH_T));
+    if (pDispatch == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pDispatch->appHandle    = appHandle;
+    pDispatch->noOfWorkers  = noOfWorkers;
+    pDispatch->noOfShards   = noOfWorkers * TRDP_DISPATCH_SHARDS_PER_WORKER;
+    pDispatch->mask         = depth - 1u;
+    pDispatch->pShard       = (TRDP_PD_DISPATCH_SHARD_T *) vos_memAlloc(pDispatch->noOfShards *
+                                                                         sizeof(TRDP_PD_DISPATCH_SHARD_T));
+    if (pDispatch->pShard == NULL)
+    {
+        ret = TRDP_MEM_ERR;
+    }
+    for (idx = 0u; (ret == TRDP_NO_ERR) && (idx < pDispatch->noOfShards); idx++)
+    {
+        pDispatch->pShard[idx].pRec = (TRDP_PD_DISPATCH_REC_T *) vos_memAlloc(depth *
+                                                                              sizeof(TRDP_PD_DISPATCH_REC_T));
+        if (pDispatch->pShard[idx].pRec == NULL)
+        {
+            ret = TRDP_MEM_ERR;
+        }
+    }
+    if ((ret == TRDP_NO_ERR) &&
+        (vos_semaCreate(&pDispatch->wakeup, VOS_SEMA_EMPTY) != VOS_NO_ERR))
+    {
+        ret = TRDP_SEMA_ERR;
+    }
+    if (ret != TRDP_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Out of memory for PD dispatch queues\n");
+        trdp_pdDispatchFree(pDispatch);
+        return ret;
+    }
+
+    for (idx = 0u; idx < noOfWorkers; idx++)
+    {
+        TRDP_PD_DISPATCH_WORKER_T *pWorker = &pDispatch->worker[idx];
+
+        pWorker->pDispatch  = pDispatch;
+        pWorker->index      = idx;
+        if (vos_threadCreate(&pWorker->thread, "TRDP PD Dispatch", VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
+                             (VOS_THREAD_FUNC_T) trdp_pdDispatchWorker, pWorker) != VOS_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "Creating PD dispatch worker %u failed\n", (unsigned int) idx);
+            pWorker->thread = NULL;
+            ret = TRDP_THREAD_ERR;
+            break;
+        }
+    }
+    if (ret != TRDP_NO_ERR)
+    {
+        trdp_pdDispatchDestroy(pDispatch);
+        return ret;
+    }
+
+    /* From now on the receiver queues the callbacks */
+    if (vos_mutexLock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        trdp_pdDispatchDestroy(pDispatch);
+        return TRDP_MUTEX_ERR;
+    }
+    appHandle->pDispatch = pDispatch;
+    if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    vos_printLog(VOS_LOG_INFO, "PD callback dispatch started (%u workers, %u queued per shard)\n",
+                 (unsigned int) noOfWorkers, (unsigned int) depth);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Stop the dispatch workers of a session, callbacks are executed inline again
+ *  Must be called without holding mutexRxPD and not from within a dispatched callback.
+ *  Callbacks still queued are discarded.
+ *
+ *  @param[in]      appHandle           session
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MUTEX_ERR      receive queue could not be locked, dispatch left running
+ */
+TRDP_ERR_T trdp_pdDispatchStop (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_PD_DISPATCH_T *pDispatch;
+
+    if (vos_mutexLock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+
+    /* No receiver is queueing while we hold the mutex */
+    pDispatch               = appHandle->pDispatch;
+    appHandle->pDispatch    = NULL;
+    if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    if (pDispatch != NULL)
+    {
+        trdp_pdDispatchDestroy(pDispatch);
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Check if we are running in one of the dispatch workers of a session
+ *
+ *  @param[in]      appHandle           session
+ *
+ *  @retval         TRUE                called from a dispatched callback
+ *  @retval         FALSE               otherwise
+ */
+BOOL8 trdp_pdDispatchIsWorker (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_PD_DISPATCH_T  *pDispatch = appHandle->pDispatch;
+    VOS_THREAD_T        self = NULL;
+    UINT32              idx;
+
+    if ((pDispatch == NULL) || (vos_threadSelf(&self) != VOS_NO_ERR))
+    {
+        return FALSE;
+    }
+    for (idx = 0u; idx < pDispatch->noOfWorkers; idx++)
+    {
+        if (pDispatch->worker[idx].thread == self)
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Inform the user about a received or timed out telegram
+ *  The callback is queued for the dispatch workers if dispatch is active, else it is executed at once.
+ *  Must be called with mutexRxPD held.
+ *
+ *  @param[in]      appHandle           session
+ *  @param[in]      pElement            subscription
+ *  @param[in]      pInfo               message info
+ *  @param[in]      pData               received data or NULL
+ *  @param[in]      dataSize            size of the received data
+ */
+void trdp_pdDispatchCallback (
+    TRDP_SESSION_PT         appHandle,
+    PD_ELE_T                *pElement,
+    const TRDP_PD_INFO_T    *pInfo,
+    const UINT8             *pData,
+    UINT32                  dataSize)
+{
+    TRDP_PD_DISPATCH_T          *pDispatch = appHandle->pDispatch;
+    TRDP_PD_DISPATCH_SHARD_T    *pShard;
+    TRDP_PD_DISPATCH_REC_T      *pRec;
+    UINT32                      head;
+    UINT32                      queued;
+
+    if (pDispatch == NULL)
+    {
+        TRDP_TRACE_EVENT(PD_CB_ENTRY, pInfo->comId, pInfo->seqCount, pInfo->srcIpAddr, dataSize, pInfo->resultCode);
+        pElement->pfCbFunction(appHandle->pdDefault.pRefCon, appHandle, pInfo, (UINT8 *) pData, dataSize);
+        TRDP_TRACE_EVENT(PD_CB_EXIT, pInfo->comId, pInfo->seqCount, pInfo->srcIpAddr, dataSize, 0);
+        return;
+    }
+
+    pShard  = &pDispatch->pShard[trdp_pdDispatchShard(pDispatch, pInfo->comId)];
+    head    = pShard->head;
+    if ((head - VOS_ATOMIC_LOAD(&pShard->tail)) > pDispatch->mask)
+    {
+        /* Queueing inline would break the order, the callback is lost */
+        pElement->dispatchStats.numDropped++;
+        return;
+    }
+
+    pRec = &pShard->pRec[head & pDispatch->mask];
+    pRec->pElement      = pElement;
+    pRec->pfCbFunction  = pElement->pfCbFunction;
+    pRec->pRefCon       = appHandle->pdDefault.pRefCon;
+    pRec->info          = *pInfo;
+    pRec->dataSize      = (dataSize < TRDP_DISPATCH_MAX_DATA) ? dataSize : TRDP_DISPATCH_MAX_DATA;
+    pRec->hasData       = (pData != NULL) ? TRUE : FALSE;
+    if (pData != NULL)
+    {
+        memcpy(pRec->data, pData, pRec->dataSize);
+    }
+    vos_getTime(&pRec->queued);
+
+    queued = VOS_ATOMIC_ADD(&pElement->dispatchRef, 1u) & TRDP_DISPATCH_REF_MASK;
+    if (queued > pElement->dispatchStats.maxQueued)
+    {
+        pElement->dispatchStats.maxQueued = queued;
+    }
+    VOS_ATOMIC_STORE(&pShard->head, head + 1u);
+
+    /* Wake up a worker, if one is sleeping */
+    VOS_ATOMIC_FENCE();
+    if (VOS_ATOMIC_LOAD(&pDispatch->idle) != 0u)
+    {
+        vos_semaGive(pDispatch->wakeup);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Release a subscription element
+ *  The element is freed at once, or by the dispatch worker executing its last queued callback.
+ *  The element must have been removed from the receive queue before.
+ *
+ *  @param[in]      pElement            subscription to release
+ */
+void trdp_pdReleaseElement (
+    PD_ELE_T *pElement)
+{
+    if (VOS_ATOMIC_ADD(&pElement->dispatchRef, TRDP_DISPATCH_REF_RELEASED) == TRDP_DISPATCH_REF_RELEASED)
+    {
+        trdp_pdFreeElement(pElement);
+    }
+}
@@ -0,0 +1,62 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_pddispatch.h
+ *
+ * @brief           Deferred PD callback dispatch
+ *
+ * @details         Callbacks of received or timed out PD telegrams are queued and executed by a pool of worker
+ *                  threads instead of the receiving thread
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ *      BL 2026-10-18: Deferred PD callback dispatch through a worker pool
+ */
+
+#ifndef TRDP_PDDISPATCH_H
+#define TRDP_PDDISPATCH_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_private.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifndef TRDP_DISPATCH_MAX_WORKERS
+#define TRDP_DISPATCH_MAX_WORKERS       16u         /**< max. number of dispatch worker threads                 */
+#endif
+#define TRDP_DISPATCH_DEFAULT_DEPTH     16u         /**< default number of queued callbacks per shard           */
+#define TRDP_DISPATCH_MAX_DEPTH         64u         /**< max. number of queued callbacks per shard              */
+#define TRDP_DISPATCH_SHARDS_PER_WORKER 2u          /**< comId shards owned by each worker                      */
+
+/** PD_ELE_T.dispatchRef: lower bits count the queued callbacks, the upper bit is set when the element is released */
+#define TRDP_DISPATCH_REF_RELEASED      0x80000000u
+#define TRDP_DISPATCH_REF_MASK          0x7FFFFFFFu
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+TRDP_ERR_T  trdp_pdDispatchStart (TRDP_SESSION_PT appHandle, UINT32 noOfWorkers, UINT32 queueDepth);
+TRDP_ERR_T  trdp_pdDispatchStop (TRDP_SESSION_PT appHandle);
+BOOL8       trdp_pdDispatchIsWorker (TRDP_SESSION_PT appHandle);
+void        trdp_pdDispatchCallback (TRDP_SESSION_PT        appHandle,
+                                     PD_ELE_T               *pElement,
+                                     const TRDP_PD_INFO_T   *pInfo,
+                                     const UINT8            *pData,
+                                     UINT32                 dataSize);
+void        trdp_pdReleaseElement (PD_ELE_T *pElement);
+
+#endif
@@ -17,6 +17,9 @@
 /*
  * $Id$
  *
+ *      BL 2026-10-18: Always compiled, trdp_pdSendIndexedDue()/trdp_indexNextCycle() for tlc_process()
+ *      BL 2026-10-18: Base transmit cycle (slot cycle of the low table) configurable down to 250us
+ *      BL 2026-10-18: Byte-balanced placement of publishers, incremental insert/remove, burst profile
  *      BL 2020-08-07: Ticket #317 Bug in trdp_indexedFindSubAddr() (HIGH_PERFORMANCE)
  *      BL 2020-08-06: Ticket #314 Timeout supervision does not restart after PD request
  *      BL 2020-07-15: Formatting (indenting)
@@ -38,6 +41,8 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_PD
+
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
@@ -50,8 +55,6 @@
 #include "vos_thread.h"
 #include "trdp_pdindex.h"
 
-#ifdef HIGH_PERF_INDEXED
-
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -119,6 +122,19 @@ static INLINE void setElement (
     *(pEntry->ppIdxCat + slot * pEntry->depthOfTxEntries + depth) = pAssign;
 }
 
+/**********************************************************************************************************************/
+/** Return the number of bytes a telegram occupies on the wire
+ *
+ *  @param[in]      pElement        pointer to the packet element
+ *
+ *  @retval         size in bytes including Ethernet, IP and UDP header
+ */
+static INLINE UINT32 wireSize (
+    const PD_ELE_T *pElement)
+{
+    return pElement->grossSize + TRDP_HP_WIRE_OVERHEAD;
+}
+
 #ifdef DEBUG
 /**********************************************************************************************************************/
 /** Print an index table
@@ -172,10 +188,12 @@ static void   print_table (
     vos_printLog(VOS_LOG_INFO,
                  "----- Time Slots for %4ums cycled packets  -----\n",
                  (unsigned int) pSlots->slotCycle / 1000u);
-    vos_printLogStr(VOS_LOG_INFO, "----- SlotNo: ComId (Tx-Interval) x depth   -----\n");
+    vos_printLogStr(VOS_LOG_INFO, "----- SlotNo (Bytes): ComId (Tx-Interval) x depth -----\n");
     vos_printLogStr(VOS_LOG_INFO, "-------------------------------------------------\n");
     for (slot = 0; slot < pSlots->noOfTxEntries; slot++)
     {
+        UINT32 bytes = 0u;
+
         for (depth = 0; depth < pSlots->depthOfTxEntries; depth++)
         {
             int n;
@@ -190,10 +208,12 @@ static void   print_table (
                 n = snprintf(strBuf, sizeof(strBuf), "%4u(%4d)\t",
                              (unsigned int) pDest->addr.comId,
                              (int) (pDest->interval.tv_usec / 1000 + pDest->interval.tv_sec * 1000u));
+                bytes += wireSize(pDest);
             }
             strncat(buffer, strBuf, n);
         }
-        vos_printLog(VOS_LOG_INFO, "%3u: %s\n", slot, buffer);
+        vos_printLog(VOS_LOG_INFO, "%3u (%5u): %s\n", slot, (unsigned int) bytes, buffer);
+
         buffer[0] = 0;
     }
     vos_printLogStr(VOS_LOG_INFO, "-------------------------------------------------\n");
@@ -219,14 +239,25 @@ static int removePub (
     /* Find the packet in the short list */
     for (idx = 0u; idx < pSlot->noOfTxEntries; idx++)
     {
-        for (depth = 0u; depth < pSlot->depthOfTxEntries; depth++)
+        depth = 0u;
+        while (depth < pSlot->depthOfTxEntries)
         {
             if (getElement(pSlot, idx, depth) == pElement)    /* hit? */
             {
-                /* remove it */
-                setElement(pSlot, idx, depth, NULL);
+                UINT32 next;
+
+                /* remove it, the following entries move up: sending stops at the first empty entry of a slot */
+                for (next = depth + 1u; next < pSlot->depthOfTxEntries; next++)
+                {
+                    setElement(pSlot, idx, next - 1u, getElement(pSlot, idx, next));
+                }
+                setElement(pSlot, idx, pSlot->depthOfTxEntries - 1u, NULL);
                 found++;
             }
+            else
+            {
+                depth++;
+            }
         }
     }
     return found;
@@ -277,8 +308,121 @@ static PERF_TABLE_TYPE_T   perf_table_category (
 }
 
 /**********************************************************************************************************************/
-/** Evenly distribute the PD over the array
+/** Compute the load of each slot of an index table
  *
+ *  @param[in]      pCat            pointer to the category
+ *  @param[out]     pBytes          bytes on the wire per slot
+ *  @param[out]     pPackets        packets per slot
+ */
+static void slotLoad (
+    TRDP_HP_CAT_SLOT_T  *pCat,
+    UINT32              *pBytes,
+    UINT32              *pPackets)
+{
+    UINT32  slot, depth;
+
+    for (slot = 0u; slot < pCat->noOfTxEntries; slot++)
+    {
+        pBytes[slot]    = 0u;
+        pPackets[slot]  = 0u;
+        for (depth = 0u; depth < pCat->depthOfTxEntries; depth++)
+        {
+            PD_ELE_T *pElement = getElement(pCat, slot, depth);
+            if (pElement != NULL)
+            {
+                pBytes[slot] += wireSize(pElement);
+                pPackets[slot]++;
+            }
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Return the slot of the low table which is sent in the same transmit cycle as a slot of the mid or high table
+ *  trdp_pdSendIndexed() sends a mid slot in the middle of its slot cycle, a high slot at the beginning.
+ *
+ *  @param[in]      pSlot           pointer to the index tables
+ *  @param[in]      pCat            mid or high table
+ *  @param[in]      slot            slot of pCat
+ *
+ *  @retval         slot of the low table
+ */
+static UINT32 lowSlotOf (
+    const TRDP_HP_SLOTS_T       *pSlot,
+    const TRDP_HP_CAT_SLOT_T    *pCat,
+    UINT32                      slot)
+{
+    UINT32 cycle = slot * pCat->slotCycle;
+
+    if (pCat == &pSlot->midCat)
+    {
+        cycle += pCat->slotCycle / 2u;
+    }
+    return (cycle / pSlot->lowCat.slotCycle) % pSlot->lowCat.noOfTxEntries;
+}
+
+/**********************************************************************************************************************/
+/** Compute the load the other tables add to each slot of a table
+ *  A low slot shares its transmit cycle with mid or high slots, the heaviest of them counts.
+ *
+ *  @param[in]      pSlot           pointer to the index tables
+ *  @param[in]      pCat            table to compute the additional load for
+ *  @param[out]     pBytes          additional bytes on the wire per slot of pCat
+ *  @param[out]     pPackets        additional packets per slot of pCat
+ */
+static void sharedLoad (
+    TRDP_HP_SLOTS_T     *pSlot,
+    TRDP_HP_CAT_SLOT_T  *pCat,
+    UINT32              *pBytes,
+    UINT32              *pPackets)
+{
+    UINT32              bytes[TRDP_HP_MAX_SLOTS];
+    UINT32              packets[TRDP_HP_MAX_SLOTS];
+    TRDP_HP_CAT_SLOT_T  *pOther[2];
+    UINT32              slot, i;
+
+    if (pCat == &pSlot->lowCat)
+    {
+        memset(pBytes, 0, pCat->noOfTxEntries * sizeof(UINT32));
+        memset(pPackets, 0, pCat->noOfTxEntries * sizeof(UINT32));
+        pOther[0]   = &pSlot->midCat;
+        pOther[1]   = &pSlot->highCat;
+        for (i = 0u; i < 2u; i++)
+        {
+            slotLoad(pOther[i], bytes, packets);
+            for (slot = 0u; slot < pOther[i]->noOfTxEntries; slot++)
+            {
+                UINT32 low = lowSlotOf(pSlot, pOther[i], slot);
+                if (bytes[slot] > pBytes[low])
+                {
+                    pBytes[low] = bytes[slot];
+                }
+                if (packets[slot] > pPackets[low])
+                {
+                    pPackets[low] = packets[slot];
+                }
+            }
+        }
+    }
+    else
+    {
+        slotLoad(&pSlot->lowCat, bytes, packets);
+        for (slot = 0u; slot < pCat->noOfTxEntries; slot++)
+        {
+            UINT32 low = lowSlotOf(pSlot, pCat, slot);
+            pBytes[slot]    = bytes[low];
+            pPackets[slot]  = packets[low];
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Distribute the PD over the array, balancing the bytes and packets sent per transmit cycle
+ *  Every possible first slot is tried, the PD then occupies each interval/slotCycle-th slot. The first slot leading
+ *  to the lowest peak of bytes (including the load of the other tables sent in the same cycle), then of packets, then
+ *  to the least loaded slots is taken. Slots without free depth are only used if there is no other choice.
+ *
+ *  @param[in,out]  pSlot           pointer to the index tables
  *  @param[in,out]  pCat            pointer to the array to fill
  *  @param[in]      pElement        pointer to the packet element to be handled
  *
@@ -287,16 +431,26 @@ static PERF_TABLE_TYPE_T   perf_table_category (
  *                  TRDP_MEM_ERR        table too small (depth)
  */
 static TRDP_ERR_T distribute (
+    TRDP_HP_SLOTS_T     *pSlot,
     TRDP_HP_CAT_SLOT_T  *pCat,
     PD_ELE_T            *pElement)
 {
     TRDP_ERR_T  err         = TRDP_NO_ERR;
-    INT32       startIdx    = 0;
-    UINT32      depthIdx;
+    INT32       startIdx    = -1;
+    INT32       candidate;
+    UINT32      depthIdx    = 0u;
     UINT32      maxStartIdx;
     UINT32      count;
     UINT32      idx;
-    int         found = FALSE;
+    UINT32      size        = wireSize(pElement);
+    UINT32      bestBytes   = 0u;
+    UINT32      bestPackets = 0u;
+    UINT32      bestSum     = 0u;
+    BOOL8       bestFits    = FALSE;
+    UINT32      bytes[TRDP_HP_MAX_SLOTS];
+    UINT32      packets[TRDP_HP_MAX_SLOTS];
+    UINT32      sharedBytes[TRDP_HP_MAX_SLOTS];
+    UINT32      sharedPackets[TRDP_HP_MAX_SLOTS];
 
     /* This is the interval we need to distribute */
     UINT32      pdInterval = (UINT32) pElement->interval.tv_usec + (UINT32) pElement->interval.tv_sec * 1000000u;
@@ -307,6 +461,21 @@ static TRDP_ERR_T distribute (
         return TRDP_PARAM_ERR;
     }
 
+    /* Validate the interval against the schedule */
+    if (pdInterval < pCat->slotCycle)
+    {
+        vos_printLog(VOS_LOG_ERROR, "comId %u: interval %uus is shorter than the base cycle (%uus)\n",
+                     (unsigned int) pElement->addr.comId, (unsigned int) pdInterval,
+                     (unsigned int) pCat->slotCycle);
+        return TRDP_PARAM_ERR;
+    }
+    if ((pdInterval % pCat->slotCycle) != 0u)
+    {
+        vos_printLog(VOS_LOG_WARNING, "comId %u: interval %uus is not a multiple of %uus and will have jitter\n",
+                     (unsigned int) pElement->addr.comId, (unsigned int) pdInterval,
+                     (unsigned int) pCat->slotCycle);
+    }
+
     /* We must not place the PD later than this in the array, or we will not be able to send without a gap! */
     maxStartIdx = pdInterval / pCat->slotCycle;
 
@@ -320,27 +489,58 @@ static TRDP_ERR_T distribute (
                      (unsigned int) (pdInterval / 1000u), (unsigned int) maxStartIdx, (unsigned int) count);
         return TRDP_PARAM_ERR;
     }
-    /* Find a first empty slot */
-    for (depthIdx = 0u; depthIdx < pCat->depthOfTxEntries; depthIdx++)
+
+    slotLoad(pCat, bytes, packets);
+    sharedLoad(pSlot, pCat, sharedBytes, sharedPackets);
+
+    /* Find the best first slot */
+    for (candidate = (INT32) maxStartIdx - 1; candidate >= 0; candidate--)
     {
-        /* for (startIdx = 0u; (startIdx < pCat->noOfTxEntries); startIdx++) */
-        for (startIdx = (INT32) maxStartIdx - 1; startIdx >= 0; startIdx--)
+        UINT32  peakBytes   = 0u;
+        UINT32  peakPackets = 0u;
+        UINT32  sum         = 0u;
+        UINT32  n;
+        BOOL8   fits        = TRUE;
+
+        if (packets[candidate] >= pCat->depthOfTxEntries)
         {
-            if (getElement(pCat, (UINT32) startIdx, depthIdx) == NULL)
+            continue;   /* no room to start here */
+        }
+        for (idx = (UINT32) candidate, n = 0u; (idx < pCat->noOfTxEntries) && (n < count); idx += maxStartIdx, n++)
+        {
+            UINT32  slotBytes   = bytes[idx] + sharedBytes[idx] + size;
+            UINT32  slotPackets = packets[idx] + sharedPackets[idx] + 1u;
+
+            if (packets[idx] >= pCat->depthOfTxEntries)
             {
-                found = TRUE;
-                break;
+                fits = FALSE;
+            }
+            if (slotBytes > peakBytes)
+            {
+                peakBytes = slotBytes;
             }
+            if (slotPackets > peakPackets)
+            {
+                peakPackets = slotPackets;
+            }
+            sum += slotBytes;
         }
-        if (found)
+        if ((startIdx < 0) ||
+            ((fits == TRUE) && (bestFits == FALSE)) ||
+            ((fits == bestFits) &&
+             ((peakBytes < bestBytes) ||
+              ((peakBytes == bestBytes) && (peakPackets < bestPackets)) ||
+              ((peakBytes == bestBytes) && (peakPackets == bestPackets) && (sum < bestSum)))))
         {
-            break;
+            startIdx    = candidate;
+            bestFits    = fits;
+            bestBytes   = peakBytes;
+            bestPackets = peakPackets;
+            bestSum     = sum;
         }
     }
 
-    if ((startIdx >= pCat->noOfTxEntries) ||
-        (startIdx < 0) ||
-        (depthIdx >= pCat->depthOfTxEntries))
+    if (startIdx < 0)
     {
         vos_printLogStr(VOS_LOG_ERROR, "No room for PD in index table!\n");
         err = TRDP_MEM_ERR;
@@ -439,7 +639,7 @@ static TRDP_ERR_T indexCreatePubTable (
     }
 
     /* Allocate the 2-Dim array: */
-    pCat->noOfTxEntries     = (UINT8) slots;
+    pCat->noOfTxEntries     = (UINT16) slots;
     pCat->depthOfTxEntries  = (UINT8) depth;
 
     /* first time allocation */
@@ -549,6 +749,7 @@ TRDP_ERR_T  trdp_indexInit (TRDP_SESSION_PT appHandle)
         }
 
         /* prevent division with zero during initialisation */
+        appHandle->pSlot->baseCycle         = TRDP_DEFAULT_CYCLE;
         appHandle->pSlot->lowCat.slotCycle  = TRDP_LOW_CYCLE;   /* the lowest table can be called with 1ms cycle      */
         appHandle->pSlot->midCat.slotCycle  = TRDP_MID_CYCLE;   /* the mid table will always be called in 10ms steps  */
         appHandle->pSlot->highCat.slotCycle = TRDP_HIGH_CYCLE;  /* the hi table will always be called in 100ms steps  */
@@ -614,9 +815,11 @@ void trdp_indexDeInit (TRDP_SESSION_PT appHandle)
  *  @param[in]      maxNoOfHighCatPublishers    max. expected number of publishers
  *  @param[in]      maxDepthOfHighCatPublishers max. depth of publishers
  *  @param[in]      maxNoOfExtPublishers        max. expected number of publishers
+ *  @param[in]      baseCycle                   base transmit cycle in us (250, 500 or 1000), 0 for 1000
  *
  *  @retval         TRDP_NO_ERR     no error
  *                  TRDP_MEM_ERR    not enough memory
+ *                  TRDP_PARAM_ERR  unsupported base cycle
  */
 
 TRDP_ERR_T  trdp_indexAllocTables (
@@ -628,10 +831,26 @@ TRDP_ERR_T  trdp_indexAllocTables (
     UINT32          maxDepthOfMidCatPublishers,
     UINT32          maxNoOfHighCatPublishers,
     UINT32          maxDepthOfHighCatPublishers,
-    UINT32          maxNoOfExtPublishers)
+    UINT32          maxNoOfExtPublishers,
+    UINT32          baseCycle)
 {
     TRDP_ERR_T err = TRDP_NO_ERR;
 
+    if (baseCycle == 0u)
+    {
+        baseCycle = TRDP_DEFAULT_CYCLE;
+    }
+    /* The mid and high tables are sent in the middle resp. at the beginning of a millisecond */
+    if ((baseCycle < TRDP_MIN_CYCLE) ||
+        ((TRDP_DEFAULT_CYCLE % baseCycle) != 0u))
+    {
+        vos_printLog(VOS_LOG_ERROR, "Base cycle %uus not supported, must be a divisor of 1ms and >= %uus\n",
+                     (unsigned int) baseCycle, (unsigned int) TRDP_MIN_CYCLE);
+        return TRDP_PARAM_ERR;
+    }
+    appHandle->pSlot->baseCycle         = baseCycle;
+    appHandle->pSlot->lowCat.slotCycle  = baseCycle;
+
     err = indexCreatePubTable(TRDP_LOW_CYCLE_LIMIT, maxNoOfLowCatPublishers,
                               maxDepthOfLowCatPublishers, &appHandle->pSlot->lowCat);
     if (err == TRDP_NO_ERR)
@@ -805,7 +1024,7 @@ void    trdp_queueInsIntervalAccending (
 TRDP_ERR_T trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle)
 {
     TRDP_ERR_T      err = TRDP_NO_ERR;
-    UINT32          processCycle = TRDP_DEFAULT_CYCLE;
+    UINT32          processCycle;
     UINT32          lowCat_noOfTxEntries    = 0u;
     UINT32          midCat_noOfTxEntries    = 0u;
     UINT32          highCat_noOfTxEntries   = 0u;
@@ -813,27 +1032,27 @@ TRDP_ERR_T trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle)
     UINT32          idx, depth;
     TRDP_HP_SLOTS_T *pSlot;
 
+    pSlot = appHandle->pSlot;
+
     /* Check the parameters */
-    /* Determine the minimal process cycle time (and the ranges from it) from our configuration */
-    if (appHandle->stats.processCycle != 0u)
-    {
-        processCycle = appHandle->stats.processCycle;   /* Take the value from the process configuration, if set */
-    }
-    /* the smallest array in 500us...5000us steps */
-    if ((processCycle < TRDP_MIN_CYCLE) ||
-        (processCycle > TRDP_MAX_CYCLE))
+    /* Take the process cycle time from the process configuration, if set. Otherwise we are called every base cycle */
+    processCycle = (appHandle->stats.processCycle != 0u) ? appHandle->stats.processCycle : pSlot->baseCycle;
+
+    /* Each call sends the slots of processCycle / baseCycle base cycles */
+
+    if ((processCycle < pSlot->baseCycle) ||
+        (processCycle > TRDP_MAX_CYCLE) ||
+        ((processCycle % pSlot->baseCycle) != 0u))
     {
         vos_printLog(VOS_LOG_ERROR,
-                     "trdp_indexCreatePubTables Failed! processCycle %d : Not between 1000 to 10000...\n",
-                     processCycle);
+                     "trdp_indexCreatePubTables Failed! processCycle %u : Not a multiple of %uus up to %uus\n",
+                     (unsigned int) processCycle, (unsigned int) pSlot->baseCycle, (unsigned int) TRDP_MAX_CYCLE);
         return TRDP_PARAM_ERR;
     }
 
-    pSlot = appHandle->pSlot;
-
     /* Initialize the table entries */
     pSlot->processCycle         = processCycle;      /* cycle time in us with which we will be called      */
-    pSlot->lowCat.slotCycle     = TRDP_LOW_CYCLE;    /* the lowest table can be called with 1ms cycle     */
+    pSlot->lowCat.slotCycle     = pSlot->baseCycle;  /* the lowest table is called every base cycle        */
     pSlot->midCat.slotCycle     = TRDP_MID_CYCLE;    /* the mid table will always be called in 10ms steps  */
     pSlot->highCat.slotCycle    = TRDP_HIGH_CYCLE;   /* the hi table will always be called in 100ms steps  */
 
@@ -954,13 +1173,13 @@ TRDP_ERR_T trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle)
             switch (perf_table_category(pPDsend))
             {
                 case PERF_LOW_TABLE:
-                    err = distribute(&pSlot->lowCat, pPDsend);
+                    err = distribute(pSlot, &pSlot->lowCat, pPDsend);
                     break;
                 case PERF_MID_TABLE:
-                    err = distribute(&pSlot->midCat, pPDsend);
+                    err = distribute(pSlot, &pSlot->midCat, pPDsend);
                     break;
                 case PERF_HIGH_TABLE:
-                    err = distribute(&pSlot->highCat, pPDsend);
+                    err = distribute(pSlot, &pSlot->highCat, pPDsend);
                     break;
                 case PERF_EXT_TABLE:
                     pSlot->pExtTxTable[extCat_noOfTxEntries] = pPDsend;
@@ -986,6 +1205,163 @@ TRDP_ERR_T trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle)
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Enter a new publisher into the transmitter index tables
+ *  The publisher is placed into the existing tables, they are only re-created if it does not fit.
+ *  Before tlc_updateSession() created the tables, nothing is done.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        pointer to the publisher element, already in the send queue
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *                  TRDP_MEM_ERR    not enough memory
+ *                  TRDP_PARAM_ERR  unsupported configuration
+ */
+TRDP_ERR_T trdp_indexAddPub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    TRDP_ERR_T      err     = TRDP_NO_ERR;
+    TRDP_HP_SLOTS_T *pSlot  = appHandle->pSlot;
+    UINT32          idx;
+
+    if ((pSlot == NULL) ||
+        (pSlot->processCycle == 0u))
+    {
+        return TRDP_NO_ERR;
+    }
+
+    switch (perf_table_category(pElement))
+    {
+        case PERF_LOW_TABLE:
+            err = distribute(pSlot, &pSlot->lowCat, pElement);
+            break;
+        case PERF_MID_TABLE:
+            err = distribute(pSlot, &pSlot->midCat, pElement);
+            break;
+        case PERF_HIGH_TABLE:
+            err = distribute(pSlot, &pSlot->highCat, pElement);
+            break;
+        case PERF_EXT_TABLE:
+            /* Append it to the list, if there is room left */
+            idx = 0u;
+            while ((idx < pSlot->noOfExtTxEntries) && (pSlot->pExtTxTable[idx] != NULL))
+            {
+                idx++;
+            }
+            if ((idx < 255u) &&
+                (idx < pSlot->allocatedExtTxTableSize / sizeof(PD_ELE_T *)))
+            {
+                pSlot->pExtTxTable[idx] = pElement;
+                if (idx == pSlot->noOfExtTxEntries)
+                {
+                    pSlot->noOfExtTxEntries++;
+                }
+            }
+            else
+            {
+                err = TRDP_MEM_ERR;
+            }
+            break;
+        case PERF_IGNORE:
+            break;
+    }
+
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_INFO, "No room for comId %u in the index tables, re-creating them\n",
+                     (unsigned int) pElement->addr.comId);
+        err = trdp_indexCreatePubTables(appHandle);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Report the load of the transmitter index tables
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[out]     pProfile        bytes and packets per slot and their peaks
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *                  TRDP_STATE_ERR  tables not yet created (tlc_updateSession)
+ */
+TRDP_ERR_T trdp_indexBurstProfile (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_BURST_PROFILE_T    *pProfile)
+{
+    TRDP_HP_SLOTS_T         *pSlot = appHandle->pSlot;
+    TRDP_HP_CAT_SLOT_T      *pCat[3];
+    TRDP_BURST_CATEGORY_T   *pReport[3];
+    UINT32                  bytes[3][TRDP_HP_MAX_SLOTS];
+    UINT32                  packets[3][TRDP_HP_MAX_SLOTS];
+    UINT32                  i, slot;
+
+    memset(pProfile, 0, sizeof(TRDP_BURST_PROFILE_T));
+
+    if ((pSlot == NULL) ||
+        (pSlot->processCycle == 0u))
+    {
+        return TRDP_STATE_ERR;
+    }
+
+    pCat[0]     = &pSlot->lowCat;
+    pCat[1]     = &pSlot->midCat;
+    pCat[2]     = &pSlot->highCat;
+    pReport[0]  = &pProfile->lowCat;
+    pReport[1]  = &pProfile->midCat;
+    pReport[2]  = &pProfile->highCat;
+
+    for (i = 0u; i < 3u; i++)
+    {
+        slotLoad(pCat[i], bytes[i], packets[i]);
+        pReport[i]->slotCycle   = pCat[i]->slotCycle;
+        pReport[i]->noOfSlots   = (pCat[i]->noOfTxEntries < TRDP_BURST_PROFILE_SLOTS) ?
+            pCat[i]->noOfTxEntries : TRDP_BURST_PROFILE_SLOTS;
+        for (slot = 0u; slot < pCat[i]->noOfTxEntries; slot++)
+        {
+            if (slot < pReport[i]->noOfSlots)
+            {
+                pReport[i]->bytes[slot]     = bytes[i][slot];
+                pReport[i]->packets[slot]   = packets[i][slot];
+            }
+            if (bytes[i][slot] > pReport[i]->peakBytes)
+            {
+                pReport[i]->peakBytes = bytes[i][slot];
+            }
+            if (packets[i][slot] > pReport[i]->peakPackets)
+            {
+                pReport[i]->peakPackets = packets[i][slot];
+            }
+        }
+    }
+
+    /* A transmit cycle sends one low slot, together with a mid or a high slot */
+    pProfile->peakCycleBytes    = pProfile->lowCat.peakBytes;
+    pProfile->peakCyclePackets  = pProfile->lowCat.peakPackets;
+    for (i = 1u; i < 3u; i++)
+    {
+        for (slot = 0u; slot < pCat[i]->noOfTxEntries; slot++)
+        {
+            UINT32 low = lowSlotOf(pSlot, pCat[i], slot);
+
+            if ((bytes[0][low] + bytes[i][slot]) > pProfile->peakCycleBytes)
+            {
+                pProfile->peakCycleBytes = bytes[0][low] + bytes[i][slot];
+            }
+            if ((packets[0][low] + packets[i][slot]) > pProfile->peakCyclePackets)
+            {
+                pProfile->peakCyclePackets = packets[0][low] + packets[i][slot];
+            }
+        }
+    }
+
+    for (i = 0u; (i < pSlot->noOfExtTxEntries) && (pSlot->pExtTxTable[i] != NULL); i++)
+    {
+        pProfile->noOfExtPublishers++;
+    }
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Access the receiver index table for timeout supervision
  *  Assume to be called irregularly by the receiver thread
@@ -1080,7 +1456,7 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
 
 
     /* In case we are called less often than 1ms, we'll loop over the index table */
-    for (i = 0u; i < pSlot->processCycle; i += TRDP_MIN_CYCLE)
+    for (i = 0u; i < pSlot->processCycle; i += pSlot->baseCycle)
     {
         /* cycleN is the Nth send cycle in us */
         UINT32 cycleN = pSlot->currentCycle;
@@ -1102,7 +1478,7 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
             }
         }
 
-        if ((idxLow % 10) == 5u)
+        if ((cycleN % pSlot->midCat.slotCycle) == (pSlot->midCat.slotCycle / 2u))
         {
             idxMid = (cycleN / pSlot->midCat.slotCycle) % pSlot->midCat.noOfTxEntries;
 
@@ -1140,7 +1516,7 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
                 }
             }
         }
-        if (idxLow == 0u)       /* Every 100ms check the > 1s PDs   */
+        if ((cycleN % pSlot->highCat.slotCycle) == 0u)       /* Every 100ms check the > 1s PDs   */
         {
             idxHigh = (cycleN / pSlot->highCat.slotCycle) % pSlot->highCat.noOfTxEntries;
 
@@ -1179,7 +1555,8 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
             }
         }
         /* We count the numbers of cycles, an overflow does not matter! */
-        pSlot->currentCycle += TRDP_MIN_CYCLE;
+        pSlot->currentCycle += pSlot->baseCycle;
+
         if (pSlot->currentCycle >= (pSlot->highCat.noOfTxEntries * pSlot->highCat.slotCycle))
         {
             pSlot->currentCycle = 0u;
@@ -1188,6 +1565,78 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
     return result;
 }
 
+/**********************************************************************************************************************/
+/** Send the index tables if the next process cycle is due
+ *  For sessions driven by tlc_process(), which is not called cyclically. The process cycles are kept by time,
+ *  cycles missed by a late call are skipped.
+ *
+ *  @param[in]      appHandle       session pointer
+ *
+ *  @retval         TRDP_NO_ERR     no error / cycle not yet due
+ *                  TRDP_BLOCK_ERR  no index tables
+ *                  (errors of trdp_pdSendIndexed)
+ */
+TRDP_ERR_T trdp_pdSendIndexedDue (TRDP_SESSION_PT appHandle)
+{
+    TRDP_HP_SLOTS_T *pSlot = appHandle->pSlot;
+    TRDP_TIME_T     now;
+    TRDP_TIME_T     cycle;
+
+    if ((pSlot == NULL) || (pSlot->processCycle == 0u))
+    {
+        return TRDP_BLOCK_ERR;
+    }
+
+    vos_getTime(&now);
+    if (timerisset(&pSlot->nextCycle) && timercmp(&now, &pSlot->nextCycle, <))
+    {
+        return TRDP_NO_ERR;
+    }
+
+    cycle.tv_sec    = pSlot->processCycle / 1000000u;
+    cycle.tv_usec   = (INT32) (pSlot->processCycle % 1000000u);
+    if (!timerisset(&pSlot->nextCycle))
+    {
+        pSlot->nextCycle = now;
+    }
+    vos_addTime(&pSlot->nextCycle, &cycle);
+    if (!timercmp(&pSlot->nextCycle, &now, >))
+
+    {
+        /* called too late: skip the missed cycles */
+        pSlot->nextCycle = now;
+        vos_addTime(&pSlot->nextCycle, &cycle);
+    }
+
+    return trdp_pdSendIndexed(appHandle);
+}
+
+/**********************************************************************************************************************/
+/** Limit the time of the next job to the next process cycle
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in,out]  pNextJob        time of the next job, zero if none
+ */
+void trdp_indexNextCycle (
+    TRDP_SESSION_PT appHandle,
+    TRDP_TIME_T     *pNextJob)
+{
+    TRDP_HP_SLOTS_T *pSlot = appHandle->pSlot;
+
+    if ((pSlot == NULL) || (pSlot->processCycle == 0u))
+    {
+        return;
+    }
+    if (!timerisset(&pSlot->nextCycle))
+    {
+        vos_getTime(pNextJob);      /* first cycle is due now */
+    }
+    else if (!timerisset(pNextJob) || timercmp(&pSlot->nextCycle, pNextJob, <))
+    {
+        *pNextJob = pSlot->nextCycle;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Create the receiver index tables
  *  Create the index tables from the subscriber elements currently in the receive queue
@@ -1441,14 +1890,23 @@ void    trdp_indexRemovePub (TRDP_SESSION_PT appHandle, PD_ELE_T *pElement)
     /* Must be an extended interval entry */
     if (pSlot->noOfExtTxEntries != 0)
     {
-        for (idx = 0; idx < pSlot->noOfExtTxEntries; idx++)
+        idx = 0u;
+        while (idx < pSlot->noOfExtTxEntries)
         {
             if (pSlot->pExtTxTable[idx] == pElement)
             {
-                pSlot->pExtTxTable[idx] = NULL;
+                /* the following entries move up: sending stops at the first empty entry */
+                memmove(&pSlot->pExtTxTable[idx], &pSlot->pExtTxTable[idx + 1u],
+                        (pSlot->noOfExtTxEntries - idx - 1u) * sizeof(PD_ELE_T *));
+                pSlot->pExtTxTable[pSlot->noOfExtTxEntries - 1u] = NULL;
+            }
+            else
+            {
+                idx++;
             }
         }
     }
+
 }
 
 /******************************************************************************/
@@ -1481,4 +1939,3 @@ void    trdp_indexRemoveSub (TRDP_SESSION_PT appHandle, PD_ELE_T *pElement)
 #ifdef __cplusplus
 }
 #endif
-#endif
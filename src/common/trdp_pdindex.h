@@ -17,6 +17,9 @@
 /*
  * $Id$
  *
+ *      BL 2026-10-18: Due time of the next process cycle (nextCycle) for tlc_process()
+ *      BL 2026-10-18: Base transmit cycle (slot cycle of the low table) configurable down to 250us
+ *      BL 2026-10-18: Byte-balanced placement, incremental insert/remove of publishers, burst profile
  *      BL 2020-08-06: Ticket #314 Timeout supervision does not restart after PD request
  *      BL 2019-10-15: Ticket #282 Preset index table size and depth to prevent memory fragmentation
  *      BL 2019-07-10: Ticket #162 Independent handling of PD and MD to reduce jitter
@@ -42,12 +45,13 @@
    #define TRDP_DEFAULT_NO_SLOTS_PER_IDX       5
  */
 
-/** Supported and recomended cycle times for the tlp_processTransmit loop   */
+/** Supported and recomended cycle times for the tlp_processTransmit loop.
+    The base cycle (slot cycle of the low table) must divide 1ms, the process cycle must be a multiple of it.   */
 #define TRDP_DEFAULT_CYCLE      1000u
-#define TRDP_MIN_CYCLE          1000u
+#define TRDP_MIN_CYCLE          250u
 #define TRDP_MAX_CYCLE          10000u
 
-#define TRDP_LOW_CYCLE          1000                    /**< 1...99ms         */
+#define TRDP_LOW_CYCLE          1000                    /**< 1...99ms, default base cycle */
 #define TRDP_MID_CYCLE          10000                   /**< 100ms...990ms    */
 #define TRDP_HIGH_CYCLE         100000                  /**< >= 1000ms        */
 
@@ -55,11 +59,19 @@
 #define TRDP_MID_CYCLE_LIMIT    1000000                 /**< 101ms...1000ms   */
 #define TRDP_HIGH_CYCLE_LIMIT   10000000                /**< over 1000ms         */
 
+/** Bytes on the wire in front of each PD frame (Ethernet, IPv4 and UDP header), used to weight the slot load   */
+#ifndef TRDP_HP_WIRE_OVERHEAD
+#define TRDP_HP_WIRE_OVERHEAD   42u
+#endif
+
+/** Max. number of slots of a category (low table at the shortest base cycle)    */
+#define TRDP_HP_MAX_SLOTS       (TRDP_LOW_CYCLE_LIMIT / TRDP_MIN_CYCLE)
+
 #ifndef TRDP_TO_CHECK_CYCLE
 #define TRDP_TO_CHECK_CYCLE     100000                  /* default 100ms      */
 #endif
 
-/** Default table size settings in HIGH_PERF_INDEXED Mode  */
+/** Default table size settings of the indexed scheduler  */
 #define TRDP_DEFAULT_INDEX_SIZES  {100,     /**< Max. number of expected subscriptions with intervals <= 100ms  */ \
                                    200,     /**< Max. number of expected subscriptions with intervals <= 1000ms */ \
                                    10,      /**< Max. number of expected subscriptions with intervals > 1000ms  */ \
@@ -69,7 +81,8 @@
                                    15,      /**< depth / overlapped publishers with intervals <= 1000ms         */ \
                                    10,      /**< Max. number of expected publishers with intervals <= 10000ms   */ \
                                    5,       /**< depth / overlapped publishers with intervals <= 10000ms        */ \
-                                   10  }    /**< Max. number of expected publishers with intervals > 10000ms    */
+                                   10,      /**< Max. number of expected publishers with intervals > 10000ms    */ \
+                                   1000 }   /**< Base transmit cycle in us (250, 500 or 1000)                   */
 
 
 /***********************************************************************************************************************
@@ -82,7 +95,7 @@
 typedef struct hp_slot
 {
     UINT32          slotCycle;                          /**< cycle time with which each slot will be called (us)    */
-    UINT8           noOfTxEntries;                      /**< no of slots == first array dimension                   */
+    UINT16          noOfTxEntries;                      /**< no of slots == first array dimension                   */
     UINT8           depthOfTxEntries;                   /**< depth of slots == second array dimension               */
     PD_ELE_T        * *ppIdxCat;                        /**< pointer to an array of PD_ELE_T* (dim[depth][slot])    */
     UINT32          allocatedTableSize;                 /**< real allocated size                                    */
@@ -95,8 +108,10 @@ typedef PD_ELE_T *(PD_ELE_ARRAY_T[]);
 /** entry for the application session */
 typedef struct hp_slots
 {
+    UINT32              baseCycle;                      /**< transmit tick, slot cycle of the low array               */
     UINT32              processCycle;                   /**< system cycle time with which lowest array will be called */
     UINT32              currentCycle;                   /**< the current cycle of the send loop                       */
+    TRDP_TIME_T         nextCycle;                      /**< due time of the next process cycle (tlc_process only)    */
 
     TRDP_HP_CAT_SLOT_T  lowCat;                         /**< array dim[slot][depth]          */
     TRDP_HP_CAT_SLOT_T  midCat;                         /**< array dim[slot][depth]          */
@@ -125,7 +140,8 @@ TRDP_ERR_T  trdp_indexAllocTables (TRDP_SESSION_PT  appHandle,
                                    UINT32           maxDepthOfMidCatPublishers,
                                    UINT32           maxNoOfHighCatPublishers,
                                    UINT32           maxDepthOfHighCatPublishers,
-                                   UINT32           maxNoOfExtPublishers);
+                                   UINT32           maxNoOfExtPublishers,
+                                   UINT32           baseCycle);
 
 void        trdp_queueInsIntervalAccending (PD_ELE_T    * *ppHead,
                                             PD_ELE_T    *pNew);
@@ -133,12 +149,20 @@ void        trdp_queueInsThroughputAccending (PD_ELE_T  * *ppHead,
                                               PD_ELE_T  *pNew);
 
 TRDP_ERR_T  trdp_pdSendIndexed (TRDP_SESSION_PT appHandle);
+TRDP_ERR_T  trdp_pdSendIndexedDue (TRDP_SESSION_PT appHandle);
+void        trdp_indexNextCycle (TRDP_SESSION_PT    appHandle,
+                                 TRDP_TIME_T        *pNextJob);
 void        trdp_pdHandleTimeOutsIndexed (TRDP_SESSION_PT appHandle);
 
 PD_ELE_T    *trdp_indexedFindSubAddr (TRDP_SESSION_PT   appHandle,
                                       TRDP_ADDRESSES_T  *pAddr);
 
 TRDP_ERR_T  trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle);
+TRDP_ERR_T  trdp_indexAddPub (TRDP_SESSION_PT   appHandle,
+                              PD_ELE_T          *pElement);
+TRDP_ERR_T  trdp_indexBurstProfile (TRDP_SESSION_PT         appHandle,
+                                    TRDP_BURST_PROFILE_T    *pProfile);
+
 TRDP_ERR_T  trdp_indexCreateSubTables (TRDP_SESSION_PT appHandle);
 void        trdp_indexCheckPending (TRDP_APP_SESSION_T  appHandle,
                                     TRDP_TIME_T         *pInterval,
@@ -17,6 +17,23 @@
 /*
  * $Id$
  *
+ *      BL 2026-10-18: Version 2.3.0.1, TRDP_PROCESS_CONFIG_T changed (TRDP_OPTION_T 16 bit)
+ *      BL 2026-10-18: Hot PD counters per processing context (TRDP_PD_COUNTERS_T, pdCounters)
+ *      BL 2026-10-18: Timing histogram per publisher/subscriber (timing, timingRef, lastDelta)
+ *      BL 2026-10-18: Index tables (pSlot) per session, no longer HIGH_PERF_INDEXED only
+ *      BL 2026-10-18: State of the fast session ID generator (mdSessionIdPrefix, mdSessionIdCount)
+ *      BL 2026-10-18: Packet arena of batched notifications (pMDNotifyArena)
+ *      BL 2026-10-18: MD completion queue (pMDCompletion)
+ *      BL 2026-10-18: MD receive buffer pool (TRDP_MD_RCV_POOL_T, MD_ELE_T.poolClass)
+ *      BL 2026-10-18: MD packet buffers lent to the application (TRDP_MD_LENT_BUF_T, pMDLentBufs)
+ *      BL 2026-10-18: TCP MD connection pool (tcpPool, tcpPoolStats, TRDP_SOCKET_TCP_T.connected)
+ *      BL 2026-10-18: TCP receive buffer per MD connection (TRDP_TCP_RX_T replaces uncompletedTCP[])
+ *      BL 2026-10-18: MD session timer heap (timerIdx, pNextExpired, ppMDTimers)
+ *      BL 2026-10-18: MD listener dispatch table (pNextDispatch, pMDListenComId, pMDListenURI, pMDListenAny)
+ *      BL 2026-10-18: MD session index by session ID (pNextSession, pMDSndSessions, pMDRcvSessions)
+ *      BL 2026-10-18: Deferred PD callback dispatch (pDispatch, dispatch counters in PD_ELE_T)
+ *      BL 2026-10-18: Managed session threads (pThreads)
+ *      BL 2026-10-18: Session handle table size TRDP_MAX_SESSIONS
  *      BL 2020-07-10: Ticket #321 Move TRDP_TIMER_GRANULARITY to public API
  *      CK 2020-04-06: Ticket #318 Added pointer to list of seqCnt used per comId for PD Requests in TRDP_SESSION_T
  *      SB 2020-03-30: Ticket #309 Added pointer to a Session's Listener
@@ -65,9 +82,9 @@
 /* The TRDP version can be predefined as CFLAG   */
 #ifndef TRDP_VERSION
 #define TRDP_VERSION    2
-#define TRDP_RELEASE    2
-#define TRDP_UPDATE     23
-#define TRDP_EVOLUTION  33              /* Evolution > 0 denotes trunk! */
+#define TRDP_RELEASE    3
+#define TRDP_UPDATE     0
+#define TRDP_EVOLUTION  1               /* Evolution > 0 denotes trunk! */
 #endif
 
 /* Version as a string, this can also be for example 1.2.3.4.RC1 */
@@ -95,6 +112,19 @@
 #endif
 
 #define TRDP_MD_MAN_CYCLE_TIME          5000u                       /**< cycle time [us} = delay for outgoing MD      */
+#ifndef TRDP_MD_SESSION_HASH_SIZE
+#define TRDP_MD_SESSION_HASH_SIZE       512u                        /**< buckets of the MD session index (power of 2) */
+#endif
+#ifndef TRDP_MD_LISTENER_HASH_SIZE
+#define TRDP_MD_LISTENER_HASH_SIZE      256u                        /**< buckets of the MD listener dispatch table    */
+#endif
+#ifndef TRDP_MD_TCP_RX_SIZE
+#define TRDP_MD_TCP_RX_SIZE             16384u                      /**< initial receive buffer per TCP connection    */
+#endif
+#define TRDP_MD_RCV_POOL_CLASSES        4u                          /**< size classes of the MD receive buffer pool   */
+#ifndef TRDP_MD_RCV_POOL_DEPTH
+#define TRDP_MD_RCV_POOL_DEPTH          16u                         /**< max. idle receive buffers per size class     */
+#endif
 
 #define TRDP_DEBUG_DEFAULT_FILE_SIZE    65536u                      /**< Default maximum size of log file             */
 
@@ -103,6 +133,10 @@
 
 #define TRDP_SEQ_CNT_START_ARRAY_SIZE   64u                         /**< This should be enough for the start          */
 
+#ifndef TRDP_MAX_SESSIONS
+#define TRDP_MAX_SESSIONS               32u     /**< Size of the session handle table, must be a power of 2           */
+#endif
+
 #define TRDP_IF_WAIT_FOR_READY          120u        /**< 120 seconds (120 tries each second to bind to an IP address) */
 
 #ifdef SOA_SUPPORT
@@ -199,6 +233,16 @@ typedef struct TRDP_PR_SEQ_CNT_ELE
     UINT32                       lastSeqCnt;             /**< Sequence counter value for comId           */
 } TRDP_PR_SEQ_CNT_LIST_T;
 
+/** Receive buffer of a TCP connection: bytes read from the socket, but not yet processed.
+    Messages are taken from head, data is appended at tail.    */
+typedef struct TRDP_TCP_RX
+{
+    UINT32          head;                               /**< offset of the first unprocessed byte         */
+    UINT32          tail;                               /**< offset behind the last received byte         */
+    UINT32          size;                               /**< size of data[]                               */
+    UINT8           data[1];                            /**< received byte stream                         */
+} TRDP_TCP_RX_T;
+
 /** TCP parameters    */
 typedef struct TRDP_SOCKET_TCP
 {
@@ -209,6 +253,8 @@ typedef struct TRDP_SOCKET_TCP
     TRDP_TIME_T     sendingTimeout;                     /**< The timeout sending the message              */
     BOOL8           addFileDesc;                        /**< Ready to add the socket in the fd            */
     BOOL8           morituri;                           /**< about to die                                 */
+    BOOL8           connected;                          /**< connect() completed, no connect needed       */
+    TRDP_TCP_RX_T   *pRx;                               /**< receive buffer, allocated on first receive   */
 } TRDP_SOCKET_TCP_T;
 
 
@@ -302,9 +348,7 @@ typedef struct
 } GNU_PACKED MD_PACKET_T;
 #endif /* MD_SUPPORT */
 
-#ifdef HIGH_PERF_INDEXED
 typedef struct hp_slots TRDP_HP_SLOTS_T;        /**< forward declaration                                    */
-#endif /* HIGH_PERF_INDEXED */
 
 #if (defined (WIN32) || defined (WIN64))
 #pragma pack(pop)
@@ -341,6 +385,13 @@ typedef struct PD_ELE
     const void          *pUserRef;              /**< from subscribe()                                       */
     TRDP_PD_CALLBACK_T  pfCbFunction;           /**< Pointer to PD callback function                        */
     PD_PACKET_T         *pFrame;                /**< header ... data + FCS...                               */
+    UINT32              dispatchRef;            /**< callbacks queued for dispatch workers, see
+                                                     trdp_pdReleaseElement()                                */
+    TRDP_PD_DISPATCH_STATISTICS_T   dispatchStats;  /**< dispatch counters of a subscription                */
+    TRDP_HISTOGRAM_T    timing;                 /**< jitter of a subscription / send deviation of a publisher
+                                                     (statistics, p99 is computed on request)               */
+    TRDP_TIME_T         timingRef;              /**< last reception / next ideal send time                  */
+    UINT32              lastDelta;              /**< last time between two receptions in us                 */
 } PD_ELE_T, *TRDP_PUB_PT, *TRDP_SUB_PT;
 
 #if MD_SUPPORT
@@ -348,6 +399,8 @@ typedef struct PD_ELE
 typedef struct MD_LIS_ELE
 {
     struct MD_LIS_ELE   *pNext;                 /**< pointer to next element or NULL                        */
+    struct MD_LIS_ELE   *pNextDispatch;         /**< next listener in the same dispatch bucket or NULL      */
+    UINT32              order;                  /**< insertion sequence, the newest matching listener wins  */
     TRDP_ADDRESSES_T    addr;                   /**< addressing values                                      */
     TRDP_PRIV_FLAGS_T   privFlags;              /**< private flags                                          */
     TRDP_FLAGS_T        pktFlags;               /**< flags                                                  */
@@ -370,6 +423,9 @@ typedef struct TRDP_MD_TCP
 typedef struct MD_ELE
 {
     struct MD_ELE       *pNext;                 /**< pointer to next element or NULL                        */
+    struct MD_ELE       *pNextSession;          /**< next element in the same session index bucket or NULL  */
+    struct MD_ELE       *pNextExpired;          /**< next element with an elapsed timeout                   */
+    UINT32              timerIdx;               /**< position in the MD timer heap + 1, 0 if not armed      */
     TRDP_ADDRESSES_T    addr;                   /**< handle of publisher/subscriber                         */
     UINT32              curSeqCnt;              /**< the last sent or received sequence counter             */
     TRDP_PRIV_FLAGS_T   privFlags;              /**< private flags                                          */
@@ -402,8 +458,27 @@ typedef struct MD_ELE
     MD_PACKET_T         *pPacket;               /**< Packet header in network byte order                    */
                                                 /**< data ready to be sent (with CRCs)                      */
     MD_LIS_ELE_T        *pListener;             /**< Pointer to the Session's associated Listener           */
+    UINT8               poolClass;              /**< receive pool size class of pPacket + 1, 0 if not pooled*/
 } MD_ELE_T;
 
+/** Idle MD receive buffers and session elements, kept for reuse */
+typedef struct
+{
+    MD_PACKET_T *pFree[TRDP_MD_RCV_POOL_CLASSES];   /**< idle packet buffers per size class, linked through
+                                                         their first bytes                                  */
+    UINT32      noOfFree[TRDP_MD_RCV_POOL_CLASSES]; /**< number of idle packet buffers per size class       */
+    MD_ELE_T    *pFreeEle;                          /**< idle session elements, linked through pNext        */
+    UINT32      noOfFreeEle;                        /**< number of idle session elements                    */
+} TRDP_MD_RCV_POOL_T;
+
+/** MD packet buffer lent to the application */
+typedef struct TRDP_MD_LENT_BUF
+{
+    struct TRDP_MD_LENT_BUF *pNext;             /**< next lent buffer of the session                        */
+    MD_PACKET_T             *pPacket;           /**< packet buffer, its payload is handed out               */
+    UINT32                  capacity;           /**< payload size the buffer is able to hold                */
+} TRDP_MD_LENT_BUF_T;
+
 /**    TCP file descriptor parameters   */
 typedef struct
 {
@@ -414,6 +489,32 @@ typedef struct
 #endif
 
 struct TAU_TTDB;
+struct TRDP_SESSION_THREADS;
+struct TRDP_PD_DISPATCH;
+
+/** Processing contexts counting PD statistics of their own */
+typedef enum
+{
+    TRDP_STATS_CTX_RX   = 0,    /**< reception, timeout supervision and pull replies (tlp_processReceive)   */
+    TRDP_STATS_CTX_TX   = 1,    /**< cyclic and immediate transmission (tlp_processSend, tlp_put)           */
+    TRDP_STATS_CTX_CNT  = 2     /**< number of contexts                                                     */
+} TRDP_STATS_CTX_T;
+
+/** Hot PD counters of one processing context.
+ *  Each context is served by one thread, its counters are plain increments (atomic with TRDP_STATS_ATOMIC).
+ *  The trailing cache line keeps the blocks apart without any alignment of the session memory.
+ *  trdp_UpdateStats() sums the blocks up into the session statistics. */
+typedef struct
+{
+    UINT32  numRcv;                             /**< Number of received PD packets                          */
+    UINT32  numCrcErr;                          /**< Number of received PD packets with CRC err             */
+    UINT32  numProtErr;                         /**< Number of received PD packets with protocol err        */
+    UINT32  numTopoErr;                         /**< Number of received PD packets with wrong topo count    */
+    UINT32  numNoSubs;                          /**< Number of received PD packets without subscription     */
+    UINT32  numTimeout;                         /**< Number of PD timeouts                                  */
+    UINT32  numSend;                            /**< Number of sent PD packets                              */
+    UINT8   pad[VOS_CACHELINE_SIZE];            /**< keeps the next block off this cache line               */
+} TRDP_PD_COUNTERS_T;
 
 /** Session/application variables store */
 typedef struct TRDP_SESSION
@@ -439,10 +540,14 @@ typedef struct TRDP_SESSION
     TRDP_PR_SEQ_CNT_LIST_T  *pSeqCntList4PDReq; /**< pointer to list of sequence counters for PR per comId  */
     TRDP_TIME_T             initTime;           /**< initialization time of session                         */
     TRDP_STATISTICS_T       stats;              /**< statistics of this session                             */
-#ifdef HIGH_PERF_INDEXED
+    UINT8                   padCounters[VOS_CACHELINE_SIZE];    /**< keeps the counters off the session data */
+    TRDP_PD_COUNTERS_T      pdCounters[TRDP_STATS_CTX_CNT];     /**< hot PD counters per processing context */
+    struct TRDP_SESSION_THREADS *pThreads;      /**< threads started by tlc_startSessionThreads or NULL     */
+    struct TRDP_PD_DISPATCH     *pDispatch;     /**< PD callback dispatch workers or NULL (inline callbacks) */
+
     TRDP_HP_SLOTS_T         *pSlot;             /**< pointer to a struct holding a list of slots for
-                                                                        high speed access to PD telegrams   */
-#endif
+                                                     high speed access to PD telegrams, NULL if the session
+                                                     uses the send queue                                    */
 #if MD_SUPPORT
     VOS_MUTEX_T             mutexMD;            /**< protect the message data handling                      */
     TRDP_SOCKETS_T          ifaceMD[TRDP_MAX_MD_SOCKET_CNT];  /**< Collection of sockets to use             */
@@ -451,10 +556,28 @@ typedef struct TRDP_SESSION
     TRDP_TCP_FD_T           tcpFd;              /**< TCP file descriptor parameters                         */
     TRDP_MD_CONFIG_T        mdDefault;          /**< Default configuration for message data                 */
     MD_LIS_ELE_T            *pMDListenQueue;    /**< pointer to first element of listeners queue            */
+    MD_LIS_ELE_T            *pMDListenComId[TRDP_MD_LISTENER_HASH_SIZE]; /**< comId listeners by comId      */
+    MD_LIS_ELE_T            *pMDListenURI[TRDP_MD_LISTENER_HASH_SIZE];   /**< URI listeners by dest. URI    */
+    MD_LIS_ELE_T            *pMDListenAny;      /**< listeners filtering neither comId nor dest. URI        */
+    UINT32                  mdListenOrder;      /**< insertion sequence of the last added listener          */
     MD_ELE_T                *pMDSndQueue;       /**< pointer to first element of send MD queue (caller)     */
     MD_ELE_T                *pMDRcvQueue;       /**< pointer to first element of recv MD queue (replier)    */
+    MD_ELE_T                *pMDSndSessions[TRDP_MD_SESSION_HASH_SIZE]; /**< send MD queue by session ID    */
+    MD_ELE_T                *pMDRcvSessions[TRDP_MD_SESSION_HASH_SIZE]; /**< recv MD queue by session ID    */
+    UINT32                  numMDRcvSessions;   /**< number of elements in the recv MD queue                */
+    MD_ELE_T                * *ppMDTimers;      /**< MD sessions ordered by timeToGo (binary min-heap)      */
+    UINT32                  numMDTimers;        /**< number of armed MD session timers                      */
+    UINT32                  maxMDTimers;        /**< allocated size of ppMDTimers                           */
+    TRDP_MD_TCP_POOL_CONFIG_T tcpPool;          /**< TCP MD connection pool configuration                   */
+    TRDP_MD_TCP_POOL_STATISTICS_T tcpPoolStats; /**< TCP MD connection pool counters                        */
+    TRDP_MD_RCV_POOL_T      mdRcvPool;          /**< idle MD receive buffers                                */
+    struct TRDP_MD_COMPLETION_QUEUE *pMDCompletion; /**< MD completion queue or NULL                        */
+    TRDP_MD_LENT_BUF_T      *pMDLentBufs;       /**< packet buffers lent to the application                 */
+    UINT8                   *pMDNotifyArena;    /**< packets of batched notifications                       */
+    UINT32                  mdNotifyArenaSize;  /**< allocated size of pMDNotifyArena                       */
+    UINT64                  mdSessionIdPrefix;  /**< random part of fast session IDs, 0 until drawn         */
+    UINT64                  mdSessionIdCount;   /**< counter part of the next fast session ID               */
     MD_ELE_T                *pMDRcvEle;         /**< pointer to received MD element                         */
-    MD_ELE_T                *uncompletedTCP[VOS_MAX_SOCKET_CNT];     /**< uncompleted TCP messages buffer   */
 #endif
 } TRDP_SESSION_T, *TRDP_SESSION_PT;
 
@@ -17,6 +17,9 @@
  /*
  * $Id$
  *
+ *      BL 2026-10-18: Timing histograms read and restarted under the PD queue mutexes
+ *      BL 2026-10-18: Hot PD counters summed up from the processing contexts in trdp_UpdateStats()
+ *      BL 2026-10-18: Timing histograms: jitter of subscriptions, send deviation of publishers, reset with statistics
  *      SB 2021-08.09: Ticket #375 Replaced parameters of vos_memCount to prevent alignment issues
  *      BL 2019-02-01: Ticket #234 Correcting Statistics ComIds & defines
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -33,6 +36,8 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_PD
+
 #include <stdio.h>
 #include <string.h>
 
@@ -59,6 +64,111 @@
 
 void trdp_UpdateStats (TRDP_APP_SESSION_T appHandle);
 
+/**********************************************************************************************************************/
+/** Add a sample to a timing histogram
+ *
+ *  @param[in,out]  pHist               histogram
+ *  @param[in]      value               sample in us
+ */
+static void trdp_histogramAdd (
+    TRDP_HISTOGRAM_T    *pHist,
+    UINT32              value)
+{
+    UINT32  idx = 0u;
+    UINT32  rest;
+
+    /*  The bucket is the number of significant bits */
+    for (rest = value; (rest != 0u) && (idx < (TRDP_HISTOGRAM_BUCKETS - 1u)); rest >>= 1)
+    {
+        idx++;
+    }
+    pHist->bucket[idx]++;
+
+    if ((pHist->count == 0u) || (value < pHist->min))
+    {
+        pHist->min = value;
+    }
+    if (value > pHist->max)
+    {
+        pHist->max = value;
+    }
+    pHist->count++;
+}
+
+/**********************************************************************************************************************/
+/** Copy a timing histogram and compute its 99th percentile
+ *
+ *  @param[out]     pDest               copy
+ *  @param[in]      pSrc                histogram
+ */
+static void trdp_histogramGet (
+    TRDP_HISTOGRAM_T        *pDest,
+    const TRDP_HISTOGRAM_T  *pSrc)
+{
+    UINT32  idx;
+    UINT32  sum     = 0u;
+    UINT32  target;
+
+    *pDest      = *pSrc;
+    pDest->p99  = 0u;
+    if (pDest->count == 0u)
+    {
+        return;
+    }
+    target = (UINT32) (((UINT64) pDest->count * 99u + 99u) / 100u);
+    for (idx = 0u; idx < TRDP_HISTOGRAM_BUCKETS; idx++)
+    {
+        sum += pDest->bucket[idx];
+        if (sum >= target)
+        {
+            break;
+        }
+    }
+    if ((idx == 0u) || (idx >= (TRDP_HISTOGRAM_BUCKETS - 1u)))
+    {
+        pDest->p99 = (idx == 0u) ? 0u : pDest->max;
+    }
+    else if (((1u << idx) - 1u) < pDest->max)
+    {
+        pDest->p99 = (1u << idx) - 1u;
+    }
+    else
+    {
+        pDest->p99 = pDest->max;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Absolute difference of two times in us, saturated at 0xFFFFFFFF
+ *
+ *  @param[in]      pTime1              first time
+ *  @param[in]      pTime2              second time
+ *
+ *  @retval         |time1 - time2| in us
+ */
+static UINT32 trdp_timeDiff (
+    const TRDP_TIME_T   *pTime1,
+    const TRDP_TIME_T   *pTime2)
+{
+    TRDP_TIME_T diff;
+
+    if (timercmp(pTime1, pTime2, <))
+    {
+        diff = *pTime2;
+        vos_subTime(&diff, pTime1);
+    }
+    else
+    {
+        diff = *pTime1;
+        vos_subTime(&diff, pTime2);
+    }
+    if (diff.tv_sec >= 4294)
+    {
+        return 0xFFFFFFFFu;
+    }
+    return (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+}
+
 /******************************************************************************
  *   Globals
  */
@@ -96,8 +206,75 @@ void trdp_initStats (
     }
 }
 
+/**********************************************************************************************************************/
+/** Record the reception time of a subscribed packet.
+ *  The jitter is the change of the time between two receptions, |(t(n) - t(n-1)) - (t(n-1) - t(n-2))|.
+ *  It is not recorded for the first two packets and after a timeout.
+ *
+ *  @param[in,out]  pElement            subscription
+ *  @param[in]      pNow                reception time
+ */
+void trdp_statsRxTiming (
+    PD_ELE_T            *pElement,
+    const TRDP_TIME_T   *pNow)
+{
+    UINT32 delta;
+
+    if (!timerisset(&pElement->timingRef) ||
+        ((pElement->privFlags & TRDP_TIMED_OUT) != 0))
+    {
+        pElement->lastDelta = 0u;
+    }
+    else
+    {
+        delta = trdp_timeDiff(pNow, &pElement->timingRef);
+        if (pElement->lastDelta != 0u)
+        {
+            trdp_histogramAdd(&pElement->timing,
+                              (delta > pElement->lastDelta) ? delta - pElement->lastDelta : pElement->lastDelta - delta);
+        }
+        pElement->lastDelta = (delta != 0u) ? delta : 1u;
+    }
+    pElement->timingRef = *pNow;
+}
+
+/**********************************************************************************************************************/
+/** Record the send time of a cyclic packet.
+ *  The deviation is the distance to the ideal schedule, which advances by the interval with each packet.
+ *  The schedule restarts with the first packet and after a deviation of more than one interval.
+ *
+ *  @param[in,out]  pElement            publisher
+ *  @param[in]      pNow                send time
+ */
+void trdp_statsTxTiming (
+    PD_ELE_T            *pElement,
+    const TRDP_TIME_T   *pNow)
+{
+    UINT32  deviation;
+    UINT32  interval = (UINT32) pElement->interval.tv_sec * 1000000u + (UINT32) pElement->interval.tv_usec;
+
+    if ((interval == 0u) ||
+        ((pElement->privFlags & TRDP_REQ_2B_SENT) != 0))
+    {
+        return;     /* no schedule for requests and pulled packets */
+    }
+    if (timerisset(&pElement->timingRef))
+    {
+        deviation = trdp_timeDiff(pNow, &pElement->timingRef);
+        trdp_histogramAdd(&pElement->timing, deviation);
+        if (deviation < interval)
+        {
+            vos_addTime(&pElement->timingRef, &pElement->interval);
+            return;
+        }
+    }
+    pElement->timingRef = *pNow;
+    vos_addTime(&pElement->timingRef, &pElement->interval);
+}
+
 /**********************************************************************************************************************/
 /** Reset statistics.
+ *  Clears the session statistics and restarts the timing histograms of all publishers and subscriptions.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *  @retval         TRDP_NO_ERR         no error
@@ -107,7 +284,8 @@ void trdp_initStats (
 EXT_DECL TRDP_ERR_T tlc_resetStatistics (
     TRDP_APP_SESSION_T appHandle)
 {
-    TIMEDATE32 tempTime;
+    TIMEDATE32  tempTime;
+    PD_ELE_T    *iter;
 
     if (!trdp_isValidSession(appHandle))
     {
@@ -116,8 +294,36 @@ EXT_DECL TRDP_ERR_T tlc_resetStatistics (
 
     tempTime = appHandle->stats.upTime;
     memset(&appHandle->stats, 0, sizeof(TRDP_STATISTICS_T));
+    memset(appHandle->pdCounters, 0, sizeof(appHandle->pdCounters));
     appHandle->stats.upTime = tempTime;
 
+    /*  Restart the timing histograms of publishers and subscriptions, the queues are walked by the PD threads  */
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    for (iter = appHandle->pSndQueue; iter != NULL; iter = iter->pNext)
+    {
+        memset(&iter->timing, 0, sizeof(TRDP_HISTOGRAM_T));
+    }
+    if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    if (vos_mutexLock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    for (iter = appHandle->pRcvQueue; iter != NULL; iter = iter->pNext)
+    {
+        memset(&iter->timing, 0, sizeof(TRDP_HISTOGRAM_T));
+    }
+    if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
     return TRDP_NO_ERR;
 }
 
@@ -154,6 +360,7 @@ EXT_DECL TRDP_ERR_T tlc_getStatistics (
 /**********************************************************************************************************************/
 /** Return PD subscription statistics.
  *  Memory for statistics information must be provided by the user.
+ *  The jitter histogram holds the changes of the time between two received packets since the last reset.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *  @param[in,out]  pNumSubs            In: The number of subscriptions requested
@@ -182,6 +389,10 @@ EXT_DECL TRDP_ERR_T tlc_getSubsStatistics (
     {
         return TRDP_PARAM_ERR;
     }
+    if (vos_mutexLock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
     /*  Loop over our subscriptions, but do not exceed user supplied buffers!    */
     for ((void)(lIndex = 0), iter = appHandle->pRcvQueue; lIndex < *pNumSubs && iter != NULL; (void)(lIndex++), iter = iter->pNext)
     {
@@ -193,14 +404,19 @@ EXT_DECL TRDP_ERR_T tlc_getSubsStatistics (
         pStatistics[lIndex].timeout     = (UINT32) iter->interval.tv_usec + (UINT32) iter->interval.tv_sec * 1000000;
         /* Time-out value in us. 0 = No time-out supervision  */
         pStatistics[lIndex].toBehav     = iter->toBehavior;     /* Behavior at time-out    */
-        pStatistics[lIndex].numRecv     = iter->numRxTx;        /* Number of packets received for this subscription.  */
-        pStatistics[lIndex].numMissed   = iter->numMissed;      /* Number of packets received for this subscription.  */
+        pStatistics[lIndex].numRecv     = TRDP_STATS_GET(iter->numRxTx);    /* Number of packets received for this subscription.  */
+        pStatistics[lIndex].numMissed   = TRDP_STATS_GET(iter->numMissed);  /* Number of packets received for this subscription.  */
         pStatistics[lIndex].status      = (UINT32) iter->lastErr;        /*lint !e571 suspicious cast, Receive status information  */
+        trdp_histogramGet(&pStatistics[lIndex].jitter, &iter->timing);  /* Inter-arrival jitter               */
     }
     if (lIndex >= *pNumSubs && iter != NULL)
     {
         err = TRDP_MEM_ERR;
     }
+    if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
     *pNumSubs = lIndex;
     return err;
 }
@@ -208,6 +424,7 @@ EXT_DECL TRDP_ERR_T tlc_getSubsStatistics (
 /**********************************************************************************************************************/
 /** Return PD publish statistics.
  *  Memory for statistics information must be provided by the user.
+ *  The deviation histogram holds the distances of the send times to the ideal schedule since the last reset.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *  @param[in,out]  pNumPub             Pointer to the number of publishers
@@ -235,6 +452,10 @@ EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
     {
         return TRDP_PARAM_ERR;
     }
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
 
     /*  Loop over our subscriptions, but do not exceed user supplied buffers!    */
     for ((void)(lIndex = 0), iter = appHandle->pSndQueue; (lIndex < *pNumPub) && (iter != NULL); (void)(lIndex++), iter = iter->pNext)
@@ -248,13 +469,18 @@ EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
 
         pStatistics[lIndex].cycle = (UINT32) iter->interval.tv_usec + (UINT32)iter->interval.tv_sec * 1000000;
         /* Interval/cycle in us. 0 = No time-out supervision */
-        pStatistics[lIndex].numSend = iter->numRxTx;            /* Number of packets sent for this publisher.       */
+        pStatistics[lIndex].numSend = TRDP_STATS_GET(iter->numRxTx);    /* Number of packets sent for this publisher.   */
         pStatistics[lIndex].numPut  = iter->updPkts;            /* Updated packets (via put)                        */
+        trdp_histogramGet(&pStatistics[lIndex].deviation, &iter->timing);   /* Deviation from the schedule      */
     }
     if (lIndex >= *pNumPub && iter != NULL)
     {
         err = TRDP_MEM_ERR;
     }
+    if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
     *pNumPub = lIndex;
     return err;
 }
@@ -489,12 +715,33 @@ void    trdp_UpdateStats (
         vos_printLog(VOS_LOG_ERROR, "vos_memCount() failed (Err: %d)\n", ret);
     }
 
+    /*  Sum up the hot counters of the processing contexts  */
+    appHandle->stats.pd.numRcv      = 0u;
+    appHandle->stats.pd.numCrcErr   = 0u;
+    appHandle->stats.pd.numProtErr  = 0u;
+    appHandle->stats.pd.numTopoErr  = 0u;
+    appHandle->stats.pd.numNoSubs   = 0u;
+    appHandle->stats.pd.numTimeout  = 0u;
+    appHandle->stats.pd.numSend     = 0u;
+    for (lIndex = 0u; lIndex < (UINT16) TRDP_STATS_CTX_CNT; lIndex++)
+    {
+        const TRDP_PD_COUNTERS_T *pCounters = &appHandle->pdCounters[lIndex];
+
+        appHandle->stats.pd.numRcv      += TRDP_STATS_GET(pCounters->numRcv);
+        appHandle->stats.pd.numCrcErr   += TRDP_STATS_GET(pCounters->numCrcErr);
+        appHandle->stats.pd.numProtErr  += TRDP_STATS_GET(pCounters->numProtErr);
+        appHandle->stats.pd.numTopoErr  += TRDP_STATS_GET(pCounters->numTopoErr);
+        appHandle->stats.pd.numNoSubs   += TRDP_STATS_GET(pCounters->numNoSubs);
+        appHandle->stats.pd.numTimeout  += TRDP_STATS_GET(pCounters->numTimeout);
+        appHandle->stats.pd.numSend     += TRDP_STATS_GET(pCounters->numSend);
+    }
+
     appHandle->stats.pd.numMissed = 0u;
 
     /*  Count our subscriptions */
     for ((void)(lIndex = 0u), iter = appHandle->pRcvQueue; iter != NULL; (void)(lIndex++), iter = iter->pNext)
     {
-        appHandle->stats.pd.numMissed += iter->numMissed;
+        appHandle->stats.pd.numMissed += TRDP_STATS_GET(iter->numMissed);
     }
 
     appHandle->stats.pd.numSubs = lIndex;
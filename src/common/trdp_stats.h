@@ -17,6 +17,8 @@
  /*
  * $Id$
  *
+ *      BL 2026-10-18: TRDP_STATS_INC(), TRDP_STATS_ADD(), TRDP_STATS_GET() (atomic with TRDP_STATS_ATOMIC)
+ *      BL 2026-10-18: trdp_statsRxTiming(), trdp_statsTxTiming()
  */
 
 
@@ -35,6 +37,18 @@
  * DEFINES
  */
 
+/*  Access to the hot counters (TRDP_PD_COUNTERS_T, numRxTx, numMissed). By default the counters are
+    written by their processing context only and plain increments suffice. Define TRDP_STATS_ATOMIC for
+    exact counts if the application shares a context between threads.  */
+#ifdef TRDP_STATS_ATOMIC
+#define TRDP_STATS_ADD(counter, value)  ((void) VOS_ATOMIC_ADD(&(counter), (UINT32) (value)))
+#define TRDP_STATS_GET(counter)         VOS_ATOMIC_LOAD(&(counter))
+#else
+#define TRDP_STATS_ADD(counter, value)  ((counter) += (UINT32) (value))
+#define TRDP_STATS_GET(counter)         (counter)
+#endif
+#define TRDP_STATS_INC(counter)         TRDP_STATS_ADD(counter, 1u)
+
 
 /*******************************************************************************
  * TYPEDEFS
@@ -47,6 +61,8 @@
 
 void    trdp_initStats(TRDP_APP_SESSION_T appHandle);
 void    trdp_pdPrepareStats (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pPacket);
+void    trdp_statsRxTiming (PD_ELE_T *pElement, const TRDP_TIME_T *pNow);
+void    trdp_statsTxTiming (PD_ELE_T *pElement, const TRDP_TIME_T *pNow);
 
 
 #endif
@@ -0,0 +1,334 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_trace.c
+ *
+ * @brief           Binary trace ring of the hot paths
+ *
+ * @details         Every tracing thread claims one ring on its first event and is the only writer of that ring.
+ *                  Writing a record takes no lock: The record is filled in and then published by a release store
+ *                  of the ring head. If the ring is full, the oldest records are overwritten. The threads of the
+ *                  stack release their ring when they stop, a released ring keeps its records until another thread
+ *                  claims it. tlc_traceDump() writes all rings to a file, test/diverse/traceToJson converts it for
+ *                  chrome://tracing or Perfetto.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ *      BL 2026-10-18: Rings released by stopping threads are reused (trdp_traceRelease)
+ *      BL 2026-10-18: Binary trace ring with static probe points
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#define VOS_LOG_CAT     VOS_LOG_CAT_PD
+
+#include <stdio.h>
+#include <string.h>
+
+#include "trdp_trace.h"
+#include "trdp_if_light.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+#ifdef TRDP_TRACE
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TRDP_TRACE_MASK     (TRDP_TRACE_RING_SIZE - 1u)
+
+/*  Thread local cache of the own ring. Without compiler support the ring is looked up by the thread handle. */
+#ifndef TRDP_TRACE_TLS
+#if defined (__GNUC__)
+#define TRDP_TRACE_TLS  __thread
+#elif defined (_MSC_VER)
+#define TRDP_TRACE_TLS  __declspec(thread)
+#endif
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Ring of one thread. The head is kept apart from the records of the ring before. */
+typedef struct
+{
+    UINT32              head;                   /**< number of records ever written, changed by the owner only */
+    UINT32              inUse;                  /**< 1 while owned by a thread, 0 after trdp_traceRelease() */
+    VOS_THREAD_T        owner;                  /**< thread writing the ring                                */
+    UINT8               pad[VOS_CACHELINE_SIZE];
+    TRDP_TRACE_REC_T    rec[TRDP_TRACE_RING_SIZE];
+} TRDP_TRACE_RING_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static TRDP_TRACE_RING_T    sRing[TRDP_TRACE_MAX_RINGS];
+static UINT32               sNoOfRings  = 0u;   /**< rings ever claimed, released ones included             */
+static UINT32               sNoOfLost   = 0u;   /**< events of threads which did not get a ring             */
+
+#ifdef TRDP_TRACE_TLS
+static TRDP_TRACE_TLS TRDP_TRACE_RING_T *sOwnRing = NULL;
+#endif
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Claim a free ring for the calling thread
+ *  A ring released by a stopped thread is reused first, its records are discarded.
+ *
+ *  @param[in]      self                handle of the calling thread
+ *
+ *  @retval         pointer to the ring or NULL if all rings are taken
+ */
+static TRDP_TRACE_RING_T *trdp_traceClaim (
+    VOS_THREAD_T self)
+{
+    UINT32 idx = VOS_ATOMIC_LOAD(&sNoOfRings);
+    UINT32 i;
+
+    for (i = 0u; (i < idx) && (i < TRDP_TRACE_MAX_RINGS); i++)
+    {
+        UINT32 free = 0u;
+
+        if (VOS_ATOMIC_CAS(&sRing[i].inUse, &free, 1u))
+        {
+            sRing[i].owner = self;
+            VOS_ATOMIC_STORE(&sRing[i].head, 0u);
+            return &sRing[i];
+        }
+    }
+
+    do
+    {
+        if (idx >= TRDP_TRACE_MAX_RINGS)
+        {
+            return NULL;
+        }
+    }
+    while (!VOS_ATOMIC_CAS(&sNoOfRings, &idx, idx + 1u));
+
+    sRing[idx].owner = self;
+    VOS_ATOMIC_STORE(&sRing[idx].inUse, 1u);
+    return &sRing[idx];
+}
+
+/**********************************************************************************************************************/
+/** Get the ring of the calling thread, claim one on its first event
+ *
+ *  @retval         pointer to the ring or NULL if all rings are taken
+ */
+static TRDP_TRACE_RING_T *trdp_traceRing (void)
+{
+    VOS_THREAD_T        self    = NULL;
+    TRDP_TRACE_RING_T   *pRing  = NULL;
+
+#ifdef TRDP_TRACE_TLS
+    if (sOwnRing != NULL)
+    {
+        return sOwnRing;
+    }
+    (void) vos_threadSelf(&self);
+    pRing       = trdp_traceClaim(self);
+    sOwnRing    = pRing;
+#else
+    UINT32  i;
+    UINT32  noOfRings = VOS_ATOMIC_LOAD(&sNoOfRings);
+
+    (void) vos_threadSelf(&self);
+    for (i = 0u; (i < noOfRings) && (i < TRDP_TRACE_MAX_RINGS); i++)
+    {
+        if (sRing[i].owner == self)
+        {
+            return &sRing[i];
+        }
+    }
+    pRing = trdp_traceClaim(self);
+#endif
+    return pRing;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Add an event to the ring of the calling thread
+ *
+ *  @param[in]      event               event
+ *  @param[in]      comId               comId
+ *  @param[in]      seqCnt              sequence counter
+ *  @param[in]      srcIpAddr           source IP address
+ *  @param[in]      size                dataset size
+ *  @param[in]      info                event specific
+ */
+void trdp_traceAdd (
+    TRDP_TRACE_EVENT_T  event,
+    UINT32              comId,
+    UINT32              seqCnt,
+    UINT32              srcIpAddr,
+    UINT32              size,
+    INT32               info)
+{
+    TRDP_TRACE_RING_T   *pRing = trdp_traceRing();
+    TRDP_TRACE_REC_T    *pRec;
+    UINT32              head;
+
+    if (pRing == NULL)
+    {
+        (void) VOS_ATOMIC_ADD(&sNoOfLost, 1u);
+        return;
+    }
+
+    head = pRing->head;
+    pRec = &pRing->rec[head & TRDP_TRACE_MASK];
+    vos_getNanoTime(&pRec->timeStamp);
+    pRec->event     = (UINT16) event;
+    pRec->info      = (INT16) info;
+    pRec->comId     = comId;
+    pRec->seqCnt    = seqCnt;
+    pRec->srcIpAddr = srcIpAddr;
+    pRec->size      = size;
+    pRec->reserved  = 0u;
+    VOS_ATOMIC_STORE(&pRing->head, head + 1u);
+}
+
+/**********************************************************************************************************************/
+/** Release the ring of the calling thread
+ *  Called by the threads of the stack before they stop. The records stay in the dump until another thread
+ *  claims the ring.
+ */
+void trdp_traceRelease (void)
+{
+#ifdef TRDP_TRACE_TLS
+    TRDP_TRACE_RING_T *pRing = sOwnRing;
+
+    sOwnRing = NULL;
+#else
+    VOS_THREAD_T        self    = NULL;
+    TRDP_TRACE_RING_T   *pRing  = NULL;
+    UINT32              noOfRings = VOS_ATOMIC_LOAD(&sNoOfRings);
+    UINT32              i;
+
+    (void) vos_threadSelf(&self);
+    for (i = 0u; (i < noOfRings) && (i < TRDP_TRACE_MAX_RINGS); i++)
+    {
+        if ((sRing[i].owner == self) && (VOS_ATOMIC_LOAD(&sRing[i].inUse) != 0u))
+        {
+            pRing = &sRing[i];
+            break;
+        }
+    }
+#endif
+    if (pRing != NULL)
+    {
+        pRing->owner = NULL;
+        VOS_ATOMIC_STORE(&pRing->inUse, 0u);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Write the trace rings to a file
+ *  The file starts with a TRDP_TRACE_FILE_HEAD_T, followed by every ring as TRDP_TRACE_RING_HEAD_T and its records,
+ *  oldest first. All values are in host byte order. Records written by other threads while dumping may be
+ *  inconsistent, call it when the stack is idle or stopped for an exact picture.
+ *  At most TRDP_TRACE_MAX_RINGS threads trace at the same time. The threads of the stack (tlc_startSessionThreads,
+ *  PD callback dispatch) release their ring when they stop, application threads calling into the stack keep theirs
+ *  until the process ends. Events of threads finding no free ring are only counted (noOfLost).
+ *
+ *  @param[in]      pFileName           name of the file to write
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_IO_ERR         file could not be written
+ */
+EXT_DECL TRDP_ERR_T tlc_traceDump (
+    const CHAR8 *pFileName)
+{
+    TRDP_ERR_T              err = TRDP_NO_ERR;
+    TRDP_TRACE_FILE_HEAD_T  fileHead;
+    TRDP_TRACE_RING_HEAD_T  ringHead;
+    FILE                    *fp;
+    UINT32                  i;
+
+    if (pFileName == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    fp = fopen(pFileName, "wb");
+    if (fp == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tlc_traceDump: cannot open %s\n", pFileName);
+        return TRDP_IO_ERR;
+    }
+
+    memset(&fileHead, 0, sizeof(fileHead));
+    fileHead.magic      = TRDP_TRACE_MAGIC;
+    fileHead.version    = TRDP_TRACE_VERSION;
+    fileHead.recSize    = (UINT16) sizeof(TRDP_TRACE_REC_T);
+    fileHead.noOfRings  = VOS_ATOMIC_LOAD(&sNoOfRings);
+    fileHead.noOfLost   = VOS_ATOMIC_LOAD(&sNoOfLost);
+    if (fileHead.noOfRings > TRDP_TRACE_MAX_RINGS)
+    {
+        fileHead.noOfRings = TRDP_TRACE_MAX_RINGS;
+    }
+
+    if (fwrite(&fileHead, sizeof(fileHead), 1u, fp) != 1u)
+    {
+        err = TRDP_IO_ERR;
+    }
+
+    for (i = 0u; (i < fileHead.noOfRings) && (err == TRDP_NO_ERR); i++)
+    {
+        UINT32  head    = VOS_ATOMIC_LOAD(&sRing[i].head);
+        UINT32  first;
+        UINT32  count;
+
+        ringHead.ringId             = i;
+        ringHead.noOfRecs           = (head < TRDP_TRACE_RING_SIZE) ? head : TRDP_TRACE_RING_SIZE;
+        ringHead.noOfOverwritten    = head - ringHead.noOfRecs;
+
+        /* The records wrap at the end of the ring: write the older part first */
+        first   = (head - ringHead.noOfRecs) & TRDP_TRACE_MASK;
+        count   = TRDP_TRACE_RING_SIZE - first;
+        if (count > ringHead.noOfRecs)
+        {
+            count = ringHead.noOfRecs;
+        }
+
+        if ((fwrite(&ringHead, sizeof(ringHead), 1u, fp) != 1u)
+            || (fwrite(&sRing[i].rec[first], sizeof(TRDP_TRACE_REC_T), count, fp) != count)
+            || (fwrite(&sRing[i].rec[0], sizeof(TRDP_TRACE_REC_T), ringHead.noOfRecs - count, fp)
+                != (ringHead.noOfRecs - count)))
+        {
+            err = TRDP_IO_ERR;
+        }
+    }
+
+    if (fclose(fp) != 0)
+    {
+        err = TRDP_IO_ERR;
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tlc_traceDump: writing %s failed\n", pFileName);
+    }
+    return err;
+}
+
+#endif
@@ -0,0 +1,92 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_trace.h
+ *
+ * @brief           Binary trace ring of the hot paths
+ *
+ * @details         Compile time optional (TRDP_TRACE): Receive, send, callback, timeout and MD state events are
+ *                  written as fixed size binary records into a lock-free ring of the calling thread. With
+ *                  TRDP_TRACE_USDT every event is also a static probe point (provider 'trdp') for dtrace, perf,
+ *                  bpftrace or SystemTap. Without TRDP_TRACE the trace points compile to nothing.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ *      BL 2026-10-18: TRDP_TRACE_RELEASE() for stopping threads
+ *      BL 2026-10-18: Binary trace ring with static probe points
+ */
+
+#ifndef TRDP_TRACE_H
+#define TRDP_TRACE_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_types.h"
+
+#if defined (TRDP_TRACE) && defined (TRDP_TRACE_USDT)
+#include <sys/sdt.h>
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifndef TRDP_TRACE_MAX_RINGS
+#define TRDP_TRACE_MAX_RINGS    16u         /**< max. number of tracing threads                                 */
+#endif
+#ifndef TRDP_TRACE_RING_SIZE
+#define TRDP_TRACE_RING_SIZE    4096u       /**< records per thread, must be a power of 2                       */
+#endif
+
+/*  Trace points. The arguments are evaluated twice with TRDP_TRACE_USDT, they must not have side effects.
+    The event name is the suffix of the TRDP_TRACE_EVENT_T value and the name of the probe.   */
+#ifdef TRDP_TRACE
+#ifdef TRDP_TRACE_USDT
+#define TRDP_TRACE_PROBE(name, comId, seqCnt, srcIpAddr, size, info)  \
+    DTRACE_PROBE5(trdp, name, comId, seqCnt, srcIpAddr, size, info)
+#else
+#define TRDP_TRACE_PROBE(name, comId, seqCnt, srcIpAddr, size, info)
+#endif
+#define TRDP_TRACE_EVENT(name, comId, seqCnt, srcIpAddr, size, info)                           \
+    do                                                                                          \
+    {                                                                                           \
+        TRDP_TRACE_PROBE(name, (comId), (seqCnt), (srcIpAddr), (size), (info));                 \
+        trdp_traceAdd(TRDP_TRACE_ ## name, (comId), (seqCnt), (srcIpAddr), (size), (INT32) (info)); \
+    }                                                                                           \
+    while (0)
+#define TRDP_TRACE_RELEASE()    trdp_traceRelease()
+#else
+#define TRDP_TRACE_EVENT(name, comId, seqCnt, srcIpAddr, size, info)
+#define TRDP_TRACE_RELEASE()
+#endif
+
+/** Trace point of a PD_ELE_T or MD_ELE_T */
+#define TRDP_TRACE_ELEMENT(name, pElement, info)                                                    \
+    TRDP_TRACE_EVENT(name, (pElement)->addr.comId, (pElement)->curSeqCnt, (pElement)->addr.srcIpAddr, \
+                     (pElement)->dataSize, (info))
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+#ifdef TRDP_TRACE
+void trdp_traceAdd (TRDP_TRACE_EVENT_T event,
+                    UINT32             comId,
+                    UINT32             seqCnt,
+                    UINT32             srcIpAddr,
+                    UINT32             size,
+                    INT32              info);
+void trdp_traceRelease (void);
+#endif
+
+#endif
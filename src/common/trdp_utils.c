@@ -17,6 +17,8 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: TCP connection state (tcpParams.connected) kept with the socket
+*      BL 2026-10-18: TCP receive buffers released with their socket, trdp_freeTCPRx() replaces trdp_initUncompletedTCP()
 *      BL 2020-08-07: Ticket #317 Bug in trdp_indexedFindSubAddr() (HIGH_PERFORMANCE)
 *      A 2020-05-04: Ticket #331: Add VLAN support for Sim
 *      SB 2020-03-30: Ticket #311: removed trdp_getSeqCnt() because redundant publisher should not run on the same interface
@@ -59,6 +61,8 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_PD
+
 #include <string.h>
 
 #include "tlc_if.h"
@@ -866,17 +870,24 @@ void    trdp_MDqueueInsFirst (
 }
 
 /**********************************************************************************************************************/
-/** Initialize the UncompletedTCP pointers to null
+/** Free the receive buffers of all TCP connections
  *
- *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  iface           socket pool
+ *  @param[in]      noOfEntries     number of socket pool entries
  */
-void trdp_initUncompletedTCP (TRDP_APP_SESSION_T appHandle)
+void trdp_freeTCPRx (
+    TRDP_SOCKETS_T  iface[],
+    UINT8           noOfEntries)
 {
-    int lIndex;
-    /* Initialize the pointers to Null */
-    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    UINT8 lIndex;
+
+    for (lIndex = 0; lIndex < noOfEntries; lIndex++)
     {
-        appHandle->uncompletedTCP[lIndex] = NULL;
+        if (iface[lIndex].tcpParams.pRx != NULL)
+        {
+            vos_memFree(iface[lIndex].tcpParams.pRx);
+            iface[lIndex].tcpParams.pRx = NULL;
+        }
     }
 }
 #endif
@@ -949,6 +960,7 @@ void trdp_initSockets (
     {
         iface[lIndex].sock = VOS_INVALID_SOCKET;
         iface[lIndex].type = TRDP_SOCK_INVAL;
+        iface[lIndex].tcpParams.pRx = NULL;
     }
 }
 
@@ -1142,6 +1154,7 @@ TRDP_ERR_T  trdp_requestSocket (
         iface[lIndex].usage = 0;
         iface[lIndex].tcpParams.notSend     = FALSE;
         iface[lIndex].tcpParams.morituri    = FALSE;
+        iface[lIndex].tcpParams.connected   = (useSocket != VOS_INVALID_SOCKET) ? TRUE : FALSE;
         iface[lIndex].tcpParams.sendingTimeout.tv_sec   = 0;
         iface[lIndex].tcpParams.sendingTimeout.tv_usec  = 0;
 
@@ -1461,7 +1474,16 @@ void  trdp_releaseSocket (
                 iface[lIndex].tcpParams.connectionTimeout.tv_usec   = 0;
                 iface[lIndex].tcpParams.addFileDesc = FALSE;
                 iface[lIndex].tcpParams.morituri    = FALSE;
+                iface[lIndex].tcpParams.connected   = FALSE;
+
+                if (iface[lIndex].tcpParams.pRx != NULL)
+                {
+                    /* Unprocessed data of a closed connection is void */
+                    vos_memFree(iface[lIndex].tcpParams.pRx);
+                    iface[lIndex].tcpParams.pRx = NULL;
+                }
             }
+
         }
 
     }
@@ -17,6 +17,7 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: trdp_freeTCPRx() replaces trdp_initUncompletedTCP()
 *      BL 2020-08-07: Ticket #317 Bug in trdp_indeedFindSubAddr() (HIGH_PERFORMANCE)
 *      SB 2020-03-30: Ticket #311: removed trdp_getSeqCnt() because redundant publisher should not run on the same interface
 *      BL 2019-06-17: Ticket #264 Provide service oriented interface
@@ -149,8 +150,9 @@ void trdp_initSockets (
     TRDP_SOCKETS_T  iface[],
     UINT8           noOfEntries);
 
-void    trdp_initUncompletedTCP (
-    TRDP_APP_SESSION_T appHandle);
+void    trdp_freeTCPRx (
+    TRDP_SOCKETS_T  iface[],
+    UINT8           noOfEntries);
 
 void    trdp_resetSequenceCounter (
     PD_ELE_T        *pElement,
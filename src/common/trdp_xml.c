@@ -30,6 +30,8 @@
  * INCLUDES
  */
 
+#define VOS_LOG_CAT     VOS_LOG_CAT_TAU
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
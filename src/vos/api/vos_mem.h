@@ -18,6 +18,7 @@
  /*
  * $Id$
  *
+ *      BL 2026-10-18: Lock-free queue policies VOS_QUEUE_POLICY_SPSC and VOS_QUEUE_POLICY_MPSC
  *      SB 2021-08.09: Ticket #375 Replaced parameters of vos_memCount to prevent alignment issues
  *      BL 2019-09-06: Default pre-allocated blocks for HIGH_PERF raised again
  *      BL 2019-08-15: Default pre-allocated blocks for HIGH_PERF raised
@@ -54,7 +55,9 @@ typedef enum
 {
     VOS_QUEUE_POLICY_OTHER,         /*  Default for the target system    */
     VOS_QUEUE_POLICY_FIFO,          /*  First in, first out              */
-    VOS_QUEUE_POLICY_LIFO           /*  Last in, first out               */
+    VOS_QUEUE_POLICY_LIFO,          /*  Last in, first out               */
+    VOS_QUEUE_POLICY_SPSC,          /*  Lock-free FIFO, one sending and one receiving thread   */
+    VOS_QUEUE_POLICY_MPSC           /*  Lock-free FIFO, any sending threads, one receiving thread */
 } VOS_QUEUE_POLICY_T;
 
 
@@ -309,8 +312,10 @@ EXT_DECL void vos_strncat (
 /**********************************************************************************************************************/
 /** Initialize a message queue.
  *  Returns a handle for further calls
+ *  VOS_QUEUE_POLICY_SPSC and VOS_QUEUE_POLICY_MPSC create bounded lock-free rings, maxNoOfMsg is rounded up to the
+ *  next power of 2. The semaphore is only used if the receiver has to wait.
  *
- *  @param[in]      queueType       Define queue type (1 = FIFO, 2 = LIFO, 3 = PRIO)
+ *  @param[in]      queueType       Define queue type (1 = FIFO, 2 = LIFO, 3 = SPSC, 4 = MPSC)
  *  @param[in]      maxNoOfMsg      Maximum number of messages
  *  @param[out]     pQueueHandle    Handle of created queue
  *
@@ -17,6 +17,9 @@
 /*
  * $Id$
  *
+ *      BL 2026-10-18: vos_sockSendUDPv() batched send of several datagrams
+ *      BL 2026-10-18: vos_sockPeekUDP() added
+ *      BL 2026-10-18: vos_sockSendTCPv() gather send of several buffers
  *     AHW 2021-05-06: Ticket #322 Subscriber multicast message routing in multi-home device
  *      A 2019-11-11: Ticket #290: Add support for Virtualization on Windows
  *      BL 2019-09-10: Ticket #278 Don't check if a socket is < 0
@@ -107,6 +110,12 @@ extern "C" {
 #ifndef VOS_MAC_SIZE                /**< The MAC size supported by VOS */
 #define VOS_MAC_SIZE  6
 #endif
+#ifndef VOS_MAX_IOV_CNT             /**< The maximum number of buffers one gather send can take */
+#define VOS_MAX_IOV_CNT  16
+#endif
+#ifndef VOS_MAX_DGRAM_CNT           /**< The maximum number of datagrams one batched send can take */
+#define VOS_MAX_DGRAM_CNT  32
+#endif
 #ifndef TRDP_SOCKBUF_SIZE           /**< Size of socket send and receive buffer */
 #if MD_SUPPORT
 #define TRDP_SOCKBUF_SIZE   (64 * 1024)
@@ -153,6 +162,22 @@ typedef struct
 
 typedef fd_set VOS_FDS_T;
 
+/** Buffer descriptor for gather sends  */
+typedef struct
+{
+    const UINT8 *pBuffer;   /**< start of the data to send                          */
+    UINT32      size;       /**< no. of bytes to send                               */
+} VOS_IOVEC_T;
+
+/** Datagram descriptor for batched sends  */
+typedef struct
+{
+    const UINT8 *pBuffer;   /**< start of the datagram                              */
+    UINT32      size;       /**< size of the datagram                               */
+    UINT32      ipAddress;  /**< destination IP                                     */
+    UINT16      port;       /**< destination port                                   */
+} VOS_DGRAM_T;
+
 typedef struct
 {
     CHAR8           name[VOS_MAX_IF_NAME_SIZE]; /**< interface adapter name         */
@@ -476,6 +501,29 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     UINT32      ipAddress,
     UINT16      port);
 
+/**********************************************************************************************************************/
+/** Send several UDP datagrams.
+ *  The datagrams are sent in order, with as few system calls as the platform allows. Sending stops at the first
+ *  datagram which could not be sent, its error is returned and *pNoSent tells its position.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pDgram          array of datagrams to send
+ *  @param[in]      dgramCnt        no. of datagrams in pDgram (max. VOS_MAX_DGRAM_CNT)
+ *  @param[out]     pNoSent         no. of datagrams sent
+ *
+ *  @retval         VOS_NO_ERR      no error, all datagrams sent
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      datagram *pNoSent could not be sent
+ *  @retval         VOS_BLOCK_ERR   call would have blocked, datagram *pNoSent not sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPv (
+    SOCKET              sock,
+    const VOS_DGRAM_T   *pDgram,
+    UINT32              dgramCnt,
+    UINT32              *pNoSent);
+
+
 /**********************************************************************************************************************/
 /** Receive UDP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -511,6 +559,29 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     UINT32  *pSrcIFAddr,
     BOOL8   peek);
 
+/**********************************************************************************************************************/
+/** Peek at the next UDP datagram.
+ *  Up to *pSize bytes of the next datagram are copied without removing it from the receive queue.
+ *  Where the platform supports it, the size of the complete datagram is reported in *pDgramSize, else 0.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the buffer size / copied data size
+ *  @param[out]     pDgramSize      pointer to the size of the complete datagram, 0 if unknown
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockPeekUDP (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pDgramSize);
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -606,6 +677,31 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     const UINT8 *pBuffer,
     UINT32      *pSize);
 
+/**********************************************************************************************************************/
+/** Send TCP data from several buffers.
+ *  The buffers are sent in order as one contiguous byte stream, with as few system calls as possible.
+ *  If the socket would block, the number of bytes already sent is returned in *pSize and the caller
+ *  shall resume with the remaining bytes later on.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pIov            array of buffers to send
+ *  @param[in]      iovCnt          no. of buffers in pIov (max. VOS_MAX_IOV_CNT)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error, all data sent
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   call would have blocked, data partially sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET              sock,
+    const VOS_IOVEC_T   *pIov,
+    UINT32              iovCnt,
+    UINT32              *pSize);
+
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
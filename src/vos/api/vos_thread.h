@@ -17,6 +17,8 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: Cyclic thread overrun policy and statistics
+*      BL 2026-10-18: vos_threadSetAffinity() added
 *      A 2022-03-02: Ticket #389: Add vos Sim function vos_threadRegisterExisting
 *      A 2019-12-17: Ticket #308: Add vos Sim function to API 
 *      A 2019-11-11: Ticket #290: Add support for Virtualization on Windows
@@ -127,6 +129,31 @@ typedef UINT8 VOS_THREAD_PRIORITY_T;
 /** Thread function definition    */
 typedef void (__cdecl * VOS_THREAD_FUNC_T)(void *pArg);
 
+/** Behaviour of a cyclic thread if the thread function was running beyond the next deadline    */
+typedef enum
+{
+    VOS_THREAD_OVERRUN_LOG      = 0,    /**< skip the missed cycles and log a warning (default)     */
+    VOS_THREAD_OVERRUN_SKIP     = 1,    /**< skip the missed cycles silently                        */
+    VOS_THREAD_OVERRUN_CATCHUP  = 2     /**< execute the missed cycles without delay                */
+} VOS_THREAD_OVERRUN_T;
+
+/** Number of histogram buckets: bucket 0 counts values < 1us, bucket n values from 2^(n-1) to 2^n - 1 us,
+    the last bucket all larger values    */
+#define VOS_THREAD_HIST_BUCKETS  16u
+
+/** Timing statistics of a cyclic thread    */
+typedef struct
+{
+    UINT32  interval;                               /**< cycle time in us                                   */
+    UINT32  cycles;                                 /**< number of executed cycles                          */
+    UINT32  overruns;                               /**< cycles which ended after the next deadline         */
+    UINT32  skipped;                                /**< deadlines dropped due to overruns                  */
+    UINT32  maxLatency;                             /**< max. wake-up latency (deadline to wake-up) in us   */
+    UINT32  maxExecTime;                            /**< max. execution time of the thread function in us   */
+    UINT32  latencyHist[VOS_THREAD_HIST_BUCKETS];   /**< histogram of the wake-up latency                   */
+    UINT32  execTimeHist[VOS_THREAD_HIST_BUCKETS];  /**< histogram of the execution time                    */
+} VOS_THREAD_STATISTICS_T;
+
 /** State of the semaphore    */
 typedef enum
 {
@@ -335,6 +362,62 @@ EXT_DECL VOS_ERR_T vos_threadDelay (
 EXT_DECL VOS_ERR_T vos_threadSelf (
     VOS_THREAD_T *pThread);
 
+/**********************************************************************************************************************/
+/** Bind a thread to a set of CPUs
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[in]      cpuMask         Bit mask of allowed CPUs (bit 0 = CPU 0), 0 = no restriction
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  affinity could not be set
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT32          cpuMask);
+
+/**********************************************************************************************************************/
+/** Define the behaviour of a cyclic thread if its function was running beyond the next deadline
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[in]      policy          Overrun policy
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   no cyclic thread
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy);
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[out]     pStatistics     Pointer to statistics
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   no cyclic thread
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetStatistics (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_STATISTICS_T *pStatistics);
+
+/**********************************************************************************************************************/
+/** Reset the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   no cyclic thread
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadResetStatistics (
+    VOS_THREAD_T thread);
+
+
 /**********************************************************************************************************************/
 /** Return the current monotonic time in sec and us
  *
@@ -17,6 +17,8 @@
  /*
  * $Id$
  *
+ *      BL 2026-10-18: Lock based fallback for compilers without atomic builtins (VOS_ATOMIC_FALLBACK)
+ *      BL 2026-10-18: Atomic access macros for lock-free handle validation
  *      SB 2019-08-30: Added precompiler warning macro for windows
  *      BL 2018-06-25: Ticket #202: vos_mutexTrylock return value
  *      BL 2018-05-03: no inline if < C99
@@ -179,7 +181,78 @@ typedef double REAL64;
    #endif
 #endif
 
+/*    Compiler dependent atomic access (32 bit values and pointers)
+ *      VOS_ATOMIC_LOAD     load with acquire semantics
+ *      VOS_ATOMIC_STORE    store with release semantics
+ *      VOS_ATOMIC_ADD      add and return new value (32 bit only)
+ *      VOS_ATOMIC_SUB      subtract and return new value (32 bit only)
+ *      VOS_ATOMIC_CAS      compare *p with *pExp, store d if equal (32 bit only), returns TRUE on success
+ *      VOS_ATOMIC_LOAD_PTR, VOS_ATOMIC_STORE_PTR   the same for pointers
+ *  A target configuration may provide its own set. Compilers without atomic builtins (or VOS_ATOMIC_FALLBACK
+ *  defined) get functions of the VOS layer, serialized by one global lock which vos_init() creates.
+ */
+#if defined (VOS_ATOMIC_LOAD)
+    /* provided by the target configuration */
+#elif defined (VOS_ATOMIC_FALLBACK)
+    /* forced by the target configuration */
+#elif defined (__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7)))
+    #define VOS_ATOMIC_LOAD(p)              __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define VOS_ATOMIC_STORE(p, v)          __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define VOS_ATOMIC_ADD(p, v)            __atomic_add_fetch((p), (v), __ATOMIC_ACQ_REL)
+    #define VOS_ATOMIC_SUB(p, v)            __atomic_sub_fetch((p), (v), __ATOMIC_ACQ_REL)
+    #define VOS_ATOMIC_CAS(p, pExp, d)      __atomic_compare_exchange_n((p), (pExp), (d), 0, \
+                                                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+    #define VOS_ATOMIC_FENCE()              __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#elif (defined (WIN32) || defined (WIN64))
+    #include <intrin.h>
+    #define VOS_ATOMIC_LOAD(p)              (_ReadWriteBarrier(), *(p))
+    #define VOS_ATOMIC_STORE(p, v)          do { _ReadWriteBarrier(); *(p) = (v); _ReadWriteBarrier(); } while (0)
+    #define VOS_ATOMIC_ADD(p, v)            ((UINT32) _InterlockedExchangeAdd((volatile long *)(p), (long)(v)) + (v))
+    #define VOS_ATOMIC_SUB(p, v)            ((UINT32) _InterlockedExchangeAdd((volatile long *)(p), -(long)(v)) - (v))
+    #define VOS_ATOMIC_CAS(p, pExp, d)      vos_atomicCas32((volatile UINT32 *)(p), (UINT32 *)(pExp), (UINT32)(d))
+    #define VOS_ATOMIC_FENCE()              _mm_mfence()
+    static __inline int vos_atomicCas32 (volatile UINT32 *p, UINT32 *pExp, UINT32 d)
+    {
+        UINT32 old = (UINT32) _InterlockedCompareExchange((volatile long *)p, (long)d, (long)*pExp);
+        if (old == *pExp)
+        {
+            return 1;
+        }
+        *pExp = old;
+        return 0;
+    }
+#else
+    #define VOS_ATOMIC_FALLBACK
+#endif
+
+#ifdef VOS_ATOMIC_FALLBACK
+    #define VOS_ATOMIC_LOAD(p)              vos_atomicLoad32((const volatile UINT32 *)(p))
+    #define VOS_ATOMIC_STORE(p, v)          vos_atomicStore32((volatile UINT32 *)(p), (UINT32)(v))
+    #define VOS_ATOMIC_ADD(p, v)            vos_atomicAdd32((volatile UINT32 *)(p), (UINT32)(v))
+    #define VOS_ATOMIC_SUB(p, v)            vos_atomicAdd32((volatile UINT32 *)(p), (UINT32) 0u - (UINT32)(v))
+    #define VOS_ATOMIC_CAS(p, pExp, d)      vos_atomicCas32((volatile UINT32 *)(p), (UINT32 *)(pExp), (UINT32)(d))
+    #define VOS_ATOMIC_FENCE()              vos_atomicFence()
+    #define VOS_ATOMIC_LOAD_PTR(p)          vos_atomicLoadPtr((void *const volatile *)(p))
+    #define VOS_ATOMIC_STORE_PTR(p, v)      vos_atomicStorePtr((void *volatile *)(p), (void *)(v))
+    UINT32  vos_atomicLoad32 (const volatile UINT32 *p);
+    void    vos_atomicStore32 (volatile UINT32 *p, UINT32 v);
+    UINT32  vos_atomicAdd32 (volatile UINT32 *p, UINT32 v);
+    int     vos_atomicCas32 (volatile UINT32 *p, UINT32 *pExp, UINT32 d);
+    void    vos_atomicFence (void);
+    void    *vos_atomicLoadPtr (void *const volatile *p);
+    void    vos_atomicStorePtr (void *volatile *p, void *v);
+#elif !defined (VOS_ATOMIC_LOAD_PTR)
+    #define VOS_ATOMIC_LOAD_PTR(p)          VOS_ATOMIC_LOAD(p)
+    #define VOS_ATOMIC_STORE_PTR(p, v)      VOS_ATOMIC_STORE(p, v)
+#endif
+
+/** Size of a cache line, used to keep concurrently written data apart */
+#ifndef VOS_CACHELINE_SIZE
+    #define VOS_CACHELINE_SIZE  64u
+#endif
+
 /* Precompiler warnings */
+
 #if (defined WIN32 || defined WIN64)
 #define STRING2(x) #x
 #define STRING(x) STRING2(x)
@@ -17,6 +17,7 @@
  /*
  * $Id$
  *
+ *      BL 2026-10-18: Log output gated by a level mask per category before formatting, optional asynchronous sink
  *      BL 2019-01-23: Ticket #231: XML config from stream buffer
  *     AHW 2018-11-28: Doxygen comment errors
  *      BL 2017-05-08: Compiler warnings, doxygen comment errors
@@ -48,6 +49,33 @@ extern "C" {
 
 extern VOS_PRINT_DBG_T gPDebugFunction;
 extern void *gRefCon;
+extern UINT32 gVosLogMask;
+extern UINT32 gVosLogAsync;
+
+/** Categories of log output. A source file selects its category by defining VOS_LOG_CAT before its includes. */
+typedef enum
+{
+    VOS_LOG_CAT_VOS = 0,        /**< OS abstraction and everything not assigned otherwise       */
+    VOS_LOG_CAT_PD  = 1,        /**< session handling and process data                          */
+    VOS_LOG_CAT_MD  = 2,        /**< message data                                               */
+    VOS_LOG_CAT_TAU = 3         /**< utilities (XML, marshalling, DNR, TTI, ...)                */
+} VOS_LOG_CAT_T;
+
+#ifndef VOS_LOG_CAT
+#define VOS_LOG_CAT     VOS_LOG_CAT_VOS
+#endif
+
+/** Log mask: one byte per category, one bit per VOS_LOG_T level */
+#define VOS_LOG_CAT_BIT(cat)        (1u << (UINT32)(cat))               /**< category selector of vos_setLogMask */
+#define VOS_LOG_CAT_ALL             0x0Fu                               /**< all categories                     */
+#define VOS_LOG_LEVEL_BIT(level)    (1u << (UINT32)(level))             /**< single level                       */
+#define VOS_LOG_UPTO(level)         ((2u << (UINT32)(level)) - 1u)      /**< all levels up to level             */
+#define VOS_LOG_ENABLED(level)      \
+    ((gVosLogMask & (VOS_LOG_LEVEL_BIT(level) << (8u * (UINT32)(VOS_LOG_CAT)))) != 0u)
+
+#ifndef VOS_LOG_ASYNC_ARG_SIZE
+#define VOS_LOG_ASYNC_ARG_SIZE  192u         /**< Max. size of the arguments of an asynchronous log message */
+#endif
 
 /** String size definitions for the debug output functions */
 #define VOS_MAX_PRNT_STR_SIZE   256u         /**< Max. size of the debug/error string of debug function */
@@ -73,39 +101,62 @@ extern void *gRefCon;
     snprintf(str, size, format, ## args)    /*lint !e586 logging output needed */
 #endif
 
-/** Debug output macro without formatting options */
-#define vos_printLogStr(level, string)  {if (gPDebugFunction != NULL)         \
-                                         {gPDebugFunction(gRefCon,            \
-                                                          (level),            \
-                                                          vos_getTimeStamp(), \
-                                                          (__FILE__),         \
-                                                          (UINT16)(__LINE__), \
+/** Output of a log string, the level has been checked already */
+#define vos_printLogOut(level, string)  {if (gVosLogAsync != 0u)                                            \
+                                         {vos_logAsync((level), (__FILE__), (UINT16)(__LINE__), "%s",       \
+                                                       (string)); }                                         \
+                                         else                                                               \
+                                         {gPDebugFunction(gRefCon,                                          \
+                                                          (level),                                          \
+                                                          vos_getTimeStamp(),                               \
+                                                          (__FILE__),                                       \
+                                                          (UINT16)(__LINE__),                               \
                                                           (string)); }}
 
-/** Debug output macro with formatting options */
+/** Debug output macro without formatting options */
+#define vos_printLogStr(level, string)  {if ((gPDebugFunction != NULL) && VOS_LOG_ENABLED(level)) \
+                                         {vos_printLogOut(level, string); }}
+
+/** Debug output macro with formatting options. The level is checked before formatting, the asynchronous sink
+    stores the arguments and formats them later. */
 #if (defined (WIN32) || defined (WIN64))
-    #define vos_printLog(level, format, ...)                                   \
-    {if (gPDebugFunction != NULL)                                              \
-     {   char str[VOS_MAX_PRNT_STR_SIZE];                                      \
-         (void) _snprintf_s(str, sizeof(str), _TRUNCATE, format, __VA_ARGS__); \
-         vos_printLogStr(level, str);                                          \
-     }                                                                         \
+    #define vos_printLog(level, format, ...)                                           \
+    {if ((gPDebugFunction != NULL) && VOS_LOG_ENABLED(level))                          \
+     {   if (gVosLogAsync != 0u)                                                       \
+         {   vos_logAsync((level), (__FILE__), (UINT16)(__LINE__), format, __VA_ARGS__); \
+         }                                                                             \
+         else                                                                          \
+         {   char str[VOS_MAX_PRNT_STR_SIZE];                                          \
+             (void) _snprintf_s(str, sizeof(str), _TRUNCATE, format, __VA_ARGS__);     \
+             vos_printLogOut(level, str);                                              \
+         }                                                                             \
+     }                                                                                 \
     }
 #elif defined(__clang__)
-    #define vos_printLog(level, format, ...)                    \
-    {if (gPDebugFunction != NULL)                               \
-     {   char str[VOS_MAX_PRNT_STR_SIZE];                       \
-         (void)snprintf(str, sizeof(str), format, __VA_ARGS__); \
-         vos_printLogStr(level, str);                           \
-     }                                                          \
+    #define vos_printLog(level, format, ...)                                           \
+    {if ((gPDebugFunction != NULL) && VOS_LOG_ENABLED(level))                          \
+     {   if (gVosLogAsync != 0u)                                                       \
+         {   vos_logAsync((level), (__FILE__), (UINT16)(__LINE__), format, __VA_ARGS__); \
+         }                                                                             \
+         else                                                                          \
+         {   char str[VOS_MAX_PRNT_STR_SIZE];                                          \
+             (void)snprintf(str, sizeof(str), format, __VA_ARGS__);                    \
+             vos_printLogOut(level, str);                                              \
+         }                                                                             \
+     }                                                                                 \
     }
 #else
-    #define vos_printLog(level, format, args ...)            \
-    {if (gPDebugFunction != NULL)                            \
-     {   char str[VOS_MAX_PRNT_STR_SIZE];                    \
-         (void) snprintf(str, sizeof(str), format, ## args); \
-         vos_printLogStr(level, str);                        \
-     }                                                       \
+    #define vos_printLog(level, format, args ...)                                      \
+    {if ((gPDebugFunction != NULL) && VOS_LOG_ENABLED(level))                          \
+     {   if (gVosLogAsync != 0u)                                                       \
+         {   vos_logAsync((level), (__FILE__), (UINT16)(__LINE__), format, ## args);   \
+         }                                                                             \
+         else                                                                          \
+         {   char str[VOS_MAX_PRNT_STR_SIZE];                                          \
+             (void) snprintf(str, sizeof(str), format, ## args);                       \
+             vos_printLogOut(level, str);                                              \
+         }                                                                             \
+     }                                                                                 \
     }
 #endif
 
@@ -267,6 +318,66 @@ EXT_DECL const VOS_VERSION_T *vos_getVersion (void);
 
 EXT_DECL const CHAR8 *vos_getErrorString (VOS_ERR_T error);
 
+/**********************************************************************************************************************/
+/** Set the log levels of some categories.
+ *  Messages of disabled levels are not formatted at all. By default all levels of all categories are enabled.
+ *
+ *  @param[in]          categories      categories to change, VOS_LOG_CAT_BIT() or'ed or VOS_LOG_CAT_ALL
+ *  @param[in]          levels          enabled levels, VOS_LOG_LEVEL_BIT() or'ed or VOS_LOG_UPTO(), 0 to disable
+ */
+
+EXT_DECL void vos_setLogMask (
+    UINT32  categories,
+    UINT32  levels);
+
+/**********************************************************************************************************************/
+/** Start the asynchronous log sink.
+ *  vos_printLog() then copies its arguments into a lock-free ring, a background thread formats them and calls the
+ *  debug output function. Messages are dropped (and counted) if the ring is full.
+ *
+ *  @param[in]          queueDepth      number of messages the ring holds, rounded up to a power of 2 (0: 512)
+ *  @retval             VOS_NO_ERR      no error
+ *  @retval             VOS_INIT_ERR    already started or no debug output function
+ *  @retval             VOS_MEM_ERR     out of memory
+ *  @retval             VOS_SEMA_ERR    semaphore could not be created
+ *  @retval             VOS_THREAD_ERR  thread could not be created
+ */
+
+EXT_DECL VOS_ERR_T vos_logAsyncStart (
+    UINT32 queueDepth);
+
+/**********************************************************************************************************************/
+/** Stop the asynchronous log sink.
+ *  Pending messages are output before the function returns. Called by vos_terminate().
+ */
+
+EXT_DECL void vos_logAsyncStop (void);
+
+/**********************************************************************************************************************/
+/** Return the number of messages dropped by the asynchronous log sink because its ring was full.
+ *
+ *  @retval             number of dropped messages since vos_logAsyncStart()
+ */
+
+EXT_DECL UINT32 vos_logAsyncDropped (void);
+
+/**********************************************************************************************************************/
+/** Queue a log message for the asynchronous sink. Used by vos_printLog(), do not call directly.
+ *  The format must be a string literal, %s arguments are copied.
+ *
+ *  @param[in]          level           log level
+ *  @param[in]          pFile           source file (literal)
+ *  @param[in]          line            source line
+ *  @param[in]          pFormat         printf format (literal)
+ */
+
+EXT_DECL void vos_logAsync (
+    VOS_LOG_T   level,
+    const CHAR8 *pFile,
+    UINT16      line,
+    const CHAR8 *pFormat,
+    ...);
+
 
 
 #ifdef __cplusplus
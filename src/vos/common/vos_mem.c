@@ -20,6 +20,7 @@
  *
  * Changes:
  * 
+ *      BL 2026-10-18: Lock-free SPSC/MPSC queue variants (VOS_QUEUE_POLICY_SPSC, VOS_QUEUE_POLICY_MPSC)
  *      SB 2021-08.09: Ticket #375 Replaced parameters of vos_memCount to prevent alignment issues
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2016-07-06: Ticket #122 64Bit compatibility (+ compiler warnings)
@@ -127,6 +128,7 @@ struct VOS_QUEUE
     VOS_SEMA_T              semaphore;
     VOS_MUTEX_T             mutex;
     struct VOS_QUEUE_ELEM   *pQueue;
+    struct VOS_RING         *pRing;     /* lock-free ring of SPSC/MPSC queues, NULL otherwise */
 };
 
 /* Queue element struct */
@@ -136,6 +138,26 @@ struct VOS_QUEUE_ELEM
     UINT32  size;
 };
 
+/* Lock-free ring cell */
+typedef struct
+{
+    UINT32  seq;                        /* MPSC: position the cell is ready for (write: pos, read: pos + 1) */
+    UINT32  size;
+    UINT8   *pData;
+} VOS_RING_CELL_T;
+
+/* Lock-free ring, the indices are running counters on separate cache lines */
+struct VOS_RING
+{
+    UINT32          tail;               /* next position to write (producers) */
+    UINT8           pad1[VOS_CACHELINE_SIZE - sizeof(UINT32)];
+    UINT32          head;               /* next position to read (consumer only) */
+    UINT32          sleeping;           /* consumer waits on the semaphore, cleared by the waking producer */
+    UINT8           pad2[VOS_CACHELINE_SIZE - 2u * sizeof(UINT32)];
+    UINT32          mask;               /* number of cells - 1 */
+    VOS_RING_CELL_T *pCell;
+};
+
 /* Forward declaration, Mutex size is target dependent! */
 VOS_ERR_T       vos_mutexLocalCreate (struct VOS_MUTEX *pMutex);
 void            vos_mutexLocalDelete (struct VOS_MUTEX *pMutex);
@@ -765,11 +787,271 @@ EXT_DECL void vos_strncat (
                                                                                                                */
 /**********************************************************************************************************************/
 
+/**********************************************************************************************************************/
+/** Create the lock-free ring of a SPSC/MPSC queue.
+ *  The number of cells is maxNoOfMsg rounded up to the next power of 2.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[in]      maxNoOfMsg      Maximum number of messages
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SEMA_ERR    no semaphore available
+ */
+
+static VOS_ERR_T vos_ringCreate (
+    VOS_QUEUE_T queueHandle,
+    UINT32      maxNoOfMsg)
+{
+    struct VOS_RING *pRing;
+    UINT32          cells;
+    UINT32          i;
+
+    for (cells = 1u; (cells < maxNoOfMsg) && (cells < 0x80000000u); cells <<= 1u)
+    {
+        ;
+    }
+
+    pRing = (struct VOS_RING *) vos_memAlloc(sizeof(struct VOS_RING));
+    if (pRing == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+    pRing->pCell = (VOS_RING_CELL_T *) vos_memAlloc(cells * sizeof(VOS_RING_CELL_T));
+    if (pRing->pCell == NULL)
+    {
+        vos_memFree(pRing);
+        return VOS_MEM_ERR;
+    }
+    if (vos_semaCreate(&queueHandle->semaphore, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+    {
+        vos_memFree(pRing->pCell);
+        vos_memFree(pRing);
+        return VOS_SEMA_ERR;
+    }
+    for (i = 0u; i < cells; i++)
+    {
+        pRing->pCell[i].seq = i;
+    }
+    pRing->mask             = cells - 1u;
+    queueHandle->maxNoOfMsg = cells;
+    queueHandle->pRing      = pRing;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Put a message into a lock-free ring.
+ *  SPSC: the only producer owns 'tail'. MPSC: producers claim a cell by advancing 'tail' with CAS and publish it
+ *  by setting its sequence number.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[in]      pData           Pointer to data to be sent
+ *  @param[in]      size            Size of data to be sent
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_QUEUE_FULL_ERR  queue is full
+ */
+
+static VOS_ERR_T vos_ringSend (
+    VOS_QUEUE_T queueHandle,
+    UINT8       *pData,
+    UINT32      size)
+{
+    struct VOS_RING *pRing = queueHandle->pRing;
+    VOS_RING_CELL_T *pCell;
+    UINT32          sleeping = 1u;
+
+    if (queueHandle->queueType == VOS_QUEUE_POLICY_SPSC)
+    {
+        UINT32 tail = pRing->tail;
+
+        if ((tail - VOS_ATOMIC_LOAD(&pRing->head)) > pRing->mask)
+        {
+            return VOS_QUEUE_FULL_ERR;
+        }
+        pCell           = &pRing->pCell[tail & pRing->mask];
+        pCell->pData    = pData;
+        pCell->size     = size;
+        VOS_ATOMIC_STORE(&pRing->tail, tail + 1u);
+    }
+    else
+    {
+        UINT32 pos = VOS_ATOMIC_LOAD(&pRing->tail);
+
+        for (;; )
+        {
+            INT32 diff;
+
+            pCell   = &pRing->pCell[pos & pRing->mask];
+            diff    = (INT32) (VOS_ATOMIC_LOAD(&pCell->seq) - pos);
+            if (diff == 0)
+            {
+                if (VOS_ATOMIC_CAS(&pRing->tail, &pos, pos + 1u))
+                {
+                    break;
+                }
+                /* pos was updated by the failed CAS */
+            }
+            else if (diff < 0)
+            {
+                return VOS_QUEUE_FULL_ERR;
+            }
+            else
+            {
+                pos = VOS_ATOMIC_LOAD(&pRing->tail);
+            }
+        }
+        pCell->pData    = pData;
+        pCell->size     = size;
+        VOS_ATOMIC_STORE(&pCell->seq, pos + 1u);
+    }
+
+    /* Wake up the consumer, if it is waiting. Only the producer resetting the flag gives the semaphore. */
+    VOS_ATOMIC_FENCE();
+    if ((VOS_ATOMIC_LOAD(&pRing->sleeping) != 0u) &&
+        VOS_ATOMIC_CAS(&pRing->sleeping, &sleeping, 0u))
+    {
+        vos_semaGive(queueHandle->semaphore);
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Take a message from a lock-free ring without waiting.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     ppData          Pointer to data pointer to be received
+ *  @param[out]     pSize           Size of receive data
+ *
+ *  @retval         TRUE            message received
+ *  @retval         FALSE           queue is empty
+ */
+
+static BOOL8 vos_ringPop (
+    VOS_QUEUE_T queueHandle,
+    UINT8       * *ppData,
+    UINT32      *pSize)
+{
+    struct VOS_RING *pRing  = queueHandle->pRing;
+    UINT32          head    = pRing->head;
+    VOS_RING_CELL_T *pCell  = &pRing->pCell[head & pRing->mask];
+
+    if (queueHandle->queueType == VOS_QUEUE_POLICY_SPSC)
+    {
+        if (VOS_ATOMIC_LOAD(&pRing->tail) == head)
+        {
+            return FALSE;
+        }
+        *ppData = pCell->pData;
+        *pSize  = pCell->size;
+    }
+    else
+    {
+        if (VOS_ATOMIC_LOAD(&pCell->seq) != (head + 1u))
+        {
+            return FALSE;
+        }
+        *ppData = pCell->pData;
+        *pSize  = pCell->size;
+        VOS_ATOMIC_STORE(&pCell->seq, head + pRing->mask + 1u);     /* free for the next round */
+    }
+    VOS_ATOMIC_STORE(&pRing->head, head + 1u);
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Get a message from a lock-free ring.
+ *  The semaphore is used only if the consumer has to wait, sending and receiving otherwise need no system call.
+ *  A wake-up does not guarantee a message: a MPSC producer may have claimed the head cell without having published
+ *  it yet, its publishing will wake us again.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     ppData          Pointer to data pointer to be received
+ *  @param[out]     pSize           Size of receive data
+ *  @param[in]      usTimeout       Maximum time to wait for a message (in usec)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_QUEUE_ERR   queue is empty
+ */
+
+static VOS_ERR_T vos_ringReceive (
+    VOS_QUEUE_T queueHandle,
+    UINT8       * *ppData,
+    UINT32      *pSize,
+    UINT32      usTimeout)
+{
+    struct VOS_RING *pRing      = queueHandle->pRing;
+    UINT32          sleeping;
+    UINT32          remaining   = usTimeout;
+    VOS_TIMEVAL_T   deadline;
+    VOS_TIMEVAL_T   now;
+    VOS_TIMEVAL_T   left;
+
+    if (vos_ringPop(queueHandle, ppData, pSize) == TRUE)
+    {
+        return VOS_NO_ERR;
+    }
+    if (usTimeout != 0u)
+    {
+        if (usTimeout != VOS_SEMA_WAIT_FOREVER)
+        {
+            now.tv_sec      = usTimeout / 1000000u;
+            now.tv_usec     = usTimeout % 1000000u;
+            vos_getTime(&deadline);
+            vos_addTime(&deadline, &now);
+        }
+        for (;; )
+        {
+            /* Announce that we wait and check again, a producer may have been faster */
+            sleeping = 1u;
+            VOS_ATOMIC_STORE(&pRing->sleeping, 1u);
+            VOS_ATOMIC_FENCE();
+            if (vos_ringPop(queueHandle, ppData, pSize) == TRUE)
+            {
+                if (!VOS_ATOMIC_CAS(&pRing->sleeping, &sleeping, 0u))
+                {
+                    /* A producer reset the flag and gives the semaphore: take it to keep the count balanced */
+                    (void) vos_semaTake(queueHandle->semaphore, VOS_SEMA_WAIT_FOREVER);
+                }
+                return VOS_NO_ERR;
+            }
+            if ((vos_semaTake(queueHandle->semaphore, remaining) != VOS_NO_ERR) &&
+                !VOS_ATOMIC_CAS(&pRing->sleeping, &sleeping, 0u))
+            {
+                /* Timed out while a producer was waking us */
+                (void) vos_semaTake(queueHandle->semaphore, VOS_SEMA_WAIT_FOREVER);
+            }
+            if (vos_ringPop(queueHandle, ppData, pSize) == TRUE)
+            {
+                return VOS_NO_ERR;
+            }
+            if (usTimeout != VOS_SEMA_WAIT_FOREVER)
+            {
+                vos_getTime(&now);
+                if (vos_cmpTime(&now, &deadline) >= 0)
+                {
+                    break;
+                }
+                left = deadline;
+                vos_subTime(&left, &now);
+                remaining = (UINT32) left.tv_sec * 1000000u + (UINT32) left.tv_usec;
+            }
+        }
+    }
+
+    *ppData = NULL;
+    *pSize  = 0u;
+    return VOS_QUEUE_ERR;
+}
+
+
 /**********************************************************************************************************************/
 /** Initialize a message queue.
  *  Returns a handle for further calls
+ *  VOS_QUEUE_POLICY_SPSC and VOS_QUEUE_POLICY_MPSC create bounded lock-free rings, maxNoOfMsg is rounded up to the
+ *  next power of 2. The semaphore is only used if the receiver has to wait.
  *
- *  @param[in]      queueType       Define queue type (1 = FIFO, 2 = LIFO, 3 = PRIO)
+ *  @param[in]      queueType       Define queue type (1 = FIFO, 2 = LIFO, 3 = SPSC, 4 = MPSC)
  *  @param[in]      maxNoOfMsg      Maximum number of messages
  *  @param[out]     pQueueHandle    Handle of created queue
  *
@@ -790,7 +1072,7 @@ EXT_DECL VOS_ERR_T vos_queueCreate (
 
     /* Check parameters */
     if ((queueType < VOS_QUEUE_POLICY_OTHER)
-        || (queueType > VOS_QUEUE_POLICY_LIFO)
+        || (queueType > VOS_QUEUE_POLICY_MPSC)
         || (pQueueHandle == NULL)
         || (maxNoOfMsg == 0))
     {
@@ -805,6 +1087,22 @@ EXT_DECL VOS_ERR_T vos_queueCreate (
             vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreate() ERROR could not allocate memory\n");
             retVal = VOS_MEM_ERR;
         }
+        else if ((queueType == VOS_QUEUE_POLICY_SPSC) || (queueType == VOS_QUEUE_POLICY_MPSC))
+        {
+            /* lock-free ring, no mutex needed */
+            (*pQueueHandle)->queueType = queueType;
+            retVal = vos_ringCreate(*pQueueHandle, maxNoOfMsg);
+            if (retVal != VOS_NO_ERR)
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreate() ERROR could not create ring\n");
+                vos_memFree(*pQueueHandle);
+                *pQueueHandle = NULL;
+            }
+            else
+            {
+                (*pQueueHandle)->magicNumber = cQueueMagic;
+            }
+        }
         else
         {
             retVal = vos_semaCreate(&((*pQueueHandle)->semaphore), VOS_SEMA_EMPTY);
@@ -900,6 +1198,10 @@ EXT_DECL VOS_ERR_T vos_queueSend (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueSend() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+    else if (queueHandle->pRing != NULL)
+    {
+        retVal = vos_ringSend(queueHandle, pData, size);
+    }
     else
     {
         err = vos_mutexLock(queueHandle->mutex);
@@ -1011,6 +1313,10 @@ EXT_DECL VOS_ERR_T vos_queueReceive (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+    else if (queueHandle->pRing != NULL)
+    {
+        retVal = vos_ringReceive(queueHandle, ppData, pSize, usTimeout);
+    }
     else
     {
         /* wait for semaphore indicating new message in queue */
@@ -1095,6 +1401,15 @@ EXT_DECL VOS_ERR_T vos_queueDestroy (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueDestroy() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+    else if (queueHandle->pRing != NULL)
+    {
+        queueHandle->magicNumber = 0;
+        vos_semaDelete(queueHandle->semaphore);
+        vos_memFree(queueHandle->pRing->pCell);
+        vos_memFree(queueHandle->pRing);
+        vos_memFree(queueHandle);
+        retVal = VOS_NO_ERR;
+    }
     else
     {
         err = vos_mutexLock(queueHandle->mutex);
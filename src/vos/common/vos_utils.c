@@ -18,6 +18,8 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: Lock based atomic access for compilers without atomic builtins
+*      BL 2026-10-18: Log level mask per category, asynchronous log sink
 *      BL 2017-05-08: Compiler warnings
 *      BL 2017-02-27: #142 Compiler warnings / MISRA-C 2012 issues
 *      BL 2016-08-17: parentheses added (compiler warning)
@@ -32,6 +34,7 @@
  * INCLUDES
  */
 
+#include <stdarg.h>
 #include <string.h>
 
 #include "vos_utils.h"
@@ -51,12 +54,77 @@
 
 #define NO_OF_ERROR_STRINGS  52u
 
+#define VOS_LOG_ASYNC_DEPTH         512u        /**< default number of messages in the asynchronous ring    */
+#define VOS_LOG_ASYNC_IDLE_WAIT     10000u      /**< max. sleep time of the idle log thread [us]            */
+#define VOS_LOG_ASYNC_STOP_WAIT     1000000u    /**< max. time to wait for the log thread on stop [us]      */
+#define VOS_LOG_MAX_SPEC_SIZE       32u         /**< max. size of a single conversion specification         */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Argument types of printf conversions */
+typedef enum
+{
+    VOS_LOG_ARG_NONE,           /**< "%%", no argument                          */
+    VOS_LOG_ARG_INT,            /**< int and smaller                            */
+    VOS_LOG_ARG_LONG,           /**< long                                       */
+    VOS_LOG_ARG_LLONG,          /**< long long, intmax_t                        */
+    VOS_LOG_ARG_SIZE,           /**< size_t, ptrdiff_t                          */
+    VOS_LOG_ARG_DOUBLE,         /**< double and float                           */
+    VOS_LOG_ARG_LDOUBLE,        /**< long double                                */
+    VOS_LOG_ARG_PTR,            /**< void *                                     */
+    VOS_LOG_ARG_STR,            /**< string, copied                             */
+    VOS_LOG_ARG_END             /**< unsupported conversion, stop here          */
+} VOS_LOG_ARG_T;
+
+/** A conversion specification of a format string */
+typedef struct
+{
+    const CHAR8     *pStart;    /**< the '%'                                    */
+    UINT32          len;        /**< length of the specification                */
+    UINT32          noOfStars;  /**< int arguments for '*' width / precision    */
+    VOS_LOG_ARG_T   type;       /**< type of the argument                       */
+} VOS_LOG_SPEC_T;
+
+/** A queued log message, the arguments are formatted by the log thread */
+typedef struct
+{
+    UINT32      seq;                            /**< ring position the record is valid for          */
+    UINT16      line;                           /**< source line                                    */
+    UINT8       level;                          /**< VOS_LOG_T                                      */
+    UINT8       noOfSpecs;                      /**< conversions with stored arguments              */
+    const CHAR8 *pFile;                         /**< source file (literal)                          */
+    const CHAR8 *pFormat;                       /**< format (literal)                               */
+    UINT8       args[VOS_LOG_ASYNC_ARG_SIZE];   /**< raw arguments, strings copied                  */
+} VOS_LOG_REC_T;
+
+/** The asynchronous sink. Producers and the log thread work on separate cache lines. */
+typedef struct
+{
+    UINT32          tail;                       /**< next position to claim, CAS by producers       */
+    UINT32          users;                      /**< producers currently queueing                   */
+    UINT32          dropped;                    /**< messages dropped because the ring was full     */
+    UINT8           pad1[VOS_CACHELINE_SIZE - 3u * sizeof(UINT32)];
+    UINT32          head;                       /**< next position to format, log thread only       */
+    UINT32          idle;                       /**< log thread waits for the semaphore             */
+    UINT32          stop;                       /**< != 0: log thread shall terminate               */
+    UINT32          done;                       /**< log thread left its loop                       */
+    UINT8           pad2[VOS_CACHELINE_SIZE - 4u * sizeof(UINT32)];
+    UINT32          mask;                       /**< queue depth - 1                                */
+    VOS_LOG_REC_T   *pRec;                      /**< ring of queueDepth records                     */
+    VOS_SEMA_T      wakeup;                     /**< given by a producer if the log thread is idle  */
+    VOS_THREAD_T    thread;                     /**< log thread                                     */
+} VOS_LOG_ASYNC_T;
+
 /***********************************************************************************************************************
  * GLOBALS
  */
 
 VOS_PRINT_DBG_T gPDebugFunction = NULL;
 void *gRefCon = NULL;
+UINT32 gVosLogMask  = 0xFFFFFFFFu;  /**< enabled levels per category, see VOS_LOG_ENABLED()  */
+UINT32 gVosLogAsync = 0u;           /**< != 0: vos_printLog() queues to the asynchronous sink */
 
 /***********************************************************************************************************************
  *  LOCALS
@@ -64,6 +132,13 @@ void *gRefCon = NULL;
 
 static const VOS_VERSION_T vosVersion = {VOS_VERSION, VOS_RELEASE, VOS_UPDATE, VOS_EVOLUTION};
 
+static VOS_LOG_ASYNC_T sLogAsync;
+
+#ifdef VOS_ATOMIC_FALLBACK
+static struct VOS_MUTEX sAtomicMutex;               /**< serializes VOS_ATOMIC_xxx without compiler support   */
+static BOOL8            sAtomicMutexValid = FALSE;  /**< FALSE before vos_init(): single threaded, no lock     */
+#endif
+
 /** Table of CRC-32s of all single-byte values according to IEEE802.3 / IEC 61375-2-3 A.3
  *  The FCS-32 generator polynomial:
  *  x**0 + x**1 + x**2 + x**4 + x**5 + x**7 + x**8 + x**10 + x**11 + x**12 + x**16
@@ -447,6 +522,414 @@ static VOS_ERR_T vos_initRuntimeConsts (void)
 #endif
 }
 
+/**********************************************************************************************************************/
+/** Find the next conversion specification of a printf format
+ *
+ *  @param[in]      pFormat         format string
+ *  @param[out]     pSpec           the specification found
+ *
+ *  @retval         pointer to the '%' of the specification or NULL if there is none
+ */
+static const CHAR8 *vos_logNextSpec (
+    const CHAR8     *pFormat,
+    VOS_LOG_SPEC_T  *pSpec)
+{
+    const CHAR8 *p = strchr(pFormat, '%');
+    UINT32      noOfL = 0u;
+
+    if (p == NULL)
+    {
+        return NULL;
+    }
+    pSpec->pStart       = p;
+    pSpec->noOfStars    = 0u;
+    pSpec->type         = VOS_LOG_ARG_END;
+    p++;
+    if (*p == '%')
+    {
+        pSpec->len  = 2u;
+        pSpec->type = VOS_LOG_ARG_NONE;
+        return pSpec->pStart;
+    }
+
+    /* flags, width, precision */
+    while ((*p == '-') || (*p == '+') || (*p == ' ') || (*p == '#') || (*p == '0'))
+    {
+        p++;
+    }
+    if (*p == '*')
+    {
+        pSpec->noOfStars++;
+        p++;
+    }
+    while ((*p >= '0') && (*p <= '9'))
+    {
+        p++;
+    }
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            pSpec->noOfStars++;
+            p++;
+        }
+        while ((*p >= '0') && (*p <= '9'))
+        {
+            p++;
+        }
+    }
+
+    /* length modifier and conversion */
+    if (*p == 'h')
+    {
+        p += (p[1] == 'h') ? 2 : 1;
+    }
+    else if (*p == 'l')
+    {
+        noOfL = (p[1] == 'l') ? 2u : 1u;
+        p += noOfL;
+    }
+    else if ((*p == 'z') || (*p == 't'))
+    {
+        noOfL = 3u;
+        p++;
+    }
+    else if ((*p == 'j') || (*p == 'L'))
+    {
+        noOfL = (*p == 'j') ? 2u : 4u;
+        p++;
+    }
+
+    switch (*p)
+    {
+       case 'd':
+       case 'i':
+       case 'u':
+       case 'x':
+       case 'X':
+       case 'o':
+       case 'c':
+           pSpec->type = (noOfL == 1u) ? VOS_LOG_ARG_LONG :
+                         (noOfL == 2u) ? VOS_LOG_ARG_LLONG :
+                         (noOfL == 3u) ? VOS_LOG_ARG_SIZE : VOS_LOG_ARG_INT;
+           break;
+       case 'f':
+       case 'F':
+       case 'e':
+       case 'E':
+       case 'g':
+       case 'G':
+       case 'a':
+       case 'A':
+           pSpec->type = (noOfL == 4u) ? VOS_LOG_ARG_LDOUBLE : VOS_LOG_ARG_DOUBLE;
+           break;
+       case 'p':
+           pSpec->type = VOS_LOG_ARG_PTR;
+           break;
+       case 's':
+           pSpec->type = (noOfL == 0u) ? VOS_LOG_ARG_STR : VOS_LOG_ARG_END;
+           break;
+       default:
+           /* %n, wide strings and invalid conversions are not supported */
+           return pSpec->pStart;
+    }
+    pSpec->len = (UINT32) (p - pSpec->pStart) + 1u;
+    if (pSpec->len >= VOS_LOG_MAX_SPEC_SIZE)
+    {
+        pSpec->type = VOS_LOG_ARG_END;
+    }
+    return pSpec->pStart;
+}
+
+/**********************************************************************************************************************/
+/** Copy the arguments of a message into its record
+ *
+ *  @param[in,out]  pRec            record, pFormat set
+ *  @param[in]      ap              arguments
+ */
+static void vos_logStoreArgs (
+    VOS_LOG_REC_T   *pRec,
+    va_list         ap)
+{
+    VOS_LOG_SPEC_T  spec;
+    const CHAR8     *p      = pRec->pFormat;
+    UINT32          pos     = 0u;
+    UINT32          idx;
+    UINT8           *pArgs  = pRec->args;
+
+#define VOS_LOG_STORE(type)                                 \
+    {   type val = va_arg(ap, type);                        \
+        if ((pos + sizeof(type)) > VOS_LOG_ASYNC_ARG_SIZE)  \
+        {                                                   \
+            return;                                         \
+        }                                                   \
+        memcpy(&pArgs[pos], &val, sizeof(type));            \
+        pos += (UINT32) sizeof(type);                       \
+    }
+
+    pRec->noOfSpecs = 0u;
+    while ((p = vos_logNextSpec(p, &spec)) != NULL)
+    {
+        if (spec.type == VOS_LOG_ARG_END)
+        {
+            return;
+        }
+        for (idx = 0u; idx < spec.noOfStars; idx++)
+        {
+            VOS_LOG_STORE(int);
+        }
+        switch (spec.type)
+        {
+           case VOS_LOG_ARG_INT:
+               VOS_LOG_STORE(int);
+               break;
+           case VOS_LOG_ARG_LONG:
+               VOS_LOG_STORE(long);
+               break;
+           case VOS_LOG_ARG_LLONG:
+               VOS_LOG_STORE(long long);
+               break;
+           case VOS_LOG_ARG_SIZE:
+               VOS_LOG_STORE(size_t);
+               break;
+           case VOS_LOG_ARG_DOUBLE:
+               VOS_LOG_STORE(double);
+               break;
+           case VOS_LOG_ARG_LDOUBLE:
+               VOS_LOG_STORE(long double);
+               break;
+           case VOS_LOG_ARG_PTR:
+               VOS_LOG_STORE(void *);
+               break;
+           case VOS_LOG_ARG_STR:
+           {
+               const CHAR8  *pStr = va_arg(ap, const CHAR8 *);
+               UINT32       len;
+
+               if (pStr == NULL)
+               {
+                   pStr = "(null)";
+               }
+               if (pos >= VOS_LOG_ASYNC_ARG_SIZE)
+               {
+                   return;
+               }
+               /* Strings are truncated to the space left */
+               len = (UINT32) strlen(pStr);
+               if (len > (VOS_LOG_ASYNC_ARG_SIZE - pos - 1u))
+               {
+                   len = VOS_LOG_ASYNC_ARG_SIZE - pos - 1u;
+               }
+               memcpy(&pArgs[pos], pStr, len);
+               pArgs[pos + len] = 0u;
+               pos += len + 1u;
+               break;
+           }
+           default:
+               break;
+        }
+        if (spec.type != VOS_LOG_ARG_NONE)
+        {
+            pRec->noOfSpecs++;
+        }
+        p += spec.len;
+    }
+#undef VOS_LOG_STORE
+}
+
+/**********************************************************************************************************************/
+/** Format a queued message
+ *
+ *  @param[in]      pRec            record
+ *  @param[out]     pBuf            output buffer
+ *  @param[in]      size            size of the output buffer
+ */
+static void vos_logFormat (
+    const VOS_LOG_REC_T *pRec,
+    CHAR8               *pBuf,
+    UINT32              size)
+{
+    VOS_LOG_SPEC_T  spec;
+    const CHAR8     *p      = pRec->pFormat;
+    const CHAR8     *pNext;
+    CHAR8           fmt[VOS_LOG_MAX_SPEC_SIZE + 2u * 12u];
+    UINT32          out     = 0u;
+    UINT32          pos     = 0u;
+    UINT32          noOfSpecs = 0u;
+    UINT32          idx;
+    UINT32          len;
+    int             ret     = 0;
+
+#define VOS_LOG_FETCH(type)                                 \
+    {   type val;                                           \
+        memcpy(&val, &pRec->args[pos], sizeof(type));       \
+        pos += (UINT32) sizeof(type);                       \
+        ret = snprintf(&pBuf[out], size - out, fmt, val);   \
+    }
+
+    while (out < (size - 1u))
+    {
+        /* literal text up to the next conversion */
+        pNext   = vos_logNextSpec(p, &spec);
+        len     = (pNext != NULL) ? (UINT32) (pNext - p) : (UINT32) strlen(p);
+        if (len > (size - 1u - out))
+        {
+            len = size - 1u - out;
+        }
+        memcpy(&pBuf[out], p, len);
+        out += len;
+        if ((pNext == NULL) || (out >= (size - 1u)))
+        {
+            break;
+        }
+        if (spec.type == VOS_LOG_ARG_NONE)
+        {
+            pBuf[out++] = '%';
+            p = pNext + spec.len;
+            continue;
+        }
+        if (spec.type == VOS_LOG_ARG_END)
+        {
+            break;
+        }
+        if (noOfSpecs >= pRec->noOfSpecs)
+        {
+            /* the arguments did not fit into the record */
+            len = (UINT32) vos_snprintf(&pBuf[out], size - out, "...\n");
+            out += (len < (size - out)) ? len : (size - 1u - out);
+            break;
+        }
+
+        /* the specification, '*' replaced by the stored width / precision */
+        len = 0u;
+        for (idx = 0u; idx < spec.len; idx++)
+        {
+            if (spec.pStart[idx] == '*')
+            {
+                int val;
+
+                memcpy(&val, &pRec->args[pos], sizeof(int));
+                pos += (UINT32) sizeof(int);
+                len += (UINT32) snprintf(&fmt[len], sizeof(fmt) - len, "%d", val);
+            }
+            else
+            {
+                fmt[len++] = spec.pStart[idx];
+            }
+        }
+        fmt[len] = '\0';
+
+        switch (spec.type)
+        {
+           case VOS_LOG_ARG_INT:
+               VOS_LOG_FETCH(int);
+               break;
+           case VOS_LOG_ARG_LONG:
+               VOS_LOG_FETCH(long);
+               break;
+           case VOS_LOG_ARG_LLONG:
+               VOS_LOG_FETCH(long long);
+               break;
+           case VOS_LOG_ARG_SIZE:
+               VOS_LOG_FETCH(size_t);
+               break;
+           case VOS_LOG_ARG_DOUBLE:
+               VOS_LOG_FETCH(double);
+               break;
+           case VOS_LOG_ARG_LDOUBLE:
+               VOS_LOG_FETCH(long double);
+               break;
+           case VOS_LOG_ARG_PTR:
+               VOS_LOG_FETCH(void *);
+               break;
+           case VOS_LOG_ARG_STR:
+               ret = snprintf(&pBuf[out], size - out, fmt, (const CHAR8 *) &pRec->args[pos]);
+               pos += (UINT32) strlen((const CHAR8 *) &pRec->args[pos]) + 1u;
+               break;
+           default:
+               ret = 0;
+               break;
+        }
+        if (ret > 0)
+        {
+            out += ((UINT32) ret < (size - out)) ? (UINT32) ret : (size - 1u - out);
+        }
+        noOfSpecs++;
+        p = pNext + spec.len;
+    }
+    pBuf[out] = '\0';
+#undef VOS_LOG_FETCH
+}
+
+/**********************************************************************************************************************/
+/** Output the queued messages
+ *
+ *  @retval         number of messages output
+ */
+static UINT32 vos_logDrain (void)
+{
+    CHAR8           str[VOS_MAX_PRNT_STR_SIZE];
+    VOS_LOG_REC_T   *pRec;
+    UINT32          count = 0u;
+
+    for (;;)
+    {
+        pRec = &sLogAsync.pRec[sLogAsync.head & sLogAsync.mask];
+        if (VOS_ATOMIC_LOAD(&pRec->seq) != (sLogAsync.head + 1u))
+        {
+            break;
+        }
+        vos_logFormat(pRec, str, sizeof(str));
+        if (gPDebugFunction != NULL)
+        {
+            gPDebugFunction(gRefCon, (VOS_LOG_T) pRec->level, vos_getTimeStamp(), pRec->pFile, pRec->line, str);
+        }
+        /* hand the record back to the producers */
+        VOS_ATOMIC_STORE(&pRec->seq, sLogAsync.head + sLogAsync.mask + 1u);
+        sLogAsync.head++;
+        count++;
+    }
+    return count;
+}
+
+/**********************************************************************************************************************/
+/** Log thread function
+ *
+ *  @param[in]      pArg            not used
+ */
+static void vos_logThread (
+    void *pArg)
+{
+    UINT32 reported = 0u;
+    UINT32 dropped;
+
+    (void) pArg;
+    while ((vos_logDrain() != 0u) || (VOS_ATOMIC_LOAD(&sLogAsync.stop) == 0u))
+    {
+        dropped = VOS_ATOMIC_LOAD(&sLogAsync.dropped);
+        if ((dropped != reported) && (gPDebugFunction != NULL))
+        {
+            CHAR8 str[64u];
+
+            (void) vos_snprintf(str, sizeof(str), "%u log messages dropped\n", (unsigned int) (dropped - reported));
+            gPDebugFunction(gRefCon, VOS_LOG_WARNING, vos_getTimeStamp(), __FILE__, (UINT16) __LINE__, str);
+            reported = dropped;
+        }
+
+        /* Announce that we are idle before checking a last time, a producer gives the semaphore
+           after queueing if it sees the idle flag. */
+        VOS_ATOMIC_STORE(&sLogAsync.idle, 1u);
+        VOS_ATOMIC_FENCE();
+        if ((vos_logDrain() == 0u) && (VOS_ATOMIC_LOAD(&sLogAsync.stop) == 0u))
+        {
+            (void) vos_semaTake(sLogAsync.wakeup, VOS_LOG_ASYNC_IDLE_WAIT);
+        }
+        VOS_ATOMIC_STORE(&sLogAsync.idle, 0u);
+    }
+    VOS_ATOMIC_STORE(&sLogAsync.done, 1u);
+}
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -485,6 +968,16 @@ VOS_ERR_T vos_init (
     {
         return VOS_UNKNOWN_ERR;
     }
+#ifdef VOS_ATOMIC_FALLBACK
+    if (sAtomicMutexValid == FALSE)
+    {
+        if (vos_mutexLocalCreate(&sAtomicMutex) != VOS_NO_ERR)
+        {
+            return VOS_UNKNOWN_ERR;
+        }
+        sAtomicMutexValid = TRUE;
+    }
+#endif
     return vos_sockInit();
 }
 
@@ -495,11 +988,123 @@ VOS_ERR_T vos_init (
  */
 EXT_DECL void vos_terminate (void)
 {
+    vos_logAsyncStop();
     vos_sockTerm();
     vos_threadTerm();
     vos_memDelete(NULL);
+#ifdef VOS_ATOMIC_FALLBACK
+    if (sAtomicMutexValid == TRUE)
+    {
+        sAtomicMutexValid = FALSE;
+        vos_mutexLocalDelete(&sAtomicMutex);
+    }
+#endif
 }
 
+#ifdef VOS_ATOMIC_FALLBACK
+/**********************************************************************************************************************/
+/** Atomic access for compilers without atomic builtins (see VOS_ATOMIC_LOAD in vos_types.h)
+ *  All accesses take one global lock, which also orders them like a full memory barrier. The lock does not log
+ *  errors: logging may itself use these functions.
+ */
+
+static void vos_atomicLock (void)
+{
+    if (sAtomicMutexValid == TRUE)
+    {
+        (void) vos_mutexLock(&sAtomicMutex);
+    }
+}
+
+static void vos_atomicUnlock (void)
+{
+    if (sAtomicMutexValid == TRUE)
+    {
+        (void) vos_mutexUnlock(&sAtomicMutex);
+    }
+}
+
+UINT32 vos_atomicLoad32 (
+    const volatile UINT32 *p)
+{
+    UINT32 v;
+
+    vos_atomicLock();
+    v = *p;
+    vos_atomicUnlock();
+    return v;
+}
+
+void vos_atomicStore32 (
+    volatile UINT32 *p,
+    UINT32          v)
+{
+    vos_atomicLock();
+    *p = v;
+    vos_atomicUnlock();
+}
+
+UINT32 vos_atomicAdd32 (
+    volatile UINT32 *p,
+    UINT32          v)
+{
+    UINT32 result;
+
+    vos_atomicLock();
+    result  = *p + v;
+    *p      = result;
+    vos_atomicUnlock();
+    return result;
+}
+
+int vos_atomicCas32 (
+    volatile UINT32 *p,
+    UINT32          *pExp,
+    UINT32          d)
+{
+    int success = 0;
+
+    vos_atomicLock();
+    if (*p == *pExp)
+    {
+        *p      = d;
+        success = 1;
+    }
+    else
+    {
+        *pExp = *p;
+    }
+    vos_atomicUnlock();
+    return success;
+}
+
+void vos_atomicFence (void)
+{
+    vos_atomicLock();
+    vos_atomicUnlock();
+}
+
+void *vos_atomicLoadPtr (
+    void *const volatile *p)
+{
+    void *v;
+
+    vos_atomicLock();
+    v = *p;
+    vos_atomicUnlock();
+    return v;
+}
+
+void vos_atomicStorePtr (
+    void *volatile  *p,
+    void            *v)
+{
+    vos_atomicLock();
+    *p = v;
+    vos_atomicUnlock();
+}
+#endif
+
 /**********************************************************************************************************************/
 /** Compute crc32 according to IEEE802.3. / to IEC 61375-2-3 A.3
  *  Note: Returned CRC is inverted
@@ -602,3 +1207,222 @@ EXT_DECL const CHAR8 *vos_getErrorString (VOS_ERR_T error)
 #endif
     return buf;
 }
+
+/**********************************************************************************************************************/
+/** Set the log levels of some categories.
+ *  Messages of disabled levels are not formatted at all. By default all levels of all categories are enabled.
+ *
+ *  @param[in]          categories      categories to change, VOS_LOG_CAT_BIT() or'ed or VOS_LOG_CAT_ALL
+ *  @param[in]          levels          enabled levels, VOS_LOG_LEVEL_BIT() or'ed or VOS_LOG_UPTO(), 0 to disable
+ */
+EXT_DECL void vos_setLogMask (
+    UINT32  categories,
+    UINT32  levels)
+{
+    UINT32  mask = gVosLogMask;
+    UINT32  cat;
+
+    for (cat = 0u; cat < 4u; cat++)
+    {
+        if ((categories & VOS_LOG_CAT_BIT(cat)) != 0u)
+        {
+            mask = (mask & ~(0xFFu << (8u * cat))) | ((levels & 0xFFu) << (8u * cat));
+        }
+    }
+    gVosLogMask = mask;
+}
+
+/**********************************************************************************************************************/
+/** Start the asynchronous log sink.
+ *  vos_printLog() then copies its arguments into a lock-free ring, a background thread formats them and calls the
+ *  debug output function. Messages are dropped (and counted) if the ring is full.
+ *
+ *  @param[in]          queueDepth      number of messages the ring holds, rounded up to a power of 2 (0: 512)
+ *  @retval             VOS_NO_ERR      no error
+ *  @retval             VOS_INIT_ERR    already started or no debug output function
+ *  @retval             VOS_MEM_ERR     out of memory
+ *  @retval             VOS_SEMA_ERR    semaphore could not be created
+ *  @retval             VOS_THREAD_ERR  thread could not be created
+ */
+EXT_DECL VOS_ERR_T vos_logAsyncStart (
+    UINT32 queueDepth)
+{
+    UINT32 depth = 2u;
+    UINT32 idx;
+
+    if ((gPDebugFunction == NULL) || (sLogAsync.pRec != NULL))
+    {
+        return VOS_INIT_ERR;
+    }
+    if (queueDepth == 0u)
+    {
+        queueDepth = VOS_LOG_ASYNC_DEPTH;
+    }
+    while ((depth < queueDepth) && (depth < 0x40000000u))
+    {
+        depth <<= 1;
+    }
+
+    memset(&sLogAsync, 0, sizeof(sLogAsync));
+    sLogAsync.pRec = (VOS_LOG_REC_T *) vos_memAlloc(depth * (UINT32) sizeof(VOS_LOG_REC_T));
+    if (sLogAsync.pRec == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+    for (idx = 0u; idx < depth; idx++)
+    {
+        sLogAsync.pRec[idx].seq = idx;
+    }
+    sLogAsync.mask = depth - 1u;
+
+    if (vos_semaCreate(&sLogAsync.wakeup, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+    {
+        vos_memFree(sLogAsync.pRec);
+        sLogAsync.pRec = NULL;
+        return VOS_SEMA_ERR;
+    }
+    if (vos_threadCreate(&sLogAsync.thread, "VOS Log", VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
+                         (VOS_THREAD_FUNC_T) vos_logThread, NULL) != VOS_NO_ERR)
+    {
+        vos_semaDelete(sLogAsync.wakeup);
+        vos_memFree(sLogAsync.pRec);
+        sLogAsync.pRec = NULL;
+        return VOS_THREAD_ERR;
+    }
+    VOS_ATOMIC_STORE(&gVosLogAsync, 1u);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Stop the asynchronous log sink.
+ *  Pending messages are output before the function returns. Called by vos_terminate().
+ */
+EXT_DECL void vos_logAsyncStop (void)
+{
+    UINT32 waitTime;
+
+    if (sLogAsync.pRec == NULL)
+    {
+        return;
+    }
+
+    /* New messages are output directly, wait for the producers still queueing */
+    VOS_ATOMIC_STORE(&gVosLogAsync, 0u);
+    VOS_ATOMIC_FENCE();
+    for (waitTime = VOS_LOG_ASYNC_STOP_WAIT; (waitTime > 0u) && (VOS_ATOMIC_LOAD(&sLogAsync.users) != 0u);
+         waitTime -= 1000u)
+    {
+        (void) vos_threadDelay(1000u);
+    }
+
+    /* The log thread outputs the pending messages and terminates */
+    VOS_ATOMIC_STORE(&sLogAsync.stop, 1u);
+    VOS_ATOMIC_FENCE();
+    vos_semaGive(sLogAsync.wakeup);
+    for (waitTime = VOS_LOG_ASYNC_STOP_WAIT; (waitTime > 0u) && (VOS_ATOMIC_LOAD(&sLogAsync.done) == 0u);
+         waitTime -= 1000u)
+    {
+        (void) vos_threadDelay(1000u);
+    }
+    if (VOS_ATOMIC_LOAD(&sLogAsync.done) == 0u)
+    {
+        /* Stuck in the debug output function, the ring must be kept */
+        (void) vos_threadTerminate(sLogAsync.thread);
+        return;
+    }
+    vos_semaDelete(sLogAsync.wakeup);
+    vos_memFree(sLogAsync.pRec);
+    sLogAsync.pRec = NULL;
+}
+
+/**********************************************************************************************************************/
+/** Return the number of messages dropped by the asynchronous log sink because its ring was full.
+ *
+ *  @retval             number of dropped messages since vos_logAsyncStart()
+ */
+EXT_DECL UINT32 vos_logAsyncDropped (void)
+{
+    return VOS_ATOMIC_LOAD(&sLogAsync.dropped);
+}
+
+/**********************************************************************************************************************/
+/** Queue a log message for the asynchronous sink. Used by vos_printLog(), do not call directly.
+ *  The format must be a string literal, %s arguments are copied. If the sink is not running, the message is
+ *  formatted and output directly.
+ *
+ *  @param[in]          level           log level
+ *  @param[in]          pFile           source file (literal)
+ *  @param[in]          line            source line
+ *  @param[in]          pFormat         printf format (literal)
+ */
+EXT_DECL void vos_logAsync (
+    VOS_LOG_T   level,
+    const CHAR8 *pFile,
+    UINT16      line,
+    const CHAR8 *pFormat,
+    ...)
+{
+    VOS_LOG_REC_T   *pRec = NULL;
+    va_list         ap;
+    UINT32          pos;
+    INT32           diff;
+
+    /* Announce the producer before checking the sink, vos_logAsyncStop() waits for it */
+    (void) VOS_ATOMIC_ADD(&sLogAsync.users, 1u);
+    VOS_ATOMIC_FENCE();
+    if (VOS_ATOMIC_LOAD(&gVosLogAsync) == 0u)
+    {
+        (void) VOS_ATOMIC_SUB(&sLogAsync.users, 1u);
+        if (gPDebugFunction != NULL)
+        {
+            CHAR8 str[VOS_MAX_PRNT_STR_SIZE];
+
+            va_start(ap, pFormat);
+            (void) vsnprintf(str, sizeof(str), pFormat, ap);
+            va_end(ap);
+            gPDebugFunction(gRefCon, level, vos_getTimeStamp(), pFile, line, str);
+        }
+        return;
+    }
+
+    /* Claim a record: it is free if its sequence equals the position */
+    pos = VOS_ATOMIC_LOAD(&sLogAsync.tail);
+    for (;;)
+    {
+        pRec    = &sLogAsync.pRec[pos & sLogAsync.mask];
+        diff    = (INT32) (VOS_ATOMIC_LOAD(&pRec->seq) - pos);
+        if (diff == 0)
+        {
+            if (VOS_ATOMIC_CAS(&sLogAsync.tail, &pos, pos + 1u))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* full */
+            (void) VOS_ATOMIC_ADD(&sLogAsync.dropped, 1u);
+            (void) VOS_ATOMIC_SUB(&sLogAsync.users, 1u);
+            return;
+        }
+        else
+        {
+            pos = VOS_ATOMIC_LOAD(&sLogAsync.tail);
+        }
+    }
+
+    pRec->level     = (UINT8) level;
+    pRec->line      = line;
+    pRec->pFile     = pFile;
+    pRec->pFormat   = pFormat;
+    va_start(ap, pFormat);
+    vos_logStoreArgs(pRec, ap);
+    va_end(ap);
+    VOS_ATOMIC_STORE(&pRec->seq, pos + 1u);
+
+    if (VOS_ATOMIC_LOAD(&sLogAsync.idle) != 0u)
+    {
+        vos_semaGive(sLogAsync.wakeup);
+    }
+    (void) VOS_ATOMIC_SUB(&sLogAsync.users, 1u);
+}
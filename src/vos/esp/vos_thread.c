@@ -17,6 +17,8 @@
  /*
  * $Id$
  *
+ *      BL 2026-10-18: Cyclic thread overrun policy and statistics (not supported)
+ *      BL 2026-10-18: vos_threadSetAffinity() added
  *      BL 2018-06-25: Ticket #202: vos_mutexTrylock return value
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  */
@@ -418,6 +420,82 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
 }
 
 
+/**********************************************************************************************************************/
+/** Bind a thread to a set of CPUs
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[in]      cpuMask         Bit mask of allowed CPUs (bit 0 = CPU 0), 0 = no restriction
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  affinity could not be set
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT32          cpuMask)
+{
+    if (thread == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (cpuMask == 0u)
+    {
+        return VOS_NO_ERR;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "vos_threadSetAffinity() not supported\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Define the behaviour of a cyclic thread if its function was running beyond the next deadline
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[in]      policy          Overrun policy
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy)
+{
+    (void) thread;
+    (void) policy;
+    vos_printLogStr(VOS_LOG_WARNING, "vos_threadSetOverrunPolicy() not supported\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[out]     pStatistics     Pointer to statistics
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetStatistics (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_STATISTICS_T *pStatistics)
+{
+    (void) thread;
+    (void) pStatistics;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Reset the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadResetStatistics (
+    VOS_THREAD_T thread)
+{
+    (void) thread;
+    return VOS_UNKNOWN_ERR;
+}
+
 /**********************************************************************************************************************/
 /*  Timers                                                                                                            */
 /**********************************************************************************************************************/
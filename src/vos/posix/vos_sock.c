@@ -17,6 +17,10 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: TCP sends use MSG_NOSIGNAL (SO_NOSIGPIPE), a connection reset by the peer no longer raises SIGPIPE
+*      BL 2026-10-18: vos_sockSendUDPv() batched send using sendmmsg()
+*      BL 2026-10-18: vos_sockPeekUDP() reports the datagram size using MSG_PEEK|MSG_TRUNC
+*      BL 2026-10-18: vos_sockSendTCPv() gather send using writev()
 *      SB 2021-08-09: Lint warnings
 *      BL 2021-06-11: Enhanced error handling on empty getifaddrs() returned list (segfault on Raspberry Pi)
 *     AHW 2021-05-06: Ticket #322 Subscriber multicast message routing in multi-home device
@@ -59,6 +63,7 @@
 #include <fcntl.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 
 #ifdef INTEGRITY
 #   include <sys/uio.h>
@@ -102,6 +107,14 @@ const CHAR8 *cDefaultIface = "eth0";
 #warning "SOL_IP undeclared"
 #endif
 
+/* Sending on a TCP connection closed by the peer shall fail with EPIPE instead of raising SIGPIPE.
+   Where MSG_NOSIGNAL is missing, SO_NOSIGPIPE is set on the socket (inherited by accepted sockets). */
+#ifdef MSG_NOSIGNAL
+#define VOS_SEND_FLAGS  MSG_NOSIGNAL
+#else
+#define VOS_SEND_FLAGS  0
+#endif
+
 /***********************************************************************************************************************
  *  LOCALS
  */
@@ -774,6 +787,19 @@ EXT_DECL VOS_ERR_T vos_sockOpenTCP (
         return VOS_SOCK_ERR;
     }
 
+#ifdef SO_NOSIGPIPE
+    {
+        int optValue = 1;
+
+        if (setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &optValue, sizeof(optValue)) == -1)
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_NOSIGPIPE failed (Err: %s)\n", buff);
+        }
+    }
+#endif
+
     *pSock = (SOCKET) sock;
 
     vos_printLog(VOS_LOG_INFO, "vos_sockOpenTCP: socket()=%d success\n", (int)sock);
@@ -1228,6 +1254,102 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send several UDP datagrams.
+ *  The datagrams are sent in order, on Linux by sendmmsg() with one system call for all of them. Sending stops at
+ *  the first datagram which could not be sent, its error is returned and *pNoSent tells its position.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pDgram          array of datagrams to send
+ *  @param[in]      dgramCnt        no. of datagrams in pDgram (max. VOS_MAX_DGRAM_CNT)
+ *  @param[out]     pNoSent         no. of datagrams sent
+ *
+ *  @retval         VOS_NO_ERR      no error, all datagrams sent
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      datagram *pNoSent could not be sent
+ *  @retval         VOS_BLOCK_ERR   call would have blocked, datagram *pNoSent not sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPv (
+    SOCKET              sock,
+    const VOS_DGRAM_T   *pDgram,
+    UINT32              dgramCnt,
+    UINT32              *pNoSent)
+{
+#if defined(__linux__) && defined(_GNU_SOURCE)
+    struct mmsghdr      msg[VOS_MAX_DGRAM_CNT];
+    struct iovec        iov[VOS_MAX_DGRAM_CNT];
+    struct sockaddr_in  destAddr[VOS_MAX_DGRAM_CNT];
+    int                 sent;
+#else
+    VOS_ERR_T           err;
+    UINT32              size;
+#endif
+    UINT32              i;
+
+    if (sock == -1 || pDgram == NULL || pNoSent == NULL || dgramCnt > VOS_MAX_DGRAM_CNT)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pNoSent = 0u;
+
+#if defined(__linux__) && defined(_GNU_SOURCE)
+    memset(msg, 0, dgramCnt * sizeof(struct mmsghdr));
+    memset(destAddr, 0, dgramCnt * sizeof(struct sockaddr_in));
+
+    for (i = 0u; i < dgramCnt; i++)
+    {
+        destAddr[i].sin_family      = AF_INET;
+        destAddr[i].sin_addr.s_addr = vos_htonl(pDgram[i].ipAddress);
+        destAddr[i].sin_port        = vos_htons(pDgram[i].port);
+        iov[i].iov_base = (void *) pDgram[i].pBuffer;
+        iov[i].iov_len  = (size_t) pDgram[i].size;
+        msg[i].msg_hdr.msg_name     = &destAddr[i];
+        msg[i].msg_hdr.msg_namelen  = sizeof(struct sockaddr_in);
+        msg[i].msg_hdr.msg_iov      = &iov[i];
+        msg[i].msg_hdr.msg_iovlen   = 1;
+    }
+
+    /* sendmmsg() returns the number of datagrams sent, a failing datagram is reported by the next call */
+    while (*pNoSent < dgramCnt)
+    {
+        sent = sendmmsg(sock, &msg[*pNoSent], dgramCnt - *pNoSent, 0);
+        if (sent == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EWOULDBLOCK)
+            {
+                return VOS_BLOCK_ERR;
+            }
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "sendmmsg() to %s:%u failed (Err: %s)\n",
+                             inet_ntoa(destAddr[*pNoSent].sin_addr), (unsigned int) pDgram[*pNoSent].port, buff);
+            }
+            return VOS_IO_ERR;
+        }
+        *pNoSent += (UINT32) sent;
+    }
+#else
+    for (i = 0u; i < dgramCnt; i++)
+    {
+        size    = pDgram[i].size;
+        err     = vos_sockSendUDP(sock, pDgram[i].pBuffer, &size, pDgram[i].ipAddress, pDgram[i].port);
+        if (err != VOS_NO_ERR)
+        {
+            return err;
+        }
+        (*pNoSent)++;
+    }
+#endif
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Receive UDP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -1382,6 +1504,85 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     }
 }
 
+/**********************************************************************************************************************/
+/** Peek at the next UDP datagram.
+ *  Up to *pSize bytes of the next datagram are copied without removing it from the receive queue.
+ *  Where the platform supports it, the size of the complete datagram is reported in *pDgramSize, else 0.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the buffer size / copied data size
+ *  @param[out]     pDgramSize      pointer to the size of the complete datagram, 0 if unknown
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockPeekUDP (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pDgramSize)
+{
+    ssize_t rcvSize;
+
+    if (sock == -1 || pBuffer == NULL || pSize == NULL || pDgramSize == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pDgramSize = 0u;
+
+    do
+    {
+#if defined(MSG_TRUNC) && defined(__linux__)
+        /* Linux reports the real datagram size with MSG_TRUNC */
+        rcvSize = recv(sock, pBuffer, *pSize, MSG_PEEK | MSG_TRUNC);
+#else
+        rcvSize = recv(sock, pBuffer, *pSize, MSG_PEEK);
+#endif
+        if (rcvSize == -1 && errno == EWOULDBLOCK)
+        {
+            *pSize = 0u;
+            return VOS_BLOCK_ERR;
+        }
+    }
+    while (rcvSize == -1 && errno == EINTR);
+
+    if (rcvSize == -1)
+    {
+        *pSize = 0u;
+        if (errno == ECONNRESET)
+        {
+            /* ICMP port unreachable received (result of previous send), treat this as no error */
+            return VOS_NO_ERR;
+        }
+        else
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "recv() failed (Err: %s)\n", buff);
+            return VOS_IO_ERR;
+        }
+    }
+    else if (rcvSize == 0)
+    {
+        *pSize = 0u;
+        return VOS_NODATA_ERR;
+    }
+#if defined(MSG_TRUNC) && defined(__linux__)
+    *pDgramSize = (UINT32) rcvSize;
+#endif
+    if ((UINT32) rcvSize < *pSize)
+    {
+        *pSize = (UINT32) rcvSize;
+    }
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -1646,7 +1847,7 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     /* Keep on sending until we got rid of all data or we received an unrecoverable error */
     do
     {
-        sendSize = write(sock, pBuffer, bufferSize);
+        sendSize = send(sock, pBuffer, bufferSize, VOS_SEND_FLAGS);
         if (sendSize >= 0)
         {
             bufferSize  -= (size_t) sendSize;
@@ -1680,6 +1881,98 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send TCP data from several buffers.
+ *  The buffers are sent in order as one contiguous byte stream, with as few system calls as possible.
+ *  If the socket would block, the number of bytes already sent is returned in *pSize and the caller
+ *  shall resume with the remaining bytes later on.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pIov            array of buffers to send
+ *  @param[in]      iovCnt          no. of buffers in pIov (max. VOS_MAX_IOV_CNT)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error, all data sent
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   call would have blocked, data partially sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET              sock,
+    const VOS_IOVEC_T   *pIov,
+    UINT32              iovCnt,
+    UINT32              *pSize)
+{
+    struct iovec    iov[VOS_MAX_IOV_CNT];
+    struct msghdr   msg;
+    ssize_t         sendSize    = 0;
+    UINT32          i;
+
+    if (sock == -1 || pIov == NULL || pSize == NULL || iovCnt > VOS_MAX_IOV_CNT)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0u;
+
+    for (i = 0u; i < iovCnt; i++)
+    {
+        iov[i].iov_base = (void *) pIov[i].pBuffer;
+        iov[i].iov_len  = (size_t) pIov[i].size;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov     = iov;
+    msg.msg_iovlen  = iovCnt;
+
+    /* Keep on sending until we got rid of all data or we received an unrecoverable error */
+    while (msg.msg_iovlen > 0)
+    {
+        sendSize = sendmsg(sock, &msg, VOS_SEND_FLAGS);
+        if (sendSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EWOULDBLOCK)
+            {
+                return VOS_BLOCK_ERR;
+            }
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "sendmsg() failed (Err: %s)\n", buff);
+            }
+            if ((errno == ENOTCONN)
+                || (errno == ECONNREFUSED)
+                || (errno == EHOSTUNREACH))
+            {
+                return VOS_NOCONN_ERR;
+            }
+            return VOS_IO_ERR;
+        }
+
+        *pSize += (UINT32) sendSize;
+
+        /* Skip the buffers sent completely and continue within the partially sent one */
+        while ((msg.msg_iovlen > 0) && ((size_t) sendSize >= msg.msg_iov->iov_len))
+        {
+            sendSize -= (ssize_t) msg.msg_iov->iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen > 0)
+        {
+            msg.msg_iov->iov_base  = (UINT8 *) msg.msg_iov->iov_base + sendSize;
+            msg.msg_iov->iov_len  -= (size_t) sendSize;
+        }
+    }
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -17,6 +17,10 @@
  *
  * $Id$
  *
+ *      BL 2026-10-18: vos_getUuid() MAC cache and counter are thread-safe (atomic access)
+ *      BL 2026-10-18: vos_getUuid() without HAS_UUID reads the MAC and warns only once
+ *      BL 2026-10-18: Cyclic threads sleep to absolute deadlines, overrun policy and statistics
+ *      BL 2026-10-18: vos_threadSetAffinity() added
  *      SB 2021-08-09: Lint warnings
  *      BL 2020-11-03: Ticket #345: Blocked indefinitely in the nanosleep() call
  *      BL 2020-07-29: Ticket #303: UUID creation... #warning if uuid not used
@@ -56,6 +60,7 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <sched.h>
+#include <string.h>
 
 #ifdef HAS_UUID
 #include <uuid/uuid.h>
@@ -292,27 +297,114 @@ static int clock_nanosleep (
 #define NSECS_PER_USEC  1000u
 #define USECS_PER_MSEC  1000u
 #define MSECS_PER_SEC   1000u
-#define NSECS_PER_SEC   1000000000u;
+#define NSECS_PER_SEC   1000000000u
 
-/* This define holds the max amount os seconds to get stored in 32bit holding micro seconds        */
-/* It is the result when using the common time struct with tv_sec and tv_usec as on a 32 bit value */
-/* so far 0..999999 gets used for the tv_usec field as per definition, then 0xFFF0BDC0 usec        */
-/* are remaining to represent the seconds, which in turn give 0x10C5 seconds or in decimal 4293    */
-#define MAXSEC_FOR_USECPRESENTATION  4293
-
-typedef struct
+typedef struct VOS_THREAD_CYC
 {
-    const CHAR8         *pName;
-    VOS_TIMEVAL_T       startTime;
-    UINT32              interval;
-    VOS_THREAD_FUNC_T   pFunction;
-    void                *pArguments;
+    struct VOS_THREAD_CYC   *pNext;         /* list of running cyclic threads                   */
+    pthread_t               hThread;
+    CHAR8                   name[16];       /* for logging                                      */
+    VOS_TIMEVAL_T           startTime;
+    UINT32                  interval;
+    VOS_THREAD_FUNC_T       pFunction;
+    void                    *pArguments;
+    VOS_THREAD_OVERRUN_T    overrunPolicy;
+    VOS_THREAD_STATISTICS_T stats;
 } VOS_THREAD_CYC_T;
 
+/* Cyclic threads are registered to make their statistics accessible by thread handle */
+static pthread_mutex_t  sCyclicMutex    = PTHREAD_MUTEX_INITIALIZER;
+static VOS_THREAD_CYC_T *sCyclicThreads = NULL;
+
+/**********************************************************************************************************************/
+/** Find a registered cyclic thread. Must be called with sCyclicMutex locked.
+ *
+ *  @param[in]      thread          Thread handle
+ *
+ *  @retval         pointer to the cyclic thread parameters or NULL
+ */
+static VOS_THREAD_CYC_T *vos_findCyclicThread (
+    VOS_THREAD_T thread)
+{
+    VOS_THREAD_CYC_T *pIter;
+
+    for (pIter = sCyclicThreads; pIter != NULL; pIter = pIter->pNext)
+    {
+        if (pthread_equal(pIter->hThread, (pthread_t)thread))
+        {
+            return pIter;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Remove a cyclic thread from the list and free its parameters.
+ *  Called when the thread is cancelled.
+ *
+ *  @param[in]      pArg            Pointer to the cyclic thread parameters
+ *
+ *  @retval         none
+ */
+static void vos_releaseCyclicThread (
+    void *pArg)
+{
+    VOS_THREAD_CYC_T *pParameters = (VOS_THREAD_CYC_T *) pArg;
+    VOS_THREAD_CYC_T **ppIter;
+
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    for (ppIter = &sCyclicThreads; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+    {
+        if (*ppIter == pParameters)
+        {
+            *ppIter = pParameters->pNext;
+            break;
+        }
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+
+    vos_printLog(VOS_LOG_DBG, "thread parameters freed: %p\n", (void *) pParameters);
+    vos_memFree(pParameters);
+}
+
+/**********************************************************************************************************************/
+/** Histogram bucket of a time value.
+ *
+ *  @param[in]      usec            time in us
+ *
+ *  @retval         0 for < 1us, n for 2^(n-1)...2^n - 1 us, limited to the last bucket
+ */
+static UINT32 vos_histBucket (
+    UINT32 usec)
+{
+    UINT32 bucket = 0u;
+
+    while ((usec != 0u) && (bucket < (VOS_THREAD_HIST_BUCKETS - 1u)))
+    {
+        usec >>= 1u;
+        bucket++;
+    }
+    return bucket;
+}
+
+/**********************************************************************************************************************/
+/** Convert a monotonic time to nanoseconds.
+ *
+ *  @param[in]      pTime           time
+ *
+ *  @retval         time in ns
+ */
+static UINT64 vos_timespecToNs (
+    const struct timespec *pTime)
+{
+    return (UINT64) pTime->tv_sec * NSECS_PER_SEC + (UINT64) pTime->tv_nsec;
+}
+
 /**********************************************************************************************************************/
 /** Execute a cyclic thread function.
- *  This function blocks by cyclically executing the provided user function. If supported by the OS,
- *  uses real-time threads and tries to sync to the supplied start time.
+ *  This function blocks by cyclically executing the provided user function. The deadlines are absolute multiples of
+ *  interval from the supplied start time, so the cycle does not drift with the execution time. If supported by the
+ *  OS, uses real-time threads.
  *
  *  @param[in]      pParameters     Pointer to the thread function parameters
  *
@@ -321,153 +413,130 @@ typedef struct
 static void vos_runCyclicThread (
     VOS_THREAD_CYC_T *pParameters)
 {
-#if defined(SCHED_DEADLINE) && defined (RT_THREADS)
     struct timespec     deadline;
     struct timespec     now;
-#else
-    VOS_TIMEVAL_T       now;
-    VOS_TIMEVAL_T       priorCall;
-    VOS_TIMEVAL_T       afterCall;
+    struct timespec     afterCall;
+    UINT64              deadlineNs;
+    UINT64              startNs;
+    UINT64              nowNs;
+    UINT64              afterNs;
+    UINT64              intervalNs  = (UINT64) pParameters->interval * NSECS_PER_USEC;
+    UINT32              latency;
     UINT32              execTime;
-    UINT32              waitingTime;
-#endif
-    UINT32              interval    = pParameters->interval;
-    VOS_THREAD_FUNC_T   pFunction   = pParameters->pFunction;
-    void *pArguments = pParameters->pArguments;
-    VOS_TIMEVAL_T       startTime = pParameters->startTime;
-    CHAR8               name[16];
-
-    vos_strncpy(name, pParameters->pName, 16);      /* for logging */
+    UINT32              missed;
 
-    vos_printLog(VOS_LOG_DBG, "thread parameters freed: %p\n", (void *) pParameters);
-    vos_memFree(pParameters);
+    pthread_cleanup_push(vos_releaseCyclicThread, pParameters);
 
 #if defined(SCHED_DEADLINE) && defined (RT_THREADS)
-
-    UINT64  interval_ns = interval * NSECS_PER_USEC;
-    int     retCode;
     /* Cyclic tasks are real-time tasks (RTLinux only) */
     {
-        struct sched_attr rt_attribs;
+        struct sched_attr   rt_attribs;
+        int                 retCode;
+
         rt_attribs.size             = sizeof(struct sched_attr); /* Size of this structure */
         rt_attribs.sched_policy     = SCHED_DEADLINE; /* Policy (SCHED_*) */
         rt_attribs.sched_flags      = 0u;           /* Flags */
         rt_attribs.sched_nice       = 0;            /* Nice value (SCHED_OTHER, SCHED_BATCH) */
         rt_attribs.sched_priority   = 0u;           /* Static priority (SCHED_FIFO, SCHED_RR) */
         /* Remaining fields are for SCHED_DEADLINE only */
-        rt_attribs.sched_runtime    = interval_ns / 4u;
-        rt_attribs.sched_deadline   = interval_ns / 2u;
-        rt_attribs.sched_period     = interval_ns;
+        rt_attribs.sched_runtime    = intervalNs / 4u;
+        rt_attribs.sched_deadline   = intervalNs / 2u;
+        rt_attribs.sched_period     = intervalNs;
         retCode = sched_setattr(0, &rt_attribs, 0);
         if (retCode != 0)
         {
             vos_printLog(VOS_LOG_ERROR,
                          "%s sched_setattr for policy %d failed (Err: %d)\n",
-                         name,
+                         pParameters->name,
                          (int)rt_attribs.sched_policy,
                          (int)errno);
-            return;
+            pthread_exit(NULL);
         }
     }
+    startNs = (UINT64) pParameters->startTime.tv_sec * NSECS_PER_SEC +
+        (UINT64) pParameters->startTime.tv_usec * NSECS_PER_USEC + 7500000u;
+#else
+    startNs = (UINT64) pParameters->startTime.tv_sec * NSECS_PER_SEC +
+        (UINT64) pParameters->startTime.tv_usec * NSECS_PER_USEC;
+#endif
 
-    deadline.tv_sec     = startTime.tv_sec;
-    deadline.tv_nsec    = startTime.tv_usec * NSECS_PER_USEC;
-
-    deadline.tv_nsec    += 7500000;
-    deadline.tv_sec     += deadline.tv_nsec / NSECS_PER_SEC;
-    deadline.tv_nsec    = deadline.tv_nsec % NSECS_PER_SEC;
+    /* Synchronize with start time: first deadline is the next multiple of interval */
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    nowNs       = vos_timespecToNs(&now);
+    deadlineNs  = startNs;
+    if (deadlineNs <= nowNs)
+    {
+        deadlineNs += ((nowNs - startNs) / intervalNs + 1u) * intervalNs;
+    }
 
     for (;; )
     {
         /* Sleep until deadline */
+        deadline.tv_sec     = (time_t) (deadlineNs / NSECS_PER_SEC);
+        deadline.tv_nsec    = (long) (deadlineNs % NSECS_PER_SEC);
         while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) != 0)
         {
             if (errno != EINTR)
             {
                 vos_printLog(VOS_LOG_ERROR,
                              "cyclic thread %s sleep error.\n",
-                             name);
+                             pParameters->name);
+                break;
             }
         }
-        pFunction(pArguments);
 
-        /* calculate next deadline */
-        deadline.tv_nsec    += interval_ns;
-        deadline.tv_sec     += deadline.tv_nsec / NSECS_PER_SEC;
-        deadline.tv_nsec    = deadline.tv_nsec % NSECS_PER_SEC;
+        (void) clock_gettime(CLOCK_MONOTONIC, &now);
+        pParameters->pFunction(pParameters->pArguments);  /* perform thread function */
+        (void) clock_gettime(CLOCK_MONOTONIC, &afterCall);
+
+        nowNs       = vos_timespecToNs(&now);
+        afterNs     = vos_timespecToNs(&afterCall);
+        latency     = (nowNs > deadlineNs) ? (UINT32) ((nowNs - deadlineNs) / NSECS_PER_USEC) : 0u;
+        execTime    = (UINT32) ((afterNs - nowNs) / NSECS_PER_USEC);
 
-        clock_gettime(CLOCK_MONOTONIC, &now);
-        if (now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec > deadline.tv_nsec))
+        pParameters->stats.cycles++;
+        pParameters->stats.latencyHist[vos_histBucket(latency)]++;
+        pParameters->stats.execTimeHist[vos_histBucket(execTime)]++;
+        if (latency > pParameters->stats.maxLatency)
         {
-            /*severe error: cyclic task time violated*/
-            /* calculate next deadline */
-            deadline.tv_nsec    += interval_ns;
-            deadline.tv_sec     += deadline.tv_nsec / NSECS_PER_SEC;
-            deadline.tv_nsec    = deadline.tv_nsec % NSECS_PER_SEC;
-            /* Log the runtime violation */
-            vos_printLog(VOS_LOG_WARNING,
-                         "cyclic thread with interval %u usec was running too long.\n",
-                         (unsigned int)interval);
+            pParameters->stats.maxLatency = latency;
         }
-        pthread_testcancel();
-    }
-
-#else
-    for (;; )
-    {
-        /* Synchronize with starttime */
-        vos_getTime(&now);                      /* get initial time */
-        vos_subTime(&now, &startTime);
-
-        /* Wait for multiples of interval */
-
-        execTime    = ((UINT32)now.tv_usec % interval);
-        waitingTime = interval - execTime;
-        if (waitingTime > interval)
+        if (execTime > pParameters->stats.maxExecTime)
         {
-            vos_printLog(VOS_LOG_ERROR,
-                         "waiting time > interval:  %u > %u usec!\n",
-                         (unsigned int) waitingTime, (unsigned int) interval);
+            pParameters->stats.maxExecTime = execTime;
         }
 
-        /* Idle for the difference */
-        (void) vos_threadDelay(waitingTime);
-
-        vos_getTime(&priorCall);  /* get initial time */
-        pFunction(pArguments);    /* perform thread function */
-        vos_getTime(&afterCall);  /* get time after function ghas returned */
-
-        /* subtract in the pattern after - prior to get the runtime of function() */
-        vos_subTime(&afterCall, &priorCall);
-
-        /* afterCall holds now the time difference within a structure not compatible with interval */
-        /* check if UINT32 fits to hold the waiting time value */
-        if (afterCall.tv_sec <= MAXSEC_FOR_USECPRESENTATION)
+        /* calculate next deadline */
+        deadlineNs += intervalNs;
+        if (afterNs > deadlineNs)
         {
-            /*           sec to usec conversion value normalized from 0 .. 999999*/
-            execTime =
-                ((UINT32) ((UINT32)afterCall.tv_sec * MSECS_PER_SEC * USECS_PER_MSEC) + (UINT32)afterCall.tv_usec);
-            if (execTime > interval)
+            /* cyclic task time violated, the next deadline(s) already passed */
+            missed = (UINT32) ((afterNs - deadlineNs) / intervalNs) + 1u;
+            pParameters->stats.overruns++;
+            switch (pParameters->overrunPolicy)
             {
-                /*  Log the runtime violation */
-                vos_printLog(VOS_LOG_WARNING,
-                             "cyclic thread with interval %u usec was running  %u usec\n",
-                             (unsigned int)interval, (unsigned int)execTime);
+                case VOS_THREAD_OVERRUN_CATCHUP:
+                    /* keep the deadline, the missed cycles are executed back-to-back */
+                    break;
+                case VOS_THREAD_OVERRUN_SKIP:
+                    deadlineNs += (UINT64) missed * intervalNs;
+                    pParameters->stats.skipped += missed;
+                    break;
+                default:
+                    deadlineNs += (UINT64) missed * intervalNs;
+                    pParameters->stats.skipped += missed;
+                    vos_printLog(VOS_LOG_WARNING,
+                                 "cyclic thread %s with interval %u usec missed %u cycle(s) (latency %u, run %u usec)\n",
+                                 pParameters->name, (unsigned int)pParameters->interval, (unsigned int)missed,
+                                 (unsigned int)latency, (unsigned int)execTime);
+
+                    break;
             }
         }
-        else
-        {
-            /* seems a very critical overflow has happened - or simply a misconfiguration */
-            /* as a rough first guess use zero waiting time here */
-            /* waitingTime = 0U; */
-            /* Have this value range violation logged */
-            vos_printLog(VOS_LOG_ERROR,
-                         "cyclic thread with interval %u usec exceeded time out by running %ld sec\n",
-                         (unsigned int)interval, (long)afterCall.tv_sec);
-        }
         pthread_testcancel();
     }
-#endif
+
+    pthread_cleanup_pop(1);     /*lint !e527 not reached, but needed to close pthread_cleanup_push */
 }
 
 /***********************************************************************************************************************
@@ -679,20 +748,40 @@ EXT_DECL VOS_ERR_T vos_threadCreateSync (
         /* malloc freed in vos_runCyclicThread */
         VOS_THREAD_CYC_T *p_params = (VOS_THREAD_CYC_T *) vos_memAlloc(sizeof(VOS_THREAD_CYC_T));
 
-        p_params->pName = pName;
+        if (p_params == NULL)
+        {
+            (void) pthread_attr_destroy(&threadAttrib);
+            return VOS_MEM_ERR;
+        }
+        vos_strncpy(p_params->name, pName, sizeof(p_params->name) - 1u);
         p_params->startTime.tv_sec  = 0;
         p_params->startTime.tv_usec = 0;
-        p_params->interval      = interval;
-        p_params->pFunction     = pFunction;
-        p_params->pArguments    = pArguments;
+        p_params->interval          = interval;
+        p_params->pFunction         = pFunction;
+        p_params->pArguments        = pArguments;
+        p_params->overrunPolicy     = VOS_THREAD_OVERRUN_LOG;
+        p_params->stats.interval    = interval;
         vos_printLog(VOS_LOG_DBG, "thread parameters alloc: %p\n", (void *) p_params);
 
         if (pStartTime != NULL)
         {
             p_params->startTime = *pStartTime;
         }
-        /* Create a cyclic thread */
+        /* Create a cyclic thread, it frees the parameters when it is cancelled. It is registered before it runs,
+           so its overrun policy and statistics can be accessed as soon as the handle is returned. */
+        (void) pthread_mutex_lock(&sCyclicMutex);
         retCode = pthread_create(&hThread, &threadAttrib, (void *(*)(void *))vos_runCyclicThread, p_params);
+        if (retCode != 0)
+        {
+            vos_memFree(p_params);
+        }
+        else
+        {
+            p_params->hThread   = hThread;
+            p_params->pNext     = sCyclicThreads;
+            sCyclicThreads      = p_params;
+        }
+        (void) pthread_mutex_unlock(&sCyclicMutex);
         (void) vos_threadDelay(10000u);
     }
     else
@@ -832,6 +921,152 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Bind a thread to a set of CPUs
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[in]      cpuMask         Bit mask of allowed CPUs (bit 0 = CPU 0), 0 = no restriction
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  affinity could not be set
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT32          cpuMask)
+{
+    if (thread == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (cpuMask == 0u)
+    {
+        return VOS_NO_ERR;
+    }
+#if defined(__linux__) && defined(_GNU_SOURCE)
+    {
+        cpu_set_t   cpuSet;
+        UINT32      cpu;
+        int         retCode;
+
+        CPU_ZERO(&cpuSet);
+        for (cpu = 0u; cpu < 32u; cpu++)
+        {
+            if ((cpuMask & (1u << cpu)) != 0u)
+            {
+                CPU_SET(cpu, &cpuSet);
+            }
+        }
+        retCode = pthread_setaffinity_np((pthread_t)thread, sizeof(cpu_set_t), &cpuSet);
+        if (retCode != 0)
+        {
+            vos_printLog(VOS_LOG_ERROR, "pthread_setaffinity_np(0x%x) failed (Err:%d)\n",
+                         (unsigned int) cpuMask, (int)retCode);
+            return VOS_THREAD_ERR;
+        }
+        return VOS_NO_ERR;
+    }
+#else
+    vos_printLogStr(VOS_LOG_WARNING, "vos_threadSetAffinity() not supported\n");
+    return VOS_UNKNOWN_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Define the behaviour of a cyclic thread if its function was running beyond the next deadline
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[in]      policy          Overrun policy
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   no cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy)
+{
+    VOS_THREAD_CYC_T    *pCyclic;
+    VOS_ERR_T           retVal = VOS_PARAM_ERR;
+
+    if ((thread == NULL) || (policy > VOS_THREAD_OVERRUN_CATCHUP))
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCyclic = vos_findCyclicThread(thread);
+    if (pCyclic != NULL)
+    {
+        pCyclic->overrunPolicy = policy;
+        retVal = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+    return retVal;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[out]     pStatistics     Pointer to statistics
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   no cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetStatistics (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_STATISTICS_T *pStatistics)
+{
+    VOS_THREAD_CYC_T    *pCyclic;
+    VOS_ERR_T           retVal = VOS_PARAM_ERR;
+
+    if ((thread == NULL) || (pStatistics == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCyclic = vos_findCyclicThread(thread);
+    if (pCyclic != NULL)
+    {
+        /* the thread updates its counters without lock, a concurrent cycle may be counted partially */
+        *pStatistics = pCyclic->stats;
+        retVal = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+    return retVal;
+}
+
+/**********************************************************************************************************************/
+/** Reset the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   no cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadResetStatistics (
+    VOS_THREAD_T thread)
+{
+    VOS_THREAD_CYC_T    *pCyclic;
+    VOS_ERR_T           retVal = VOS_PARAM_ERR;
+
+    if (thread == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCyclic = vos_findCyclicThread(thread);
+    if (pCyclic != NULL)
+    {
+        memset(&pCyclic->stats, 0, sizeof(pCyclic->stats));
+        pCyclic->stats.interval = pCyclic->interval;
+        retVal = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+    return retVal;
+}
+
+
 /**********************************************************************************************************************/
 /*  Timers                                                                                                            */
 /**********************************************************************************************************************/
@@ -1224,9 +1459,13 @@ EXT_DECL void vos_getUuid (
     uuid_generate_time(pUuID);
 #else
     /*  Manually creating a UUID from time stamp and MAC address  */
-    static UINT16   count = 1u;
+    static UINT32   count       = 0u;
+    static UINT8    mac[VOS_MAC_SIZE];
+    static UINT32   macState    = 0u;   /* 0: not read yet, 1: being stored, 2: valid */
     VOS_TIMEVAL_T   current;
     VOS_ERR_T       ret;
+    UINT32          cnt;
+    UINT32          expected    = 0u;
 
     vos_getTime(&current);
 
@@ -1239,20 +1478,32 @@ EXT_DECL void vos_getUuid (
     pUuID[6]    = (current.tv_sec & 0xFF0000u) >> 16u;
     pUuID[7]    = ((current.tv_sec & 0x0F000000u) >> 24u) | 0x4u; /*  pseudo-random version   */
 
-    /* We are using the Unix epoch here instead of UUID epoch (gregorian), until this is fixed
-        we issue a warning */
-    vos_printLogStr(VOS_LOG_WARNING, "UUID generation is based on Unix epoch, instead of UUID epoch. #define HAS_UUID!\n");
-
     /* we always increment these values, this definitely makes the UUID unique */
-    pUuID[8]    = (UINT8) (count & 0xFFu);
-    pUuID[9]    = (UINT8) (count >> 8u);
-    count++;
+    cnt         = VOS_ATOMIC_ADD(&count, 1u);
+    pUuID[8]    = (UINT8) (cnt & 0xFFu);
+    pUuID[9]    = (UINT8) ((cnt >> 8u) & 0xFFu);
 
-    /*  Copy the mac address into the rest of the array */
-    ret = vos_sockGetMAC(&pUuID[10]);
-    if (ret != VOS_NO_ERR)
+    /*  Copy the mac address into the rest of the array. It is read from the interface until a caller has stored it,
+        concurrent callers meanwhile read it on their own  */
+    if (VOS_ATOMIC_LOAD(&macState) == 2u)
     {
-        vos_printLog(VOS_LOG_ERROR, "vos_sockGetMAC() failed (Err:%d)\n", (int)ret);
+        memcpy(&pUuID[10], mac, VOS_MAC_SIZE);
+    }
+    else
+    {
+        ret = vos_sockGetMAC(&pUuID[10]);
+        if (ret != VOS_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "vos_sockGetMAC() failed (Err:%d)\n", (int)ret);
+        }
+        else if (VOS_ATOMIC_CAS(&macState, &expected, 1u))
+        {
+            /* We are using the Unix epoch here instead of UUID epoch (gregorian), until this is fixed
+                we issue a warning with the first UUID */
+            vos_printLogStr(VOS_LOG_WARNING, "UUID generation is based on Unix epoch, instead of UUID epoch. #define HAS_UUID!\n");
+            memcpy(mac, &pUuID[10], VOS_MAC_SIZE);
+            VOS_ATOMIC_STORE(&macState, 2u);
+        }
     }
 #endif
 }
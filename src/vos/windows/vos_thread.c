@@ -18,6 +18,10 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: vos_getUuid() MAC cache and counter are thread-safe (atomic access)
+*      BL 2026-10-18: vos_getUuid() without HAS_UUID reads the MAC and warns only once
+*      BL 2026-10-18: Cyclic thread overrun policy and statistics (not supported)
+*      BL 2026-10-18: vos_threadSetAffinity() added
 *      BL 2019-12-06: Ticket #303: UUID creation does not always conform to standard
 *      SB 2019-08-30: Added vos_getRealTime and vos_getNanoTime
 *      SB 2019-08-26: Added sub millisecond precision to vos_runCyclicThread
@@ -444,6 +448,86 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Bind a thread to a set of CPUs
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[in]      cpuMask         Bit mask of allowed CPUs (bit 0 = CPU 0), 0 = no restriction
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  affinity could not be set
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT32          cpuMask)
+{
+    if (thread == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (cpuMask == 0u)
+    {
+        return VOS_NO_ERR;
+    }
+    if (SetThreadAffinityMask((HANDLE)thread, (DWORD_PTR)cpuMask) == 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "SetThreadAffinityMask(0x%x) failed (Err:%d)\n",
+                     (unsigned int) cpuMask, (int)GetLastError());
+        return VOS_THREAD_ERR;
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Define the behaviour of a cyclic thread if its function was running beyond the next deadline
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[in]      policy          Overrun policy
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy)
+{
+    (void) thread;
+    (void) policy;
+    vos_printLogStr(VOS_LOG_WARNING, "vos_threadSetOverrunPolicy() not supported\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[out]     pStatistics     Pointer to statistics
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetStatistics (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_STATISTICS_T *pStatistics)
+{
+    (void) thread;
+    (void) pStatistics;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Reset the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadResetStatistics (
+    VOS_THREAD_T thread)
+{
+    (void) thread;
+    return VOS_UNKNOWN_ERR;
+}
+
 /**********************************************************************************************************************/
 /*  Timers                                                                                                            */
 /**********************************************************************************************************************/
@@ -772,9 +856,13 @@ EXT_DECL void vos_getUuid (
     VOS_UUID_T pUuID)
 {
     /*  Manually creating a UUID from time stamp and MAC address  */
-    static UINT16   count = 1;
+    static UINT32   count       = 0u;
+    static UINT8    mac[VOS_MAC_SIZE];
+    static UINT32   macState    = 0u;   /* 0: not read yet, 1: being stored, 2: valid */
     VOS_TIMEVAL_T   current;
     VOS_ERR_T       ret;
+    UINT32          cnt;
+    UINT32          expected    = 0u;
 
     vos_getTime(&current);
 
@@ -787,20 +875,32 @@ EXT_DECL void vos_getUuid (
     pUuID[6]    = (UINT8)((current.tv_sec & 0xFF0000) >> 16);
     pUuID[7]    = ((current.tv_sec & 0x0F000000) >> 24) | 0x4; /*  pseudo-random version   */
 
-    /* We are using the Unix epoch here instead of UUID epoch (gregorian), until this is fixed
-     we issue a warning */
-    vos_printLogStr(VOS_LOG_WARNING, "UUID generation is based on Unix epoch, instead of UUID epoch!\n");
-
     /* we always increment these values, this definitely makes the UUID unique */
-    pUuID[8]    = (UINT8)(count & 0xFF);
-    pUuID[9]    = (UINT8)(count >> 8);
-    count++;
+    cnt         = VOS_ATOMIC_ADD(&count, 1u);
+    pUuID[8]    = (UINT8) (cnt & 0xFFu);
+    pUuID[9]    = (UINT8) ((cnt >> 8u) & 0xFFu);
 
-    /*  Copy the mac address into the rest of the array */
-    ret = vos_sockGetMAC(&pUuID[10]);
-    if (ret != VOS_NO_ERR)
+    /*  Copy the mac address into the rest of the array. It is read from the interface until a caller has stored it,
+        concurrent callers meanwhile read it on their own  */
+    if (VOS_ATOMIC_LOAD(&macState) == 2u)
     {
-        vos_printLog(VOS_LOG_ERROR, "vos_sockGetMAC() failed (Err:%d)\n", ret);
+        memcpy(&pUuID[10], mac, VOS_MAC_SIZE);
+    }
+    else
+    {
+        ret = vos_sockGetMAC(&pUuID[10]);
+        if (ret != VOS_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "vos_sockGetMAC() failed (Err:%d)\n", ret);
+        }
+        else if (VOS_ATOMIC_CAS(&macState, &expected, 1u))
+        {
+            /* We are using the Unix epoch here instead of UUID epoch (gregorian), until this is fixed
+                we issue a warning with the first UUID */
+            vos_printLogStr(VOS_LOG_WARNING, "UUID generation is based on Unix epoch, instead of UUID epoch!\n");
+            memcpy(mac, &pUuID[10], VOS_MAC_SIZE);
+            VOS_ATOMIC_STORE(&macState, 2u);
+        }
     }
 }
 
@@ -20,6 +20,9 @@
 /*
 * $Id$*
 *
+*      BL 2026-10-18: vos_sockSendUDPv() batched send of several datagrams
+*      BL 2026-10-18: vos_sockPeekUDP() added
+*      BL 2026-10-18: vos_sockSendTCPv() gather send
 *      A 2021-12-17: Ticket #384: Added #include <windows.h>
 *     AHW 2021-05-06: Ticket #322 Subscriber multicast message routing in multi-home device
 *      A 2020-05-04: Ticket #331: Add VLAN support for Sim, removed old SimTecc workarounds, Requires SimTecc from 2020 or later
@@ -1077,6 +1080,52 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send several UDP datagrams.
+ *  The datagrams are sent in order, one call of vos_sockSendUDP() each. Sending stops at the first datagram which
+ *  could not be sent, its error is returned and *pNoSent tells its position.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pDgram          array of datagrams to send
+ *  @param[in]      dgramCnt        no. of datagrams in pDgram (max. VOS_MAX_DGRAM_CNT)
+ *  @param[out]     pNoSent         no. of datagrams sent
+ *
+ *  @retval         VOS_NO_ERR      no error, all datagrams sent
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      datagram *pNoSent could not be sent
+ *  @retval         VOS_BLOCK_ERR   call would have blocked, datagram *pNoSent not sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPv (
+    SOCKET              sock,
+    const VOS_DGRAM_T   *pDgram,
+    UINT32              dgramCnt,
+    UINT32              *pNoSent)
+{
+    VOS_ERR_T   err;
+    UINT32      size;
+    UINT32      i;
+
+    if (pDgram == NULL || pNoSent == NULL || dgramCnt > VOS_MAX_DGRAM_CNT)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pNoSent = 0u;
+
+    for (i = 0u; i < dgramCnt; i++)
+    {
+        size    = pDgram[i].size;
+        err     = vos_sockSendUDP(sock, pDgram[i].pBuffer, &size, pDgram[i].ipAddress, pDgram[i].port);
+        if (err != VOS_NO_ERR)
+        {
+            return err;
+        }
+        (*pNoSent)++;
+    }
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Receive UDP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -1214,6 +1263,37 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
 
 }
 
+/**********************************************************************************************************************/
+/** Peek at the next UDP datagram.
+ *  Up to *pSize bytes of the next datagram are copied without removing it from the receive queue.
+ *  Where the platform supports it, the size of the complete datagram is reported in *pDgramSize, else 0.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the buffer size / copied data size
+ *  @param[out]     pDgramSize      pointer to the size of the complete datagram, 0 if unknown
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockPeekUDP (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pDgramSize)
+{
+    if (pDgramSize == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    *pDgramSize = 0u;
+    return vos_sockReceiveUDP(sock, pBuffer, pSize, NULL, NULL, NULL, NULL, TRUE);
+}
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -1510,6 +1590,51 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send TCP data from several buffers.
+ *  The buffers are sent in order as one contiguous byte stream.
+ *  If the socket would block, the number of bytes already sent is returned in *pSize and the caller
+ *  shall resume with the remaining bytes later on.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pIov            array of buffers to send
+ *  @param[in]      iovCnt          no. of buffers in pIov (max. VOS_MAX_IOV_CNT)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error, all data sent
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   call would have blocked, data partially sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET              sock,
+    const VOS_IOVEC_T   *pIov,
+    UINT32              iovCnt,
+    UINT32              *pSize)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      sendSize;
+    UINT32      i;
+
+    if ((pIov == NULL) || (pSize == NULL) || (iovCnt > VOS_MAX_IOV_CNT))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0u;
+
+    /* No gather call available, send the buffers one after the other */
+    for (i = 0u; (i < iovCnt) && (err == VOS_NO_ERR); i++)
+    {
+        sendSize    = pIov[i].size;
+        err         = vos_sockSendTCP(sock, pIov[i].pBuffer, &sendSize);
+        *pSize     += sendSize;
+    }
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -20,6 +20,8 @@
 /*
 * $Id$
 *
+*      BL 2026-10-18: Cyclic thread overrun policy and statistics (not supported)
+*      BL 2026-10-18: vos_threadSetAffinity() added
 *      A 2022-03-02: Ticket #389: Add vos Sim function vos_threadRegisterExisting, moved common functionality to vos_threadRegisterMain
 *      A 2021-12-17: Ticket #386: Support for TimeSync multicore
 *      A 2021-12-17: Ticket #385: Increase MAX_TIMESYNC_PREFIX_STRING from 20 to 64
@@ -976,6 +978,86 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Bind a thread to a set of CPUs
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[in]      cpuMask         Bit mask of allowed CPUs (bit 0 = CPU 0), 0 = no restriction
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  affinity could not be set
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT32          cpuMask)
+{
+    if (thread == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (cpuMask == 0u)
+    {
+        return VOS_NO_ERR;
+    }
+    if (SetThreadAffinityMask((HANDLE)thread, (DWORD_PTR)cpuMask) == 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "SetThreadAffinityMask(0x%x) failed (Err:%d)\n",
+                     (unsigned int) cpuMask, (int)GetLastError());
+        return VOS_THREAD_ERR;
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Define the behaviour of a cyclic thread if its function was running beyond the next deadline
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[in]      policy          Overrun policy
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy)
+{
+    (void) thread;
+    (void) policy;
+    vos_printLogStr(VOS_LOG_WARNING, "vos_threadSetOverrunPolicy() not supported\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[out]     pStatistics     Pointer to statistics
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetStatistics (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_STATISTICS_T *pStatistics)
+{
+    (void) thread;
+    (void) pStatistics;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Reset the timing statistics of a cyclic thread
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadResetStatistics (
+    VOS_THREAD_T thread)
+{
+    (void) thread;
+    return VOS_UNKNOWN_ERR;
+}
+
 /**********************************************************************************************************************/
 /*  Timers                                                                                                            */
 /**********************************************************************************************************************/
@@ -0,0 +1,990 @@
+/**********************************************************************************************************************/
+/**
+ * @file            mdBench.c
+ *
+ * @brief           MD benchmark
+ *
+ * @details         A caller keeps a number of request/reply sessions outstanding to a replier on the loopback
+ *                  interface, over UDP or TCP, within one process (the replier runs in its own thread) or split into
+ *                  a calling and a replying process. The replier echoes the payload with tlm_reply(), or with
+ *                  tlm_replyQuery() to be confirmed by the caller with tlm_confirm().
+ *                  Payload size, concurrency (outstanding sessions) and the number of listeners of the replier are
+ *                  swept, every combination is a run of its own. Round trip time percentiles, sessions/s, CPU time
+ *                  per session and the memory blocks of the stack held per outstanding session are written as JSON.
+ *                  Caller and replier have own IP addresses, both use the standard MD ports.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      BL 2026-10-18: -F selects fast session IDs
+ *      BL 2026-10-18: Initial version
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined (POSIX)
+#include <unistd.h>
+#include <sys/select.h>
+#include <sys/resource.h>
+#elif (defined (WIN32) || defined (WIN64))
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "vos_thread.h"
+#include "vos_sock.h"
+#include "vos_mem.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+#define APP_VERSION             "1.0"
+
+#define BENCH_COMID             21000u                  /**< comId of the first listener                            */
+#define BENCH_MAX_LISTENERS     1000u                   /**< max. listeners of the replier                          */
+#define BENCH_MAX_CONCURRENCY   256u                    /**< max. outstanding sessions                              */
+#define BENCH_MAX_STEPS         8u                      /**< max. values of a swept parameter                       */
+#define BENCH_MAX_SAMPLES       (1u << 20)              /**< round trip samples kept per run (reservoir)            */
+#define BENCH_MEM_SIZE          (32u * 1024u * 1024u)   /**< memory of the stack, raised for large payloads         */
+#define BENCH_IDLE_TIMEOUT      10000u                  /**< max. wait for the sockets [us]                         */
+
+#define BENCH_ROLE_BOTH         0u
+#define BENCH_ROLE_CALLER       1u
+#define BENCH_ROLE_REPLIER      2u
+
+#ifdef HIGH_PERF_INDEXED
+#define BENCH_BUILD             "hp"
+#else
+#define BENCH_BUILD             "std"
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Values of a swept parameter */
+typedef struct
+{
+    UINT32  noOfSteps;
+    UINT32  value[BENCH_MAX_STEPS];
+} BENCH_SWEEP_T;
+
+/** Benchmark parameters */
+typedef struct
+{
+    BENCH_SWEEP_T   payload;                            /**< dataset size [bytes]                                   */
+    BENCH_SWEEP_T   concurrency;                        /**< outstanding sessions                                   */
+    BENCH_SWEEP_T   listeners;                          /**< listeners of the replier                               */
+    UINT32          duration;                           /**< measurement per run [s]                                */
+    UINT32          warmUp;                             /**< before the measurement [ms]                            */
+    UINT32          replyTimeout;                       /**< reply and confirm timeout [us]                         */
+    UINT32          noOfRuns;                           /**< combinations of the swept parameters                   */
+    UINT32          role;
+    UINT32          callerIP;                           /**< own IP of the calling session                          */
+    UINT32          replierIP;                          /**< own IP of the replying session                         */
+    BOOL8           tcp;
+    BOOL8           confirm;                            /**< reply with confirmation                                */
+    BOOL8           fastId;                             /**< fast session IDs instead of UUIDs                      */
+    const char      *pJsonFile;
+} BENCH_CONFIG_T;
+
+/** Parameters and counters of a run */
+typedef struct
+{
+    UINT32  payload;
+    UINT32  concurrency;
+    UINT32  listeners;
+    UINT64  time;                                       /**< measurement time [ns]                                  */
+    UINT64  cpuUser;                                    /**< user CPU time [ns]                                     */
+    UINT64  cpuSystem;                                  /**< system CPU time [ns]                                   */
+    UINT32  requests;                                   /**< requests issued                                        */
+    UINT32  sessions;                                   /**< replies received (and confirmed)                       */
+    UINT32  replies;                                    /**< replies sent by the replier                            */
+    UINT32  confirms;                                   /**< confirmations received by the replier                  */
+    UINT32  timeouts;                                   /**< reply or confirm timeouts                              */
+    UINT32  errors;                                     /**< failed calls or unexpected results                     */
+    UINT32  noOfSamples;                                /**< round trip samples taken                               */
+    UINT32  rttMin;                                     /**< [ns]                                                   */
+    UINT32  rttMax;
+    UINT64  rttSum;
+    UINT32  rttPercentile[4];                           /**< p50, p90, p99, p99.9 [ns]                              */
+    UINT32  noOfMemSamples;                             /**< memory samples with all sessions outstanding           */
+    UINT64  memBlocks;                                  /**< sum of the blocks held above idle                      */
+    UINT64  memBytes;                                   /**< sum of the bytes held above idle                       */
+    UINT32  memPeakBlocks;                              /**< max. blocks in use                                     */
+    UINT32  memAllocErr;                                /**< allocation errors of the run                           */
+} BENCH_RESULT_T;
+
+/** Outstanding session of the caller */
+typedef struct
+{
+    TRDP_UUID_T sessionId;
+    UINT64      start;                                  /**< request time [ns]                                      */
+    BOOL8       busy;
+} BENCH_SLOT_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static BENCH_CONFIG_T       sCfg;
+static TRDP_APP_SESSION_T   sCaller     = NULL;
+static TRDP_APP_SESSION_T   sReplier    = NULL;
+static TRDP_LIS_T           sListener[BENCH_MAX_LISTENERS];
+static BENCH_SLOT_T         sSlot[BENCH_MAX_CONCURRENCY];
+static UINT8                sPayload[TRDP_MAX_MD_DATA_SIZE];
+
+/*  Caller side: written by the calling thread only */
+static UINT32               sMeasuring  = 0u;
+static UINT32               *sSample    = NULL;         /**< round trip times [ns]                                  */
+static UINT32               sNoOfSamples = 0u;
+static UINT32               sNoOfSessions = 0u;
+static UINT32               sNoOfTimeouts = 0u;
+static UINT32               sNoOfErrors = 0u;
+
+/*  Replier side: written by the replier thread */
+static UINT32               sReplierRun = 0u;           /**< the replier thread shall run                           */
+static UINT32               sReplierDone = 0u;          /**< the replier thread has left its loop                   */
+static UINT32               sNoOfReplies = 0u;
+static UINT32               sNoOfConfirms = 0u;
+static UINT32               sNoOfReplierErrors = 0u;
+static UINT32               sReplyPending = 0u;         /**< replies to be sent by the next tlm_process()           */
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void    dbgOut (void *pRefCon, TRDP_LOG_T category, const CHAR8 *pTime, const CHAR8 *pFile, UINT16 LineNumber,
+                const CHAR8 *pMsgStr);
+void    usage (const char *appName);
+void    callerCallback (void *pRefCon, TRDP_APP_SESSION_T appHandle, const TRDP_MD_INFO_T *pMsg, UINT8 *pData,
+                        UINT32 dataSize);
+void    replierCallback (void *pRefCon, TRDP_APP_SESSION_T appHandle, const TRDP_MD_INFO_T *pMsg, UINT8 *pData,
+                         UINT32 dataSize);
+void    benchSample (UINT32 rtt);
+void    benchCpuTime (UINT64 *pUser, UINT64 *pSystem);
+int     benchParseSweep (const char *pList, BENCH_SWEEP_T *pSweep, UINT32 min, UINT32 max);
+UINT32  benchMax (const BENCH_SWEEP_T *pSweep);
+void    benchProcess (TRDP_APP_SESSION_T appHandle, BOOL8 noWait);
+void    benchReplierThread (void *pArg);
+int     benchOpen (const BENCH_RESULT_T *pRun);
+void    benchClose (void);
+void    benchCall (const BENCH_RESULT_T *pRun, UINT64 end, const VOS_MEM_STATISTICS_T *pIdle,
+                   BENCH_RESULT_T *pResult);
+void    benchRun (BENCH_RESULT_T *pRun);
+void    benchReport (FILE *out, const BENCH_RESULT_T *pRun, BOOL8 first);
+int     compareUINT32 (const void *p1, const void *p2);
+
+/**********************************************************************************************************************/
+
+/* Print errors of the stack only */
+void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    if (category == VOS_LOG_ERROR)
+    {
+        fprintf(stderr, "%s %s:%d %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool measures MD request/reply round trip times and session rates on the loopback interface.\n"
+           "Lists of up to %u values are swept, every combination is a run of its own.\n"
+           "Arguments are:\n"
+           "-s <bytes>[,...]    payload size, 0...%u (default 64)\n"
+           "-c <n>[,...]        outstanding sessions, 1...%u (default 1)\n"
+           "-n <n>[,...]        listeners of the replier, requests are spread over them, 1...%u (default 1)\n"
+           "-T                  TCP instead of UDP\n"
+           "-q                  reply with confirmation (tlm_replyQuery/tlm_confirm)\n"
+           "-F                  fast session IDs (random prefix and counter) instead of UUIDs\n"
+           "-d <s>              measurement time per run (default 2)\n"
+           "-u <ms>             warm up time per run (default 200)\n"
+           "-R <us>             reply and confirm timeout (default 1000000)\n"
+           "-r both|caller|replier\n"
+           "                    call and/or reply in this process (default both). Started with the same\n"
+           "                    arguments, a replier serves the largest listener count for all runs of the caller\n"
+           "-o <ip>             own IP of the caller (default 127.0.0.2)\n"
+           "-t <ip>             own IP of the replier (default 127.0.0.1)\n"
+           "-j <file>           JSON output (default stdout)\n"
+           "-v                  print version and quit\n",
+           BENCH_MAX_STEPS, TRDP_MAX_MD_DATA_SIZE, BENCH_MAX_CONCURRENCY, BENCH_MAX_LISTENERS);
+}
+
+/**********************************************************************************************************************/
+/** Caller callback: reply received or session failed
+ */
+void callerCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    BENCH_SLOT_T    *pSlot = (BENCH_SLOT_T *) pMsg->pUserRef;
+    UINT64          now;
+
+    /*  Late calls for a session already finished are ignored   */
+    if ((pSlot == NULL) || (pSlot->busy == FALSE)
+        || (memcmp(pSlot->sessionId, pMsg->sessionId, sizeof(TRDP_UUID_T)) != 0))
+    {
+        return;
+    }
+
+    if ((pMsg->resultCode == TRDP_NO_ERR) && ((pMsg->msgType == TRDP_MSG_MP) || (pMsg->msgType == TRDP_MSG_MQ)))
+    {
+        vos_getNanoTime(&now);
+        if (pMsg->msgType == TRDP_MSG_MQ)
+        {
+            if (tlm_confirm(appHandle, &pMsg->sessionId, 0u, NULL) != TRDP_NO_ERR)
+            {
+                sNoOfErrors += sMeasuring;
+            }
+        }
+        if (sMeasuring != 0u)
+        {
+            sNoOfSessions++;
+            benchSample((UINT32) (now - pSlot->start));
+        }
+    }
+    else if ((pMsg->resultCode == TRDP_REPLYTO_ERR) || (pMsg->resultCode == TRDP_TIMEOUT_ERR))
+    {
+        sNoOfTimeouts += sMeasuring;
+    }
+    else
+    {
+        sNoOfErrors += sMeasuring;
+    }
+    pSlot->busy = FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Replier callback: echo the request
+ */
+void replierCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TRDP_ERR_T err;
+
+    if (pMsg->resultCode != TRDP_NO_ERR)
+    {
+        (void) VOS_ATOMIC_ADD(&sNoOfReplierErrors, 1u);
+        return;
+    }
+    if (pMsg->msgType == TRDP_MSG_MR)
+    {
+        if (sCfg.confirm == TRUE)
+        {
+            err = tlm_replyQuery(appHandle, &pMsg->sessionId, pMsg->comId, 0u, sCfg.replyTimeout, NULL,
+                                 (dataSize > 0u) ? sPayload : NULL, dataSize, NULL);
+        }
+        else
+        {
+            err = tlm_reply(appHandle, &pMsg->sessionId, pMsg->comId, 0u, NULL,
+                            (dataSize > 0u) ? sPayload : NULL, dataSize, NULL);
+        }
+        if (err == TRDP_NO_ERR)
+        {
+            (void) VOS_ATOMIC_ADD(&sNoOfReplies, 1u);
+            sReplyPending = 1u;
+        }
+        else
+        {
+            (void) VOS_ATOMIC_ADD(&sNoOfReplierErrors, 1u);
+        }
+    }
+    else if (pMsg->msgType == TRDP_MSG_MC)
+    {
+        (void) VOS_ATOMIC_ADD(&sNoOfConfirms, 1u);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Take a round trip time, beyond BENCH_MAX_SAMPLES a random sample is replaced
+ *
+ *  @param[in]      rtt         round trip time [ns]
+ */
+void benchSample (
+    UINT32 rtt)
+{
+    UINT32 idx = sNoOfSamples++;
+
+    if (idx >= BENCH_MAX_SAMPLES)
+    {
+        idx = (idx * 2654435761u) % sNoOfSamples;
+        if (idx >= BENCH_MAX_SAMPLES)
+        {
+            return;
+        }
+    }
+    sSample[idx] = rtt;
+}
+
+/**********************************************************************************************************************/
+/** Get the CPU time of the process
+ *
+ *  @param[out]     pUser       user time [ns]
+ *  @param[out]     pSystem     system time [ns], 0 if not available
+ */
+void benchCpuTime (
+    UINT64  *pUser,
+    UINT64  *pSystem)
+{
+#if defined (POSIX)
+    struct rusage usage;
+
+    (void) getrusage(RUSAGE_SELF, &usage);
+    *pUser      = (UINT64) usage.ru_utime.tv_sec * 1000000000u + (UINT64) usage.ru_utime.tv_usec * 1000u;
+    *pSystem    = (UINT64) usage.ru_stime.tv_sec * 1000000000u + (UINT64) usage.ru_stime.tv_usec * 1000u;
+#else
+    *pUser      = (UINT64) clock() * (1000000000u / CLOCKS_PER_SEC);
+    *pSystem    = 0u;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Parse the values of a swept parameter
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int benchParseSweep (
+    const char      *pList,
+    BENCH_SWEEP_T   *pSweep,
+    UINT32          min,
+    UINT32          max)
+{
+    pSweep->noOfSteps = 0u;
+    while ((pList != NULL) && (*pList != '\0'))
+    {
+        unsigned int value;
+
+        if ((pSweep->noOfSteps >= BENCH_MAX_STEPS) || (sscanf(pList, "%u", &value) != 1)
+            || (value < min) || (value > max))
+        {
+            return 1;
+        }
+        pSweep->value[pSweep->noOfSteps++] = value;
+        pList = strchr(pList, ',');
+        if (pList != NULL)
+        {
+            pList++;
+        }
+    }
+    return (pSweep->noOfSteps == 0u) ? 1 : 0;
+}
+
+/**********************************************************************************************************************/
+/** Largest value of a swept parameter
+ */
+UINT32 benchMax (
+    const BENCH_SWEEP_T *pSweep)
+{
+    UINT32  max = 0u;
+    UINT32  i;
+
+    for (i = 0u; i < pSweep->noOfSteps; i++)
+    {
+        max = (pSweep->value[i] > max) ? pSweep->value[i] : max;
+    }
+    return max;
+}
+
+/**********************************************************************************************************************/
+/** Wait for the sockets of a session and process it
+ *
+ *  @param[in]      appHandle   session
+ *  @param[in]      noWait      do not wait, there is something to send
+ */
+void benchProcess (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               noWait)
+{
+    TRDP_FDS_T  rfds;
+    TRDP_TIME_T tv;
+    INT32       noDesc = 0;
+    INT32       rv;
+
+    FD_ZERO(&rfds);
+    (void) tlm_getInterval(appHandle, &tv, &rfds, &noDesc);
+    if ((noWait == TRUE) || (tv.tv_sec > 0) || (tv.tv_usec > (long) BENCH_IDLE_TIMEOUT))
+    {
+        tv.tv_sec   = 0;
+        tv.tv_usec  = (noWait == TRUE) ? 0 : (long) BENCH_IDLE_TIMEOUT;
+    }
+    rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+    if (rv < 0)
+    {
+        rv = 0;
+        FD_ZERO(&rfds);
+    }
+    (void) tlm_process(appHandle, &rfds, &rv);
+}
+
+/**********************************************************************************************************************/
+/** Replier thread: process the replying session until stopped
+ */
+void benchReplierThread (
+    void *pArg)
+{
+    BOOL8 noWait;
+
+    while (VOS_ATOMIC_LOAD(&sReplierRun) != 0u)
+    {
+        noWait          = (sReplyPending != 0u) ? TRUE : FALSE;
+        sReplyPending   = 0u;
+        benchProcess(sReplier, noWait);
+    }
+    VOS_ATOMIC_STORE(&sReplierDone, 1u);
+}
+
+/**********************************************************************************************************************/
+/** Open the sessions of a run, add the listeners and start the replier thread
+ *
+ *  @param[in]      pRun        parameters of the run
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int benchOpen (
+    const BENCH_RESULT_T *pRun)
+{
+    TRDP_MD_CONFIG_T        mdConfig        = {NULL, NULL, TRDP_MD_DEFAULT_SEND_PARAM, TRDP_FLAGS_CALLBACK,
+                                               TRDP_MD_DEFAULT_REPLY_TIMEOUT, TRDP_MD_DEFAULT_CONFIRM_TIMEOUT,
+                                               TRDP_MD_DEFAULT_CONNECTION_TIMEOUT, TRDP_MD_DEFAULT_SENDING_TIMEOUT,
+                                               TRDP_MD_UDP_PORT, TRDP_MD_TCP_PORT, TRDP_MD_MAX_NUM_SESSIONS,
+                                               TRDP_MD_SESSION_ID_UUID};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"mdBench", "", "", 0u, 0u, TRDP_OPTION_NONE};
+    VOS_THREAD_T            thread;
+    UINT32                  i;
+    TRDP_ERR_T              err = TRDP_NO_ERR;
+
+    mdConfig.flags          = (sCfg.tcp == TRUE) ? (TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP) : TRDP_FLAGS_CALLBACK;
+    mdConfig.replyTimeout   = sCfg.replyTimeout;
+    mdConfig.confirmTimeout = sCfg.replyTimeout;
+    mdConfig.sessionIdGen   = (sCfg.fastId == TRUE) ? TRDP_MD_SESSION_ID_FAST : TRDP_MD_SESSION_ID_UUID;
+
+    if (sCfg.role != BENCH_ROLE_CALLER)
+    {
+        mdConfig.pfCbFunction = replierCallback;
+        err = tlc_openSession(&sReplier, sCfg.replierIP, 0u, NULL, NULL, &mdConfig, &processConfig);
+        for (i = 0u; (i < pRun->listeners) && (err == TRDP_NO_ERR); i++)
+        {
+            err = tlm_addListener(sReplier, &sListener[i], NULL, replierCallback, TRUE, BENCH_COMID + i, 0u, 0u,
+                                  VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, mdConfig.flags, NULL, NULL);
+        }
+        if (err != TRDP_NO_ERR)
+        {
+            fprintf(stderr, "replier session failed (%d)\n", err);
+            return 1;
+        }
+        VOS_ATOMIC_STORE(&sReplierRun, 1u);
+        VOS_ATOMIC_STORE(&sReplierDone, 0u);
+        if (vos_threadCreate(&thread, "mdBenchReplier", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u,
+                             benchReplierThread, NULL) != VOS_NO_ERR)
+        {
+            fprintf(stderr, "replier thread failed\n");
+            VOS_ATOMIC_STORE(&sReplierDone, 1u);
+            return 1;
+        }
+    }
+
+    if (sCfg.role != BENCH_ROLE_REPLIER)
+    {
+        mdConfig.pfCbFunction = callerCallback;
+        err = tlc_openSession(&sCaller, sCfg.callerIP, 0u, NULL, NULL, &mdConfig, &processConfig);
+        if (err != TRDP_NO_ERR)
+        {
+            fprintf(stderr, "caller session failed (%d)\n", err);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Stop the replier thread and close the sessions
+ */
+void benchClose (void)
+{
+    UINT32 i;
+
+    VOS_ATOMIC_STORE(&sReplierRun, 0u);
+    for (i = 0u; (sReplier != NULL) && (VOS_ATOMIC_LOAD(&sReplierDone) == 0u) && (i < 1000u); i++)
+    {
+        (void) vos_threadDelay(1000u);
+    }
+    if (sCaller != NULL)
+    {
+        (void) tlc_closeSession(sCaller);
+        sCaller = NULL;
+    }
+    if (sReplier != NULL)
+    {
+        (void) tlc_closeSession(sReplier);
+        sReplier = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Keep the sessions outstanding until end
+ *
+ *  @param[in]      pRun        parameters of the run
+ *  @param[in]      end         end of the calls [ns]
+ *  @param[in]      pIdle       memory in use without outstanding sessions, NULL while warming up
+ *  @param[in,out]  pResult     counters of the run
+ */
+void benchCall (
+    const BENCH_RESULT_T        *pRun,
+    UINT64                      end,
+    const VOS_MEM_STATISTICS_T  *pIdle,
+    BENCH_RESULT_T              *pResult)
+{
+    VOS_MEM_STATISTICS_T    mem;
+    UINT64                  now;
+    UINT32                  comId   = 0u;
+    UINT32                  i;
+
+    vos_getNanoTime(&now);
+    while (now < end)
+    {
+        BOOL8   requested   = FALSE;
+        UINT32  busy        = 0u;
+
+        for (i = 0u; i < pRun->concurrency; i++)
+        {
+            BENCH_SLOT_T *pSlot = &sSlot[i];
+
+            if (pSlot->busy == FALSE)
+            {
+                vos_getNanoTime(&pSlot->start);
+                if (tlm_request(sCaller, pSlot, callerCallback, &pSlot->sessionId, BENCH_COMID + comId, 0u, 0u,
+                                sCfg.callerIP, sCfg.replierIP,
+                                (sCfg.tcp == TRUE) ? (TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP) : TRDP_FLAGS_CALLBACK,
+                                1u, sCfg.replyTimeout, NULL, (pRun->payload > 0u) ? sPayload : NULL, pRun->payload,
+                                NULL, NULL) == TRDP_NO_ERR)
+                {
+                    pSlot->busy = TRUE;
+                    requested   = TRUE;
+                    pResult->requests += sMeasuring;
+                }
+                else
+                {
+                    sNoOfErrors += sMeasuring;
+                }
+                comId = (comId + 1u) % pRun->listeners;
+            }
+            busy += (pSlot->busy == TRUE) ? 1u : 0u;
+        }
+
+        /*  Memory held with all sessions outstanding   */
+        if ((pIdle != NULL) && (busy == pRun->concurrency) && (vos_memCount(&mem) == VOS_NO_ERR))
+        {
+            pResult->noOfMemSamples++;
+            pResult->memBlocks      += (mem.numAllocBlocks > pIdle->numAllocBlocks)
+                                       ? (mem.numAllocBlocks - pIdle->numAllocBlocks) : 0u;
+            pResult->memBytes       += (pIdle->free > mem.free) ? (pIdle->free - mem.free) : 0u;
+            pResult->memPeakBlocks  = (mem.numAllocBlocks > pResult->memPeakBlocks)
+                                      ? mem.numAllocBlocks : pResult->memPeakBlocks;
+        }
+
+        benchProcess(sCaller, requested);
+        vos_getNanoTime(&now);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Warm up and measure one combination of the swept parameters
+ *
+ *  @param[in,out]  pRun        parameters of the run, counters on return
+ */
+void benchRun (
+    BENCH_RESULT_T *pRun)
+{
+    static const UINT32     cPercentile[] = {5000u, 9000u, 9900u, 9990u};
+    VOS_MEM_STATISTICS_T    idle;
+    VOS_MEM_STATISTICS_T    mem;
+    UINT64                  start, end, now;
+    UINT64                  cpuUser, cpuSystem;
+    UINT32                  replies, confirms, errors;
+    UINT32                  noOfSamples;
+    UINT32                  i;
+
+    memset(sSlot, 0, sizeof(sSlot));
+    sNoOfSamples    = 0u;
+    sNoOfSessions   = 0u;
+    sNoOfTimeouts   = 0u;
+    sNoOfErrors     = 0u;
+    (void) vos_memCount(&idle);
+    if (benchOpen(pRun) != 0)
+    {
+        benchClose();
+        pRun->errors = 1u;
+        return;
+    }
+    vos_getNanoTime(&now);
+
+    if (sCfg.role == BENCH_ROLE_REPLIER)
+    {
+        /*  Serve until the caller has finished all runs, with some slack for its start    */
+        start   = now;
+        end     = now + (UINT64) sCfg.noOfRuns * ((UINT64) sCfg.warmUp * 1000000u
+                                                  + (UINT64) sCfg.duration * 1000000000u) + 1000000000u;
+        benchCpuTime(&cpuUser, &cpuSystem);
+        while (now < end)
+        {
+            (void) vos_threadDelay(10000u);
+            vos_getNanoTime(&now);
+        }
+        benchCpuTime(&pRun->cpuUser, &pRun->cpuSystem);
+        pRun->time      = now - start;
+        pRun->cpuUser   -= cpuUser;
+        pRun->cpuSystem -= cpuSystem;
+        pRun->replies   = VOS_ATOMIC_LOAD(&sNoOfReplies);
+        pRun->confirms  = VOS_ATOMIC_LOAD(&sNoOfConfirms);
+        pRun->errors    = VOS_ATOMIC_LOAD(&sNoOfReplierErrors);
+        benchClose();
+        return;
+    }
+
+    /*  Warm up, let the outstanding sessions end, then measure with the idle memory of the open sessions   */
+    benchCall(pRun, now + (UINT64) sCfg.warmUp * 1000000u, NULL, pRun);
+    end = now + (UINT64) sCfg.warmUp * 1000000u + 2u * (UINT64) sCfg.replyTimeout * 1000u;
+    for (i = 0u; (i < pRun->concurrency) && (now < end); i++)
+    {
+        while ((sSlot[i].busy == TRUE) && (now < end))
+        {
+            benchProcess(sCaller, FALSE);
+            vos_getNanoTime(&now);
+        }
+    }
+    (void) vos_threadDelay(10000u);
+    (void) vos_memCount(&idle);
+
+    replies     = VOS_ATOMIC_LOAD(&sNoOfReplies);
+    confirms    = VOS_ATOMIC_LOAD(&sNoOfConfirms);
+    errors      = VOS_ATOMIC_LOAD(&sNoOfReplierErrors);
+    benchCpuTime(&cpuUser, &cpuSystem);
+    vos_getNanoTime(&start);
+    sMeasuring = 1u;
+
+    benchCall(pRun, start + (UINT64) sCfg.duration * 1000000000u, &idle, pRun);
+
+    sMeasuring = 0u;
+    vos_getNanoTime(&end);
+    benchCpuTime(&pRun->cpuUser, &pRun->cpuSystem);
+    pRun->time      = end - start;
+    pRun->cpuUser   -= cpuUser;
+    pRun->cpuSystem -= cpuSystem;
+    pRun->replies   = VOS_ATOMIC_LOAD(&sNoOfReplies) - replies;
+    pRun->confirms  = VOS_ATOMIC_LOAD(&sNoOfConfirms) - confirms;
+    pRun->sessions  = sNoOfSessions;
+    pRun->timeouts  = sNoOfTimeouts;
+    pRun->errors    = sNoOfErrors + VOS_ATOMIC_LOAD(&sNoOfReplierErrors) - errors;
+    if (vos_memCount(&mem) == VOS_NO_ERR)
+    {
+        pRun->memAllocErr = mem.numAllocErr - idle.numAllocErr;
+    }
+    benchClose();
+
+    noOfSamples         = (sNoOfSamples < BENCH_MAX_SAMPLES) ? sNoOfSamples : BENCH_MAX_SAMPLES;
+    pRun->noOfSamples   = noOfSamples;
+    if (noOfSamples > 0u)
+    {
+        qsort(sSample, noOfSamples, sizeof(UINT32), compareUINT32);
+        for (i = 0u; i < noOfSamples; i++)
+        {
+            pRun->rttSum += sSample[i];
+        }
+        pRun->rttMin = sSample[0];
+        pRun->rttMax = sSample[noOfSamples - 1u];
+        for (i = 0u; i < sizeof(cPercentile) / sizeof(cPercentile[0]); i++)
+        {
+            pRun->rttPercentile[i] = sSample[(UINT64) (noOfSamples - 1u) * cPercentile[i] / 10000u];
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+
+int compareUINT32 (const void *p1, const void *p2)
+{
+    UINT32  v1  = *(const UINT32 *) p1;
+    UINT32  v2  = *(const UINT32 *) p2;
+
+    return (v1 < v2) ? -1 : ((v1 > v2) ? 1 : 0);
+}
+
+/**********************************************************************************************************************/
+/** Write the results of a run as JSON
+ *
+ *  @param[in]      out         output file
+ *  @param[in]      pRun        parameters and counters of the run
+ *  @param[in]      first       first run of the sweep
+ */
+void benchReport (
+    FILE                    *out,
+    const BENCH_RESULT_T    *pRun,
+    BOOL8                   first)
+{
+    static const char   *cName[] = {"p50", "p90", "p99", "p999"};
+    UINT32              sessions = (sCfg.role == BENCH_ROLE_REPLIER) ? pRun->replies : pRun->sessions;
+    UINT32              i;
+
+    fprintf(out, "%s    {\"payload\": %u, \"concurrency\": %u, \"listeners\": %u,\n",
+            (first == TRUE) ? "" : ",\n", pRun->payload, pRun->concurrency, pRun->listeners);
+    fprintf(out, "     \"requests\": %u, \"sessions\": %u, \"replies\": %u, \"confirms\": %u, "
+            "\"timeouts\": %u, \"errors\": %u,\n",
+            pRun->requests, pRun->sessions, pRun->replies, pRun->confirms, pRun->timeouts, pRun->errors);
+    fprintf(out, "     \"sessions_per_s\": %.1f,\n",
+            (pRun->time != 0u) ? (double) sessions * 1e9 / (double) pRun->time : 0.0);
+    fprintf(out, "     \"cpu\": {\"user_s\": %.3f, \"system_s\": %.3f, \"us_per_session\": %.2f},\n",
+            (double) pRun->cpuUser / 1e9, (double) pRun->cpuSystem / 1e9,
+            (sessions != 0u) ? (double) (pRun->cpuUser + pRun->cpuSystem) / 1e3 / (double) sessions : 0.0);
+    fprintf(out, "     \"rtt_us\": {\"samples\": %u", pRun->noOfSamples);
+    if (pRun->noOfSamples > 0u)
+    {
+        fprintf(out, ", \"min\": %.3f, \"mean\": %.3f", (double) pRun->rttMin / 1e3,
+                (double) pRun->rttSum / (double) pRun->noOfSamples / 1e3);
+        for (i = 0u; i < sizeof(cName) / sizeof(cName[0]); i++)
+        {
+            fprintf(out, ", \"%s\": %.3f", cName[i], (double) pRun->rttPercentile[i] / 1e3);
+        }
+        fprintf(out, ", \"max\": %.3f", (double) pRun->rttMax / 1e3);
+    }
+    fprintf(out, "},\n     \"memory\": {\"blocks_per_session\": %.2f, \"bytes_per_session\": %.1f, "
+            "\"peak_blocks\": %u, \"alloc_errors\": %u}}",
+            (pRun->noOfMemSamples != 0u) ? (double) pRun->memBlocks / (double) pRun->noOfMemSamples
+            / (double) pRun->concurrency : 0.0,
+            (pRun->noOfMemSamples != 0u) ? (double) pRun->memBytes / (double) pRun->noOfMemSamples
+            / (double) pRun->concurrency : 0.0,
+            pRun->memPeakBlocks, pRun->memAllocErr);
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    TRDP_MEM_CONFIG_T   memConfig = {NULL, BENCH_MEM_SIZE, {0}};
+    BENCH_RESULT_T      *pRun   = NULL;
+    UINT32              noOfRuns;
+    unsigned int        ip[4];
+    unsigned int        value;
+    UINT32              i, j, k, n;
+    int                 ch;
+    int                 rv = 0;
+    FILE                *out = stdout;
+
+    memset(&sCfg, 0, sizeof(sCfg));
+    sCfg.payload.noOfSteps      = 1u;
+    sCfg.payload.value[0]       = 64u;
+    sCfg.concurrency.noOfSteps  = 1u;
+    sCfg.concurrency.value[0]   = 1u;
+    sCfg.listeners.noOfSteps    = 1u;
+    sCfg.listeners.value[0]     = 1u;
+    sCfg.duration       = 2u;
+    sCfg.warmUp         = 200u;
+    sCfg.replyTimeout   = 1000000u;
+    sCfg.callerIP       = vos_dottedIP("127.0.0.2");
+    sCfg.replierIP      = vos_dottedIP("127.0.0.1");
+
+    while ((ch = getopt(argc, argv, "s:c:n:TqFd:u:R:r:o:t:j:h?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 's':
+               if (benchParseSweep(optarg, &sCfg.payload, 0u, TRDP_MAX_MD_DATA_SIZE) != 0)
+               {
+                   usage(argv[0]);
+                   return 1;
+               }
+               break;
+           case 'c':
+               if (benchParseSweep(optarg, &sCfg.concurrency, 1u, BENCH_MAX_CONCURRENCY) != 0)
+               {
+                   usage(argv[0]);
+                   return 1;
+               }
+               break;
+           case 'n':
+               if (benchParseSweep(optarg, &sCfg.listeners, 1u, BENCH_MAX_LISTENERS) != 0)
+               {
+                   usage(argv[0]);
+                   return 1;
+               }
+               break;
+           case 'd':
+           case 'u':
+           case 'R':
+               if (sscanf(optarg, "%u", &value) != 1)
+               {
+                   usage(argv[0]);
+                   return 1;
+               }
+               switch (ch)
+               {
+                  case 'd': sCfg.duration       = value; break;
+                  case 'u': sCfg.warmUp         = value; break;
+                  default:  sCfg.replyTimeout   = value; break;
+               }
+               break;
+           case 'T':
+               sCfg.tcp = TRUE;
+               break;
+           case 'q':
+               sCfg.confirm = TRUE;
+               break;
+           case 'F':
+               sCfg.fastId = TRUE;
+               break;
+           case 'r':
+               sCfg.role = (strcmp(optarg, "caller") == 0) ? BENCH_ROLE_CALLER
+                           : ((strcmp(optarg, "replier") == 0) ? BENCH_ROLE_REPLIER : BENCH_ROLE_BOTH);
+               break;
+           case 'o':
+           case 't':
+               if (sscanf(optarg, "%u.%u.%u.%u", &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+               {
+                   usage(argv[0]);
+                   return 1;
+               }
+               if (ch == 'o')
+               {
+                   sCfg.callerIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               }
+               else
+               {
+                   sCfg.replierIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               }
+               break;
+           case 'j':
+               sCfg.pJsonFile = optarg;
+               break;
+           case 'v':    /*  version */
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+
+    if ((sCfg.duration == 0u) || (sCfg.replyTimeout == 0u) || (sCfg.callerIP == sCfg.replierIP))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /*  A replier serves all runs of the caller with the largest listener count */
+    sCfg.noOfRuns   = sCfg.payload.noOfSteps * sCfg.concurrency.noOfSteps * sCfg.listeners.noOfSteps;
+    noOfRuns        = sCfg.noOfRuns;
+    if (sCfg.role == BENCH_ROLE_REPLIER)
+    {
+        pRun = (BENCH_RESULT_T *) calloc(1u, sizeof(BENCH_RESULT_T));
+        if (pRun != NULL)
+        {
+            pRun->listeners = benchMax(&sCfg.listeners);
+        }
+        noOfRuns = 1u;
+    }
+    else
+    {
+        pRun = (BENCH_RESULT_T *) calloc(noOfRuns, sizeof(BENCH_RESULT_T));
+        for (i = 0u, n = 0u; (pRun != NULL) && (i < sCfg.payload.noOfSteps); i++)
+        {
+            for (j = 0u; j < sCfg.concurrency.noOfSteps; j++)
+            {
+                for (k = 0u; k < sCfg.listeners.noOfSteps; k++, n++)
+                {
+                    pRun[n].payload     = sCfg.payload.value[i];
+                    pRun[n].concurrency = sCfg.concurrency.value[j];
+                    pRun[n].listeners   = sCfg.listeners.value[k];
+                }
+            }
+        }
+    }
+
+    /*  Every outstanding session holds request and reply of both sides  */
+    memConfig.size += 4u * BENCH_MAX_CONCURRENCY * (benchMax(&sCfg.payload) + 1024u);
+
+    sSample = (UINT32 *) malloc(BENCH_MAX_SAMPLES * sizeof(UINT32));
+    if ((pRun == NULL) || (sSample == NULL) || (tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR))
+    {
+        fprintf(stderr, "initialisation failed\n");
+        free(pRun);
+        free(sSample);
+        return 1;
+    }
+    memset(sPayload, 0x5A, sizeof(sPayload));
+
+    for (i = 0u; i < noOfRuns; i++)
+    {
+        benchRun(&pRun[i]);
+        if ((pRun[i].sessions == 0u) && (pRun[i].replies == 0u))
+        {
+            fprintf(stderr, "run %u: no session completed\n", i);
+            rv = 1;
+        }
+    }
+    (void) tlc_terminate();
+
+    if (sCfg.pJsonFile != NULL)
+    {
+        out = fopen(sCfg.pJsonFile, "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", sCfg.pJsonFile);
+            out = stdout;
+        }
+    }
+    fprintf(out, "{\n  \"benchmark\": \"md\",\n  \"build\": \"%s\",\n", BENCH_BUILD);
+    fprintf(out, "  \"config\": {\"role\": \"%s\", \"transport\": \"%s\", \"confirm\": %s, \"session_id\": \"%s\", "
+            "\"reply_timeout_us\": %u, \"duration_s\": %u},\n  \"runs\": [\n",
+            (sCfg.role == BENCH_ROLE_CALLER) ? "caller" : ((sCfg.role == BENCH_ROLE_REPLIER) ? "replier" : "both"),
+            (sCfg.tcp == TRUE) ? "tcp" : "udp", (sCfg.confirm == TRUE) ? "true" : "false",
+            (sCfg.fastId == TRUE) ? "fast" : "uuid", sCfg.replyTimeout, sCfg.duration);
+    for (i = 0u; i < noOfRuns; i++)
+    {
+        benchReport(out, &pRun[i], (i == 0u) ? TRUE : FALSE);
+    }
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    free(pRun);
+    free(sSample);
+    return rv;
+}
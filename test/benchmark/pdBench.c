@@ -0,0 +1,1049 @@
+/**********************************************************************************************************************/
+/**
+ * @file            pdBench.c
+ *
+ * @brief           PD benchmark
+ *
+ * @details         N publishers send to each of M subscriber sessions on the loopback interface, within one process
+ *                  or split into a publishing and a subscribing process. A session receives on one port only and
+ *                  ignores packets of other interfaces, so every subscriber session has its own publishing session
+ *                  and port. Payload size, interval mix, marshalling,
+ *                  callback or polling reception, the PD scheduler (send queue or index tables) and the thread
+ *                  layout (one application loop or the session threads of the stack) can be selected.
+ *                  The publisher callback stamps the send time into the payload right before a telegram is sent,
+ *                  the subscriber takes the one-way latency on delivery to the application.
+ *                  Packet rates, CPU time per packet, latency percentiles and missed, timed out and late telegrams
+ *                  are written as JSON.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      BL 2026-10-18: Initial version
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined (POSIX)
+#include <unistd.h>
+#include <sys/select.h>
+#include <sys/resource.h>
+#elif (defined (WIN32) || defined (WIN64))
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "tau_marshall.h"
+#include "vos_thread.h"
+#include "vos_sock.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+#define APP_VERSION             "1.0"
+
+#define BENCH_COMID             20000u                  /**< comId of the first publisher                           */
+#define BENCH_DATASET_ID        20000u                  /**< dataset of all comIds if marshalling                   */
+#define BENCH_MAX_PUBS          1000u                   /**< max. publishers per subscriber session                 */
+#define BENCH_MAX_SUBS          200u                    /**< max. subscriber sessions                               */
+#define BENCH_MAX_INTERVALS     8u                      /**< max. entries of the interval mix                       */
+#define BENCH_MAX_SAMPLES       (1u << 20)              /**< latency samples kept (reservoir)                       */
+#define BENCH_HEAD_SIZE         16u                     /**< time stamp, sequence counter, number of items         */
+#define BENCH_MEM_SIZE          (32u * 1024u * 1024u)   /**< memory of the stack                                    */
+
+#define BENCH_ROLE_BOTH         0u
+#define BENCH_ROLE_PUB          1u
+#define BENCH_ROLE_SUB          2u
+
+#ifdef HIGH_PERF_INDEXED
+#define BENCH_BUILD             "hp"
+#else
+#define BENCH_BUILD             "std"
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Payload: the send time is written in network byte order by the publisher callback  */
+typedef struct
+{
+    UINT64  timeStamp;                                  /**< send time [ns]                                         */
+    UINT32  seqCnt;                                     /**< application counter                                    */
+    UINT32  noOfItems;                                  /**< fill up to the payload size                            */
+    UINT32  item[(TRDP_MAX_PD_DATA_SIZE - BENCH_HEAD_SIZE) / 4u];
+} BENCH_DS_T;
+
+/** Benchmark parameters */
+typedef struct
+{
+    UINT32      noOfPubs;                               /**< publishers per subscriber session                      */
+    UINT32      noOfSubs;                               /**< subscriber sessions                                    */
+    UINT32      payload;                                /**< dataset size [bytes]                                   */
+    UINT32      noOfIntervals;
+    UINT32      interval[BENCH_MAX_INTERVALS];          /**< interval mix [us], assigned round robin                */
+    UINT32      duration;                               /**< measurement [s]                                        */
+    UINT32      warmUp;                                 /**< before the measurement [ms]                            */
+    UINT32      cycle;                                  /**< process cycle [us]                                     */
+    UINT32      workers;                                /**< callback dispatch workers per subscriber session       */
+    UINT32      role;
+    UINT32      pubIP;                                  /**< own IP of the publishing sessions                      */
+    UINT32      subIP;                                  /**< own IP of the subscriber sessions                      */
+    BOOL8       marshall;
+    BOOL8       polling;
+    BOOL8       indexed;
+    BOOL8       threads;
+    const char  *pJsonFile;
+} BENCH_CONFIG_T;
+
+/** Counters of the measurement */
+typedef struct
+{
+    UINT64  time;                                       /**< measurement time [ns]                                  */
+    UINT64  cpuUser;                                    /**< user CPU time [ns]                                     */
+    UINT64  cpuSystem;                                  /**< system CPU time [ns]                                   */
+    UINT64  sent;                                       /**< telegrams sent                                         */
+    UINT64  received;                                   /**< telegrams received                                     */
+    UINT64  missed;                                     /**< sequence gaps seen by the stack                        */
+    UINT64  timeouts;                                   /**< subscription timeouts                                  */
+} BENCH_RESULT_T;
+
+/** Publisher, updated by the application with its interval */
+typedef struct
+{
+    TRDP_APP_SESSION_T  appHandle;
+    TRDP_PUB_T  handle;
+    UINT32      comId;
+    UINT32      interval;                               /**< [us]                                                   */
+    UINT64      due;                                    /**< next update [ns]                                       */
+} BENCH_PUB_T;
+
+/** Subscription */
+typedef struct
+{
+    TRDP_APP_SESSION_T  appHandle;
+    TRDP_SUB_T          handle;
+    UINT32              comId;
+    UINT64              interval;                       /**< [ns]                                                   */
+    UINT32              lastSeq;
+    BOOL8               valid;                          /**< lastSeq is set                                         */
+    TRDP_DATASET_T      *pCachedDS;
+} BENCH_SUB_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static BENCH_CONFIG_T       sCfg;
+static TRDP_APP_SESSION_T   sPubSession[BENCH_MAX_SUBS];
+static TRDP_APP_SESSION_T   sSubSession[BENCH_MAX_SUBS];
+static BENCH_PUB_T          *sPub       = NULL;
+static BENCH_SUB_T          *sSub       = NULL;
+static UINT32               sNoOfPub    = 0u;
+static UINT32               sNoOfSub    = 0u;
+static void                 *sMarshallRef = NULL;
+
+/*  Taken while measuring, concurrently from all receiving threads */
+static UINT32               sMeasuring  = 0u;
+static UINT32               *sSample    = NULL;         /**< latencies [ns]                                         */
+static UINT32               sNoOfSamples = 0u;          /**< delivered telegrams                                    */
+static UINT32               sNoOfLate   = 0u;           /**< latency above the interval                             */
+static UINT32               sNoOfSkipped = 0u;          /**< sequence gaps seen by the application                  */
+
+/*  Dataset of the payload (marshalling)    */
+static TRDP_DATASET_T       sDataset =
+{
+    BENCH_DATASET_ID,   /*    dataset/com ID  */
+    0,                  /*    reserved        */
+    4,                  /*    No of elements  */
+    {'\0'},             /*    name            */
+    {                   /*    TRDP_DATASET_ELEMENT_T[]    */
+        {
+            TRDP_UINT64,
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,
+            TRDP_VAR_SIZE,
+            NULL, NULL, 0, 0, NULL
+        }
+    }
+};
+
+/*  Referenced by the marshalling until the end */
+static TRDP_DATASET_T       *sDatasetList[] = {&sDataset};
+static TRDP_COMID_DSID_MAP_T *sComIdMap = NULL;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void    dbgOut (void *pRefCon, TRDP_LOG_T category, const CHAR8 *pTime, const CHAR8 *pFile, UINT16 LineNumber,
+                const CHAR8 *pMsgStr);
+void    usage (const char *appName);
+void    pubCallback (void *pRefCon, TRDP_APP_SESSION_T appHandle, const TRDP_PD_INFO_T *pMsg, UINT8 *pData,
+                     UINT32 dataSize);
+void    subCallback (void *pRefCon, TRDP_APP_SESSION_T appHandle, const TRDP_PD_INFO_T *pMsg, UINT8 *pData,
+                     UINT32 dataSize);
+void    benchSample (BENCH_SUB_T *pSub, UINT32 seqCnt, UINT64 sendTime);
+void    benchPoll (void);
+void    benchUpdate (UINT64 now);
+void    benchCpuTime (UINT64 *pUser, UINT64 *pSystem);
+int     benchParseIntervals (const char *pList);
+int     benchSetup (void);
+void    benchLoop (UINT64 end);
+void    benchCollect (BENCH_RESULT_T *pResult);
+void    benchReport (const BENCH_RESULT_T *pResult);
+int     compareUINT32 (const void *p1, const void *p2);
+
+/**********************************************************************************************************************/
+
+/* Print errors of the stack only */
+void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    if (category == VOS_LOG_ERROR)
+    {
+        fprintf(stderr, "%s %s:%d %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool measures PD throughput, CPU time and latency on the loopback interface.\n"
+           "Arguments are:\n"
+           "-n <publishers>     per subscriber session (default 10)\n"
+           "-m <subscribers>    subscriber sessions (default 1)\n"
+           "-s <bytes>          payload size, 16...1432 (default 64)\n"
+           "-i <us>[,<us>...]   interval mix, assigned round robin (default 10000)\n"
+           "-c <us>             process cycle (default 1000)\n"
+           "-d <s>              measurement time (default 5)\n"
+           "-u <ms>             warm up time (default 500)\n"
+           "-M                  marshall the payload\n"
+           "-P                  poll with tlp_get() instead of callbacks\n"
+           "-x                  indexed scheduler (default in HIGH_PERF_INDEXED builds)\n"
+           "-l loop|threads     one application loop (default) or the session threads of the stack\n"
+           "-w <workers>        callback dispatch workers per subscriber session (default 0)\n"
+           "-r both|pub|sub     publish and/or subscribe in this process (default both)\n"
+           "-o <ip>             own IP of the publishing sessions (default 0.0.0.0)\n"
+           "-t <ip>             own IP of the subscriber sessions (default 127.0.0.1)\n"
+           "                    session pair k (0...m-1) communicates on port 17224 + k\n"
+           "-j <file>           JSON output (default stdout)\n"
+           "-v                  print version and quit\n");
+}
+
+/**********************************************************************************************************************/
+/** Publisher callback, called right before a telegram is sent: stamp the send time
+ */
+void pubCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    UINT64 now;
+
+    if ((pData != NULL) && (dataSize >= sizeof(UINT64)))
+    {
+        vos_getNanoTime(&now);
+        now = vos_htonll(now);
+        memcpy(pData, &now, sizeof(UINT64));
+    }
+}
+
+/**********************************************************************************************************************/
+/** Subscriber callback, the payload is in network format
+ */
+void subCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    BENCH_SUB_T *pSub = (BENCH_SUB_T *) pMsg->pUserRef;
+    UINT64      sendTime;
+
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pSub == NULL) || (pData == NULL) || (dataSize < sizeof(UINT64)))
+    {
+        return;
+    }
+    if (sCfg.marshall == TRUE)
+    {
+        BENCH_DS_T  ds;
+        UINT32      size = sizeof(ds);
+
+        if (tau_unmarshall(sMarshallRef, pMsg->comId, pData, dataSize, (UINT8 *) &ds, &size,
+                           &pSub->pCachedDS) != TRDP_NO_ERR)
+        {
+            return;
+        }
+        sendTime = ds.timeStamp;
+    }
+    else
+    {
+        memcpy(&sendTime, pData, sizeof(UINT64));
+        sendTime = vos_ntohll(sendTime);
+    }
+    benchSample(pSub, pMsg->seqCount, sendTime);
+}
+
+/**********************************************************************************************************************/
+/** Take the latency of a delivered telegram
+ *  Called from several threads with the session threads layout. Beyond BENCH_MAX_SAMPLES a random sample is replaced.
+ */
+void benchSample (
+    BENCH_SUB_T *pSub,
+    UINT32      seqCnt,
+    UINT64      sendTime)
+{
+    UINT64  now;
+    UINT64  latency;
+    UINT32  n;
+
+    vos_getNanoTime(&now);
+    if ((VOS_ATOMIC_LOAD(&sMeasuring) != 0u) && (pSub->valid == TRUE) && ((seqCnt - pSub->lastSeq) > 1u))
+    {
+        (void) VOS_ATOMIC_ADD(&sNoOfSkipped, seqCnt - pSub->lastSeq - 1u);
+    }
+    pSub->lastSeq   = seqCnt;
+    pSub->valid     = TRUE;
+    if (VOS_ATOMIC_LOAD(&sMeasuring) == 0u)
+    {
+        return;
+    }
+
+    latency = (now > sendTime) ? (now - sendTime) : 0u;
+    if (latency > 0xFFFFFFFFu)
+    {
+        latency = 0xFFFFFFFFu;
+    }
+    if (latency > pSub->interval)
+    {
+        (void) VOS_ATOMIC_ADD(&sNoOfLate, 1u);
+    }
+
+    n = VOS_ATOMIC_ADD(&sNoOfSamples, 1u) - 1u;
+    if (n >= BENCH_MAX_SAMPLES)
+    {
+        /* reservoir sampling, a hash of the count is random enough */
+        UINT32 r = n * 2654435761u;
+
+        r   ^= r >> 15;
+        n   = r % (n + 1u);
+    }
+    if (n < BENCH_MAX_SAMPLES)
+    {
+        sSample[n] = (UINT32) latency;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Poll all subscriptions, a telegram is new if its sequence counter changed
+ */
+void benchPoll (void)
+{
+    BENCH_DS_T      ds;
+    TRDP_PD_INFO_T  pdInfo;
+    UINT32          i;
+
+    for (i = 0u; i < sNoOfSub; i++)
+    {
+        UINT32 size = sizeof(ds);
+
+        if ((tlp_get(sSub[i].appHandle, sSub[i].handle, &pdInfo, (UINT8 *) &ds, &size) == TRDP_NO_ERR)
+            && ((sSub[i].valid == FALSE) || (pdInfo.seqCount != sSub[i].lastSeq)))
+        {
+            /* tlp_get() unmarshalls, the time stamp stays in network format otherwise */
+            benchSample(&sSub[i], pdInfo.seqCount, (sCfg.marshall == TRUE) ? ds.timeStamp : vos_ntohll(ds.timeStamp));
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Update the data of the publishers which are due
+ *
+ *  @param[in]      now         current time [ns]
+ */
+void benchUpdate (
+    UINT64 now)
+{
+    static BENCH_DS_T   ds;
+    UINT32              i;
+
+    for (i = 0u; i < sNoOfPub; i++)
+    {
+        if (now >= sPub[i].due)
+        {
+            ds.seqCnt++;
+            ds.noOfItems = (sCfg.payload - BENCH_HEAD_SIZE) / 4u;
+            if (sCfg.marshall == FALSE)
+            {
+                ds.seqCnt = vos_htonl(ds.seqCnt);
+            }
+            (void) tlp_put(sPub[i].appHandle, sPub[i].handle, (const UINT8 *) &ds, sCfg.payload);
+            if (sCfg.marshall == FALSE)
+            {
+                ds.seqCnt = vos_ntohl(ds.seqCnt);
+            }
+            /* keep the phase, but do not catch up after an overrun */
+            sPub[i].due += (UINT64) sPub[i].interval * 1000u;
+            if (sPub[i].due <= now)
+            {
+                sPub[i].due = now + (UINT64) sPub[i].interval * 1000u;
+            }
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Get the CPU time of the process
+ *
+ *  @param[out]     pUser       user time [ns]
+ *  @param[out]     pSystem     system time [ns], 0 if not available
+ */
+void benchCpuTime (
+    UINT64  *pUser,
+    UINT64  *pSystem)
+{
+#if defined (POSIX)
+    struct rusage usage;
+
+    (void) getrusage(RUSAGE_SELF, &usage);
+    *pUser      = (UINT64) usage.ru_utime.tv_sec * 1000000000u + (UINT64) usage.ru_utime.tv_usec * 1000u;
+    *pSystem    = (UINT64) usage.ru_stime.tv_sec * 1000000000u + (UINT64) usage.ru_stime.tv_usec * 1000u;
+#else
+    *pUser      = (UINT64) clock() * (1000000000u / CLOCKS_PER_SEC);
+    *pSystem    = 0u;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Parse the interval mix
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int benchParseIntervals (
+    const char *pList)
+{
+    sCfg.noOfIntervals = 0u;
+    while ((pList != NULL) && (*pList != '\0'))
+    {
+        unsigned int interval;
+
+        if ((sCfg.noOfIntervals >= BENCH_MAX_INTERVALS) || (sscanf(pList, "%u", &interval) != 1) || (interval == 0u))
+        {
+            return 1;
+        }
+        sCfg.interval[sCfg.noOfIntervals++] = interval;
+        pList = strchr(pList, ',');
+        if (pList != NULL)
+        {
+            pList++;
+        }
+    }
+    return (sCfg.noOfIntervals == 0u) ? 1 : 0;
+}
+
+/**********************************************************************************************************************/
+/** Open the sessions, publish and subscribe
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int benchSetup (void)
+{
+    TRDP_PD_CONFIG_T        pdConfig        = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_NONE, 0u,
+                                               TRDP_TO_DEFAULT, TRDP_PD_UDP_PORT};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"pdBench", "", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_MARSHALL_CONFIG_T  marshallConfig  = {tau_marshall, tau_unmarshall, NULL};
+    TRDP_IDX_TABLE_T        idxTable;
+    TRDP_FLAGS_T            flags = (sCfg.marshall == TRUE) ? TRDP_FLAGS_MARSHALL : TRDP_FLAGS_NONE;
+    BENCH_DS_T              ds;
+    UINT32                  minInterval = 0xFFFFFFFFu;
+    UINT32                  depth;
+    UINT32                  i, j;
+    TRDP_ERR_T              err;
+
+    memset(&ds, 0, sizeof(ds));
+    ds.noOfItems = (sCfg.payload - BENCH_HEAD_SIZE) / 4u;
+
+    /*  All comIds carry the same dataset   */
+    sComIdMap = (TRDP_COMID_DSID_MAP_T *) malloc(sCfg.noOfPubs * sizeof(TRDP_COMID_DSID_MAP_T));
+    if (sComIdMap == NULL)
+    {
+        return 1;
+    }
+    for (i = 0u; i < sCfg.noOfPubs; i++)
+    {
+        sComIdMap[i].comId      = BENCH_COMID + i;
+        sComIdMap[i].datasetId  = BENCH_DATASET_ID;
+    }
+    if (sCfg.marshall == TRUE)
+    {
+        if (tau_initMarshall(&sMarshallRef, sCfg.noOfPubs, sComIdMap, 1u, sDatasetList) != TRDP_NO_ERR)
+        {
+            fprintf(stderr, "tau_initMarshall failed\n");
+            return 1;
+        }
+        marshallConfig.pRefCon = sMarshallRef;
+    }
+
+    /*  Size the index tables for all publishers in the same category   */
+    for (i = 0u; i < sCfg.noOfIntervals; i++)
+    {
+        minInterval = (sCfg.interval[i] < minInterval) ? sCfg.interval[i] : minInterval;
+    }
+    depth = (UINT32) ((UINT64) sCfg.noOfPubs * sCfg.cycle / minInterval) + 4u;
+    if (depth > sCfg.noOfPubs)
+    {
+        depth = sCfg.noOfPubs;
+    }
+    idxTable.maxNoOfLowCatSubscriptions     = sCfg.noOfPubs;
+    idxTable.maxNoOfMidCatSubscriptions     = sCfg.noOfPubs;
+    idxTable.maxNoOfHighCatSubscriptions    = sCfg.noOfPubs;
+    idxTable.maxNoOfLowCatPublishers        = sCfg.noOfPubs;
+    idxTable.maxDepthOfLowCatPublishers     = depth;
+    idxTable.maxNoOfMidCatPublishers        = sCfg.noOfPubs;
+    idxTable.maxDepthOfMidCatPublishers     = depth;
+    idxTable.maxNoOfHighCatPublishers       = sCfg.noOfPubs;
+    idxTable.maxDepthOfHighCatPublishers    = depth;
+    idxTable.maxNoOfExtPublishers           = sCfg.noOfPubs;
+    idxTable.baseCycle                      = ((sCfg.cycle % 1000u) == 0u) ? 1000u
+                                              : ((sCfg.cycle % 500u) == 0u) ? 500u : 250u;
+
+    processConfig.cycleTime = sCfg.cycle;
+    if (sCfg.indexed == TRUE)
+    {
+        processConfig.options |= TRDP_OPTION_INDEXED;
+    }
+
+    sPub    = (BENCH_PUB_T *) calloc(sCfg.noOfPubs * sCfg.noOfSubs, sizeof(BENCH_PUB_T));
+    sSub    = (BENCH_SUB_T *) calloc(sCfg.noOfPubs * sCfg.noOfSubs, sizeof(BENCH_SUB_T));
+    if ((sPub == NULL) || (sSub == NULL))
+    {
+        return 1;
+    }
+
+    /*  Subscriber sessions first, the publishers will not find closed ports    */
+    if (sCfg.role != BENCH_ROLE_PUB)
+    {
+        for (j = 0u; j < sCfg.noOfSubs; j++)
+        {
+            pdConfig.port = (UINT16) (TRDP_PD_UDP_PORT + j);
+            err = tlc_openSession(&sSubSession[j], sCfg.subIP, 0u, &marshallConfig, &pdConfig, NULL,
+                                  &processConfig);
+            if ((err == TRDP_NO_ERR) && (sCfg.indexed == TRUE))
+            {
+                err = tlc_presetIndexSession(sSubSession[j], &idxTable);
+            }
+            if ((err == TRDP_NO_ERR) && (sCfg.workers > 0u))
+            {
+                err = tlp_setCallbackDispatch(sSubSession[j], sCfg.workers, 0u);
+            }
+            for (i = 0u; (i < sCfg.noOfPubs) && (err == TRDP_NO_ERR); i++)
+            {
+                BENCH_SUB_T *pSub = &sSub[sNoOfSub];
+
+                pSub->appHandle = sSubSession[j];
+                pSub->comId     = BENCH_COMID + i;
+                pSub->interval  = (UINT64) sCfg.interval[i % sCfg.noOfIntervals] * 1000u;
+                err = tlp_subscribe(sSubSession[j], &pSub->handle, pSub,
+                                    (sCfg.polling == TRUE) ? NULL : subCallback, 0u, pSub->comId, 0u, 0u,
+                                    0u, 0u, 0u,
+                                    (sCfg.polling == TRUE) ? flags : (flags | TRDP_FLAGS_CALLBACK),
+                                    NULL, (UINT32) (3u * pSub->interval / 1000u), TRDP_TO_DEFAULT);
+                sNoOfSub++;
+            }
+            if (err == TRDP_NO_ERR)
+            {
+                err = tlc_updateSession(sSubSession[j]);
+            }
+            if (err != TRDP_NO_ERR)
+            {
+                fprintf(stderr, "subscriber session %u failed (%d)\n", j, err);
+                return 1;
+            }
+        }
+    }
+
+    if (sCfg.role != BENCH_ROLE_SUB)
+    {
+        for (j = 0u; j < sCfg.noOfSubs; j++)
+        {
+            pdConfig.port = (UINT16) (TRDP_PD_UDP_PORT + j);
+            err = tlc_openSession(&sPubSession[j], sCfg.pubIP, 0u, &marshallConfig, &pdConfig, NULL,
+                                  &processConfig);
+            if ((err == TRDP_NO_ERR) && (sCfg.indexed == TRUE))
+            {
+                err = tlc_presetIndexSession(sPubSession[j], &idxTable);
+            }
+            for (i = 0u; (i < sCfg.noOfPubs) && (err == TRDP_NO_ERR); i++)
+            {
+                BENCH_PUB_T *pPub = &sPub[sNoOfPub];
+
+                pPub->appHandle = sPubSession[j];
+                pPub->comId     = BENCH_COMID + i;
+                pPub->interval  = sCfg.interval[i % sCfg.noOfIntervals];
+                err = tlp_publish(sPubSession[j], &pPub->handle, pPub, pubCallback, 0u, pPub->comId, 0u, 0u,
+                                  0u, sCfg.subIP, pPub->interval, 0u, flags, NULL,
+                                  (const UINT8 *) &ds, sCfg.payload);
+                sNoOfPub++;
+            }
+            if (err == TRDP_NO_ERR)
+            {
+                err = tlc_updateSession(sPubSession[j]);
+            }
+            if (err != TRDP_NO_ERR)
+            {
+                fprintf(stderr, "publisher session %u failed (%d)\n", j, err);
+                return 1;
+            }
+        }
+    }
+
+    for (j = 0u; (j < sCfg.noOfSubs) && (sCfg.threads == TRUE); j++)
+    {
+        if (((sPubSession[j] != NULL) && (tlc_startSessionThreads(sPubSession[j], &processConfig) != TRDP_NO_ERR))
+            || ((sSubSession[j] != NULL) && (tlc_startSessionThreads(sSubSession[j], &processConfig) != TRDP_NO_ERR)))
+        {
+            fprintf(stderr, "session threads %u failed\n", j);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Run until end: one loop for all sessions or just the application part with the session threads
+ *
+ *  @param[in]      end         end of the run [ns]
+ */
+void benchLoop (
+    UINT64 end)
+{
+    UINT64  now;
+    UINT64  nextCycle;
+    UINT32  j;
+
+    vos_getNanoTime(&now);
+    nextCycle = now;
+    while (now < end)
+    {
+        if (now >= nextCycle)
+        {
+            benchUpdate(now);
+            for (j = 0u; (j < sCfg.noOfSubs) && (sCfg.threads == FALSE); j++)
+            {
+                if (sPubSession[j] != NULL)
+                {
+                    (void) tlp_processSend(sPubSession[j]);
+                }
+            }
+            if ((sCfg.polling == TRUE) && (sCfg.threads == TRUE))
+            {
+                benchPoll();
+            }
+            nextCycle += (UINT64) sCfg.cycle * 1000u;
+            if (nextCycle < now)
+            {
+                nextCycle = now + (UINT64) sCfg.cycle * 1000u;      /* overrun, do not catch up */
+            }
+        }
+
+        if (sCfg.threads == TRUE)
+        {
+            vos_getNanoTime(&now);
+            if (nextCycle > now)
+            {
+                (void) vos_threadDelay((UINT32) ((nextCycle - now) / 1000u));
+            }
+        }
+        else if (sSubSession[0] != NULL)
+        {
+            TRDP_FDS_T  rfds;
+            TRDP_TIME_T tv;
+            INT32       noDesc  = 0;
+            INT32       rv;
+
+            FD_ZERO(&rfds);
+            for (j = 0u; j < sCfg.noOfSubs; j++)
+            {
+                INT32 n = 0;
+
+                (void) tlp_getInterval(sSubSession[j], &tv, &rfds, &n);
+                noDesc = (n > noDesc) ? n : noDesc;
+            }
+            vos_getNanoTime(&now);
+            tv.tv_sec   = 0;
+            tv.tv_usec  = (nextCycle > now) ? (long) ((nextCycle - now) / 1000u) : 0;
+            rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+            for (j = 0u; j < sCfg.noOfSubs; j++)
+            {
+                INT32 count = rv;
+
+                (void) tlp_processReceive(sSubSession[j], &rfds, &count);
+            }
+            if (sCfg.polling == TRUE)
+            {
+                benchPoll();
+            }
+        }
+        else
+        {
+            vos_getNanoTime(&now);
+            if (nextCycle > now)
+            {
+                (void) vos_threadDelay((UINT32) ((nextCycle - now) / 1000u));
+            }
+        }
+        vos_getNanoTime(&now);
+    }
+}
+
+/**********************************************************************************************************************/
+
+int compareUINT32 (const void *p1, const void *p2)
+{
+    UINT32  v1  = *(const UINT32 *) p1;
+    UINT32  v2  = *(const UINT32 *) p2;
+
+    return (v1 < v2) ? -1 : ((v1 > v2) ? 1 : 0);
+}
+
+/**********************************************************************************************************************/
+/** Add the statistics of the sessions to the result
+ *
+ *  @param[in,out]  pResult     counters of the measurement
+ */
+void benchCollect (
+    BENCH_RESULT_T *pResult)
+{
+    TRDP_STATISTICS_T   stats;
+    UINT32              i;
+
+    for (i = 0u; i < sCfg.noOfSubs; i++)
+    {
+        if ((sPubSession[i] != NULL) && (tlc_getStatistics(sPubSession[i], &stats) == TRDP_NO_ERR))
+        {
+            pResult->sent += stats.pd.numSend;
+        }
+        if ((sSubSession[i] != NULL) && (tlc_getStatistics(sSubSession[i], &stats) == TRDP_NO_ERR))
+        {
+            pResult->received   += stats.pd.numRcv;
+            pResult->missed     += stats.pd.numMissed;
+            pResult->timeouts   += stats.pd.numTimeout;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Write the results as JSON, the sessions must be closed: the samples are not written anymore
+ *
+ *  @param[in]      pResult     counters of the measurement
+ */
+void benchReport (
+    const BENCH_RESULT_T *pResult)
+{
+    static const UINT32 cPercentile[]   = {5000u, 9000u, 9900u, 9990u};
+    static const char   *cName[]        = {"p50", "p90", "p99", "p999"};
+    UINT64              sum         = 0u;
+    UINT64              packets     = pResult->sent + pResult->received;
+    UINT32              delivered   = VOS_ATOMIC_LOAD(&sNoOfSamples);
+    UINT32              noOfSamples = (delivered < BENCH_MAX_SAMPLES) ? delivered : BENCH_MAX_SAMPLES;
+    UINT32              i;
+    FILE                *out = stdout;
+
+    qsort(sSample, noOfSamples, sizeof(UINT32), compareUINT32);
+    for (i = 0u; i < noOfSamples; i++)
+    {
+        sum += sSample[i];
+    }
+
+    if (sCfg.pJsonFile != NULL)
+    {
+        out = fopen(sCfg.pJsonFile, "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", sCfg.pJsonFile);
+            out = stdout;
+        }
+    }
+
+    fprintf(out, "{\n  \"benchmark\": \"pd\",\n  \"build\": \"%s\",\n", BENCH_BUILD);
+    fprintf(out, "  \"config\": {\"role\": \"%s\", \"publishers\": %u, \"subscribers\": %u, \"payload\": %u, "
+            "\"intervals_us\": [",
+            (sCfg.role == BENCH_ROLE_PUB) ? "pub" : ((sCfg.role == BENCH_ROLE_SUB) ? "sub" : "both"),
+            sCfg.noOfPubs, sCfg.noOfSubs, sCfg.payload);
+    for (i = 0u; i < sCfg.noOfIntervals; i++)
+    {
+        fprintf(out, "%s%u", (i == 0u) ? "" : ", ", sCfg.interval[i]);
+    }
+    fprintf(out, "], \"cycle_us\": %u, \"marshall\": %s, \"reception\": \"%s\", \"scheduler\": \"%s\", "
+            "\"layout\": \"%s\", \"workers\": %u, \"duration_s\": %u},\n",
+            sCfg.cycle, (sCfg.marshall == TRUE) ? "true" : "false", (sCfg.polling == TRUE) ? "polling" : "callback",
+#ifdef HIGH_PERF_INDEXED
+            "indexed",
+#else
+            (sCfg.indexed == TRUE) ? "indexed" : "queue",
+#endif
+            (sCfg.threads == TRUE) ? "threads" : "loop", sCfg.workers, sCfg.duration);
+    fprintf(out, "  \"sent\": %llu,\n  \"received\": %llu,\n  \"delivered\": %u,\n",
+            (unsigned long long) pResult->sent, (unsigned long long) pResult->received, delivered);
+    fprintf(out, "  \"packets_per_s\": {\"tx\": %.1f, \"rx\": %.1f},\n",
+            (double) pResult->sent * 1e9 / (double) pResult->time,
+            (double) pResult->received * 1e9 / (double) pResult->time);
+    fprintf(out, "  \"cpu\": {\"user_s\": %.3f, \"system_s\": %.3f, \"ns_per_packet\": %.1f},\n",
+            (double) pResult->cpuUser / 1e9, (double) pResult->cpuSystem / 1e9,
+            (packets != 0u) ? (double) (pResult->cpuUser + pResult->cpuSystem) / (double) packets : 0.0);
+    fprintf(out, "  \"latency_us\": {\"samples\": %u", noOfSamples);
+    if (noOfSamples > 0u)
+    {
+        fprintf(out, ", \"min\": %.3f, \"mean\": %.3f", (double) sSample[0] / 1e3,
+                (double) sum / (double) noOfSamples / 1e3);
+        for (i = 0u; i < sizeof(cPercentile) / sizeof(cPercentile[0]); i++)
+        {
+            fprintf(out, ", \"%s\": %.3f", cName[i],
+                    (double) sSample[(UINT64) (noOfSamples - 1u) * cPercentile[i] / 10000u] / 1e3);
+        }
+        fprintf(out, ", \"max\": %.3f", (double) sSample[noOfSamples - 1u] / 1e3);
+    }
+    fprintf(out, "},\n  \"missed\": %llu,\n  \"skipped\": %u,\n  \"timeouts\": %llu,\n  \"late\": %u\n}\n",
+            (unsigned long long) pResult->missed, VOS_ATOMIC_LOAD(&sNoOfSkipped),
+            (unsigned long long) pResult->timeouts,
+            VOS_ATOMIC_LOAD(&sNoOfLate));
+
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    TRDP_MEM_CONFIG_T   memConfig = {NULL, BENCH_MEM_SIZE, {0}};
+    BENCH_RESULT_T      result;
+    unsigned int        ip[4];
+    unsigned int        value;
+    UINT64              start, end, now;
+    UINT64              cpuUser, cpuSystem;
+    UINT32              i;
+    int                 ch;
+    int                 rv = 1;
+
+    memset(&result, 0, sizeof(result));
+    memset(&sCfg, 0, sizeof(sCfg));
+    sCfg.noOfPubs       = 10u;
+    sCfg.noOfSubs       = 1u;
+    sCfg.payload        = 64u;
+    sCfg.noOfIntervals  = 1u;
+    sCfg.interval[0]    = 10000u;
+    sCfg.duration       = 5u;
+    sCfg.warmUp         = 500u;
+    sCfg.cycle          = 1000u;
+    sCfg.pubIP          = VOS_INADDR_ANY;
+    sCfg.subIP          = vos_dottedIP("127.0.0.1");
+#ifdef HIGH_PERF_INDEXED
+    sCfg.indexed        = TRUE;
+#endif
+
+    while ((ch = getopt(argc, argv, "n:m:s:i:c:d:u:MPxl:w:r:o:t:j:h?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'n':
+           case 'm':
+           case 's':
+           case 'c':
+           case 'd':
+           case 'u':
+           case 'w':
+               if (sscanf(optarg, "%u", &value) != 1)
+               {
+                   usage(argv[0]);
+                   return 1;
+               }
+               switch (ch)
+               {
+                  case 'n': sCfg.noOfPubs   = value; break;
+                  case 'm': sCfg.noOfSubs   = value; break;
+                  case 's': sCfg.payload    = (value + 3u) & ~3u; break;
+                  case 'c': sCfg.cycle      = value; break;
+                  case 'd': sCfg.duration   = value; break;
+                  case 'u': sCfg.warmUp     = value; break;
+                  default:  sCfg.workers    = value; break;
+               }
+               break;
+           case 'i':
+               if (benchParseIntervals(optarg) != 0)
+               {
+                   usage(argv[0]);
+                   return 1;
+               }
+               break;
+           case 'M':
+               sCfg.marshall = TRUE;
+               break;
+           case 'P':
+               sCfg.polling = TRUE;
+               break;
+           case 'x':
+               sCfg.indexed = TRUE;
+               break;
+           case 'l':
+               sCfg.threads = (strcmp(optarg, "threads") == 0) ? TRUE : FALSE;
+               break;
+           case 'r':
+               sCfg.role = (strcmp(optarg, "pub") == 0) ? BENCH_ROLE_PUB
+                           : ((strcmp(optarg, "sub") == 0) ? BENCH_ROLE_SUB : BENCH_ROLE_BOTH);
+               break;
+           case 'o':
+           case 't':
+               if (sscanf(optarg, "%u.%u.%u.%u", &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+               {
+                   usage(argv[0]);
+                   return 1;
+               }
+               if (ch == 'o')
+               {
+                   sCfg.pubIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               }
+               else
+               {
+                   sCfg.subIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               }
+               break;
+           case 'j':
+               sCfg.pJsonFile = optarg;
+               break;
+           case 'v':    /*  version */
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+
+    if ((sCfg.noOfPubs == 0u) || (sCfg.noOfPubs > BENCH_MAX_PUBS) ||
+        (sCfg.noOfSubs == 0u) || (sCfg.noOfSubs > BENCH_MAX_SUBS) ||
+        (sCfg.payload < BENCH_HEAD_SIZE) || (sCfg.payload > TRDP_MAX_PD_DATA_SIZE) ||
+        (sCfg.cycle < 250u) || (sCfg.duration == 0u))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    for (i = 0u; i < sCfg.noOfIntervals; i++)
+    {
+        if ((sCfg.interval[i] < sCfg.cycle) ||
+            (sCfg.interval[i] < ((sCfg.indexed == TRUE) ? TRDP_TIMER_GRANULARITY_INDEXED : TRDP_TIMER_GRANULARITY)))
+        {
+            fprintf(stderr, "interval %uus is shorter than the process cycle or the timer granularity\n",
+                    sCfg.interval[i]);
+            return 1;
+        }
+    }
+
+    sSample = (UINT32 *) malloc(BENCH_MAX_SAMPLES * sizeof(UINT32));
+    if ((sSample == NULL) || (tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR))
+    {
+        fprintf(stderr, "initialisation failed\n");
+        return 1;
+    }
+
+    if (benchSetup() == 0)
+    {
+        /*  Warm up, then measure   */
+        vos_getNanoTime(&now);
+        benchLoop(now + (UINT64) sCfg.warmUp * 1000000u);
+
+        for (i = 0u; i < sCfg.noOfSubs; i++)
+        {
+            if (sPubSession[i] != NULL)
+            {
+                (void) tlc_resetStatistics(sPubSession[i]);
+            }
+            if (sSubSession[i] != NULL)
+            {
+                (void) tlc_resetStatistics(sSubSession[i]);
+            }
+        }
+        benchCpuTime(&cpuUser, &cpuSystem);
+        vos_getNanoTime(&start);
+        VOS_ATOMIC_STORE(&sMeasuring, 1u);
+
+        benchLoop(start + (UINT64) sCfg.duration * 1000000000u);
+
+        VOS_ATOMIC_STORE(&sMeasuring, 0u);
+        vos_getNanoTime(&end);
+        benchCpuTime(&result.cpuUser, &result.cpuSystem);
+        result.time         = end - start;
+        result.cpuUser      -= cpuUser;
+        result.cpuSystem    -= cpuSystem;
+        benchCollect(&result);
+        rv = 0;
+    }
+
+    for (i = 0u; i < sCfg.noOfSubs; i++)
+    {
+        if (sPubSession[i] != NULL)
+        {
+            (void) tlc_closeSession(sPubSession[i]);
+        }
+        if (sSubSession[i] != NULL)
+        {
+            (void) tlc_closeSession(sSubSession[i]);
+        }
+    }
+    (void) tlc_terminate();
+    if (rv == 0)
+    {
+        benchReport(&result);
+    }
+    free(sSample);
+    free(sPub);
+    free(sSub);
+    free(sComIdMap);
+    return rv;
+}
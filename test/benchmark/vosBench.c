@@ -0,0 +1,791 @@
+/**********************************************************************************************************************/
+/**
+ * @file            vosBench.c
+ *
+ * @brief           VOS micro benchmarks
+ *
+ * @details         Times the VOS primitives the hot paths of the stack depend on: CRC, memory pool, queues, mutexes,
+ *                  time and UDP sockets. Every case is calibrated to a batch of operations taking the sample time,
+ *                  the batch is repeated and min, median, mean, standard deviation and max of the time per operation
+ *                  are written as JSON. With multiple threads an operation of every thread counts.
+ *                  A former result can be given as baseline: every case is compared by its median and the program
+ *                  fails if one got slower than the threshold and its median is above the slowest baseline sample,
+ *                  a difference within the spread of the baseline is noise.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      BL 2026-10-18: A regression must exceed the spread (max) of the baseline as well
+ *      BL 2026-10-18: Initial version
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif (defined (WIN32) || defined (WIN64))
+#include "getopt.h"
+#endif
+
+#include "vos_types.h"
+#include "vos_utils.h"
+#include "vos_thread.h"
+#include "vos_mem.h"
+#include "vos_sock.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+#define APP_VERSION             "1.0"
+
+#define BENCH_MAX_REPS          101u                    /**< max. samples per case                                  */
+#define BENCH_MAX_THREADS       8u
+#define BENCH_MAX_CASES         64u                     /**< max. cases of a baseline                               */
+#define BENCH_MAX_NAME          32u
+#define BENCH_MAX_DATA          65536u                  /**< largest CRC or datagram size                           */
+#define BENCH_MEM_SIZE          (8u * 1024u * 1024u)    /**< memory pool                                            */
+#define BENCH_UDP_PORT          17300u                  /**< receiving port of the socket case                      */
+#define BENCH_MAX_SPINS         10000000u               /**< receive polls until a datagram counts as lost          */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+struct BENCH_CASE;
+
+/** Run noOfOps operations of a case and return the time taken [ns], 0 on error */
+typedef UINT64 (*BENCH_FUNC_T)(const struct BENCH_CASE *pCase, UINT32 noOfOps);
+
+/** Operations of a worker thread */
+typedef void (*BENCH_WORK_T)(UINT32 noOfOps);
+
+/** Benchmark case */
+typedef struct BENCH_CASE
+{
+    const char      *pName;
+    BENCH_FUNC_T    pFunc;
+    BENCH_WORK_T    pWork;                              /**< operations of the threads, if threaded                 */
+    UINT32          param;                              /**< data size, no. of threads or queue policy              */
+    UINT32          bytes;                              /**< bytes processed per operation, 0 if none               */
+} BENCH_CASE_T;
+
+/** Median and spread of a case from the baseline */
+typedef struct
+{
+    CHAR8   name[BENCH_MAX_NAME];
+    double  median;
+    double  max;                                        /**< slowest sample, the median if not in the baseline      */
+} BENCH_BASE_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void    dbgOut (void *pRefCon, VOS_LOG_T category, const CHAR8 *pTime, const CHAR8 *pFile, UINT16 LineNumber,
+                const CHAR8 *pMsgStr);
+void    usage (const char *appName);
+UINT64  benchCrc (const BENCH_CASE_T *pCase, UINT32 noOfOps);
+UINT64  benchThreads (const BENCH_CASE_T *pCase, UINT32 noOfOps);
+UINT64  benchQueue (const BENCH_CASE_T *pCase, UINT32 noOfOps);
+UINT64  benchTime (const BENCH_CASE_T *pCase, UINT32 noOfOps);
+UINT64  benchUdp (const BENCH_CASE_T *pCase, UINT32 noOfOps);
+void    workMem (UINT32 noOfOps);
+void    workMutex (UINT32 noOfOps);
+void    benchWorker (void *pArg);
+void    benchEcho (void *pArg);
+double  benchSqrt (double value);
+int     benchReadBaseline (const char *pFileName);
+int     compareDouble (const void *p1, const void *p2);
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static const BENCH_CASE_T cCase[] =
+{
+    {"crc32/16",            benchCrc,       NULL,       16u,                    16u},
+    {"crc32/64",            benchCrc,       NULL,       64u,                    64u},
+    {"crc32/256",           benchCrc,       NULL,       256u,                   256u},
+    {"crc32/1432",          benchCrc,       NULL,       1432u,                  1432u},
+    {"crc32/65536",         benchCrc,       NULL,       65536u,                 65536u},
+    {"sc32/16",             benchCrc,       NULL,       16u,                    16u},
+    {"sc32/64",             benchCrc,       NULL,       64u,                    64u},
+    {"sc32/256",            benchCrc,       NULL,       256u,                   256u},
+    {"sc32/1432",           benchCrc,       NULL,       1432u,                  1432u},
+    {"sc32/65536",          benchCrc,       NULL,       65536u,                 65536u},
+    {"mem/alloc_free/1t",   benchThreads,   workMem,    1u,                     0u},
+    {"mem/alloc_free/2t",   benchThreads,   workMem,    2u,                     0u},
+    {"mem/alloc_free/4t",   benchThreads,   workMem,    4u,                     0u},
+    {"mem/alloc_free/8t",   benchThreads,   workMem,    8u,                     0u},
+    {"queue/pingpong/fifo", benchQueue,     NULL,       VOS_QUEUE_POLICY_FIFO,  0u},
+    {"queue/pingpong/spsc", benchQueue,     NULL,       VOS_QUEUE_POLICY_SPSC,  0u},
+    {"queue/pingpong/mpsc", benchQueue,     NULL,       VOS_QUEUE_POLICY_MPSC,  0u},
+    {"mutex/uncontended",   benchThreads,   workMutex,  1u,                     0u},
+    {"mutex/contended/2t",  benchThreads,   workMutex,  2u,                     0u},
+    {"mutex/contended/4t",  benchThreads,   workMutex,  4u,                     0u},
+    {"mutex/contended/8t",  benchThreads,   workMutex,  8u,                     0u},
+    {"time/getTime",        benchTime,      NULL,       0u,                     0u},
+    {"time/getNanoTime",    benchTime,      NULL,       1u,                     0u},
+    {"sock/udp/64",         benchUdp,       NULL,       64u,                    64u},
+    {"sock/udp/1432",       benchUdp,       NULL,       1432u,                  1432u}
+};
+
+static UINT8            sData[BENCH_MAX_DATA];
+static volatile UINT32  sSink       = 0u;           /**< keeps the compiler from dropping results               */
+static UINT32           sLost       = 0u;           /**< failed allocations, echoes and datagrams not received  */
+
+/*  Threaded cases  */
+static VOS_MUTEX_T      sMutex      = NULL;         /**< mutex of the mutex cases                               */
+static UINT32           sCounter    = 0u;           /**< protected by sMutex                                    */
+static VOS_MUTEX_T      sGate       = NULL;         /**< held by the main thread until all workers are ready   */
+static VOS_SEMA_T       sDone       = NULL;         /**< given by the last worker                               */
+static UINT32           sNoOfReady  = 0u;
+static UINT32           sNoOfDone   = 0u;
+static UINT32           sNoOfWorkers = 0u;
+static BENCH_WORK_T     sWork       = NULL;
+static UINT32           sWorkOps    = 0u;
+
+/*  Queue ping-pong */
+static VOS_QUEUE_T      sPing       = NULL;
+static VOS_QUEUE_T      sPong       = NULL;
+
+static BENCH_BASE_T     sBase[BENCH_MAX_CASES];
+static UINT32           sNoOfBase   = 0u;
+
+/**********************************************************************************************************************/
+
+/* Print errors only */
+void dbgOut (
+    void        *pRefCon,
+    VOS_LOG_T   category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    if (category == VOS_LOG_ERROR)
+    {
+        fprintf(stderr, "%s %s:%d %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool times the VOS primitives (crc, memory, queue, mutex, time and UDP socket).\n"
+           "Arguments are:\n"
+           "-r <n>              samples per case, 3...%u (default 15)\n"
+           "-s <ms>             time of a sample (default 5)\n"
+           "-f <text>           run the cases containing text only\n"
+           "-b <file>           compare with the JSON output of a former run\n"
+           "-t <percent>        a median above the baseline by more and above its max is a regression (default 10)\n"
+           "-l                  list the cases and quit\n"
+           "-j <file>           JSON output (default stdout)\n"
+           "-v                  print version and quit\n"
+           "The exit code is 1 on errors and regressions.\n",
+           BENCH_MAX_REPS);
+}
+
+/**********************************************************************************************************************/
+/** CRC of a buffer: vos_crc32 or vos_sc32 by the case name
+ */
+UINT64 benchCrc (
+    const BENCH_CASE_T  *pCase,
+    UINT32              noOfOps)
+{
+    UINT64  start, end;
+    UINT32  crc = 0xFFFFFFFFu;
+    UINT32  i;
+
+    vos_getNanoTime(&start);
+    if (pCase->pName[0] == 'c')
+    {
+        for (i = 0u; i < noOfOps; i++)
+        {
+            crc ^= vos_crc32(0xFFFFFFFFu, sData, pCase->param);
+        }
+    }
+    else
+    {
+        for (i = 0u; i < noOfOps; i++)
+        {
+            crc ^= vos_sc32(0xFFFFFFFFu, sData, pCase->param);
+        }
+    }
+    vos_getNanoTime(&end);
+    sSink = crc;
+    return end - start;
+}
+
+/**********************************************************************************************************************/
+/** Allocate and free blocks of the sizes used for PD and MD packets
+ */
+void workMem (
+    UINT32 noOfOps)
+{
+    static const UINT32 cSize[] = {64u, 1480u, 180u, 1024u};
+    UINT8               *pBlock;
+    UINT32              i;
+
+    for (i = 0u; i < noOfOps; i++)
+    {
+        pBlock = vos_memAlloc(cSize[i & 3u]);
+        if (pBlock == NULL)
+        {
+            (void) VOS_ATOMIC_ADD(&sLost, 1u);
+            continue;
+        }
+        vos_memFree(pBlock);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Lock a mutex and count
+ */
+void workMutex (
+    UINT32 noOfOps)
+{
+    UINT32 i;
+
+    for (i = 0u; i < noOfOps; i++)
+    {
+        (void) vos_mutexLock(sMutex);
+        sCounter++;
+        (void) vos_mutexUnlock(sMutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Worker thread: wait at the gate, do the work, the last one reports
+ */
+void benchWorker (
+    void *pArg)
+{
+    /*  The globals are changed for the next case as soon as the last worker is done    */
+    UINT32 noOfWorkers = sNoOfWorkers;
+
+    (void) VOS_ATOMIC_ADD(&sNoOfReady, 1u);
+    (void) vos_mutexLock(sGate);
+    (void) vos_mutexUnlock(sGate);
+    sWork(sWorkOps);
+    if (VOS_ATOMIC_ADD(&sNoOfDone, 1u) == noOfWorkers)
+    {
+        vos_semaGive(sDone);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Run the work of a case in param threads, in the calling thread if 1
+ *  The time is taken from opening the gate to the end of the last thread.
+ */
+UINT64 benchThreads (
+    const BENCH_CASE_T  *pCase,
+    UINT32              noOfOps)
+{
+    VOS_THREAD_T    thread;
+    UINT64          start, end;
+    UINT32          i;
+
+    if (pCase->param <= 1u)
+    {
+        vos_getNanoTime(&start);
+        pCase->pWork(noOfOps);
+        vos_getNanoTime(&end);
+        return end - start;
+    }
+
+    sWork           = pCase->pWork;
+    sWorkOps        = (noOfOps + pCase->param - 1u) / pCase->param;
+    sNoOfWorkers    = pCase->param;
+    VOS_ATOMIC_STORE(&sNoOfReady, 0u);
+    VOS_ATOMIC_STORE(&sNoOfDone, 0u);
+    (void) vos_mutexLock(sGate);
+    for (i = 0u; i < pCase->param; i++)
+    {
+        if (vos_threadCreate(&thread, "vosBench", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u, benchWorker, NULL)
+            != VOS_NO_ERR)
+        {
+            /*  The started ones still have to finish   */
+            sNoOfWorkers = i;
+            break;
+        }
+    }
+    while (VOS_ATOMIC_LOAD(&sNoOfReady) < sNoOfWorkers)
+    {
+        (void) vos_threadDelay(100u);
+    }
+    vos_getNanoTime(&start);
+    (void) vos_mutexUnlock(sGate);
+    if (sNoOfWorkers > 0u)
+    {
+        (void) vos_semaTake(sDone, VOS_SEMA_WAIT_FOREVER);
+    }
+    vos_getNanoTime(&end);
+    return (sNoOfWorkers == pCase->param) ? (end - start) : 0u;
+}
+
+/**********************************************************************************************************************/
+/** Echo thread of the queue ping-pong
+ */
+void benchEcho (
+    void *pArg)
+{
+    UINT8   *pData;
+    UINT32  size;
+    UINT32  i;
+    UINT32  noOfOps = *(UINT32 *) pArg;
+
+    for (i = 0u; i < noOfOps; i++)
+    {
+        if ((vos_queueReceive(sPing, &pData, &size, 1000000u) != VOS_NO_ERR)
+            || (vos_queueSend(sPong, pData, size) != VOS_NO_ERR))
+        {
+            sLost++;
+            break;
+        }
+    }
+    vos_semaGive(sDone);
+}
+
+/**********************************************************************************************************************/
+/** Send a message to an echo thread and wait for it to come back
+ */
+UINT64 benchQueue (
+    const BENCH_CASE_T  *pCase,
+    UINT32              noOfOps)
+{
+    VOS_THREAD_T    thread;
+    UINT64          start, end;
+    UINT8           *pData;
+    UINT32          size;
+    UINT32          i;
+    UINT64          result = 0u;
+
+    if ((vos_queueCreate((VOS_QUEUE_POLICY_T) pCase->param, 16u, &sPing) != VOS_NO_ERR)
+        || (vos_queueCreate((VOS_QUEUE_POLICY_T) pCase->param, 16u, &sPong) != VOS_NO_ERR))
+    {
+        fprintf(stderr, "vos_queueCreate failed\n");
+    }
+    else if (vos_threadCreate(&thread, "vosBenchEcho", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u, benchEcho, &noOfOps)
+             == VOS_NO_ERR)
+    {
+        vos_getNanoTime(&start);
+        for (i = 0u; i < noOfOps; i++)
+        {
+            if ((vos_queueSend(sPing, sData, sizeof(UINT32)) != VOS_NO_ERR)
+                || (vos_queueReceive(sPong, &pData, &size, 1000000u) != VOS_NO_ERR))
+            {
+                break;
+            }
+        }
+        vos_getNanoTime(&end);
+        /*  The echo thread must have left the queues before they are destroyed    */
+        (void) vos_semaTake(sDone, VOS_SEMA_WAIT_FOREVER);
+        result = (i == noOfOps) ? (end - start) : 0u;
+    }
+    if (sPing != NULL)
+    {
+        (void) vos_queueDestroy(sPing);
+    }
+    if (sPong != NULL)
+    {
+        (void) vos_queueDestroy(sPong);
+    }
+    sPing   = NULL;
+    sPong   = NULL;
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Read the clock: vos_getTime or vos_getNanoTime
+ */
+UINT64 benchTime (
+    const BENCH_CASE_T  *pCase,
+    UINT32              noOfOps)
+{
+    VOS_TIMEVAL_T   tv;
+    UINT64          start, end, now;
+    UINT32          sum = 0u;
+    UINT32          i;
+
+    vos_getNanoTime(&start);
+    if (pCase->param == 0u)
+    {
+        for (i = 0u; i < noOfOps; i++)
+        {
+            vos_getTime(&tv);
+            sum += (UINT32) tv.tv_usec;
+        }
+    }
+    else
+    {
+        for (i = 0u; i < noOfOps; i++)
+        {
+            vos_getNanoTime(&now);
+            sum += (UINT32) now;
+        }
+    }
+    vos_getNanoTime(&end);
+    sSink = sum;
+    return end - start;
+}
+
+/**********************************************************************************************************************/
+/** Send a datagram to a socket on the loopback interface and receive it
+ */
+UINT64 benchUdp (
+    const BENCH_CASE_T  *pCase,
+    UINT32              noOfOps)
+{
+    VOS_SOCK_OPT_T  opts;
+    SOCKET          txSock  = VOS_INVALID_SOCKET;
+    SOCKET          rxSock  = VOS_INVALID_SOCKET;
+    UINT32          loopback = vos_dottedIP("127.0.0.1");
+    UINT8           buffer[BENCH_MAX_DATA];
+    UINT64          start, end;
+    UINT64          result  = 0u;
+    UINT32          size;
+    UINT32          srcIP;
+    UINT16          srcPort;
+    UINT32          spins;
+    UINT32          i;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.ttl            = 64u;
+    opts.reuseAddrPort  = TRUE;
+    opts.nonBlocking    = TRUE;
+    if ((vos_sockOpenUDP(&rxSock, &opts) != VOS_NO_ERR)
+        || (vos_sockBind(rxSock, loopback, BENCH_UDP_PORT) != VOS_NO_ERR)
+        || (vos_sockOpenUDP(&txSock, &opts) != VOS_NO_ERR)
+        || (vos_sockBind(txSock, loopback, 0u) != VOS_NO_ERR))
+    {
+        fprintf(stderr, "UDP sockets failed\n");
+    }
+    else
+    {
+        vos_getNanoTime(&start);
+        for (i = 0u; i < noOfOps; i++)
+        {
+            size = pCase->param;
+            if (vos_sockSendUDP(txSock, sData, &size, loopback, BENCH_UDP_PORT) != VOS_NO_ERR)
+            {
+                break;
+            }
+            for (spins = 0u; spins < BENCH_MAX_SPINS; spins++)
+            {
+                size = sizeof(buffer);
+                if (vos_sockReceiveUDP(rxSock, buffer, &size, &srcIP, &srcPort, NULL, NULL, FALSE) != VOS_BLOCK_ERR)
+                {
+                    break;
+                }
+            }
+            if (spins == BENCH_MAX_SPINS)
+            {
+                sLost++;
+            }
+        }
+        vos_getNanoTime(&end);
+        result = (i == noOfOps) ? (end - start) : 0u;
+    }
+    if (txSock != VOS_INVALID_SOCKET)
+    {
+        (void) vos_sockClose(txSock);
+    }
+    if (rxSock != VOS_INVALID_SOCKET)
+    {
+        (void) vos_sockClose(rxSock);
+    }
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Square root by Newton's method, the benchmark does not depend on libm
+ */
+double benchSqrt (
+    double value)
+{
+    double  root = value;
+    int     i;
+
+    if (value <= 0.0)
+    {
+        return 0.0;
+    }
+    for (i = 0; i < 64; i++)
+    {
+        root = 0.5 * (root + value / root);
+    }
+    return root;
+}
+
+/**********************************************************************************************************************/
+/** Read the medians and maxima of a former run
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int benchReadBaseline (
+    const char *pFileName)
+{
+    char    line[512];
+    FILE    *fp = fopen(pFileName, "r");
+
+    if (fp == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", pFileName);
+        return 1;
+    }
+    while ((sNoOfBase < BENCH_MAX_CASES) && (fgets(line, sizeof(line), fp) != NULL))
+    {
+        const char *pName   = strstr(line, "\"name\": \"");
+        const char *pMedian = strstr(line, "\"median\": ");
+        const char *pMax    = strstr(line, "\"max\": ");
+
+        if ((pName != NULL) && (pMedian != NULL)
+            && (sscanf(pName, "\"name\": \"%31[^\"]\"", sBase[sNoOfBase].name) == 1)
+            && (sscanf(pMedian, "\"median\": %lf", &sBase[sNoOfBase].median) == 1))
+        {
+            if ((pMax == NULL) || (sscanf(pMax, "\"max\": %lf", &sBase[sNoOfBase].max) != 1)
+                || (sBase[sNoOfBase].max < sBase[sNoOfBase].median))
+            {
+                sBase[sNoOfBase].max = sBase[sNoOfBase].median;
+            }
+            sNoOfBase++;
+        }
+    }
+    fclose(fp);
+    return (sNoOfBase == 0u) ? 1 : 0;
+}
+
+/**********************************************************************************************************************/
+
+int compareDouble (const void *p1, const void *p2)
+{
+    double  v1  = *(const double *) p1;
+    double  v2  = *(const double *) p2;
+
+    return (v1 < v2) ? -1 : ((v1 > v2) ? 1 : 0);
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error or regression
+ */
+int main (int argc, char * *argv)
+{
+    double          sample[BENCH_MAX_REPS];
+    unsigned int    value;
+    UINT32          noOfReps    = 15u;
+    UINT32          sampleTime  = 5u;
+    double          threshold   = 10.0;
+    const char      *pFilter    = NULL;
+    const char      *pBaseFile  = NULL;
+    const char      *pJsonFile  = NULL;
+    const char      *pSep       = "";
+    UINT32          noOfRegressions = 0u;
+    UINT32          i, j;
+    int             ch;
+    int             rv = 0;
+    FILE            *out = stdout;
+
+    while ((ch = getopt(argc, argv, "r:s:f:b:t:lj:h?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'r':
+           case 's':
+           case 't':
+               if (sscanf(optarg, "%u", &value) != 1)
+               {
+                   usage(argv[0]);
+                   return 1;
+               }
+               switch (ch)
+               {
+                  case 'r': noOfReps    = value; break;
+                  case 's': sampleTime  = value; break;
+                  default:  threshold   = (double) value; break;
+               }
+               break;
+           case 'f':
+               pFilter = optarg;
+               break;
+           case 'b':
+               pBaseFile = optarg;
+               break;
+           case 'l':
+               for (i = 0u; i < sizeof(cCase) / sizeof(cCase[0]); i++)
+               {
+                   printf("%s\n", cCase[i].pName);
+               }
+               return 0;
+           case 'j':
+               pJsonFile = optarg;
+               break;
+           case 'v':    /*  version */
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+
+    if ((noOfReps < 3u) || (noOfReps > BENCH_MAX_REPS) || (sampleTime == 0u))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    if ((pBaseFile != NULL) && (benchReadBaseline(pBaseFile) != 0))
+    {
+        fprintf(stderr, "no baseline in %s\n", pBaseFile);
+        return 1;
+    }
+
+    if ((vos_init(NULL, dbgOut) != VOS_NO_ERR)
+        || (vos_memInit(NULL, BENCH_MEM_SIZE, NULL) != VOS_NO_ERR)
+        || (vos_mutexCreate(&sMutex) != VOS_NO_ERR)
+        || (vos_mutexCreate(&sGate) != VOS_NO_ERR)
+        || (vos_semaCreate(&sDone, VOS_SEMA_EMPTY) != VOS_NO_ERR))
+    {
+        fprintf(stderr, "initialisation failed\n");
+        return 1;
+    }
+    for (i = 0u; i < BENCH_MAX_DATA; i++)
+    {
+        sData[i] = (UINT8) (i * 7u);
+    }
+
+    if (pJsonFile != NULL)
+    {
+        out = fopen(pJsonFile, "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", pJsonFile);
+            out = stdout;
+        }
+    }
+    fprintf(out, "{\n  \"benchmark\": \"vos\",\n  \"config\": {\"samples\": %u, \"sample_ms\": %u%s%s%s},\n"
+            "  \"cases\": [\n", noOfReps, sampleTime,
+            (pBaseFile != NULL) ? ", \"baseline\": \"" : "", (pBaseFile != NULL) ? pBaseFile : "",
+            (pBaseFile != NULL) ? "\"" : "");
+
+    for (i = 0u; i < sizeof(cCase) / sizeof(cCase[0]); i++)
+    {
+        const BENCH_CASE_T  *pCase  = &cCase[i];
+        UINT64              target  = (UINT64) sampleTime * 1000000u;
+        UINT64              elapsed = 0u;
+        UINT32              noOfOps = 1u;
+        double              sum     = 0.0;
+        double              var     = 0.0;
+        double              mean, median;
+
+        if ((pFilter != NULL) && (strstr(pCase->pName, pFilter) == NULL))
+        {
+            continue;
+        }
+
+        /*  Calibrate: double the operations until a batch takes a tenth of the sample time, then scale up  */
+        while (noOfOps < (1u << 30))
+        {
+            elapsed = pCase->pFunc(pCase, noOfOps);
+            if ((elapsed == 0u) || (elapsed >= target / 10u))
+            {
+                break;
+            }
+            noOfOps *= 2u;
+        }
+        if (elapsed == 0u)
+        {
+            fprintf(stderr, "%s failed\n", pCase->pName);
+            rv = 1;
+            continue;
+        }
+        if ((UINT64) noOfOps * target / elapsed < (1u << 30))
+        {
+            noOfOps = (UINT32) ((UINT64) noOfOps * target / elapsed);
+        }
+        noOfOps = (noOfOps < 1u) ? 1u : noOfOps;
+
+        for (j = 0u; (j < noOfReps) && (elapsed != 0u); j++)
+        {
+            elapsed     = pCase->pFunc(pCase, noOfOps);
+            sample[j]   = (double) elapsed / (double) noOfOps;
+            sum         += sample[j];
+        }
+        if (elapsed == 0u)
+        {
+            fprintf(stderr, "%s failed\n", pCase->pName);
+            rv = 1;
+            continue;
+        }
+        qsort(sample, noOfReps, sizeof(double), compareDouble);
+        mean    = sum / (double) noOfReps;
+        median  = ((noOfReps & 1u) != 0u) ? sample[noOfReps / 2u]
+                  : (sample[noOfReps / 2u - 1u] + sample[noOfReps / 2u]) / 2.0;
+        for (j = 0u; j < noOfReps; j++)
+        {
+            var += (sample[j] - mean) * (sample[j] - mean);
+        }
+        var /= (double) (noOfReps - 1u);
+
+        fprintf(out, "%s    {\"name\": \"%s\", \"ops\": %u, \"min\": %.2f, \"median\": %.2f, \"mean\": %.2f, "
+                "\"stddev\": %.2f, \"max\": %.2f, \"mops_per_s\": %.3f",
+                pSep, pCase->pName, noOfOps, sample[0], median, mean, benchSqrt(var), sample[noOfReps - 1u],
+                1e3 / median);
+        if (pCase->bytes != 0u)
+        {
+            fprintf(out, ", \"mb_per_s\": %.1f", (double) pCase->bytes * 1e3 / median);
+        }
+        for (j = 0u; j < sNoOfBase; j++)
+        {
+            if ((strcmp(sBase[j].name, pCase->pName) == 0) && (sBase[j].median > 0.0))
+            {
+                double  change      = (median - sBase[j].median) * 100.0 / sBase[j].median;
+                BOOL8   regression  = (change > threshold) && (median > sBase[j].max);
+
+                fprintf(out, ", \"base_median\": %.2f, \"base_max\": %.2f, \"change_pct\": %.1f, \"regression\": %s",
+                        sBase[j].median, sBase[j].max, change, (regression == TRUE) ? "true" : "false");
+                if (regression == TRUE)
+                {
+                    fprintf(stderr, "regression: %s %.2f ns -> %.2f ns (%+.1f%%)\n", pCase->pName,
+                            sBase[j].median, median, change);
+                    noOfRegressions++;
+                }
+                break;
+            }
+        }
+        fprintf(out, "}");
+        pSep = ",\n";
+    }
+    fprintf(out, "\n  ],\n  \"unit\": \"ns per operation\",\n  \"lost\": %u,\n  \"regressions\": %u\n}\n",
+            sLost, noOfRegressions);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    vos_semaDelete(sDone);
+    vos_mutexDelete(sGate);
+    vos_mutexDelete(sMutex);
+    vos_memDelete(NULL);
+    vos_terminate();
+    return ((rv != 0) || (noOfRegressions != 0u)) ? 1 : 0;
+}
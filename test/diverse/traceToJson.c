@@ -0,0 +1,257 @@
+/**********************************************************************************************************************/
+/**
+ * @file            traceToJson.c
+ *
+ * @brief           Convert a TRDP trace dump to JSON
+ *
+ * @details         Reads a file written by tlc_traceDump() and writes it in the Trace Event Format to be loaded
+ *                  into chrome://tracing or Perfetto. Every trace ring (thread) is shown as a track, callbacks
+ *                  as slices from entry to exit, all other events as instants.
+ *                  Dumps of targets with other byte order are accepted.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      BL 2026-10-18: Initial version
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trdp_types.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+#define APP_VERSION     "1.0"
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+/*  Names of the TRDP_TRACE_EVENT_T values  */
+static const char *cEventName[] =
+{
+    "?", "PD receive", "PD send", "PD timeout", "PD callback", "PD callback",
+    "MD receive", "MD send", "MD state", "MD timeout", "MD callback", "MD callback"
+};
+
+static int sSwap = 0;   /* dump has the other byte order */
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void    usage (const char *appName);
+UINT16  swap16 (UINT16 val);
+UINT32  swap32 (UINT32 val);
+UINT64  swap64 (UINT64 val);
+int     readRec (FILE *fp, TRDP_TRACE_REC_T *pRec);
+
+/**********************************************************************************************************************/
+
+UINT16 swap16 (UINT16 val)
+{
+    return (sSwap) ? (UINT16) ((val << 8) | (val >> 8)) : val;
+}
+
+UINT32 swap32 (UINT32 val)
+{
+    if (sSwap)
+    {
+        val = ((val & 0x00FF00FFu) << 8) | ((val >> 8) & 0x00FF00FFu);
+        val = (val << 16) | (val >> 16);
+    }
+    return val;
+}
+
+UINT64 swap64 (UINT64 val)
+{
+    if (sSwap)
+    {
+        val = ((UINT64) swap32((UINT32) val) << 32) | swap32((UINT32) (val >> 32));
+    }
+    return val;
+}
+
+/* Read a record and convert it to host byte order */
+int readRec (FILE *fp, TRDP_TRACE_REC_T *pRec)
+{
+    if (fread(pRec, sizeof(TRDP_TRACE_REC_T), 1u, fp) != 1u)
+    {
+        return 0;
+    }
+    pRec->timeStamp = swap64(pRec->timeStamp);
+    pRec->event     = swap16(pRec->event);
+    pRec->info      = (INT16) swap16((UINT16) pRec->info);
+    pRec->comId     = swap32(pRec->comId);
+    pRec->seqCnt    = swap32(pRec->seqCnt);
+    pRec->srcIpAddr = swap32(pRec->srcIpAddr);
+    pRec->size      = swap32(pRec->size);
+    return 1;
+}
+
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool converts a trace dump written by tlc_traceDump() into the Trace Event Format (JSON).\n"
+           "Arguments are:\n"
+           "<dump file> [<json file>]   (default output: stdout)\n");
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    TRDP_TRACE_FILE_HEAD_T  fileHead;
+    TRDP_TRACE_RING_HEAD_T  ringHead;
+    TRDP_TRACE_REC_T        rec;
+    TRDP_TRACE_REC_T        *pRecs  = NULL;
+    UINT32                  *pRing  = NULL;
+    UINT32                  noOfRecs = 0u;
+    UINT64                  start   = 0u;
+    FILE                    *fp;
+    FILE                    *out    = stdout;
+    UINT32                  i, j;
+    const char              *pSep   = "";
+
+    if (argc < 2)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    fp = fopen(argv[1], "rb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    if (fread(&fileHead, sizeof(fileHead), 1u, fp) != 1u)
+    {
+        fprintf(stderr, "%s: file too short\n", argv[1]);
+        fclose(fp);
+        return 1;
+    }
+    if (fileHead.magic != TRDP_TRACE_MAGIC)
+    {
+        sSwap = 1;
+        if (swap32(fileHead.magic) != TRDP_TRACE_MAGIC)
+        {
+            fprintf(stderr, "%s: not a trace dump\n", argv[1]);
+            fclose(fp);
+            return 1;
+        }
+    }
+    fileHead.version    = swap16(fileHead.version);
+    fileHead.recSize    = swap16(fileHead.recSize);
+    fileHead.noOfRings  = swap32(fileHead.noOfRings);
+    fileHead.noOfLost   = swap32(fileHead.noOfLost);
+    if ((fileHead.version != TRDP_TRACE_VERSION) || (fileHead.recSize != sizeof(TRDP_TRACE_REC_T)))
+    {
+        fprintf(stderr, "%s: unsupported version %u\n", argv[1], fileHead.version);
+        fclose(fp);
+        return 1;
+    }
+
+    /* Read all rings, the time line starts with the oldest record */
+    for (i = 0u; i < fileHead.noOfRings; i++)
+    {
+        if (fread(&ringHead, sizeof(ringHead), 1u, fp) != 1u)
+        {
+            break;
+        }
+        ringHead.ringId     = swap32(ringHead.ringId);
+        ringHead.noOfRecs   = swap32(ringHead.noOfRecs);
+        if (ringHead.noOfRecs == 0u)
+        {
+            continue;
+        }
+        pRecs   = (TRDP_TRACE_REC_T *) realloc(pRecs, (noOfRecs + ringHead.noOfRecs) * sizeof(TRDP_TRACE_REC_T));
+        pRing   = (UINT32 *) realloc(pRing, (noOfRecs + ringHead.noOfRecs) * sizeof(UINT32));
+        if ((pRecs == NULL) || (pRing == NULL))
+        {
+            fprintf(stderr, "out of memory\n");
+            fclose(fp);
+            return 1;
+        }
+        for (j = 0u; (j < ringHead.noOfRecs) && (readRec(fp, &rec) != 0); j++)
+        {
+            if ((noOfRecs == 0u) || (rec.timeStamp < start))
+            {
+                start = rec.timeStamp;
+            }
+            pRecs[noOfRecs] = rec;
+            pRing[noOfRecs] = ringHead.ringId;
+            noOfRecs++;
+        }
+    }
+    fclose(fp);
+
+    if (argc > 2)
+    {
+        out = fopen(argv[2], "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\"traceEvents\":[\n");
+    for (i = 0u; i < noOfRecs; i++)
+    {
+        const TRDP_TRACE_REC_T  *pRec   = &pRecs[i];
+        const char              *pPhase = "i";
+        const char              *pName  = "?";
+
+        if (pRec->event < sizeof(cEventName) / sizeof(cEventName[0]))
+        {
+            pName = cEventName[pRec->event];
+        }
+        if ((pRec->event == TRDP_TRACE_PD_CB_ENTRY) || (pRec->event == TRDP_TRACE_MD_CB_ENTRY))
+        {
+            pPhase = "B";
+        }
+        else if ((pRec->event == TRDP_TRACE_PD_CB_EXIT) || (pRec->event == TRDP_TRACE_MD_CB_EXIT))
+        {
+            pPhase = "E";
+        }
+        fprintf(out, "%s{\"name\":\"%s\",\"ph\":\"%s\",%s\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+                "\"args\":{\"comId\":%u,\"seq\":%u,\"src\":\"%u.%u.%u.%u\",\"size\":%u,\"info\":%d}}",
+                pSep, pName, pPhase, (pPhase[0] == 'i') ? "\"s\":\"t\"," : "",
+                (double) (pRec->timeStamp - start) / 1000.0, pRing[i],
+                pRec->comId, pRec->seqCnt,
+                (pRec->srcIpAddr >> 24) & 0xFFu, (pRec->srcIpAddr >> 16) & 0xFFu,
+                (pRec->srcIpAddr >> 8) & 0xFFu, pRec->srcIpAddr & 0xFFu,
+                pRec->size, pRec->info);
+        pSep = ",\n";
+    }
+    fprintf(out, "\n],\"otherData\":{\"lost\":%u}}\n", fileHead.noOfLost);
+
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    free(pRecs);
+    free(pRing);
+    return 0;
+}
@@ -17,6 +17,8 @@
  *
  * $Id$
  *
+ *      BL 2026-10-18: Asynchronous log output compared with snprintf
+ *      BL 2026-10-18: Function test and benchmark of the lock-free SPSC/MPSC queues
  *      SB 2021-08.09: Ticket #375 Replaced parameters of vos_memCount to prevent alignment issues
  *     AHW 2021-05-06: Ticket #322 Subscriber multicast message routing in multi-home device
  *      AÖ 2019-11-12: Ticket #290: Add support for Virtualization on Windows, changed thread names to unique ones
@@ -27,6 +29,12 @@
 
 static FILE *pLogFile;
 
+/* User messages output by the asynchronous log sink are captured here instead of being printed (UTILS_LOG test) */
+#define LOG_CAPTURE_MAX 16u
+static CHAR8    sLogCapture[LOG_CAPTURE_MAX][VOS_MAX_PRNT_STR_SIZE];
+static UINT32   sLogCaptureCnt;
+static BOOL8    sLogCaptureOn;
+
 /**********************************************************************************************************************/
 /** callback routine for TRDP logging/error output
 *
@@ -49,6 +57,16 @@ void dbgOut(
 {
    const char *catStr[] = { "**Error:", "Warning:", "   Info:", "  Debug:", "        " };
 
+   if ((sLogCaptureOn == TRUE) && (category == VOS_LOG_USR))
+   {
+      if (sLogCaptureCnt < LOG_CAPTURE_MAX)
+      {
+         vos_strncpy(sLogCapture[sLogCaptureCnt], pMsgStr, VOS_MAX_PRNT_STR_SIZE - 1u);
+      }
+      sLogCaptureCnt++;
+      return;
+   }
+
    {
       printf("%s %s %s",
          strrchr(pTime, '-') + 1,
@@ -216,6 +234,238 @@ MEM_ERR_T L3_test_mem_queue()
    return retVal;
 }
 
+/* time stamp in usec, passed as data pointer through the queue to measure the latency */
+static UINT32 queueTimeStamp()
+{
+   VOS_TIMEVAL_T now;
+
+   vos_getTime(&now);
+   return (UINT32)now.tv_sec * 1000000u + (UINT32)now.tv_usec;
+}
+
+VOS_THREAD_FUNC_T queueProducer(void* arguments)
+{
+   TEST_ARGS_QUEUE_T *arg = (TEST_ARGS_QUEUE_T *)arguments;
+   VOS_ERR_T res;
+   UINT32 i;
+
+   for (i = 0; i < arg->noOfMsg; i++)
+   {
+      /* keep the number of queued messages below the window to not flood the log with 'queue full' errors */
+      while ((VOS_ATOMIC_LOAD(arg->pSent) - VOS_ATOMIC_LOAD(arg->pReceived)) >= arg->window)
+      {
+         (void)vos_threadDelay(0);
+      }
+      (void)VOS_ATOMIC_ADD(arg->pSent, 1);
+      /* size carries producer id and sequence number (from 1, size 0 is invalid) to check the order */
+      while ((res = vos_queueSend(arg->queueHeader,
+                                  (UINT8*)(uintptr_t)queueTimeStamp(),
+                                  (arg->producerId << 24) | (i + 1))) == VOS_QUEUE_FULL_ERR)
+      {
+         (void)vos_threadDelay(0);
+      }
+      if (res != VOS_NO_ERR)
+      {
+         arg->result = res;
+         return arguments;
+      }
+   }
+   arg->result = VOS_NO_ERR;
+   return arguments;
+}
+
+/* Throughput and latency of one queue type with noOfProducers sending threads */
+MEM_ERR_T L4_test_mem_queue_bench(VOS_QUEUE_POLICY_T queueType, const CHAR8 *pName, UINT32 noOfProducers)
+{
+   TEST_ARGS_QUEUE_T arg[4];
+   VOS_THREAD_T thread[4];
+   UINT32 expected[4] = { 0, 0, 0, 0 };
+   VOS_QUEUE_T qHandle;
+   VOS_TIMEVAL_T startTime, endTime;
+   VOS_ERR_T res;
+   MEM_ERR_T retVal = MEM_NO_ERR;
+   UINT8 *pData;
+   UINT32 size;
+   UINT32 i;
+   UINT32 received = 0;
+   UINT32 sent = 0;
+   UINT32 latency;
+   UINT32 maxLatency = 0;
+   UINT64 sumLatency = 0;
+   UINT32 usec;
+   const UINT32 noOfMsg = 100000;
+
+   res = vos_queueCreate(queueType, 256, &qHandle);
+   if (res != VOS_NO_ERR)
+   {
+      vos_printLog(VOS_LOG_ERROR, "[MEM_QUEUE_BENCH] %s vos_queueCreate() ERROR: ret: %i\n", pName, res);
+      return MEM_QUEUE_ERR;
+   }
+   vos_getTime(&startTime);
+   for (i = 0; i < noOfProducers; i++)
+   {
+      CHAR8 name[16];
+
+      (void)vos_snprintf(name, sizeof(name), "QProducer%u", (unsigned)i);
+      arg[i].queueHeader = qHandle;
+      arg[i].producerId = i;
+      arg[i].noOfMsg = noOfMsg;
+      arg[i].window = 128;
+      arg[i].pSent = &sent;
+      arg[i].pReceived = &received;
+      arg[i].result = VOS_UNKNOWN_ERR;
+      res = vos_threadCreate(&thread[i], name, THREAD_POLICY, 0, 0, 0, (void*)queueProducer, (void*)&arg[i]);
+      if (res != VOS_NO_ERR)
+      {
+         vos_printLog(VOS_LOG_ERROR, "[MEM_QUEUE_BENCH] %s vos_threadCreate() ERROR: ret: %i\n", pName, res);
+         arg[i].result = res;
+         retVal = MEM_QUEUE_ERR;
+      }
+   }
+   while ((retVal == MEM_NO_ERR) && (received < noOfProducers * noOfMsg))
+   {
+      res = vos_queueReceive(qHandle, &pData, &size, 1000000);
+      if (res != VOS_NO_ERR)
+      {
+         vos_printLog(VOS_LOG_ERROR, "[MEM_QUEUE_BENCH] %s vos_queueReceive() ERROR after %u msgs\n", pName, received);
+         retVal = MEM_QUEUE_ERR;
+         break;
+      }
+      latency = queueTimeStamp() - (UINT32)(uintptr_t)pData;
+      sumLatency += latency;
+      if (latency > maxLatency)
+      {
+         maxLatency = latency;
+      }
+      if (((size >> 24) >= noOfProducers) || ((size & 0xFFFFFF) != expected[size >> 24] + 1))
+      {
+         vos_printLog(VOS_LOG_ERROR, "[MEM_QUEUE_BENCH] %s message order ERROR (%x)\n", pName, size);
+         retVal = MEM_QUEUE_ERR;
+         break;
+      }
+      expected[size >> 24]++;
+      VOS_ATOMIC_STORE(&received, received + 1);
+   }
+   vos_getTime(&endTime);
+
+   /* wait for the producers to finish before the queue is destroyed */
+   for (i = 0; i < noOfProducers; i++)
+   {
+      UINT32 wait = 0;
+
+      while ((arg[i].result == VOS_UNKNOWN_ERR) && (wait++ < 2000))
+      {
+         (void)vos_threadDelay(1000);
+      }
+      if (arg[i].result != VOS_NO_ERR)
+      {
+         vos_printLog(VOS_LOG_ERROR, "[MEM_QUEUE_BENCH] %s producer %u ERROR: ret: %i\n", pName, i, arg[i].result);
+         retVal = MEM_QUEUE_ERR;
+      }
+   }
+   (void)vos_threadDelay(10000);
+   res = vos_queueDestroy(qHandle);
+   if (res != VOS_NO_ERR)
+   {
+      vos_printLog(VOS_LOG_ERROR, "[MEM_QUEUE_BENCH] %s vos_queueDestroy() ERROR\n", pName);
+      retVal = MEM_QUEUE_ERR;
+   }
+
+   vos_subTime(&endTime, &startTime);
+   usec = (UINT32)endTime.tv_sec * 1000000u + (UINT32)endTime.tv_usec;
+   vos_printLog(VOS_LOG_USR, "[MEM_QUEUE_BENCH] %-4s %u producer(s): %u msgs in %u us = %u msgs/s, latency avg %u us, max %u us\n",
+                pName, noOfProducers, received, usec,
+                (usec != 0) ? (UINT32)(((UINT64)received * 1000000u) / usec) : 0,
+                (received != 0) ? (UINT32)(sumLatency / received) : 0,
+                maxLatency);
+   return retVal;
+}
+
+/* Function test of the lock-free queues and comparison with the mutex based FIFO */
+MEM_ERR_T L3_test_mem_queue_lockfree()
+{
+   VOS_QUEUE_POLICY_T types[2] = { VOS_QUEUE_POLICY_SPSC, VOS_QUEUE_POLICY_MPSC };
+   VOS_QUEUE_T qHandle;
+   MEM_ERR_T retVal = MEM_NO_ERR;
+   VOS_ERR_T res = VOS_NO_ERR;
+   UINT8 *pData;
+   UINT32 size;
+   UINT32 t, i;
+
+   vos_printLogStr(VOS_LOG_USR, "[MEM_QUEUE_LOCKFREE] start...\n");
+   (void)vos_threadInit();
+   for (t = 0; t < 2; t++)
+   {
+      /* 3 is rounded up to 4 cells */
+      res = vos_queueCreate(types[t], 3, &qHandle);
+      if (res != VOS_NO_ERR)
+      {
+         vos_printLog(VOS_LOG_ERROR, "[MEM_QUEUE_LOCKFREE] vos_queueCreate(%u) ERROR: ret: %i\n", types[t], res);
+         retVal = MEM_QUEUE_ERR;
+         continue;
+      }
+      for (i = 0; i < 4; i++)
+      {
+         res = vos_queueSend(qHandle, (UINT8*)(uintptr_t)(0x1000 + i), i + 1);
+         if (res != VOS_NO_ERR)
+         {
+            vos_printLog(VOS_LOG_ERROR, "[MEM_QUEUE_LOCKFREE] %u.queueSend() ERROR\n", i + 1);
+            retVal = MEM_QUEUE_ERR;
+         }
+      }
+      res = vos_queueSend(qHandle, (UINT8*)0xCDEF, 0x78); /* error expected because queue is full */
+      if (res != VOS_QUEUE_FULL_ERR)
+      {
+         vos_printLogStr(VOS_LOG_ERROR, "[MEM_QUEUE_LOCKFREE] 5.queueSend() ERROR\n");
+         retVal = MEM_QUEUE_ERR;
+      }
+      for (i = 0; i < 4; i++)
+      {
+         res = vos_queueReceive(qHandle, &pData, &size, 0);
+         if ((res != VOS_NO_ERR) || (pData != (UINT8*)(uintptr_t)(0x1000 + i)) || (size != i + 1))
+         {
+            vos_printLog(VOS_LOG_ERROR, "[MEM_QUEUE_LOCKFREE] %u.queueReceive() ERROR\n", i + 1);
+            retVal = MEM_QUEUE_ERR;
+         }
+      }
+      res = vos_queueReceive(qHandle, &pData, &size, 20000); /* error expected because queue is empty */
+      if ((res != VOS_QUEUE_ERR) || (pData != NULL) || (size != 0))
+      {
+         vos_printLogStr(VOS_LOG_ERROR, "[MEM_QUEUE_LOCKFREE] 5.queueReceive() ERROR\n");
+         retVal = MEM_QUEUE_ERR;
+      }
+      res = vos_queueDestroy(qHandle);
+      if (res != VOS_NO_ERR)
+      {
+         vos_printLogStr(VOS_LOG_ERROR, "[MEM_QUEUE_LOCKFREE] vos_queueDestroy() ERROR\n");
+         retVal = MEM_QUEUE_ERR;
+      }
+   }
+
+   /* throughput and latency */
+   retVal |= L4_test_mem_queue_bench(VOS_QUEUE_POLICY_FIFO, "FIFO", 1);
+   retVal |= L4_test_mem_queue_bench(VOS_QUEUE_POLICY_SPSC, "SPSC", 1);
+   retVal |= L4_test_mem_queue_bench(VOS_QUEUE_POLICY_FIFO, "FIFO", 4);
+   retVal |= L4_test_mem_queue_bench(VOS_QUEUE_POLICY_MPSC, "MPSC", 4);
+
+   {
+      VOS_MEM_STATISTICS_T memStatistics;
+
+      vos_memCount(&memStatistics);
+      if (memStatistics.total != RESERVED_MEMORY
+         || memStatistics.free != RESERVED_MEMORY
+         || memStatistics.numAllocBlocks != 0
+         || memStatistics.numAllocErr != 0
+         || memStatistics.numFreeErr != 0)
+      {
+         vos_printLogStr(VOS_LOG_ERROR, "[MEM_QUEUE_LOCKFREE] vos_memFree() error\n");
+         retVal = MEM_QUEUE_ERR;
+      }
+   }
+   vos_printLog(VOS_LOG_USR, "[MEM_QUEUE_LOCKFREE] finished with errcnt = %i\n", retVal);
+   return retVal;
+}
+
 int compareuints(const void * a, const void * b)
 {
    return ( *(UINT8*)a - *(UINT8*)b);
@@ -2366,6 +2616,87 @@ UTILS_ERR_T L3_test_utils_CRC()
    return retVal;
 }
 
+/* Log a message through the asynchronous sink and format the expected output with snprintf */
+#define LOG_ASYNC_EXPECT(format, ...)                                                  \
+   {  vos_printLog(VOS_LOG_USR, format, __VA_ARGS__);                                  \
+      if (cnt < LOG_CAPTURE_MAX)                                                       \
+      {  (void) snprintf(expected[cnt], VOS_MAX_PRNT_STR_SIZE, format, __VA_ARGS__); } \
+      cnt++;                                                                           \
+   }
+
+UTILS_ERR_T L3_test_utils_logAsync()
+{
+   UTILS_ERR_T retVal = UTILS_NO_ERR;
+   CHAR8 expected[LOG_CAPTURE_MAX][VOS_MAX_PRNT_STR_SIZE];
+   CHAR8 longStr[VOS_LOG_ASYNC_ARG_SIZE + 64u];
+   UINT32 cnt = 0u;
+   UINT32 i;
+
+   vos_printLogStr(VOS_LOG_USR, "[UTILS_LOG] start...\n");
+   memset(expected, 0, sizeof(expected));
+   memset(sLogCapture, 0, sizeof(sLogCapture));
+   for (i = 0u; i < sizeof(longStr) - 1u; i++)
+   {
+      longStr[i] = (CHAR8) ('a' + (i % 26u));
+   }
+   longStr[sizeof(longStr) - 1u] = '\0';
+
+   if (vos_logAsyncStart(LOG_CAPTURE_MAX) != VOS_NO_ERR)
+   {
+      vos_printLogStr(VOS_LOG_ERROR, "[UTILS_LOG] vos_logAsyncStart failed\n");
+      return UTILS_LOG_ERR;
+   }
+   sLogCaptureCnt = 0u;
+   sLogCaptureOn = TRUE;
+
+   /* the output must equal snprintf for the supported conversions */
+   LOG_ASYNC_EXPECT("%*d|%-*d|%0*x\n", 8, -42, 6, 7, 4, 0xab);
+   LOG_ASYNC_EXPECT("%.*s|%*.*s|%.2s\n", 3, "abcdef", 6, 2, "xyz", "uvw");
+   LOG_ASYNC_EXPECT("%llu %lld %lx\n", 18446744073709551615ULL, -9223372036854775807LL, 0x12345678L);
+   LOG_ASYNC_EXPECT("%zu %zx\n", (size_t) 123456789u, (size_t) 0xbeefu);
+   LOG_ASYNC_EXPECT("100%% %d%% %s\n", 50, "%d");
+   LOG_ASYNC_EXPECT("%c%5.2f %p\n", 'x', 3.14159, (void *) &cnt);
+
+   /* strings are truncated to the argument space of a message */
+   vos_printLog(VOS_LOG_USR, "[%s]\n", longStr);
+   (void) snprintf(expected[cnt++], VOS_MAX_PRNT_STR_SIZE, "[%.*s]\n",
+                   (int) (VOS_LOG_ASYNC_ARG_SIZE - 1u), longStr);
+
+   /* arguments which do not fit are replaced by "..." */
+   vos_printLog(VOS_LOG_USR, "%s|%d\n", longStr, 7);
+   (void) snprintf(expected[cnt++], VOS_MAX_PRNT_STR_SIZE, "%.*s|...\n",
+                   (int) (VOS_LOG_ASYNC_ARG_SIZE - 1u), longStr);
+
+   /* pending messages are output on stop */
+   vos_logAsyncStop();
+   sLogCaptureOn = FALSE;
+
+   if (sLogCaptureCnt != cnt)
+   {
+      vos_printLog(VOS_LOG_ERROR, "[UTILS_LOG] %u messages output, %u expected\n", sLogCaptureCnt, cnt);
+      retVal = UTILS_LOG_ERR;
+   }
+   for (i = 0u; (i < cnt) && (i < sLogCaptureCnt); i++)
+   {
+      if (strcmp(sLogCapture[i], expected[i]) != 0)
+      {
+         vos_printLog(VOS_LOG_ERROR, "[UTILS_LOG] message %u: \"%s\" expected \"%s\"\n",
+                      i, sLogCapture[i], expected[i]);
+         retVal = UTILS_LOG_ERR;
+      }
+   }
+
+   if (retVal == UTILS_NO_ERR)
+   {
+      vos_printLogStr(VOS_LOG_USR, "[UTILS_LOG] finished OK\n");
+   }
+   else
+   {
+      vos_printLogStr(VOS_LOG_ERROR, "[UTILS_LOG] finished ERROR\n");
+   }
+   return retVal;
+}
+
 UTILS_ERR_T L3_test_utils_terminate()
 {
    /* tested with debugger, it's ok although vos_memDelete() has internal error, but that's because vos_memDelete() has been
@@ -2384,6 +2715,7 @@ MEM_ERR_T L2_test_mem()
    errcnt += L3_test_mem_count();
    errcnt += L3_test_mem_alloc();
    errcnt += L3_test_mem_queue();
+   errcnt += L3_test_mem_queue_lockfree();
    errcnt += L3_test_mem_help();
    errcnt += L3_test_mem_delete();
    vos_printLogStr(VOS_LOG_USR, "*********************************************************************\n");
@@ -2460,6 +2792,7 @@ UTILS_ERR_T L2_test_utils()
    vos_printLogStr(VOS_LOG_USR, "*********************************************************************\n");
    errcnt += L3_test_utils_init();
    errcnt += L3_test_utils_CRC();
+   errcnt += L3_test_utils_logAsync();
    errcnt += L3_test_utils_terminate();
    vos_printLogStr(VOS_LOG_USR, "*********************************************************************\n");
    vos_printLog(VOS_LOG_USR, "*   [UTILS] Test finished with errcnt = %i\n", errcnt);
@@ -2749,6 +3082,15 @@ void L1_testEvaluation(MEM_ERR_T memErr, THREAD_ERR_T threadErr, SOCK_ERR_T sock
       vos_printLogStr(VOS_LOG_USR, "[OK] ");
    }
    vos_printLogStr(VOS_LOG_USR, " UTILS_CRC\n");
+   if (utilsErr& UTILS_LOG_ERR)
+   {
+      vos_printLogStr(VOS_LOG_ERROR, "[ERR]");
+   }
+   else
+   {
+      vos_printLogStr(VOS_LOG_USR, "[OK] ");
+   }
+   vos_printLogStr(VOS_LOG_USR, " UTILS_LOG\n");
    if (utilsErr& UTILS_TERMINATE_ERR)
    {
       vos_printLogStr(VOS_LOG_ERROR, "[ERR]");
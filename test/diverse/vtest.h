@@ -106,7 +106,8 @@ typedef enum
     UTILS_INIT_ERR      = 1,
     UTILS_CRC_ERR       = 2,
     UTILS_TERMINATE_ERR = 4,
-    UTILS_ALL_ERR       = 7
+    UTILS_LOG_ERR       = 8,
+    UTILS_ALL_ERR       = 15
 } UTILS_ERR_T;
 
 UINT32 gTestIP = 0;
@@ -133,6 +134,16 @@ typedef struct arg_struct_thread {
     VOS_ERR_T result;
 }TEST_ARGS_THREAD_T;
 
+typedef struct arg_struct_queue {
+    VOS_QUEUE_T queueHeader;
+    UINT32 producerId;
+    UINT32 noOfMsg;
+    UINT32 window;
+    UINT32 *pSent;
+    UINT32 *pReceived;
+    VOS_ERR_T result;
+}TEST_ARGS_QUEUE_T;
+
 typedef struct arg_struct_shmem {
     UINT32 size;
     UINT32 content;
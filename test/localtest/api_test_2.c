@@ -18,6 +18,21 @@
  *
  * $Id$
  *
+ *      BL 2026-10-18: test37: PD timing histograms, jitter and deviation after a cyclic run and after reset
+ *      BL 2026-10-18: test36: MD listener dispatch, overlapping comId, URI and wildcard listeners
+ *      BL 2026-10-18: test33...35: PD callback dispatch: order per comId, unsubscribe while queued, full queue
+ *      BL 2026-10-18: test32: session table limit
+ *      BL 2026-10-18: test31: PD statistics counters of the processing contexts
+ *      BL 2026-10-18: test30: burst profile of the indexed transmit tables
+ *      BL 2026-10-18: test29: batched notifications
+ *      BL 2026-10-18: test28: MD completion queue
+ *      BL 2026-10-18: test27: mixed indexed and non-indexed sessions
+ *      BL 2026-10-18: test22: jitter bounds checked with -j only
+ *      BL 2026-10-18: test26: MD session IDs unique and well-formed, vos_getUuid() from concurrent threads
+ *      BL 2026-10-18: test25: pipelined and partially received TCP MD messages
+ *      BL 2026-10-18: test24: borrowed MD buffers
+ *      BL 2026-10-18: test23: concurrent large TCP MD requests on one connection
+ *      BL 2026-10-18: test22: sub-millisecond base cycle, inter-arrival jitter
  *      SB 2021-08-09: Compiler warnings
  *      BL 2020-08-18: Output changed, Version info...
  *      BL 2019-08-23: Init macro changed for High Performance mode, cycle time is 3rd parm
@@ -58,6 +73,7 @@ typedef int (test_func_t)(void);
 UINT32      gDestMC = 0xEF000202u;
 int         gFailed;
 int         gFullLog = FALSE;
+int         gStrictTiming = FALSE;  /* -j: enforce the jitter bounds of timing tests (real-time host) */
 VOS_LOG_T   gCatMask = 0;
 
 static FILE *gFp = NULL;
@@ -587,6 +603,7 @@ static void usage (const char *appName)
            "-i <second IP address> (default 10.0.1.101)\n"
            "-t <destination MC> (default 239.0.1.1)\n"
            "-m number of test to run (1...n, default 0 = run all tests)\n"
+           "-j enforce the inter-arrival jitter bound of test22 (needs a real-time capable, idle host)\n"
            "-v print version and quit\n"
            "-h this list\n"
            );
@@ -3489,6 +3506,2293 @@ static int test21 ()
 }
 
 
+/**********************************************************************************************************************/
+/** Sub-millisecond transmit cycles (High Performance)
+ *  A 250us telegram is sent with a base cycle of 250us, the inter-arrival times are measured on the receiving side.
+ *  The jitter bounds are only checked with -j.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST22_CYCLE_TIME           250u            /* 250us base cycle */
+#define TEST22_COMID                22000u
+#define TEST22_SAMPLES              4000u
+
+static UINT32           gTest22NoOfSamples = 0u;
+static VOS_TIMEVAL_T    gTest22Arrival[TEST22_SAMPLES];
+static UINT32           gTest22Interval[TEST22_SAMPLES];
+
+static void  test22CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) &&
+        (pMsg->comId == TEST22_COMID) &&
+        (gTest22NoOfSamples < TEST22_SAMPLES))
+    {
+        vos_getTime(&gTest22Arrival[gTest22NoOfSamples]);
+        gTest22NoOfSamples++;
+    }
+}
+
+static int test22CompareInterval (
+    const void  *pA,
+    const void  *pB)
+{
+    UINT32  a   = *(const UINT32 *) pA;
+    UINT32  b   = *(const UINT32 *) pB;
+
+    return (a > b) - (a < b);
+}
+
+static int test22 ()
+{
+    PREPARE2("Sub-millisecond PD cycles, inter-arrival jitter", "test", TEST22_CYCLE_TIME);
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        UINT8               data[64] = "Hello fast World!";
+        UINT32              noOfIntervals;
+        UINT32              inBand  = 0u;
+        UINT64              sum     = 0u;
+        UINT32              mean;
+        UINT32              i;
+
+        TRDP_PD_CONFIG_T    pdConfig = {test22CBFunction, NULL,
+                                        TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                                        100000u, TRDP_TO_SET_TO_ZERO, 0};
+
+        TRDP_IDX_TABLE_T    indexTableSizes = {
+            100,            /**< Max. number of expected subscriptions with intervals <= 100ms  */
+            200,            /**< Max. number of expected subscriptions with intervals <= 1000ms */
+            10,             /**< Max. number of expected subscriptions with intervals > 1000ms  */
+            100,            /**< Max. number of expected publishers with intervals <= 100ms     */
+            15,             /**< depth / overlapped publishers with intervals <= 100ms          */
+            200,            /**< Max. number of expected publishers with intervals <= 1000ms    */
+            15,             /**< depth / overlapped publishers with intervals <= 1000ms         */
+            10,             /**< Max. number of expected publishers with intervals <= 10000ms   */
+            5,              /**< depth / overlapped publishers with intervals <= 10000ms        */
+            10,             /**< Max. number of expected publishers with intervals > 10000ms    */
+            TEST22_CYCLE_TIME   /**< base transmit cycle [us]                                   */
+        };
+
+        gTest22NoOfSamples = 0u;
+
+        err = tlc_configSession(gSession2.appHandle, NULL, &pdConfig, NULL, NULL);
+        IF_ERROR("tlc_configSession 2");
+
+        err = tlc_presetIndexSession(gSession1.appHandle, &indexTableSizes);
+        IF_ERROR("tlc_presetIndexSession 1");
+
+        err = tlc_presetIndexSession(gSession2.appHandle, &indexTableSizes);
+        IF_ERROR("tlc_presetIndexSession 2");
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, 0u,
+                          TEST22_COMID, 0u, 0u,
+                          0u,
+                          gSession2.ifaceIP,
+                          TEST22_CYCLE_TIME,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL,
+                            0u,
+                            TEST22_COMID, 0u, 0u,
+                            0u, 0u,
+                            0u,
+                            TRDP_FLAGS_DEFAULT, NULL,
+                            100000u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        err = tlc_updateSession(gSession1.appHandle);
+        IF_ERROR("tlc_updateSession 1");
+
+        err = tlc_updateSession(gSession2.appHandle);
+        IF_ERROR("tlc_updateSession 2");
+
+        fprintf(gFp, "Transmission is going on...\n");
+        for (i = 0u; (i < 40u) && (gTest22NoOfSamples < TEST22_SAMPLES); i++)
+        {
+            vos_threadDelay(100000u);
+        }
+        fprintf(gFp, "...transmission is finished, %u telegrams received\n", gTest22NoOfSamples);
+
+        if (gTest22NoOfSamples < TEST22_SAMPLES / 2u)
+        {
+            FAILED("too few telegrams received");
+        }
+
+        /* Skip the first 100 telegrams, sender and receiver threads are still settling */
+        noOfIntervals = 0u;
+        for (i = 101u; i < gTest22NoOfSamples; i++)
+        {
+            VOS_TIMEVAL_T diff = gTest22Arrival[i];
+
+            vos_subTime(&diff, &gTest22Arrival[i - 1u]);
+            gTest22Interval[noOfIntervals] = (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+            sum += gTest22Interval[noOfIntervals];
+            if ((gTest22Interval[noOfIntervals] >= TEST22_CYCLE_TIME / 2u) &&
+                (gTest22Interval[noOfIntervals] <= TEST22_CYCLE_TIME + TEST22_CYCLE_TIME / 2u))
+            {
+                inBand++;
+            }
+            noOfIntervals++;
+        }
+        mean = (UINT32) (sum / noOfIntervals);
+        qsort(gTest22Interval, noOfIntervals, sizeof(UINT32), test22CompareInterval);
+
+        fprintf(gFp, "Inter-arrival [us]: mean %u, p50 %u, p99 %u, max %u, %u of %u within +/-%uus\n",
+                mean, gTest22Interval[noOfIntervals / 2u], gTest22Interval[(noOfIntervals * 99u) / 100u],
+                gTest22Interval[noOfIntervals - 1u], inBand, noOfIntervals, TEST22_CYCLE_TIME / 2u);
+
+        /* Wall-clock timing depends on the host: by default the median only has to show that the sub-millisecond
+           base cycle is in effect (the default cycle would give 1000us). The jitter bounds need real-time
+           priority and an idle host, they are checked with -j only. */
+        if (gTest22Interval[noOfIntervals / 2u] > TEST22_CYCLE_TIME * 2u)
+        {
+            FAILED("median interval exceeds two base cycles");
+        }
+        if (gStrictTiming == TRUE)
+        {
+            if ((gTest22Interval[noOfIntervals / 2u] < TEST22_CYCLE_TIME - TEST22_CYCLE_TIME / 10u) ||
+                (gTest22Interval[noOfIntervals / 2u] > TEST22_CYCLE_TIME + TEST22_CYCLE_TIME / 10u))
+            {
+                FAILED("median interval off by more than 10%");
+            }
+            if (inBand < (noOfIntervals * 8u) / 10u)
+            {
+                FAILED("inter-arrival jitter too high");
+            }
+        }
+
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Concurrent large TCP MD requests
+ *  Many maximum size requests are issued at once, they share one TCP connection. The replier echoes the request,
+ *  every reply must arrive unaltered.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST23_COMID                23000u
+#define TEST23_NO_OF_REQUESTS       16u
+
+static UINT8            gTest23Data[TRDP_MAX_MD_DATA_SIZE];
+static UINT32           gTest23NoOfReplies  = 0u;
+static UINT32           gTest23NoOfErrors   = 0u;
+
+static UINT8 test23Pattern (
+    UINT32  request,
+    UINT32  offset)
+{
+    return (UINT8) ((request * 37u) + (offset * 13u) + (offset >> 8));
+}
+
+static void  test23CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    UINT32 i;
+
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pMsg->comId != TEST23_COMID))
+    {
+        fprintf(gFp, "->> MD error %d (ComId %u, type %04x)\n", pMsg->resultCode, pMsg->comId, pMsg->msgType);
+        gTest23NoOfErrors++;
+    }
+    else if (pMsg->msgType == TRDP_MSG_MR)
+    {
+        if (tlm_reply(appHandle, &pMsg->sessionId, TEST23_COMID, 0u, NULL, pData, dataSize, NULL) != TRDP_NO_ERR)
+        {
+            gTest23NoOfErrors++;
+        }
+    }
+    else if (pMsg->msgType == TRDP_MSG_MP)
+    {
+        if ((pData == NULL) || (dataSize != TRDP_MAX_MD_DATA_SIZE) || (pData[0] >= TEST23_NO_OF_REQUESTS))
+        {
+            gTest23NoOfErrors++;
+            return;
+        }
+        for (i = 1u; i < dataSize; i++)
+        {
+            if (pData[i] != test23Pattern(pData[0], i))
+            {
+                fprintf(gFp, "->> Reply %u corrupted at offset %u\n", pData[0], i);
+                gTest23NoOfErrors++;
+                return;
+            }
+        }
+        gTest23NoOfReplies++;
+    }
+}
+
+static int test23 ()
+{
+    PREPARE("Concurrent large TCP MD requests on one connection", "test"); /* allocates appHandle1, appHandle2,
+                                                                              failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T                      listenHandle;
+        TRDP_UUID_T                     sessionId;
+        TRDP_MD_TCP_POOL_STATISTICS_T   poolStatistics;
+        UINT32                          request;
+        UINT32                          i;
+
+        gTest23NoOfReplies  = 0u;
+        gTest23NoOfErrors   = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test23CBFunction, TRUE,
+                              TEST23_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        /* Queue all requests at once, they are written to the connection while others are still outstanding */
+        for (request = 0u; request < TEST23_NO_OF_REQUESTS; request++)
+        {
+            gTest23Data[0] = (UINT8) request;
+            for (i = 1u; i < TRDP_MAX_MD_DATA_SIZE; i++)
+            {
+                gTest23Data[i] = test23Pattern(request, i);
+            }
+            err = tlm_request(appHandle1, NULL, test23CBFunction, &sessionId,
+                              TEST23_COMID, 0u, 0u,
+                              0u, gSession2.ifaceIP,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, 1u, 5000000u, NULL,
+                              gTest23Data, TRDP_MAX_MD_DATA_SIZE, NULL, NULL);
+            IF_ERROR("tlm_request");
+        }
+
+        for (i = 0u; (i < 100u) && (gTest23NoOfReplies + gTest23NoOfErrors < TEST23_NO_OF_REQUESTS); i++)
+        {
+            vos_threadDelay(100000u);
+        }
+        fprintf(gFp, "%u of %u replies received, %u errors\n",
+                gTest23NoOfReplies, TEST23_NO_OF_REQUESTS, gTest23NoOfErrors);
+
+        err = tlm_getTCPPoolStatistics(appHandle1, &poolStatistics);
+        IF_ERROR("tlm_getTCPPoolStatistics");
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+
+        if ((gTest23NoOfReplies != TEST23_NO_OF_REQUESTS) || (gTest23NoOfErrors != 0u))
+        {
+            FAILED("replies missing or corrupted");
+        }
+        if (poolStatistics.numMultiplexed == 0u)
+        {
+            FAILED("requests did not share the connection");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** Borrowed MD buffers
+ *  Only buffers borrowed from the session are accepted, each of them once. A notification sent from a borrowed
+ *  buffer must arrive unaltered.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST24_COMID                24000u
+#define TEST24_DATA_SIZE            1000u
+
+static UINT32           gTest24NoOfNotifications    = 0u;
+static UINT32           gTest24NoOfErrors           = 0u;
+
+static void  test24CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    UINT32 i;
+
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pMsg->comId != TEST24_COMID) || (pMsg->msgType != TRDP_MSG_MN) ||
+        (pData == NULL) || (dataSize != TEST24_DATA_SIZE))
+    {
+        gTest24NoOfErrors++;
+        return;
+    }
+    for (i = 0u; i < dataSize; i++)
+    {
+        if (pData[i] != (UINT8) (i * 7u))
+        {
+            gTest24NoOfErrors++;
+            return;
+        }
+    }
+    gTest24NoOfNotifications++;
+}
+
+static int test24 ()
+{
+    PREPARE("Borrowed MD buffers", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T  listenHandle;
+        UINT8       notBorrowed[TEST24_DATA_SIZE];
+        UINT8       *pData;
+        UINT8       *pOtherData;
+        UINT32      i;
+
+        gTest24NoOfNotifications    = 0u;
+        gTest24NoOfErrors           = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test24CBFunction, TRUE,
+                              TEST24_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        /* A buffer is returned once only */
+        err = tlm_allocBuffer(appHandle1, TEST24_DATA_SIZE, &pData);
+        IF_ERROR("tlm_allocBuffer");
+        err = tlm_freeBuffer(appHandle1, pData);
+        IF_ERROR("tlm_freeBuffer");
+
+        /* Unknown pointers are refused, nothing in front of them is read */
+        if ((tlm_freeBuffer(appHandle1, notBorrowed + 1u) != TRDP_PARAM_ERR) ||
+            (tlm_freeBuffer(appHandle1, NULL) != TRDP_PARAM_ERR))
+        {
+            FAILED("buffer not borrowed accepted");
+        }
+
+        /* A buffer of another session is refused, also a size beyond the capacity; neither is taken over */
+        err = tlm_allocBuffer(appHandle2, TEST24_DATA_SIZE, &pOtherData);
+        IF_ERROR("tlm_allocBuffer");
+        err = tlm_allocBuffer(appHandle1, TEST24_DATA_SIZE, &pData);
+        IF_ERROR("tlm_allocBuffer");
+        if ((tlm_notifyBuffer(appHandle1, NULL, NULL, TEST24_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                              TRDP_FLAGS_NONE, NULL, pOtherData, TEST24_DATA_SIZE, NULL, NULL) != TRDP_PARAM_ERR) ||
+            (tlm_notifyBuffer(appHandle1, NULL, NULL, TEST24_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                              TRDP_FLAGS_NONE, NULL, pData, TEST24_DATA_SIZE + 1u, NULL, NULL) != TRDP_PARAM_ERR))
+        {
+            FAILED("buffer of another session or too large size accepted");
+        }
+        err = tlm_freeBuffer(appHandle2, pOtherData);
+        IF_ERROR("tlm_freeBuffer");
+
+        /* Send the buffer, it is taken over */
+        for (i = 0u; i < TEST24_DATA_SIZE; i++)
+        {
+            pData[i] = (UINT8) (i * 7u);
+        }
+        err = tlm_notifyBuffer(appHandle1, NULL, NULL, TEST24_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                               TRDP_FLAGS_NONE, NULL, pData, TEST24_DATA_SIZE, NULL, NULL);
+        IF_ERROR("tlm_notifyBuffer");
+        if (tlm_freeBuffer(appHandle1, pData) != TRDP_PARAM_ERR)
+        {
+            FAILED("sent buffer returned");
+        }
+
+        for (i = 0u; (i < 20u) && (gTest24NoOfNotifications + gTest24NoOfErrors == 0u); i++)
+        {
+            vos_threadDelay(100000u);
+        }
+
+        /* Buffers still borrowed are released by tlc_closeSession() */
+        err = tlm_allocBuffer(appHandle1, TEST24_DATA_SIZE, &pData);
+        IF_ERROR("tlm_allocBuffer");
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+
+        if ((gTest24NoOfNotifications != 1u) || (gTest24NoOfErrors != 0u))
+        {
+            FAILED("notification missing or corrupted");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** Pipelined and partially received TCP MD messages
+ *  Notifications are written to the listener's TCP port by hand: several at once, and others split at arbitrary
+ *  points, including within the header and behind a complete message. All of them must arrive unaltered and in order.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#include "trdp_private.h"
+
+#define TEST25_COMID                25000u
+#define TEST25_NO_OF_MSG            6u
+
+static const UINT32     cTest25Size[TEST25_NO_OF_MSG] = {3u, 1432u, 7u, 65000u, 1u, 401u};
+static UINT8            gTest25Stream[TEST25_NO_OF_MSG * sizeof(MD_HEADER_T) + 67000u];
+static UINT32           gTest25NoOfNotifications    = 0u;
+static UINT32           gTest25NoOfErrors           = 0u;
+
+static UINT8 test25Pattern (
+    UINT32  msg,
+    UINT32  offset)
+{
+    return (UINT8) ((msg * 29u) + (offset * 11u));
+}
+
+/* Append a notification to pStream, return its size */
+static UINT32 test25Build (
+    UINT8   *pStream,
+    UINT32  msg)
+{
+    MD_HEADER_T *pHeader = (MD_HEADER_T *) pStream;
+    UINT32      i;
+
+    memset(pHeader, 0, sizeof(MD_HEADER_T));
+    pHeader->sequenceCounter    = vos_htonl(msg);
+    pHeader->protocolVersion    = vos_htons(TRDP_PROTO_VER);
+    pHeader->msgType            = vos_htons((UINT16) TRDP_MSG_MN);
+    pHeader->comId              = vos_htonl(TEST25_COMID);
+    pHeader->datasetLength      = vos_htonl(cTest25Size[msg]);
+    pHeader->frameCheckSum      = MAKE_LE(vos_crc32(INITFCS, (UINT8 *) pHeader, sizeof(MD_HEADER_T) - SIZE_OF_FCS));
+
+    for (i = 0u; i < cTest25Size[msg]; i++)
+    {
+        pStream[sizeof(MD_HEADER_T) + i] = test25Pattern(msg, i);
+    }
+    /* padding to 4 */
+    for (; (i & 3u) != 0u; i++)
+    {
+        pStream[sizeof(MD_HEADER_T) + i] = 0u;
+    }
+    return sizeof(MD_HEADER_T) + i;
+}
+
+static void  test25CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    UINT32 msg = gTest25NoOfNotifications;
+    UINT32 i;
+
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pMsg->comId != TEST25_COMID) || (pMsg->msgType != TRDP_MSG_MN) ||
+        (msg >= TEST25_NO_OF_MSG) || (pData == NULL) || (dataSize != cTest25Size[msg]))
+    {
+        fprintf(gFp, "->> Notification %u unexpected (err %d, size %u)\n", msg, pMsg->resultCode, dataSize);
+        gTest25NoOfErrors++;
+        return;
+    }
+    for (i = 0u; i < dataSize; i++)
+    {
+        if (pData[i] != test25Pattern(msg, i))
+        {
+            fprintf(gFp, "->> Notification %u corrupted at offset %u\n", msg, i);
+            gTest25NoOfErrors++;
+            return;
+        }
+    }
+    gTest25NoOfNotifications++;
+}
+
+/* Write a part of the stream and give the listener time to read it on its own */
+static VOS_ERR_T test25Write (
+    SOCKET  sock,
+    UINT32  begin,
+    UINT32  end)
+{
+    UINT32      size    = end - begin;
+    VOS_ERR_T   err     = vos_sockSendTCP(sock, gTest25Stream + begin, &size);
+
+    vos_threadDelay(50000u);
+    return err;
+}
+
+static int test25 ()
+{
+    PREPARE("Pipelined and partially received TCP MD messages", "test"); /* allocates appHandle1, appHandle2,
+                                                                            failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T  listenHandle;
+        SOCKET      sock = VOS_INVALID_SOCKET;
+        UINT32      end[TEST25_NO_OF_MSG];
+        UINT32      msg;
+        UINT32      i;
+
+        gTest25NoOfNotifications    = 0u;
+        gTest25NoOfErrors           = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test25CBFunction, TRUE,
+                              TEST25_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        for (msg = 0u, i = 0u; msg < TEST25_NO_OF_MSG; msg++)
+        {
+            i += test25Build(gTest25Stream + i, msg);
+            end[msg] = i;
+        }
+
+        if ((vos_sockOpenTCP(&sock, NULL) != VOS_NO_ERR) ||
+            (vos_sockConnect(sock, gSession2.ifaceIP, TRDP_MD_TCP_PORT) != VOS_NO_ERR))
+        {
+            FAILED("connecting the listener");
+        }
+
+        /* Three messages with one write */
+        if ((test25Write(sock, 0u, end[2]) != VOS_NO_ERR) ||
+            /* The large one split within its header and within its payload */
+            (test25Write(sock, end[2], end[2] + 10u) != VOS_NO_ERR) ||
+            (test25Write(sock, end[2] + 10u, end[2] + 100u) != VOS_NO_ERR) ||
+            (test25Write(sock, end[2] + 100u, end[2] + 30000u) != VOS_NO_ERR) ||
+            /* Its rest, a complete message and part of the header of the last one */
+            (test25Write(sock, end[2] + 30000u, end[4] + 50u) != VOS_NO_ERR) ||
+            (test25Write(sock, end[4] + 50u, end[5]) != VOS_NO_ERR))
+        {
+            FAILED("writing to the listener");
+        }
+
+        for (i = 0u; (i < 20u) && (gTest25NoOfNotifications + gTest25NoOfErrors < TEST25_NO_OF_MSG); i++)
+        {
+            vos_threadDelay(100000u);
+        }
+        fprintf(gFp, "%u of %u notifications received, %u errors\n",
+                gTest25NoOfNotifications, TEST25_NO_OF_MSG, gTest25NoOfErrors);
+
+        (void) vos_sockClose(sock);
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+
+        if ((gTest25NoOfNotifications != TEST25_NO_OF_MSG) || (gTest25NoOfErrors != 0u))
+        {
+            FAILED("notifications missing or corrupted");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** MD session IDs
+ *  Session IDs of both generators must be unique, also across sessions. Fast IDs are RFC 4122 version 4 UUIDs sharing
+ *  a prefix per session and counting up. vos_getUuid() must deliver unique IDs to concurrent threads.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST26_COMID                26000u
+#define TEST26_NO_OF_IDS            100u
+#define TEST26_NO_OF_THREADS        4u
+#define TEST26_IDS_PER_THREAD       500u
+
+static TRDP_UUID_T      gTest26Id[2u * TEST26_NO_OF_IDS];
+static VOS_UUID_T       gTest26Uuid[TEST26_NO_OF_THREADS * TEST26_IDS_PER_THREAD];
+static UINT32           gTest26ThreadsDone = 0u;
+
+static void test26Thread (
+    void *pArg)
+{
+    UINT32 first = *(UINT32 *) pArg * TEST26_IDS_PER_THREAD;
+    UINT32 i;
+
+    for (i = 0u; i < TEST26_IDS_PER_THREAD; i++)
+    {
+        vos_getUuid(gTest26Uuid[first + i]);
+    }
+    (void) VOS_ATOMIC_ADD(&gTest26ThreadsDone, 1u);
+}
+
+static int test26CompareId (
+    const void  *p1,
+    const void  *p2)
+{
+    return memcmp(p1, p2, sizeof(TRDP_UUID_T));
+}
+
+/* Count the IDs occurring more than once, sorts them */
+static UINT32 test26Duplicates (
+    void    *pIds,
+    UINT32  noOfIds)
+{
+    UINT8   *pId = (UINT8 *) pIds;
+    UINT32  noOfDuplicates = 0u;
+    UINT32  i;
+
+    qsort(pIds, noOfIds, sizeof(TRDP_UUID_T), test26CompareId);
+    for (i = 1u; i < noOfIds; i++)
+    {
+        if (memcmp(pId + (i - 1u) * sizeof(TRDP_UUID_T), pId + i * sizeof(TRDP_UUID_T), sizeof(TRDP_UUID_T)) == 0)
+        {
+            noOfDuplicates++;
+        }
+    }
+    return noOfDuplicates;
+}
+
+static void  test26CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    /* Requests are left unanswered, they are aborted by the caller */
+}
+
+static int test26 ()
+{
+    PREPARE("MD session IDs", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_MD_CONFIG_T    mdConfig;
+        TRDP_LIS_T          listenHandle1;
+        TRDP_LIS_T          listenHandle2;
+        VOS_THREAD_T        thread;
+        UINT32              threadNo[TEST26_NO_OF_THREADS];
+        TRDP_UUID_T         *pFastId = &gTest26Id[TEST26_NO_OF_IDS];
+        UINT64              count;
+        UINT64              lastCount = 0u;
+        UINT32              i;
+        UINT32              j;
+
+        /* appHandle1 keeps vos_getUuid(), appHandle2 generates fast IDs */
+        memset(&mdConfig, 0, sizeof(mdConfig));
+        mdConfig.sendParam.retries  = TRDP_MD_DEFAULT_RETRIES;
+        mdConfig.sessionIdGen       = TRDP_MD_SESSION_ID_FAST;
+        err = tlc_configSession(appHandle2, NULL, NULL, &mdConfig, NULL);
+        IF_ERROR("tlc_configSession");
+
+        err = tlm_addListener(appHandle1, &listenHandle1, NULL, test26CBFunction, TRUE,
+                              TEST26_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+        err = tlm_addListener(appHandle2, &listenHandle2, NULL, test26CBFunction, TRUE,
+                              TEST26_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        for (i = 0u; i < TEST26_NO_OF_IDS; i++)
+        {
+            err = tlm_request(appHandle1, NULL, test26CBFunction, &gTest26Id[i], TEST26_COMID, 0u, 0u,
+                              0u, gSession2.ifaceIP, TRDP_FLAGS_CALLBACK, 1u, 10000000u, NULL, NULL, 0u, NULL, NULL);
+            IF_ERROR("tlm_request");
+            err = tlm_request(appHandle2, NULL, test26CBFunction, &pFastId[i], TEST26_COMID, 0u, 0u,
+                              0u, gSession1.ifaceIP, TRDP_FLAGS_CALLBACK, 1u, 10000000u, NULL, NULL, 0u, NULL, NULL);
+            IF_ERROR("tlm_request");
+        }
+        for (i = 0u; i < TEST26_NO_OF_IDS; i++)
+        {
+            (void) tlm_abortSession(appHandle1, &gTest26Id[i]);
+            (void) tlm_abortSession(appHandle2, &pFastId[i]);
+        }
+
+        err = tlm_delListener(appHandle1, listenHandle1);
+        IF_ERROR("tlm_delListener");
+        err = tlm_delListener(appHandle2, listenHandle2);
+        IF_ERROR("tlm_delListener");
+
+        /* Fast IDs: version 4, RFC 4122 variant, prefix of the session and a counter incremented by one */
+        for (i = 0u; i < TEST26_NO_OF_IDS; i++)
+        {
+            if (((pFastId[i][6] & 0xF0u) != 0x40u) || ((pFastId[i][8] & 0xC0u) != 0x80u) ||
+                (memcmp(pFastId[i], pFastId[0], 8u) != 0))
+            {
+                FAILED("fast session ID malformed");
+            }
+            count = pFastId[i][8] & 0x3Fu;
+            for (j = 9u; j < 16u; j++)
+            {
+                count = (count << 8u) | pFastId[i][j];
+            }
+            if ((i > 0u) && (count != lastCount + 1u))
+            {
+                FAILED("fast session ID not counting");
+            }
+            lastCount = count;
+        }
+
+        /* Unique across both sessions and generators */
+        if (test26Duplicates(gTest26Id, 2u * TEST26_NO_OF_IDS) != 0u)
+        {
+            FAILED("session ID duplicated");
+        }
+
+        /* vos_getUuid() called concurrently */
+        gTest26ThreadsDone = 0u;
+        for (i = 0u; i < TEST26_NO_OF_THREADS; i++)
+        {
+            threadNo[i] = i;
+            if (vos_threadCreate(&thread, "UUID Task", VOS_THREAD_POLICY_OTHER,
+                                 (VOS_THREAD_PRIORITY_T) VOS_THREAD_PRIORITY_DEFAULT, 0u, 0u,
+                                 (VOS_THREAD_FUNC_T) test26Thread, &threadNo[i]) != VOS_NO_ERR)
+            {
+                FAILED("vos_threadCreate");
+            }
+        }
+        for (i = 0u; (i < 100u) && (VOS_ATOMIC_LOAD(&gTest26ThreadsDone) < TEST26_NO_OF_THREADS); i++)
+        {
+            vos_threadDelay(10000u);
+        }
+        if (VOS_ATOMIC_LOAD(&gTest26ThreadsDone) < TEST26_NO_OF_THREADS)
+        {
+            FAILED("UUID threads did not finish");
+        }
+        if (test26Duplicates(gTest26Uuid, TEST26_NO_OF_THREADS * TEST26_IDS_PER_THREAD) != 0u)
+        {
+            FAILED("UUID duplicated");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** Mixed indexed and non-indexed sessions
+ *  Session 2 is switched to the indexed scheduler, session 1 keeps the queue scheduler (in HIGH_PERF_INDEXED builds
+ *  both sessions are indexed). Each session publishes to the other, both telegrams must arrive.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST27_CYCLE_TIME           1000u
+#define TEST27_INTERVAL             10000u
+#define TEST27_COMID_QUEUE          27001u      /* sent by the queue scheduler of session 1 */
+#define TEST27_COMID_INDEXED        27002u      /* sent by the indexed scheduler of session 2 */
+
+static int test27 ()
+{
+    PREPARE2("Mixed indexed and non-indexed sessions", "test", TEST27_CYCLE_TIME);
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle1, pubHandle2;
+        TRDP_SUB_T          subHandle1, subHandle2;
+        TRDP_PD_INFO_T      pdInfo;
+        TRDP_IDX_TABLE_T    indexTableSizes = {
+            10,             /**< Max. number of expected subscriptions with intervals <= 100ms  */
+            10,             /**< Max. number of expected subscriptions with intervals <= 1000ms */
+            10,             /**< Max. number of expected subscriptions with intervals > 1000ms  */
+            10,             /**< Max. number of expected publishers with intervals <= 100ms     */
+            5,              /**< depth / overlapped publishers with intervals <= 100ms          */
+            10,             /**< Max. number of expected publishers with intervals <= 1000ms    */
+            5,              /**< depth / overlapped publishers with intervals <= 1000ms         */
+            10,             /**< Max. number of expected publishers with intervals <= 10000ms   */
+            5,              /**< depth / overlapped publishers with intervals <= 10000ms        */
+            10,             /**< Max. number of expected publishers with intervals > 10000ms    */
+            TEST27_CYCLE_TIME   /**< base transmit cycle [us]                                   */
+        };
+        CHAR8               data1[32] = "Sent by the queue scheduler";
+        CHAR8               data2[32] = "Sent by the indexed scheduler";
+        CHAR8               rcv1[32];
+        CHAR8               rcv2[32];
+        UINT32              size1 = 0u;
+        UINT32              size2 = 0u;
+        TRDP_ERR_T          err1 = TRDP_NODATA_ERR;
+        TRDP_ERR_T          err2 = TRDP_NODATA_ERR;
+        UINT32              i;
+
+        err = tlc_presetIndexSession(gSession2.appHandle, &indexTableSizes);
+        IF_ERROR("tlc_presetIndexSession 2");
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle1, NULL, NULL, 0u,
+                          TEST27_COMID_QUEUE, 0u, 0u,
+                          0u,
+                          gSession2.ifaceIP,
+                          TEST27_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) data1, sizeof(data1));
+        IF_ERROR("tlp_publish 1");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle2, NULL, NULL,
+                            0u,
+                            TEST27_COMID_QUEUE, 0u, 0u,
+                            0u, 0u,
+                            0u,
+                            TRDP_FLAGS_DEFAULT, NULL,
+                            TEST27_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe 2");
+
+        err = tlp_publish(gSession2.appHandle, &pubHandle2, NULL, NULL, 0u,
+                          TEST27_COMID_INDEXED, 0u, 0u,
+                          0u,
+                          gSession1.ifaceIP,
+                          TEST27_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) data2, sizeof(data2));
+        IF_ERROR("tlp_publish 2");
+
+        err = tlp_subscribe(gSession1.appHandle, &subHandle1, NULL, NULL,
+                            0u,
+                            TEST27_COMID_INDEXED, 0u, 0u,
+                            0u, 0u,
+                            0u,
+                            TRDP_FLAGS_DEFAULT, NULL,
+                            TEST27_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe 1");
+
+        err = tlc_updateSession(gSession1.appHandle);
+        IF_ERROR("tlc_updateSession 1");
+
+        err = tlc_updateSession(gSession2.appHandle);
+        IF_ERROR("tlc_updateSession 2");
+
+        /* Wait for both telegrams, up to one second */
+        for (i = 0u; (i < 100u) && ((err1 != TRDP_NO_ERR) || (err2 != TRDP_NO_ERR)); i++)
+        {
+            vos_threadDelay(TEST27_INTERVAL);
+            size1   = sizeof(rcv1);
+            err1    = tlp_get(gSession1.appHandle, subHandle1, &pdInfo, (UINT8 *) rcv1, &size1);
+            size2   = sizeof(rcv2);
+            err2    = tlp_get(gSession2.appHandle, subHandle2, &pdInfo, (UINT8 *) rcv2, &size2);
+        }
+
+        if (err2 != TRDP_NO_ERR)
+        {
+            err = err2;
+            FAILED("indexed session did not receive from the queue session");
+        }
+        if (err1 != TRDP_NO_ERR)
+        {
+            err = err1;
+            FAILED("queue session did not receive from the indexed session");
+        }
+        if ((size2 != sizeof(data1)) || (memcmp(rcv2, data1, sizeof(data1)) != 0))
+        {
+            FAILED("data sent by the queue scheduler corrupted");
+        }
+        if ((size1 != sizeof(data2)) || (memcmp(rcv1, data2, sizeof(data2)) != 0))
+        {
+            FAILED("data sent by the indexed scheduler corrupted");
+        }
+        fprintf(gFp, "Both telegrams received after %u ms\n", i * TEST27_INTERVAL / 1000u);
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** MD completion queue
+ *  Notifications, a reply and a reply timeout are posted by tlm_postCompletion() and taken by tlm_getCompletions().
+ *  Records beyond the depth of the queue are lost, the others arrive in order with their data in lent buffers.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST28_COMID_NOTIFY         28001u
+#define TEST28_COMID_REQUEST        28002u
+#define TEST28_COMID_UNLISTENED     28003u
+#define TEST28_DEPTH                4u
+#define TEST28_NO_OF_NOTIFY         6u
+#define TEST28_DATA_SIZE            64u
+
+static UINT32 gTest28NoOfReplyErrors = 0u;
+
+/* Replier of session 2: echoes the request */
+static void  test28CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MR))
+    {
+        if (tlm_reply(appHandle, &pMsg->sessionId, TEST28_COMID_REQUEST, 0u, NULL, pData, dataSize, NULL)
+            != TRDP_NO_ERR)
+        {
+            gTest28NoOfReplyErrors++;
+        }
+    }
+}
+
+static int test28 ()
+{
+    PREPARE("MD completion queue", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T              notifyHandle;
+        TRDP_LIS_T              requestHandle;
+        TRDP_UUID_T             sessionId;
+        TRDP_MD_COMPLETION_T    rec[TEST28_NO_OF_NOTIFY + 2u];
+        UINT8                   data[TEST28_DATA_SIZE];
+        UINT32                  noOfRecs = 0u;
+        UINT32                  i;
+
+        gTest28NoOfReplyErrors = 0u;
+
+        if ((tlm_getCompletions(appHandle1, rec, 1u, &noOfRecs, 0u) != TRDP_STATE_ERR) ||
+            (tlm_openCompletionQueue(appHandle1, 0u) != TRDP_PARAM_ERR))
+        {
+            FAILED("completion queue parameters not checked");
+        }
+        err = tlm_openCompletionQueue(appHandle1, TEST28_DEPTH);
+        IF_ERROR("tlm_openCompletionQueue 1");
+        err = tlm_openCompletionQueue(appHandle2, TEST28_DEPTH);
+        IF_ERROR("tlm_openCompletionQueue 2");
+        if (tlm_openCompletionQueue(appHandle1, TEST28_DEPTH) != TRDP_STATE_ERR)
+        {
+            FAILED("completion queue opened twice");
+        }
+        if (tlm_getCompletions(appHandle1, rec, 1u, &noOfRecs, 0u) != TRDP_NODATA_ERR)
+        {
+            FAILED("completion from an empty queue");
+        }
+
+        err = tlm_addListener(appHandle2, &notifyHandle, NULL, tlm_postCompletion, TRUE,
+                              TEST28_COMID_NOTIFY, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener notify");
+        err = tlm_addListener(appHandle2, &requestHandle, NULL, test28CBFunction, TRUE,
+                              TEST28_COMID_REQUEST, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener request");
+
+        /* More notifications than the queue holds: the first ones are kept, the others lost */
+        for (i = 0u; i < TEST28_NO_OF_NOTIFY; i++)
+        {
+            memset(data, (int) i, sizeof(data));
+            err = tlm_notify(appHandle1, NULL, NULL, TEST28_COMID_NOTIFY, 0u, 0u, 0u, gSession2.ifaceIP,
+                             TRDP_FLAGS_NONE, NULL, data, sizeof(data), NULL, NULL);
+            IF_ERROR("tlm_notify");
+            vos_threadDelay(10000u);
+        }
+        vos_threadDelay(200000u);
+
+        err = tlm_getCompletions(appHandle2, rec, TEST28_NO_OF_NOTIFY + 2u, &noOfRecs, 1000000u);
+        IF_ERROR("tlm_getCompletions notify");
+        fprintf(gFp, "%u of %u notifications posted\n", noOfRecs, TEST28_NO_OF_NOTIFY);
+        for (i = 0u; i < noOfRecs; i++)
+        {
+            memset(data, (int) i, sizeof(data));
+            if ((rec[i].info.resultCode != TRDP_NO_ERR) || (rec[i].info.comId != TEST28_COMID_NOTIFY) ||
+                (rec[i].info.msgType != TRDP_MSG_MN) || (rec[i].dataSize != sizeof(data)) ||
+                (rec[i].pData == NULL) || (memcmp(rec[i].pData, data, sizeof(data)) != 0))
+            {
+                gFailed = 1;
+            }
+            if (rec[i].pData != NULL)
+            {
+                err = tlm_freeBuffer(appHandle2, rec[i].pData);
+                IF_ERROR("tlm_freeBuffer");
+            }
+        }
+        if (gFailed != 0)
+        {
+            FAILED("notification record corrupted or out of order");
+        }
+        if (noOfRecs != TEST28_DEPTH)
+        {
+            FAILED("records beyond the queue depth");
+        }
+        if (tlm_getCompletions(appHandle2, rec, 1u, &noOfRecs, 0u) != TRDP_NODATA_ERR)
+        {
+            FAILED("lost notifications posted");
+        }
+
+        /* A request: the reply is matched by the session ID */
+        for (i = 0u; i < sizeof(data); i++)
+        {
+            data[i] = (UINT8) (i * 3u);
+        }
+        err = tlm_request(appHandle1, NULL, tlm_postCompletion, &sessionId,
+                          TEST28_COMID_REQUEST, 0u, 0u,
+                          0u, gSession2.ifaceIP,
+                          TRDP_FLAGS_CALLBACK, 1u, 1000000u, NULL,
+                          data, sizeof(data), NULL, NULL);
+        IF_ERROR("tlm_request");
+
+        err = tlm_getCompletions(appHandle1, rec, 1u, &noOfRecs, 2000000u);
+        IF_ERROR("tlm_getCompletions reply");
+        if ((rec[0].info.resultCode != TRDP_NO_ERR) || (rec[0].info.msgType != TRDP_MSG_MP) ||
+            (memcmp(rec[0].info.sessionId, sessionId, sizeof(TRDP_UUID_T)) != 0) ||
+            (rec[0].dataSize != sizeof(data)) || (rec[0].pData == NULL) ||
+            (memcmp(rec[0].pData, data, sizeof(data)) != 0))
+        {
+            FAILED("reply record wrong");
+        }
+        err = tlm_freeBuffer(appHandle1, rec[0].pData);
+        IF_ERROR("tlm_freeBuffer");
+
+        /* A request nobody replies to: the time-out is posted */
+        err = tlm_request(appHandle1, NULL, tlm_postCompletion, &sessionId,
+                          TEST28_COMID_UNLISTENED, 0u, 0u,
+                          0u, gSession2.ifaceIP,
+                          TRDP_FLAGS_CALLBACK, 1u, 200000u, NULL,
+                          data, sizeof(data), NULL, NULL);
+        IF_ERROR("tlm_request");
+
+        err = tlm_getCompletions(appHandle1, rec, 1u, &noOfRecs, 3000000u);
+        IF_ERROR("tlm_getCompletions timeout");
+        if ((rec[0].info.resultCode == TRDP_NO_ERR) ||
+            (memcmp(rec[0].info.sessionId, sessionId, sizeof(TRDP_UUID_T)) != 0))
+        {
+            FAILED("time-out record wrong");
+        }
+        if (rec[0].pData != NULL)
+        {
+            err = tlm_freeBuffer(appHandle1, rec[0].pData);
+            IF_ERROR("tlm_freeBuffer");
+        }
+        fprintf(gFp, "Request without replier completed with %d\n", rec[0].info.resultCode);
+
+        err = tlm_delListener(appHandle2, notifyHandle);
+        IF_ERROR("tlm_delListener");
+        err = tlm_delListener(appHandle2, requestHandle);
+        IF_ERROR("tlm_delListener");
+
+        if (gTest28NoOfReplyErrors != 0u)
+        {
+            FAILED("tlm_reply failed");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** Batched notifications
+ *  tlm_notifyBatch() sends more notifications than fit into one system call, two of them invalid. The invalid ones
+ *  are reported per item, every other one must arrive once and unaltered. A notification the marshaller refuses
+ *  must be reported and not sent.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST29_COMID                29000u
+#define TEST29_NO_OF_ITEMS          (VOS_MAX_DGRAM_CNT + 8u)
+#define TEST29_NULL_ITEM            5u          /* data missing */
+#define TEST29_LARGE_ITEM           (VOS_MAX_DGRAM_CNT + 1u)  /* data too large */
+#define TEST29_UNMARSHALLED_ITEM    2u          /* refused by the marshaller */
+
+static UINT8            gTest29Data[TEST29_NO_OF_ITEMS][4u + TEST29_NO_OF_ITEMS * 37u];
+static UINT32           gTest29Received[TEST29_NO_OF_ITEMS];
+static UINT32           gTest29NoOfNotifications    = 0u;
+static UINT32           gTest29NoOfErrors           = 0u;
+
+static UINT32 test29Size (
+    UINT32 item)
+{
+    return 4u + item * 37u;
+}
+
+static TRDP_ERR_T test29Marshall (
+    void            *pRefCon,
+    UINT32          comId,
+    UINT8           *pSrc,
+    UINT32          srcSize,
+    UINT8           *pDst,
+    UINT32          *pDstSize,
+    TRDP_DATASET_T  * *ppCachedDS)
+{
+    UINT32 item;
+
+    memcpy(&item, pSrc, sizeof(item));
+    if ((item == TEST29_UNMARSHALLED_ITEM) || (srcSize > *pDstSize))
+    {
+        return TRDP_MARSHALLING_ERR;
+    }
+    memcpy(pDst, pSrc, srcSize);
+    *pDstSize = srcSize;
+    return TRDP_NO_ERR;
+}
+
+static void  test29CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    UINT32 item;
+
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pMsg->msgType != TRDP_MSG_MN) || (pData == NULL) || (dataSize < 4u))
+    {
+        gTest29NoOfErrors++;
+        return;
+    }
+    memcpy(&item, pData, sizeof(item));
+    if ((item >= TEST29_NO_OF_ITEMS) || (dataSize != test29Size(item)) ||
+        (memcmp(pData, gTest29Data[item], dataSize) != 0))
+    {
+        gTest29NoOfErrors++;
+        return;
+    }
+    gTest29Received[item]++;
+    gTest29NoOfNotifications++;
+}
+
+static int test29 ()
+{
+    PREPARE("Batched notifications", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T              listenHandle;
+        TRDP_MD_NOTIFY_ITEM_T   items[TEST29_NO_OF_ITEMS];
+        TRDP_ERR_T              results[TEST29_NO_OF_ITEMS];
+        UINT32                  item;
+        UINT32                  i;
+
+        gTest29NoOfNotifications    = 0u;
+        gTest29NoOfErrors           = 0u;
+        memset(gTest29Received, 0, sizeof(gTest29Received));
+
+        for (item = 0u; item < TEST29_NO_OF_ITEMS; item++)
+        {
+            memcpy(gTest29Data[item], &item, sizeof(item));
+            for (i = 4u; i < test29Size(item); i++)
+            {
+                gTest29Data[item][i] = (UINT8) (item + i * 13u);
+            }
+            items[item].comId       = TEST29_COMID;
+            items[item].destIpAddr  = gSession2.ifaceIP;
+            items[item].pData       = gTest29Data[item];
+            items[item].dataSize    = test29Size(item);
+        }
+        items[TEST29_NULL_ITEM].pData       = NULL;
+        items[TEST29_LARGE_ITEM].dataSize   = TRDP_MAX_MD_DATA_SIZE + 1u;
+
+        if ((tlm_notifyBatch(appHandle1, 0u, 0u, 0u, TRDP_FLAGS_NONE, NULL, items, 0u, NULL) != TRDP_PARAM_ERR) ||
+            (tlm_notifyBatch(appHandle1, 0u, 0u, 0u, TRDP_FLAGS_TCP, NULL, items, 1u, NULL) != TRDP_PARAM_ERR))
+        {
+            FAILED("empty or TCP batch accepted");
+        }
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test29CBFunction, TRUE,
+                              TEST29_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        err = tlm_notifyBatch(appHandle1, 0u, 0u, 0u, TRDP_FLAGS_NONE, NULL, items, TEST29_NO_OF_ITEMS, results);
+        if (err != TRDP_PARAM_ERR)
+        {
+            FAILED("invalid notification not reported");
+        }
+        for (item = 0u; item < TEST29_NO_OF_ITEMS; item++)
+        {
+            TRDP_ERR_T expected = ((item == TEST29_NULL_ITEM) || (item == TEST29_LARGE_ITEM)) ?
+                                  TRDP_PARAM_ERR : TRDP_NO_ERR;
+            if (results[item] != expected)
+            {
+                fprintf(gFp, "### notification %u: result %d\n", item, results[item]);
+                gFailed = 1;
+            }
+        }
+        if (gFailed != 0)
+        {
+            err = TRDP_NO_ERR;
+            FAILED("result per notification wrong");
+        }
+        err = TRDP_NO_ERR;
+
+        for (i = 0u; (i < 20u) && (gTest29NoOfNotifications + gTest29NoOfErrors < TEST29_NO_OF_ITEMS - 2u); i++)
+        {
+            vos_threadDelay(100000u);
+        }
+        vos_threadDelay(100000u);      /* nothing more must arrive */
+        fprintf(gFp, "%u of %u notifications received, %u errors\n",
+                gTest29NoOfNotifications, TEST29_NO_OF_ITEMS - 2u, gTest29NoOfErrors);
+
+        for (item = 0u; item < TEST29_NO_OF_ITEMS; item++)
+        {
+            UINT32 expected = ((item == TEST29_NULL_ITEM) || (item == TEST29_LARGE_ITEM)) ? 0u : 1u;
+            if (gTest29Received[item] != expected)
+            {
+                gFailed = 1;
+            }
+        }
+        if ((gFailed != 0) || (gTest29NoOfErrors != 0u))
+        {
+            FAILED("notification missing, duplicated or corrupted");
+        }
+
+        /* A notification the marshaller refuses is reported and left out, its neighbours are still sent */
+        {
+            TRDP_MARSHALL_CONFIG_T marshallConfig = {test29Marshall, NULL, NULL};
+
+            err = tlc_configSession(appHandle1, &marshallConfig, NULL, NULL, NULL);
+            IF_ERROR("tlc_configSession");
+        }
+        gTest29NoOfNotifications = 0u;
+        err = tlm_notifyBatch(appHandle1, 0u, 0u, 0u, TRDP_FLAGS_MARSHALL, NULL, &items[1], 3u, results);
+        if ((err != TRDP_MARSHALLING_ERR) || (results[0] != TRDP_NO_ERR) ||
+            (results[1] != TRDP_MARSHALLING_ERR) || (results[2] != TRDP_NO_ERR))
+        {
+            fprintf(gFp, "### marshalled batch: %d, results %d %d %d\n", err, results[0], results[1], results[2]);
+            err = TRDP_NO_ERR;
+            FAILED("marshalling error not reported");
+        }
+        err = TRDP_NO_ERR;
+
+        for (i = 0u; (i < 20u) && (gTest29NoOfNotifications + gTest29NoOfErrors < 2u); i++)
+        {
+            vos_threadDelay(100000u);
+        }
+        vos_threadDelay(100000u);      /* nothing more must arrive */
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+
+        if ((gTest29Received[1] != 2u) || (gTest29Received[TEST29_UNMARSHALLED_ITEM] != 1u) ||
+            (gTest29Received[3] != 2u) || (gTest29NoOfErrors != 0u))
+        {
+            FAILED("unmarshalled notification sent or neighbour missing");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** Burst profile of the indexed transmit tables
+ *  tlp_getBurstProfile() must refuse sessions without index tables and report every publisher of an indexed
+ *  session once per slot cycle, spread over the slots.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST30_CYCLE_TIME           1000u
+#define TEST30_COMID                30000u
+#define TEST30_NO_OF_LOW_PUBS       6u          /* 100ms */
+#define TEST30_NO_OF_MID_PUBS       3u          /* 1000ms */
+#define TEST30_DATA_SIZE            64u
+
+static UINT32 test30Packets (
+    const TRDP_BURST_CATEGORY_T *pCat)
+{
+    UINT32  slot;
+    UINT32  packets = 0u;
+
+    for (slot = 0u; slot < pCat->noOfSlots; slot++)
+    {
+        packets += pCat->packets[slot];
+    }
+    return packets;
+}
+
+static int test30 ()
+{
+    PREPARE2("Burst profile of the indexed transmit tables", "test", TEST30_CYCLE_TIME);
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T              pubHandle;
+        TRDP_IDX_TABLE_T        indexTableSizes = {
+            10,             /**< Max. number of expected subscriptions with intervals <= 100ms  */
+            10,             /**< Max. number of expected subscriptions with intervals <= 1000ms */
+            10,             /**< Max. number of expected subscriptions with intervals > 1000ms  */
+            10,             /**< Max. number of expected publishers with intervals <= 100ms     */
+            5,              /**< depth / overlapped publishers with intervals <= 100ms          */
+            10,             /**< Max. number of expected publishers with intervals <= 1000ms    */
+            5,              /**< depth / overlapped publishers with intervals <= 1000ms         */
+            10,             /**< Max. number of expected publishers with intervals <= 10000ms   */
+            5,              /**< depth / overlapped publishers with intervals <= 10000ms        */
+            10,             /**< Max. number of expected publishers with intervals > 10000ms    */
+            TEST30_CYCLE_TIME   /**< base transmit cycle [us]                                   */
+        };
+        TRDP_BURST_PROFILE_T    profile;
+        UINT8                   data[TEST30_DATA_SIZE];
+        UINT32                  comId = TEST30_COMID;
+        UINT32                  i;
+
+        memset(data, 0x30, sizeof(data));
+
+        err = tlc_presetIndexSession(gSession2.appHandle, &indexTableSizes);
+        IF_ERROR("tlc_presetIndexSession");
+
+        for (i = 0u; i < TEST30_NO_OF_LOW_PUBS; i++)
+        {
+            err = tlp_publish(gSession2.appHandle, &pubHandle, NULL, NULL, 0u, comId++, 0u, 0u, 0u,
+                              gSession1.ifaceIP, 100000u, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+            IF_ERROR("tlp_publish 100ms");
+        }
+        for (i = 0u; i < TEST30_NO_OF_MID_PUBS; i++)
+        {
+            err = tlp_publish(gSession2.appHandle, &pubHandle, NULL, NULL, 0u, comId++, 0u, 0u, 0u,
+                              gSession1.ifaceIP, 1000000u, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+            IF_ERROR("tlp_publish 1000ms");
+        }
+        err = tlp_publish(gSession2.appHandle, &pubHandle, NULL, NULL, 0u, comId++, 0u, 0u, 0u,
+                          gSession1.ifaceIP, 20000000u, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+        IF_ERROR("tlp_publish 20s");
+
+        if (tlp_getBurstProfile(gSession2.appHandle, NULL) != TRDP_PARAM_ERR)
+        {
+            FAILED("missing profile accepted");
+        }
+        if (tlp_getBurstProfile(gSession2.appHandle, &profile) != TRDP_STATE_ERR)
+        {
+            FAILED("profile reported before the index tables were created");
+        }
+        if (tlp_getBurstProfile(gSession1.appHandle, &profile) != TRDP_STATE_ERR)
+        {
+            FAILED("profile reported for a session without index tables");
+        }
+
+        err = tlc_updateSession(gSession2.appHandle);
+        IF_ERROR("tlc_updateSession");
+
+        err = tlp_getBurstProfile(gSession2.appHandle, &profile);
+        IF_ERROR("tlp_getBurstProfile");
+
+        fprintf(gFp, "low: %u slots of %u us, %u packets, peak %u packets / %u bytes\n",
+                profile.lowCat.noOfSlots, profile.lowCat.slotCycle, test30Packets(&profile.lowCat),
+                profile.lowCat.peakPackets, profile.lowCat.peakBytes);
+        fprintf(gFp, "mid: %u slots of %u us, %u packets, peak %u packets / %u bytes\n",
+                profile.midCat.noOfSlots, profile.midCat.slotCycle, test30Packets(&profile.midCat),
+                profile.midCat.peakPackets, profile.midCat.peakBytes);
+        fprintf(gFp, "cycle peak %u packets / %u bytes, %u external publishers\n",
+                profile.peakCyclePackets, profile.peakCycleBytes, profile.noOfExtPublishers);
+
+        if ((test30Packets(&profile.lowCat) != TEST30_NO_OF_LOW_PUBS) ||
+            (test30Packets(&profile.midCat) != TEST30_NO_OF_MID_PUBS) ||
+            (test30Packets(&profile.highCat) != 0u) ||
+            (profile.noOfExtPublishers != 1u))
+        {
+            FAILED("publishers missing or reported twice");
+        }
+        if ((profile.lowCat.peakPackets != 1u) || (profile.midCat.peakPackets != 1u) ||
+            (profile.peakCyclePackets < 1u) || (profile.peakCyclePackets > 2u))
+        {
+            FAILED("publishers not spread over the slots");
+        }
+        if ((profile.lowCat.peakBytes <= TEST30_DATA_SIZE) ||
+            (profile.midCat.peakBytes != profile.lowCat.peakBytes) ||
+            (profile.peakCycleBytes != profile.peakCyclePackets * profile.lowCat.peakBytes))
+        {
+            FAILED("bytes on the wire wrong");
+        }
+        for (i = 0u; i < profile.lowCat.noOfSlots; i++)
+        {
+            if (profile.lowCat.bytes[i] != profile.lowCat.packets[i] * profile.lowCat.peakBytes)
+            {
+                FAILED("bytes of a slot wrong");
+            }
+        }
+
+        /* A publisher added later is entered into the existing tables */
+        err = tlp_publish(gSession2.appHandle, &pubHandle, NULL, NULL, 0u, comId++, 0u, 0u, 0u,
+                          gSession1.ifaceIP, 100000u, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+        IF_ERROR("tlp_publish late");
+
+        err = tlp_getBurstProfile(gSession2.appHandle, &profile);
+        IF_ERROR("tlp_getBurstProfile");
+        if ((test30Packets(&profile.lowCat) != TEST30_NO_OF_LOW_PUBS + 1u) || (profile.lowCat.peakPackets != 1u))
+        {
+            FAILED("late publisher not reported");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** PD statistics counters
+ *  The receive and the transmit context count separately, tlc_getStatistics() must report their sum and
+ *  tlc_resetStatistics() must clear them.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST31_COMID_SUBSCRIBED     31000u
+#define TEST31_COMID_UNSUBSCRIBED   31001u
+#define TEST31_COMID_SILENT         31002u
+#define TEST31_INTERVAL             10000u
+#define TEST31_DURATION             500000u
+
+static int test31 ()
+{
+    PREPARE("PD statistics counters", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_STATISTICS_T   stats1, stats2;
+        UINT8               data[32];
+
+        memset(data, 0x31, sizeof(data));
+
+        err = tlp_subscribe(appHandle2, &subHandle, NULL, NULL, 0u,
+                            TEST31_COMID_SUBSCRIBED, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, NULL, TEST31_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        err = tlp_subscribe(appHandle2, &subHandle, NULL, NULL, 0u,
+                            TEST31_COMID_SILENT, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, NULL, TEST31_INTERVAL * 3u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe silent");
+
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, 0u, TEST31_COMID_SUBSCRIBED, 0u, 0u, 0u,
+                          gSession2.ifaceIP, TEST31_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, 0u, TEST31_COMID_UNSUBSCRIBED, 0u, 0u, 0u,
+                          gSession2.ifaceIP, TEST31_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+        IF_ERROR("tlp_publish unsubscribed");
+
+        err = tlc_updateSession(appHandle1);
+        IF_ERROR("tlc_updateSession 1");
+        err = tlc_updateSession(appHandle2);
+        IF_ERROR("tlc_updateSession 2");
+
+        vos_threadDelay(TEST31_DURATION);
+
+        /* The receiver first, the sender cannot have sent less since */
+        err = tlc_getStatistics(appHandle2, &stats2);
+        IF_ERROR("tlc_getStatistics 2");
+        err = tlc_getStatistics(appHandle1, &stats1);
+        IF_ERROR("tlc_getStatistics 1");
+
+        fprintf(gFp, "sent %u, received %u, no subscription %u, timeouts %u\n",
+                stats1.pd.numSend, stats2.pd.numRcv, stats2.pd.numNoSubs, stats2.pd.numTimeout);
+
+        if ((stats1.pd.numSend < TEST31_DURATION / TEST31_INTERVAL) ||
+            (stats2.pd.numRcv < TEST31_DURATION / TEST31_INTERVAL / 2u) ||
+            (stats2.pd.numRcv > stats1.pd.numSend))
+        {
+            FAILED("sent or received telegrams not counted");
+        }
+        if ((stats2.pd.numNoSubs == 0u) || (stats2.pd.numNoSubs > stats2.pd.numRcv))
+        {
+            FAILED("telegrams without subscription not counted");
+        }
+        if (stats2.pd.numTimeout != 1u)
+        {
+            FAILED("timeout not counted once");
+        }
+        if ((stats1.pd.numRcv != 0u) || (stats2.pd.numSend != 0u) ||
+            (stats2.pd.numCrcErr != 0u) || (stats2.pd.numProtErr != 0u) || (stats2.pd.numTopoErr != 0u))
+        {
+            FAILED("counters of another context changed");
+        }
+
+        err = tlc_resetStatistics(appHandle2);
+        IF_ERROR("tlc_resetStatistics");
+        err = tlc_getStatistics(appHandle2, &stats1);
+        IF_ERROR("tlc_getStatistics 2");
+        if ((stats1.pd.numRcv >= stats2.pd.numRcv) || (stats1.pd.numNoSubs >= stats2.pd.numNoSubs) ||
+            (stats1.pd.numTimeout != 0u))
+        {
+            FAILED("counters not reset");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** Session table limit
+ *  Sessions are opened until the session table (TRDP_MAX_SESSIONS) is full, the next one must be refused with
+ *  TRDP_MEM_ERR. After closing one session, another can be opened again.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+static int test32 ()
+{
+    PREPARE("Session table limit", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_APP_SESSION_T      sessions[TRDP_MAX_SESSIONS];
+        TRDP_PROCESS_CONFIG_T   procConf = {"Test", "me", "", 10000u, 0, TRDP_OPTION_NO_PD_STATS};
+        UINT32                  noOfSessions = 0u;
+        UINT32                  i;
+
+        memset(sessions, 0, sizeof(sessions));
+
+        /* appHandle1 and appHandle2 are already in the table */
+        for (i = 0u; i < TRDP_MAX_SESSIONS; i++)
+        {
+            err = tlc_openSession(&sessions[i], gSession1.ifaceIP, 0u, NULL, NULL, NULL, &procConf);
+            if (err != TRDP_NO_ERR)
+            {
+                break;
+            }
+            noOfSessions++;
+        }
+        fprintf(gFp, "%u sessions opened, then error %d\n", noOfSessions + 2u, err);
+
+        if ((noOfSessions != TRDP_MAX_SESSIONS - 2u) || (err != TRDP_MEM_ERR) || (sessions[noOfSessions] != NULL))
+        {
+            err = TRDP_NO_ERR;
+            gFailed = 1;
+        }
+        else
+        {
+            /* A freed entry can be used again */
+            err = tlc_closeSession(sessions[0]);
+            sessions[0] = NULL;
+            if (err == TRDP_NO_ERR)
+            {
+                err = tlc_openSession(&sessions[0], gSession1.ifaceIP, 0u, NULL, NULL, NULL, &procConf);
+            }
+        }
+
+        for (i = 0u; i < TRDP_MAX_SESSIONS; i++)
+        {
+            if (sessions[i] != NULL)
+            {
+                (void) tlc_closeSession(sessions[i]);
+            }
+        }
+        if (gFailed != 0)
+        {
+            FAILED("session table limit not enforced");
+        }
+        IF_ERROR("reopen after close");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** PD callback dispatch, order per comId
+ *  Several comIds are received by a session with four dispatch workers. The callbacks of each comId must be executed
+ *  one at a time and in the order of the sequence counter, none may be dropped.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST33_COMID                33000u
+#define TEST33_NO_OF_COMIDS         8u
+#define TEST33_INTERVAL             10000u
+#define TEST33_DURATION             1000000u
+
+typedef struct
+{
+    UINT32  inside;             /* callbacks currently executed */
+    UINT32  noOfCalls;
+    UINT32  noOfErrors;
+    UINT32  lastSeq;
+    BOOL8   started;
+} TEST33_SUB_T;
+
+static TEST33_SUB_T gTest33Sub[TEST33_NO_OF_COMIDS];
+
+static void test33CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TEST33_SUB_T *pSub = (TEST33_SUB_T *) pMsg->pUserRef;
+
+    if (VOS_ATOMIC_ADD(&pSub->inside, 1u) != 1u)
+    {
+        pSub->noOfErrors++;                         /* executed concurrently */
+    }
+    if (pMsg->resultCode == TRDP_NO_ERR)
+    {
+        if ((pSub->started == TRUE) && ((INT32) (pMsg->seqCount - pSub->lastSeq) <= 0))
+        {
+            pSub->noOfErrors++;                     /* out of order */
+        }
+        pSub->lastSeq   = pMsg->seqCount;
+        pSub->started   = TRUE;
+    }
+    pSub->noOfCalls++;
+    (void) vos_threadDelay(1000u);                  /* give the other workers a chance to overlap */
+    (void) VOS_ATOMIC_SUB(&pSub->inside, 1u);
+}
+
+static int test33 ()
+{
+    PREPARE("PD callback dispatch, order per comId", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T                      pubHandle[TEST33_NO_OF_COMIDS];
+        TRDP_SUB_T                      subHandle[TEST33_NO_OF_COMIDS];
+        TRDP_PD_DISPATCH_STATISTICS_T   stats;
+        UINT8                           data[16];
+        UINT32                          i;
+
+        memset(gTest33Sub, 0, sizeof(gTest33Sub));
+        memset(data, 0x33, sizeof(data));
+
+        err = tlp_setCallbackDispatch(appHandle2, 4u, 0u);
+        IF_ERROR("tlp_setCallbackDispatch");
+
+        for (i = 0u; i < TEST33_NO_OF_COMIDS; i++)
+        {
+            err = tlp_subscribe(appHandle2, &subHandle[i], &gTest33Sub[i], test33CBFunction, 0u,
+                                TEST33_COMID + i, 0u, 0u, 0u, 0u, 0u,
+                                TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, NULL, TEST33_INTERVAL * 50u, TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+
+            err = tlp_publish(appHandle1, &pubHandle[i], NULL, NULL, 0u, TEST33_COMID + i, 0u, 0u, 0u,
+                              gSession2.ifaceIP, TEST33_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+            IF_ERROR("tlp_publish");
+        }
+        err = tlc_updateSession(appHandle1);
+        IF_ERROR("tlc_updateSession 1");
+        err = tlc_updateSession(appHandle2);
+        IF_ERROR("tlc_updateSession 2");
+
+        vos_threadDelay(TEST33_DURATION);
+
+        /* Stop sending and let the queues drain before reading the counters the workers write */
+        for (i = 0u; i < TEST33_NO_OF_COMIDS; i++)
+        {
+            err = tlp_unpublish(appHandle1, pubHandle[i]);
+            IF_ERROR("tlp_unpublish");
+        }
+        vos_threadDelay(10u * TEST33_INTERVAL);
+
+        for (i = 0u; i < TEST33_NO_OF_COMIDS; i++)
+        {
+            err = tlp_getDispatchStatistics(appHandle2, subHandle[i], &stats);
+            IF_ERROR("tlp_getDispatchStatistics");
+
+            fprintf(gFp, "comId %u: %u callbacks, %u dropped, %u errors\n", TEST33_COMID + i,
+                    gTest33Sub[i].noOfCalls, stats.numDropped, gTest33Sub[i].noOfErrors);
+            if ((gTest33Sub[i].noOfErrors != 0u) ||
+                (gTest33Sub[i].noOfCalls < TEST33_DURATION / TEST33_INTERVAL / 4u) ||
+                (stats.numCalls != gTest33Sub[i].noOfCalls) || (stats.numDropped != 0u))
+            {
+                gFailed = 1;
+            }
+        }
+        if (gFailed != 0)
+        {
+            FAILED("callbacks of a comId overlapped, out of order or lost");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** PD callback dispatch, unsubscribe with queued callbacks
+ *  A slow callback lets the queue of a subscription fill up before it is unsubscribed. No queued callback may be
+ *  executed afterwards, the subscription is freed by the worker dropping the last reference.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST34_COMID                34000u
+#define TEST34_INTERVAL             10000u
+#define TEST34_CB_DURATION          30000u
+
+static UINT32   gTest34NoOfCalls;
+
+static void test34CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) VOS_ATOMIC_ADD(&gTest34NoOfCalls, 1u);
+    (void) vos_threadDelay(TEST34_CB_DURATION);
+}
+
+static int test34 ()
+{
+    PREPARE("PD callback dispatch, unsubscribe with queued callbacks", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T                      pubHandle;
+        TRDP_SUB_T                      subHandle;
+        TRDP_PD_DISPATCH_STATISTICS_T   stats;
+        UINT8                           data[16];
+        UINT32                          noOfCalls;
+
+        gTest34NoOfCalls = 0u;
+        memset(data, 0x34, sizeof(data));
+
+        err = tlp_setCallbackDispatch(appHandle2, 1u, 16u);
+        IF_ERROR("tlp_setCallbackDispatch");
+
+        err = tlp_subscribe(appHandle2, &subHandle, NULL, test34CBFunction, 0u,
+                            TEST34_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, NULL, TEST34_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, 0u, TEST34_COMID, 0u, 0u, 0u,
+                          gSession2.ifaceIP, TEST34_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        err = tlc_updateSession(appHandle1);
+        IF_ERROR("tlc_updateSession 1");
+        err = tlc_updateSession(appHandle2);
+        IF_ERROR("tlc_updateSession 2");
+
+        /* Three telegrams arrive while one callback executes */
+        vos_threadDelay(10u * TEST34_CB_DURATION);
+
+        err = tlp_getDispatchStatistics(appHandle2, subHandle, &stats);
+        IF_ERROR("tlp_getDispatchStatistics");
+        fprintf(gFp, "%u callbacks queued before unsubscribing\n", stats.queued);
+        if (stats.queued < 2u)
+        {
+            FAILED("no callbacks queued");
+        }
+
+        err = tlp_unsubscribe(appHandle2, subHandle);
+        IF_ERROR("tlp_unsubscribe");
+        noOfCalls = VOS_ATOMIC_LOAD(&gTest34NoOfCalls);
+
+        if (tlp_getDispatchStatistics(appHandle2, subHandle, &stats) != TRDP_NOSUB_ERR)
+        {
+            FAILED("statistics of an unsubscribed element");
+        }
+
+        /* The queue drains without executing the callbacks, except the one running while unsubscribing */
+        vos_threadDelay(stats.queued * TEST34_CB_DURATION + 100000u);
+        fprintf(gFp, "%u callbacks executed after unsubscribing\n", VOS_ATOMIC_LOAD(&gTest34NoOfCalls) - noOfCalls);
+        if (VOS_ATOMIC_LOAD(&gTest34NoOfCalls) > noOfCalls + 1u)
+        {
+            FAILED("queued callbacks executed after unsubscribing");
+        }
+
+        /* The dispatch stays usable */
+        err = tlp_subscribe(appHandle2, &subHandle, NULL, test34CBFunction, 0u,
+                            TEST34_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, NULL, TEST34_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe again");
+        err = tlc_updateSession(appHandle2);
+        IF_ERROR("tlc_updateSession 2");
+        noOfCalls = VOS_ATOMIC_LOAD(&gTest34NoOfCalls);
+        vos_threadDelay(5u * TEST34_CB_DURATION);
+        if (VOS_ATOMIC_LOAD(&gTest34NoOfCalls) == noOfCalls)
+        {
+            FAILED("no callbacks after subscribing again");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** PD callback dispatch, full queue
+ *  With a queue of one callback and a slow callback most telegrams must be dropped. Executed and dropped callbacks
+ *  must add up to the received telegrams.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST35_COMID                35000u
+#define TEST35_INTERVAL             10000u
+#define TEST35_CB_DURATION          50000u
+#define TEST35_DURATION             1000000u
+
+static UINT32   gTest35NoOfCalls;
+
+static void test35CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) VOS_ATOMIC_ADD(&gTest35NoOfCalls, 1u);
+    (void) vos_threadDelay(TEST35_CB_DURATION);
+}
+
+static int test35 ()
+{
+    PREPARE("PD callback dispatch, full queue", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T                      pubHandle;
+        TRDP_SUB_T                      subHandle;
+        TRDP_PD_DISPATCH_STATISTICS_T   stats;
+        TRDP_STATISTICS_T               sessionStats;
+        UINT8                           data[16];
+
+        gTest35NoOfCalls = 0u;
+        memset(data, 0x35, sizeof(data));
+
+        err = tlp_setCallbackDispatch(appHandle2, 1u, 1u);
+        IF_ERROR("tlp_setCallbackDispatch");
+
+        err = tlp_subscribe(appHandle2, &subHandle, NULL, test35CBFunction, 0u,
+                            TEST35_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, NULL, 10u * TEST35_DURATION, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, 0u, TEST35_COMID, 0u, 0u, 0u,
+                          gSession2.ifaceIP, TEST35_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        err = tlc_updateSession(appHandle1);
+        IF_ERROR("tlc_updateSession 1");
+        err = tlc_updateSession(appHandle2);
+        IF_ERROR("tlc_updateSession 2");
+
+        vos_threadDelay(TEST35_DURATION);
+
+        /* Stop sending and let the queue drain */
+        err = tlp_unpublish(appHandle1, pubHandle);
+        IF_ERROR("tlp_unpublish");
+        vos_threadDelay(4u * TEST35_CB_DURATION);
+
+        err = tlp_getDispatchStatistics(appHandle2, subHandle, &stats);
+        IF_ERROR("tlp_getDispatchStatistics");
+        err = tlc_getStatistics(appHandle2, &sessionStats);
+        IF_ERROR("tlc_getStatistics");
+
+        fprintf(gFp, "received %u, executed %u (%u), dropped %u, queued %u, max. queued %u, max. duration %u us\n",
+                sessionStats.pd.numRcv, stats.numCalls, VOS_ATOMIC_LOAD(&gTest35NoOfCalls), stats.numDropped,
+                stats.queued, stats.maxQueued, stats.maxDuration);
+
+        if ((stats.numCalls != VOS_ATOMIC_LOAD(&gTest35NoOfCalls)) || (stats.queued != 0u) ||
+            (stats.maxQueued == 0u) || (stats.maxDuration < TEST35_CB_DURATION))
+        {
+            FAILED("dispatch statistics wrong");
+        }
+        if ((stats.numDropped < sessionStats.pd.numRcv / 2u) ||
+            (stats.numCalls + stats.numDropped != sessionStats.pd.numRcv))
+        {
+            FAILED("dropped callbacks not counted");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** MD listener dispatch
+ *  Wildcard, URI and comId listeners overlap. For every notification the most recently added matching listener
+ *  must be called, as with a scan of the listener queue. Readding the listeners must not change the result,
+ *  deleting one must hand its notifications to the next older match.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST36_COMID                36000u
+#define TEST36_URI                  "test36"
+#define TEST36_NO_OF_LISTENERS      4u
+#define TEST36_NO_OF_MSGS           6u
+#define TEST36_NONE                 0xFFFFFFFFu
+
+/* listeners in the order they are added */
+#define TEST36_LIS_ANY              0u      /* no filter */
+#define TEST36_LIS_URI              1u      /* destination URI only */
+#define TEST36_LIS_COMID            2u      /* comId only */
+#define TEST36_LIS_COMID_URI        3u      /* comId and destination URI */
+
+static const struct
+{
+    UINT32          comId;
+    TRDP_URI_USER_T destURI;
+    UINT32          expected;               /* listener called, all listeners added */
+    UINT32          expectedWithoutComId;   /* listener called, TEST36_LIS_COMID deleted */
+} gTest36Msg[TEST36_NO_OF_MSGS] =
+{
+    {TEST36_COMID,      "",         TEST36_LIS_COMID,       TEST36_LIS_ANY},
+    {TEST36_COMID + 2u, "Test36",   TEST36_LIS_URI,         TEST36_LIS_URI},        /* URIs ignore the case */
+    {TEST36_COMID + 2u, "",         TEST36_LIS_ANY,         TEST36_LIS_ANY},
+    {TEST36_COMID,      TEST36_URI, TEST36_LIS_COMID,       TEST36_LIS_URI},
+    {TEST36_COMID + 1u, TEST36_URI, TEST36_LIS_COMID_URI,   TEST36_LIS_COMID_URI},
+    {TEST36_COMID + 1u, "",         TEST36_LIS_ANY,         TEST36_LIS_ANY}
+};
+
+static const UINT32             gTest36Id[TEST36_NO_OF_LISTENERS] =
+{
+    TEST36_LIS_ANY, TEST36_LIS_URI, TEST36_LIS_COMID, TEST36_LIS_COMID_URI
+};
+static const TRDP_URI_USER_T    gTest36URI = TEST36_URI;
+static volatile UINT32          gTest36Called       = TEST36_NONE;
+static volatile UINT32          gTest36NoOfCalls    = 0u;
+
+static void  test36CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->pUserRef != NULL))
+    {
+        gTest36Called = *(const UINT32 *) pMsg->pUserRef;
+    }
+    gTest36NoOfCalls++;
+}
+
+static TRDP_ERR_T test36AddListener (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_LIS_T          *pListenHandle,
+    UINT32              listener)
+{
+    BOOL8       comIdListener   = (listener == TEST36_LIS_COMID) || (listener == TEST36_LIS_COMID_URI);
+    UINT32      comId           = (listener == TEST36_LIS_COMID_URI) ? TEST36_COMID + 1u : TEST36_COMID;
+    const CHAR8 *destURI        = ((listener == TEST36_LIS_URI) || (listener == TEST36_LIS_COMID_URI)) ?
+                                  gTest36URI : NULL;
+
+    return tlm_addListener(appHandle, pListenHandle, &gTest36Id[listener], test36CBFunction, comIdListener,
+                           comIdListener ? comId : 0u, 0u, 0u, 0u, 0u, VOS_INADDR_ANY,
+                           TRDP_FLAGS_CALLBACK, NULL, destURI);
+}
+
+/* Send every notification and compare the listener called, returns the number of mismatches */
+static UINT32 test36Check (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               comIdListenerDeleted)
+{
+    UINT32  mismatches = 0u;
+    UINT32  msg;
+    UINT32  i;
+    UINT8   data[4] = {0x36, 0x36, 0x36, 0x36};
+
+    for (msg = 0u; msg < TEST36_NO_OF_MSGS; msg++)
+    {
+        UINT32 expected = comIdListenerDeleted ? gTest36Msg[msg].expectedWithoutComId : gTest36Msg[msg].expected;
+
+        gTest36Called       = TEST36_NONE;
+        gTest36NoOfCalls    = 0u;
+        if (tlm_notify(appHandle, NULL, NULL, gTest36Msg[msg].comId, 0u, 0u, 0u, gSession2.ifaceIP,
+                       TRDP_FLAGS_NONE, NULL, data, sizeof(data), NULL, gTest36Msg[msg].destURI) != TRDP_NO_ERR)
+        {
+            mismatches++;
+            continue;
+        }
+        for (i = 0u; (i < 20u) && (gTest36NoOfCalls == 0u); i++)
+        {
+            vos_threadDelay(50000u);
+        }
+        vos_threadDelay(50000u);      /* nothing more must arrive */
+        if ((gTest36Called != expected) || (gTest36NoOfCalls != 1u))
+        {
+            fprintf(gFp, "### comId %u, URI '%s': listener %d called %u times, expected %u\n",
+                    gTest36Msg[msg].comId, gTest36Msg[msg].destURI, (int) gTest36Called, gTest36NoOfCalls, expected);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+static int test36 ()
+{
+    PREPARE("MD listener dispatch", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T  listenHandle[TEST36_NO_OF_LISTENERS];
+        UINT32      listener;
+
+        for (listener = 0u; listener < TEST36_NO_OF_LISTENERS; listener++)
+        {
+            err = test36AddListener(appHandle2, &listenHandle[listener], listener);
+            IF_ERROR("tlm_addListener");
+        }
+
+        if (test36Check(appHandle1, FALSE) != 0u)
+        {
+            FAILED("wrong listener called");
+        }
+
+        for (listener = 0u; listener < TEST36_NO_OF_LISTENERS; listener++)
+        {
+            err = tlm_readdListener(appHandle2, listenHandle[listener], 0u, 0u, 0u, 0u, VOS_INADDR_ANY);
+            IF_ERROR("tlm_readdListener");
+        }
+        if (test36Check(appHandle1, FALSE) != 0u)
+        {
+            FAILED("wrong listener called after tlm_readdListener");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle[TEST36_LIS_COMID]);
+        IF_ERROR("tlm_delListener");
+        if (test36Check(appHandle1, TRUE) != 0u)
+        {
+            FAILED("wrong listener called after tlm_delListener");
+        }
+
+        /* added again it is the newest listener, as it was before */
+        err = test36AddListener(appHandle2, &listenHandle[TEST36_LIS_COMID], TEST36_LIS_COMID);
+        IF_ERROR("tlm_addListener");
+        if (test36Check(appHandle1, FALSE) != 0u)
+        {
+            FAILED("wrong listener called after adding it again");
+        }
+
+        for (listener = 0u; listener < TEST36_NO_OF_LISTENERS; listener++)
+        {
+            err = tlm_delListener(appHandle2, listenHandle[listener]);
+            IF_ERROR("tlm_delListener");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** PD timing histograms
+ *  After a short cyclic run the jitter of the subscription and the send deviation of the publisher must hold
+ *  samples, after tlc_resetStatistics() they must start again. The histograms are read while the PD threads run.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST37_COMID                37000u
+#define TEST37_INTERVAL             10000u      /* 10ms */
+#define TEST37_DURATION             1000000u    /* 1s */
+#define TEST37_MAX_ELEMENTS         16u
+
+/* Read the publisher and the subscription statistics of TEST37_COMID */
+static TRDP_ERR_T test37GetStatistics (
+    TRDP_APP_SESSION_T      appHandle1,
+    TRDP_APP_SESSION_T      appHandle2,
+    TRDP_PUB_STATISTICS_T   *pPubStats,
+    TRDP_SUBS_STATISTICS_T  *pSubStats)
+{
+    TRDP_PUB_STATISTICS_T   pubStats[TEST37_MAX_ELEMENTS];
+    TRDP_SUBS_STATISTICS_T  subStats[TEST37_MAX_ELEMENTS];
+    UINT16                  noOfPubs = TEST37_MAX_ELEMENTS;
+    UINT16                  noOfSubs = TEST37_MAX_ELEMENTS;
+    TRDP_ERR_T              err;
+    UINT16                  i;
+
+    err = tlc_getPubStatistics(appHandle1, &noOfPubs, pubStats);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    err = tlc_getSubsStatistics(appHandle2, &noOfSubs, subStats);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    err = TRDP_NOPUB_ERR;
+    for (i = 0u; i < noOfPubs; i++)
+    {
+        if (pubStats[i].comId == TEST37_COMID)
+        {
+            *pPubStats  = pubStats[i];
+            err         = TRDP_NO_ERR;
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    err = TRDP_NOSUB_ERR;
+    for (i = 0u; i < noOfSubs; i++)
+    {
+        if (subStats[i].comId == TEST37_COMID)
+        {
+            *pSubStats  = subStats[i];
+            err         = TRDP_NO_ERR;
+        }
+    }
+    return err;
+}
+
+/* Bucket sum, min, p99 and max must agree with the count, returns FALSE if not */
+static BOOL8 test37Consistent (
+    const CHAR8             *pName,
+    const TRDP_HISTOGRAM_T  *pHist)
+{
+    UINT32  sum = 0u;
+    UINT32  i;
+
+    for (i = 0u; i < TRDP_HISTOGRAM_BUCKETS; i++)
+    {
+        sum += pHist->bucket[i];
+    }
+    fprintf(gFp, "%s: count %u, min %u us, max %u us, p99 %u us\n", pName, pHist->count, pHist->min, pHist->max,
+            pHist->p99);
+    if (sum != pHist->count)
+    {
+        return FALSE;
+    }
+    if (pHist->count == 0u)
+    {
+        return (pHist->min == 0u) && (pHist->max == 0u) && (pHist->p99 == 0u);
+    }
+    return (pHist->min <= pHist->p99) && (pHist->p99 <= pHist->max);
+}
+
+static int test37 ()
+{
+    PREPARE("PD timing histograms", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T              pubHandle;
+        TRDP_SUB_T              subHandle;
+        TRDP_PUB_STATISTICS_T   pubStats;
+        TRDP_SUBS_STATISTICS_T  subStats;
+        UINT32                  deviationCount;
+        UINT32                  jitterCount;
+        UINT8                   data[16];
+
+        memset(data, 0x37, sizeof(data));
+
+        err = tlp_subscribe(appHandle2, &subHandle, NULL, NULL, 0u,
+                            TEST37_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, NULL, TEST37_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, 0u, TEST37_COMID, 0u, 0u, 0u,
+                          gSession2.ifaceIP, TEST37_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        err = tlc_updateSession(appHandle1);
+        IF_ERROR("tlc_updateSession 1");
+        err = tlc_updateSession(appHandle2);
+        IF_ERROR("tlc_updateSession 2");
+
+        vos_threadDelay(TEST37_DURATION);
+
+        err = test37GetStatistics(appHandle1, appHandle2, &pubStats, &subStats);
+        IF_ERROR("tlc_getPubStatistics/tlc_getSubsStatistics");
+
+        fprintf(gFp, "sent %u, received %u\n", pubStats.numSend, subStats.numRecv);
+        if (!test37Consistent("deviation", &pubStats.deviation) || !test37Consistent("jitter", &subStats.jitter))
+        {
+            FAILED("histogram inconsistent");
+        }
+        if ((pubStats.deviation.count < pubStats.numSend / 2u) || (pubStats.deviation.count > pubStats.numSend) ||
+            (subStats.jitter.count < subStats.numRecv / 2u) || (subStats.jitter.count > subStats.numRecv) ||
+            (subStats.numRecv < TEST37_DURATION / TEST37_INTERVAL / 2u))
+        {
+            FAILED("samples not recorded");
+        }
+        deviationCount  = pubStats.deviation.count;
+        jitterCount     = subStats.jitter.count;
+
+        err = tlc_resetStatistics(appHandle1);
+        IF_ERROR("tlc_resetStatistics 1");
+        err = tlc_resetStatistics(appHandle2);
+        IF_ERROR("tlc_resetStatistics 2");
+
+        err = test37GetStatistics(appHandle1, appHandle2, &pubStats, &subStats);
+        IF_ERROR("tlc_getPubStatistics/tlc_getSubsStatistics");
+
+        if (!test37Consistent("deviation after reset", &pubStats.deviation) ||
+            !test37Consistent("jitter after reset", &subStats.jitter))
+        {
+            FAILED("histogram inconsistent after reset");
+        }
+        if ((pubStats.deviation.count >= deviationCount / 2u) || (subStats.jitter.count >= jitterCount / 2u))
+        {
+            FAILED("histograms not reset");
+        }
+
+        /* and they fill again */
+        vos_threadDelay(TEST37_DURATION / 4u);
+
+        err = test37GetStatistics(appHandle1, appHandle2, &pubStats, &subStats);
+        IF_ERROR("tlc_getPubStatistics/tlc_getSubsStatistics");
+
+        if (!test37Consistent("deviation", &pubStats.deviation) || !test37Consistent("jitter", &subStats.jitter) ||
+            (pubStats.deviation.count == 0u) || (subStats.jitter.count == 0u))
+        {
+            FAILED("no samples after reset");
+        }
+
+        err = tlp_unpublish(appHandle1, pubHandle);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_unsubscribe(appHandle2, subHandle);
+        IF_ERROR("tlp_unsubscribe");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
 /**********************************************************************************************************************/
 /* This array holds pointers to the m-th test (m = 1 will execute test1...)                                           */
 /**********************************************************************************************************************/
@@ -3517,6 +5821,22 @@ test_func_t *testArray[] =
     test19,  /* Basic test of PD send performance enhancement */
     test20,  /* Basic test of PD receive performance enhancement */
     test21,  /* Basic test of PD send/receive performance enhancement, unpublish/unsubscribe while operating */
+    test22,  /* Sub-millisecond base cycle (High Performance), inter-arrival jitter */
+    test23,  /* Concurrent large TCP MD requests on one connection */
+    test24,  /* Borrowed MD buffers */
+    test25,  /* Pipelined and partially received TCP MD messages */
+    test26,  /* MD session IDs */
+    test27,  /* Mixed indexed and non-indexed sessions */
+    test28,  /* MD completion queue */
+    test29,  /* Batched notifications */
+    test30,  /* Burst profile */
+    test31,  /* PD statistics counters */
+    test32,  /* Session table limit */
+    test33,  /* PD callback dispatch, order */
+    test34,  /* PD callback dispatch, unsubscribe */
+    test35,  /* PD callback dispatch, full queue */
+    test36,  /* MD listener dispatch */
+    test37,  /* PD timing histograms */
     NULL
 };
 
@@ -3540,7 +5860,7 @@ int main (int argc, char *argv[])
         gFp = stdout;
     }
 
-    while ((ch = getopt(argc, argv, "d:i:t:o:m:h?v")) != -1)
+    while ((ch = getopt(argc, argv, "d:i:t:o:m:jh?v")) != -1)
     {
         switch (ch)
         {
@@ -3587,6 +5907,9 @@ int main (int argc, char *argv[])
                 }
                 break;
             }
+            case 'j':   /*  strict timing */
+                gStrictTiming = TRUE;
+                break;
             case 'v':   /*  version */
                 printf("%s: Version %s\t(%s - %s)\n",
                        argv[0], APP_VERSION, __DATE__, __TIME__);
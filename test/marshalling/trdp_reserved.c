@@ -16,6 +16,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-18: Subscription and publish statistics datasets completed, timing histograms added
  *      BL 2019-02-01: Ticket #234 Correcting Statistics ComIds
  *      BL 2018-09-05: Ticket #211 XML handling: Dataset Name should be stored in TRDP_DATASET_ELEMENT_T
  *      BL 2017-06-30: Compiler warnings, local prototypes added
@@ -343,7 +344,7 @@ TRDP_DATASET_T  dsSubsStatistics =   /* subs statistics */
 {
     TRDP_SUBS_STATISTICS_DSID,         /*    dataset/com ID  */
     0,          /*    reserved        */
-    8,         /*    No of elements, var size    */
+    15,        /*    No of elements, var size    */
     {           /*    TRDP_DATASET_ELEMENT_T[]    */
         {
             TRDP_UINT32,   /**< Subscribed ComId */
@@ -366,6 +367,11 @@ TRDP_DATASET_T  dsSubsStatistics =   /* subs statistics */
             1,
             NULL, NULL, 0, 0, NULL
         },
+        {
+            TRDP_UINT32,   /**< User reference if used */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
         {
             TRDP_UINT32,   /**< Time-out value in us. 0 = No time-out supervision */
             1,
@@ -385,6 +391,36 @@ TRDP_DATASET_T  dsSubsStatistics =   /* subs statistics */
             TRDP_UINT32,   /**< Number of packets received for this subscription. */
             1,
             NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< Number of packets skipped for this subscription */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< Number of jitter samples */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< Smallest jitter in us */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< Largest jitter in us */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< 99th percentile of the jitter in us */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< Jitter histogram, logarithmic buckets */
+            TRDP_HISTOGRAM_BUCKETS,
+            NULL, NULL, 0, 0, NULL
         }
     }
 };
@@ -412,7 +448,7 @@ TRDP_DATASET_T  dsPubStatistics =   /* pub statistics */
 {
     TRDP_PUB_STATISTICS_DSID,         /*    dataset/com ID  */
     0,          /*    reserved        */
-    7,         /*    No of elements, var size    */
+    12,        /*    No of elements, var size    */
     {           /*    TRDP_DATASET_ELEMENT_T[]    */
         {
             TRDP_UINT32,   /**< Published ComId  */
@@ -448,8 +484,32 @@ TRDP_DATASET_T  dsPubStatistics =   /* pub statistics */
             TRDP_UINT32,   /**< Number of packets sent out */
             1,
             NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< Number of deviation samples */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< Smallest deviation in us */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< Largest deviation in us */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< 99th percentile of the deviation in us */
+            1,
+            NULL, NULL, 0, 0, NULL
+        },
+        {
+            TRDP_UINT32,   /**< Deviation histogram, logarithmic buckets */
+            TRDP_HISTOGRAM_BUCKETS,
+            NULL, NULL, 0, 0, NULL
         }
-
     }
 };
 